@@ -0,0 +1,216 @@
+#include "bench_runner.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QSysInfo>
+#include <QtGlobal>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+volatile quint64 g_benchSink = 0;
+
+double median(QVector<double> values)
+{
+    if (values.isEmpty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    const int middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+double percentile(const QVector<double>& sorted, double fraction)
+{
+    if (sorted.isEmpty()) {
+        return 0;
+    }
+    const int index = qBound(0, static_cast<int>(fraction * (sorted.size() - 1) + 0.5), static_cast<int>(sorted.size()) - 1);
+    return sorted[index];
+}
+
+} // namespace
+
+void benchKeep(quint64 value)
+{
+    g_benchSink = g_benchSink + value;
+}
+
+BenchRunner::BenchRunner()
+    : m_minTimeMs(200)
+    , m_repeats(5)
+{
+}
+
+void BenchRunner::setFilter(const QString& pattern)
+{
+    m_filter = QRegularExpression(pattern);
+}
+
+void BenchRunner::setMinTimeMs(int minTimeMs)
+{
+    m_minTimeMs = qMax(1, minTimeMs);
+}
+
+void BenchRunner::setRepeats(int repeats)
+{
+    m_repeats = qMax(1, repeats);
+}
+
+bool BenchRunner::selected(const QString& name) const
+{
+    return m_filter.pattern().isEmpty() || m_filter.match(name).hasMatch();
+}
+
+void BenchRunner::runMicro(const QString& name, const QString& unit, double bytesPerOp, double opsPerCall,
+                           const std::function<void(qint64)>& body)
+{
+    if (!selected(name)) {
+        return;
+    }
+
+    // 预热并估计循环次数：次数翻倍直到一轮超过 minTimeMs 的十分之一
+    QElapsedTimer timer;
+    qint64 iterations = 1;
+    for (;;) {
+        timer.start();
+        body(iterations);
+        const qint64 elapsedNs = timer.nsecsElapsed();
+        if (elapsedNs >= m_minTimeMs * 100000LL || iterations >= (1LL << 40)) {
+            const double perCall = static_cast<double>(elapsedNs) / iterations;
+            iterations = qMax<qint64>(1, static_cast<qint64>(m_minTimeMs * 1000000.0 / qMax(1.0, perCall)));
+            break;
+        }
+        iterations *= 2;
+    }
+
+    QVector<double> samples;
+    for (int repeat = 0; repeat < m_repeats; ++repeat) {
+        timer.start();
+        body(iterations);
+        samples.append(static_cast<double>(timer.nsecsElapsed()) / iterations / opsPerCall);
+    }
+
+    Result result;
+    result.name = name;
+    result.unit = unit;
+    result.value = median(samples);
+    result.min = *std::min_element(samples.constBegin(), samples.constEnd());
+    result.iterations = iterations;
+    result.bytesPerOp = bytesPerOp;
+    report(result);
+}
+
+void BenchRunner::addLatency(const QString& name, QVector<qint64> samplesNs)
+{
+    if (samplesNs.isEmpty()) {
+        skip(name, "没有采样");
+        return;
+    }
+    QVector<double> sorted;
+    sorted.reserve(samplesNs.size());
+    for (qint64 sample : samplesNs) {
+        sorted.append(sample / 1000.0);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    Result result;
+    result.name = name;
+    result.unit = "us";
+    result.value = percentile(sorted, 0.5);
+    result.min = sorted.first();
+    result.p90 = percentile(sorted, 0.9);
+    result.p99 = percentile(sorted, 0.99);
+    result.max = sorted.last();
+    result.iterations = sorted.size();
+    report(result);
+}
+
+void BenchRunner::skip(const QString& name, const QString& reason)
+{
+    if (selected(name)) {
+        fprintf(stderr, "%-36s 跳过: %s\n", qPrintable(name), qPrintable(reason));
+    }
+}
+
+void BenchRunner::report(const Result& result)
+{
+    m_results.append(result);
+    if (result.unit == "us") {
+        fprintf(stderr, "%-36s %10.1f us  p90 %8.1f  p99 %8.1f  max %8.1f  (%lld 次)\n",
+                qPrintable(result.name), result.value, result.p90, result.p99, result.max,
+                static_cast<long long>(result.iterations));
+    } else if (result.bytesPerOp > 0) {
+        fprintf(stderr, "%-36s %10.1f %-9s min %10.1f  %8.1f MB/s\n",
+                qPrintable(result.name), result.value, qPrintable(result.unit), result.min,
+                result.throughputMBps());
+    } else {
+        fprintf(stderr, "%-36s %10.1f %-9s min %10.1f\n",
+                qPrintable(result.name), result.value, qPrintable(result.unit), result.min);
+    }
+}
+
+QJsonObject BenchRunner::toJson() const
+{
+    QJsonArray results;
+    for (const Result& result : m_results) {
+        QJsonObject item;
+        item.insert("name", result.name);
+        item.insert("unit", result.unit);
+        item.insert("value", result.value);
+        item.insert("min", result.min);
+        item.insert("iterations", static_cast<double>(result.iterations));
+        if (result.unit == "us") {
+            item.insert("p90", result.p90);
+            item.insert("p99", result.p99);
+            item.insert("max", result.max);
+        }
+        if (result.bytesPerOp > 0) {
+            item.insert("throughputMBps", result.throughputMBps());
+        }
+        results.append(item);
+    }
+
+    QJsonObject root;
+    root.insert("schema", 1);
+    root.insert("timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    root.insert("host", QSysInfo::machineHostName());
+    root.insert("cpu", QSysInfo::currentCpuArchitecture());
+    root.insert("os", QSysInfo::prettyProductName());
+    root.insert("qt", QString(qVersion()));
+#ifdef QT_DEBUG
+    root.insert("build", "debug");
+#else
+    root.insert("build", "release");
+#endif
+    root.insert("results", results);
+    return root;
+}
+
+QList<BenchRunner::Comparison> BenchRunner::compare(const QJsonObject& baseline, double thresholdPercent) const
+{
+    QHash<QString, double> baselineValues;
+    const QJsonArray items = baseline.value("results").toArray();
+    for (const QJsonValue& value : items) {
+        const QJsonObject item = value.toObject();
+        baselineValues.insert(item.value("name").toString(), item.value("value").toDouble());
+    }
+
+    QList<Comparison> comparisons;
+    for (const Result& result : m_results) {
+        const double base = baselineValues.value(result.name, 0);
+        if (base <= 0) {
+            continue;
+        }
+        Comparison comparison;
+        comparison.name = result.name;
+        comparison.baseline = base;
+        comparison.current = result.value;
+        comparison.changePercent = (result.value - base) * 100.0 / base;
+        comparison.regression = comparison.changePercent > thresholdPercent;
+        comparisons.append(comparison);
+    }
+    return comparisons;
+}
@@ -0,0 +1,83 @@
+#ifndef BENCH_RUNNER_H
+#define BENCH_RUNNER_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QRegularExpression>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+/*
+    基准测试运行器
+    1. 微基准：先估计循环次数，使一轮耗时不少于 minTimeMs，再重复 repeats 轮，
+       取每次操作耗时的中位数为结果，同时记录最小值
+    2. 延迟基准：由调用方逐次测量往返时间，记录中位数和 p90/p99/最大值
+    3. 结果可输出为 JSON，并与之前保存的 JSON 基线逐项比较，
+       中位数变慢超过阈值的项目视为回退
+ */
+class BenchRunner
+{
+public:
+    struct Result {
+        QString name;
+        QString unit;           // ns/op、ns/frame、ns/record、us
+        double value;           // 中位数
+        double min;
+        double p90;             // 仅延迟基准
+        double p99;
+        double max;
+        qint64 iterations;      // 每轮循环次数或延迟采样数
+        double bytesPerOp;      // 大于 0 时输出吞吐量
+
+        Result() : value(0), min(0), p90(0), p99(0), max(0), iterations(0), bytesPerOp(0) {}
+        double throughputMBps() const { return bytesPerOp > 0 && value > 0 ? bytesPerOp * 1000.0 / value : 0; }
+    };
+
+    // 与基线比较的一项
+    struct Comparison {
+        QString name;
+        double baseline;
+        double current;
+        double changePercent;   // 正数表示变慢
+        bool regression;
+    };
+
+    BenchRunner();
+
+    void setFilter(const QString& pattern);
+    void setMinTimeMs(int minTimeMs);
+    void setRepeats(int repeats);
+
+    // 名称是否匹配过滤条件（不匹配的基准不运行）
+    bool selected(const QString& name) const;
+
+    // body(n) 执行 n 次被测操作；opsPerCall 为每次操作包含的单元数（帧数、记录数），
+    // unit 以该单元计
+    void runMicro(const QString& name, const QString& unit, double bytesPerOp, double opsPerCall,
+                  const std::function<void(qint64)>& body);
+
+    // 延迟采样（纳秒），结果以微秒表示
+    void addLatency(const QString& name, QVector<qint64> samplesNs);
+
+    // 跳过的基准（环境不支持等），只打印原因
+    void skip(const QString& name, const QString& reason);
+
+    const QList<Result>& results() const { return m_results; }
+
+    QJsonObject toJson() const;
+    QList<Comparison> compare(const QJsonObject& baseline, double thresholdPercent) const;
+
+private:
+    void report(const Result& result);
+
+    QRegularExpression m_filter;
+    int m_minTimeMs;
+    int m_repeats;
+    QList<Result> m_results;
+};
+
+// 防止编译器把被测结果优化掉
+void benchKeep(quint64 value);
+
+#endif // BENCH_RUNNER_H
@@ -0,0 +1,13 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+class BenchRunner;
+
+// 热路径微基准：CRC、建帧、解析校验、分片重组、接收路径 trace 关闭/开启、VCU解码、字段格式化
+void runMicroBenchmarks(BenchRunner& runner);
+
+// 端到端请求延迟：经完整收发链路（发送队列、I/O线程、接收流水线、跨线程信号）
+// 对本机模拟设备往返，TCP 回环和伪终端（Unix）各测一组
+void runLatencyBenchmarks(BenchRunner& runner, int samples);
+
+#endif // BENCHMARKS_H
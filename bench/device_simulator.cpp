@@ -0,0 +1,234 @@
+#include "device_simulator.h"
+#include <QHostAddress>
+#include <QSocketNotifier>
+#include <QTcpSocket>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+DeviceSimulator::DeviceSimulator(QObject *parent)
+    : QObject(parent)
+    , m_tcpPort(0)
+    , m_ptyMaster(-1)
+    , m_ptySlaveHold(-1)
+    , m_ptyNotifier(nullptr)
+    , m_replied(0)
+{
+    connect(&m_server, &QTcpServer::newConnection, this, &DeviceSimulator::onNewConnection);
+}
+
+DeviceSimulator::~DeviceSimulator()
+{
+    stop();
+}
+
+QByteArray DeviceSimulator::buildReply(quint16 functionCode)
+{
+    QByteArray payload;
+    switch (functionCode) {
+    case PC_MAC_ADDR_QUERY:
+        payload = QByteArray::fromHex("02a0b0c0d0e0");
+        break;
+    case PC_IP_ADDR_QUERY:
+        payload = QByteArray::fromHex("c0a80164");
+        break;
+    case PC_MASK_ADDR_QUERY:
+        payload = QByteArray::fromHex("ffffff00");
+        break;
+    case PC_GATEWAY_ADDR_QUERY:
+        payload = QByteArray::fromHex("c0a80101");
+        break;
+    case PC_VCU_INFO_GET: {
+        const state_def_t state = sampleVcuState();
+        payload = QByteArray(reinterpret_cast<const char*>(&state), sizeof(state));
+        break;
+    }
+    case PC_HARDFAULT_INFO_GET:
+        payload = QByteArray(static_cast<int>(sizeof(hardfault_info_t)), '\0');
+        break;
+    default:
+        break;
+    }
+
+    pc_comm_protocol__head_t header;
+    header.head = pc_protocol_head;
+    header.source_addr = mcu_addr;
+    header.target_addr = pc_addr;
+    header.function_code = functionCode;
+    header.data_length = static_cast<uint16_t>(payload.size());
+
+    QByteArray frame;
+    frame.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    frame.append(payload);
+    const uint16_t crc = static_cast<uint16_t>(
+        CRC16(reinterpret_cast<uint8_t*>(frame.data()), static_cast<unsigned int>(frame.size())));
+    frame.append(reinterpret_cast<const char*>(&crc), 2);
+    return frame;
+}
+
+state_def_t DeviceSimulator::sampleVcuState()
+{
+    // 每个字节取不同的值，数值字段不全为 0，格式化和解码都走正常路径
+    state_def_t state;
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(&state);
+    for (size_t i = 0; i < sizeof(state); ++i) {
+        bytes[i] = static_cast<unsigned char>(i * 37 + 11);
+    }
+    state.voltage = 48.5f;
+    strncpy(state.boot_version, "H7-BOOT-1.2.3", sizeof(state.boot_version));
+    return state;
+}
+
+bool DeviceSimulator::start()
+{
+    if (!m_server.listen(QHostAddress::LocalHost, 0)) {
+        return false;
+    }
+    m_tcpPort = m_server.serverPort();
+    openPty();
+    return true;
+}
+
+void DeviceSimulator::stop()
+{
+    m_server.close();
+    for (auto it = m_tcpPipelines.begin(); it != m_tcpPipelines.end(); ++it) {
+        it.key()->deleteLater();
+        delete it.value();
+    }
+    m_tcpPipelines.clear();
+    closePty();
+}
+
+void DeviceSimulator::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        m_tcpPipelines.insert(socket, new FramePipeline());
+        connect(socket, &QTcpSocket::readyRead, this, &DeviceSimulator::onTcpReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            delete m_tcpPipelines.take(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void DeviceSimulator::onTcpReadyRead()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    FramePipeline* pipeline = m_tcpPipelines.value(socket);
+    if (!socket || !pipeline) {
+        return;
+    }
+    const QByteArray data = socket->readAll();
+    const QByteArray replies = handle(pipeline, data.constData(), data.size());
+    if (!replies.isEmpty()) {
+        socket->write(replies);
+    }
+}
+
+QByteArray DeviceSimulator::handle(FramePipeline* pipeline, const char* data, int size)
+{
+    // 请求帧的数据长度一般为 0，解码结果只用到功能码
+    QByteArray replies;
+    const QVector<DeviceMessage> requests = pipeline->feed(data, size);
+    for (const DeviceMessage& request : requests) {
+        if (request.type == DeviceMessage::InvalidFrame) {
+            continue;
+        }
+        replies.append(buildReply(request.functionCode));
+        m_replied++;
+    }
+    return replies;
+}
+
+#ifdef Q_OS_UNIX
+
+bool DeviceSimulator::openPty()
+{
+    m_ptyMaster = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m_ptyMaster < 0 || grantpt(m_ptyMaster) != 0 || unlockpt(m_ptyMaster) != 0) {
+        closePty();
+        return false;
+    }
+    const char* slaveName = ptsname(m_ptyMaster);
+    if (!slaveName) {
+        closePty();
+        return false;
+    }
+    m_ptyName = QString::fromLocal8Bit(slaveName);
+
+    // 原始模式：不回显、不做行处理
+    termios options;
+    if (tcgetattr(m_ptyMaster, &options) == 0) {
+        cfmakeraw(&options);
+        tcsetattr(m_ptyMaster, TCSANOW, &options);
+    }
+    fcntl(m_ptyMaster, F_SETFL, fcntl(m_ptyMaster, F_GETFL) | O_NONBLOCK);
+    m_ptySlaveHold = ::open(slaveName, O_RDWR | O_NOCTTY);
+
+    m_ptyNotifier = new QSocketNotifier(m_ptyMaster, QSocketNotifier::Read, this);
+    connect(m_ptyNotifier, &QSocketNotifier::activated, this, &DeviceSimulator::onPtyReadable);
+    return true;
+}
+
+void DeviceSimulator::closePty()
+{
+    delete m_ptyNotifier;
+    m_ptyNotifier = nullptr;
+    if (m_ptySlaveHold >= 0) {
+        ::close(m_ptySlaveHold);
+        m_ptySlaveHold = -1;
+    }
+    if (m_ptyMaster >= 0) {
+        ::close(m_ptyMaster);
+        m_ptyMaster = -1;
+    }
+    m_ptyName.clear();
+}
+
+void DeviceSimulator::onPtyReadable()
+{
+    char buffer[4096];
+    for (;;) {
+        const ssize_t bytesRead = ::read(m_ptyMaster, buffer, sizeof(buffer));
+        if (bytesRead <= 0) {
+            break;
+        }
+        const QByteArray replies = handle(&m_ptyPipeline, buffer, static_cast<int>(bytesRead));
+        int offset = 0;
+        while (offset < replies.size()) {
+            const ssize_t written = ::write(m_ptyMaster, replies.constData() + offset, replies.size() - offset);
+            if (written < 0) {
+                if (errno == EAGAIN || errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            offset += static_cast<int>(written);
+        }
+    }
+}
+
+#else
+
+bool DeviceSimulator::openPty()
+{
+    return false;
+}
+
+void DeviceSimulator::closePty()
+{
+}
+
+void DeviceSimulator::onPtyReadable()
+{
+}
+
+#endif
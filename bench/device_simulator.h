@@ -0,0 +1,69 @@
+#ifndef DEVICE_SIMULATOR_H
+#define DEVICE_SIMULATOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QTcpServer>
+#include "protocol/frame_pipeline.h"
+
+class QSocketNotifier;
+class QTcpSocket;
+
+/*
+    本机设备模拟器，用于端到端延迟测试
+    1. 在 127.0.0.1 的随机端口上监听 TCP，在 Unix 上另外创建一对伪终端（pty），
+       从端路径可直接作为串口名称打开
+    2. 收到请求帧后立即以同一功能码应答：网络参数查询回 4/6 字节，
+       VCU综合信息回 state_def_t，HardFault 回 hardfault_info_t，其他功能码回空数据
+    3. 应放在单独线程中运行，与被测的传输线程和主线程互不干扰；
+       start() 在模拟器线程中调用（BlockingQueuedConnection）
+ */
+class DeviceSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DeviceSimulator(QObject *parent = nullptr);
+    ~DeviceSimulator();
+
+    // 设备对 functionCode 的应答帧
+    static QByteArray buildReply(quint16 functionCode);
+    // 填充了示例数据的VCU综合信息
+    static state_def_t sampleVcuState();
+
+    quint16 tcpPort() const { return m_tcpPort; }
+    // 伪终端从端路径，不支持时为空
+    QString ptyName() const { return m_ptyName; }
+
+    // 已应答的请求数
+    qint64 repliedCount() const { return m_replied; }
+
+public slots:
+    bool start();
+    void stop();
+
+private slots:
+    void onNewConnection();
+    void onTcpReadyRead();
+    void onPtyReadable();
+
+private:
+    QByteArray handle(FramePipeline* pipeline, const char* data, int size);
+    bool openPty();
+    void closePty();
+
+    QTcpServer m_server;
+    quint16 m_tcpPort;
+    QHash<QTcpSocket*, FramePipeline*> m_tcpPipelines;
+
+    QString m_ptyName;
+    int m_ptyMaster;
+    int m_ptySlaveHold;         // 模拟器自己持有一个从端，避免串口关闭时主端持续报告挂断
+    QSocketNotifier* m_ptyNotifier;
+    FramePipeline m_ptyPipeline;
+
+    qint64 m_replied;
+};
+
+#endif // DEVICE_SIMULATOR_H
@@ -0,0 +1,23 @@
+# 基准测试：协议热路径微基准和本机模拟设备端到端延迟，不链接 QtGui/QtWidgets
+# 测量应使用 release 构建: qmake CONFIG+=release
+QT       = core serialport network
+
+# 协程设备接口（DeviceSession）需要 C++20；c++2a 兼容 Qt5 的 qmake
+CONFIG += c++2a console
+CONFIG -= app_bundle
+
+TARGET = h7_bench
+
+include(../h7_core.pri)
+
+SOURCES += \
+    main.cpp \
+    bench_runner.cpp \
+    device_simulator.cpp \
+    latency_benchmarks.cpp \
+    micro_benchmarks.cpp
+
+HEADERS += \
+    bench_runner.h \
+    benchmarks.h \
+    device_simulator.h
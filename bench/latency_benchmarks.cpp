@@ -0,0 +1,178 @@
+#include "benchmarks.h"
+#include "bench_runner.h"
+#include "device_simulator.h"
+#include "communication/serial_thread.h"
+#include "communication/socket_thread.h"
+#include "protocol/protocol_frame.h"
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QThread>
+#include <QTimer>
+
+namespace {
+
+const int kWarmupRounds = 20;
+const int kReplyTimeoutMs = 1000;
+
+// 等待传输对象连接成功
+template <typename Transport>
+bool waitConnected(Transport* transport, int timeoutMs)
+{
+    if (transport->isConnected()) {
+        return true;
+    }
+    QEventLoop loop;
+    bool connected = false;
+    QObject::connect(transport, &Transport::connectionStateChanged, &loop, [&](bool state) {
+        connected = state;
+        loop.quit();
+    });
+    QTimer::singleShot(timeoutMs, &loop, &QEventLoop::quit);
+    loop.exec();
+    return connected;
+}
+
+// 逐次发送请求并等待同功能码的应答，记录往返时间；超时返回已采集的部分并给出错误
+template <typename Transport>
+QVector<qint64> measureRoundTrips(Transport* transport, const QByteArray& request, int samples, QString* error)
+{
+    const quint16 replyCode = ProtocolFrame::functionCodeOf(request);
+    QVector<qint64> result;
+    result.reserve(samples);
+
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    bool replied = false;
+    QObject::connect(transport, &Transport::messageReceived, &loop, [&](const DeviceMessage& message) {
+        if (message.functionCode == replyCode && message.isValid()) {
+            replied = true;
+            loop.quit();
+        }
+    });
+
+    QElapsedTimer timer;
+    for (int i = 0; i < kWarmupRounds + samples; ++i) {
+        replied = false;
+        timeout.start(kReplyTimeoutMs);
+        timer.start();
+        transport->sendData(request, SendQueue::OneShotQuery);
+        loop.exec();
+        const qint64 elapsedNs = timer.nsecsElapsed();
+        if (!replied) {
+            *error = QString("第 %1 次请求在 %2 ms 内未收到应答").arg(i + 1).arg(kReplyTimeoutMs);
+            break;
+        }
+        if (i >= kWarmupRounds) {
+            result.append(elapsedNs);
+        }
+    }
+    return result;
+}
+
+template <typename Transport>
+void measureRequests(BenchRunner& runner, Transport* transport, const QString& prefix, int samples)
+{
+    const struct {
+        const char* name;
+        QByteArray request;
+    } requests[] = {
+        { "ip_query", ProtocolFrame::buildIpQueryFrame() },
+        { "vcu_get", ProtocolFrame::buildVcuInfoGetFrame() }
+    };
+
+    for (const auto& request : requests) {
+        const QString name = prefix + request.name;
+        if (!runner.selected(name)) {
+            continue;
+        }
+        QString error;
+        const QVector<qint64> roundTrips = measureRoundTrips(transport, request.request, samples, &error);
+        if (!error.isEmpty()) {
+            runner.skip(name, error);
+        } else {
+            runner.addLatency(name, roundTrips);
+        }
+    }
+}
+
+bool anySelected(const BenchRunner& runner, const QString& prefix)
+{
+    return runner.selected(prefix + "ip_query") || runner.selected(prefix + "vcu_get");
+}
+
+void benchTcp(BenchRunner& runner, quint16 port, int samples)
+{
+    const QString prefix("latency/tcp_");
+    if (!anySelected(runner, prefix)) {
+        return;
+    }
+
+    SocketThread socket;
+    SocketThread::SocketConfig config;
+    config.hostAddress = "127.0.0.1";
+    config.port = port;
+    config.connectTimeout = 3000;
+    config.autoReconnect = false;
+    socket.connectToHost(config);
+    if (!waitConnected(&socket, config.connectTimeout)) {
+        runner.skip(prefix + "*", "无法连接本机模拟设备");
+        return;
+    }
+    measureRequests(runner, &socket, prefix, samples);
+    socket.disconnectFromHost();
+}
+
+void benchPty(BenchRunner& runner, const QString& ptyName, int samples)
+{
+    const QString prefix("latency/pty_");
+    if (!anySelected(runner, prefix)) {
+        return;
+    }
+    if (ptyName.isEmpty()) {
+        runner.skip(prefix + "*", "当前平台不支持伪终端");
+        return;
+    }
+
+    SerialThread serial;
+    SerialThread::SerialConfig config;
+    config.portName = ptyName;
+    config.baudRate = QSerialPort::Baud115200;
+    serial.openSerial(config);
+    if (!waitConnected(&serial, 3000)) {
+        runner.skip(prefix + "*", QString("无法打开伪终端 %1").arg(ptyName));
+        return;
+    }
+    measureRequests(runner, &serial, prefix, samples);
+    serial.closeSerial();
+}
+
+} // namespace
+
+void runLatencyBenchmarks(BenchRunner& runner, int samples)
+{
+    if (!anySelected(runner, "latency/tcp_") && !anySelected(runner, "latency/pty_")) {
+        return;
+    }
+
+    // 模拟设备在独立线程中运行
+    QThread simulatorThread;
+    simulatorThread.setObjectName("模拟设备");
+    DeviceSimulator* simulator = new DeviceSimulator();
+    simulator->moveToThread(&simulatorThread);
+    QObject::connect(&simulatorThread, &QThread::finished, simulator, &QObject::deleteLater);
+    simulatorThread.start();
+
+    bool started = false;
+    QMetaObject::invokeMethod(simulator, "start", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, started));
+    if (started) {
+        benchTcp(runner, simulator->tcpPort(), samples);
+        benchPty(runner, simulator->ptyName(), samples);
+    } else {
+        runner.skip("latency/*", "模拟设备无法监听本机端口");
+    }
+
+    simulatorThread.quit();
+    simulatorThread.wait();
+}
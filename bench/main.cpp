@@ -0,0 +1,103 @@
+#include "bench_runner.h"
+#include "benchmarks.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+#include <cstdio>
+
+// 退出码
+enum BenchExitCode {
+    BenchOk = 0,
+    BenchUsage = 1,
+    BenchRegression = 2     // 与基线相比有项目变慢超过阈值
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("h7_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "H7 IPSet 基准测试：协议热路径微基准和本机模拟设备端到端延迟\n"
+        "结果表输出到标准错误，--json 输出机器可读结果，--baseline 与之前的结果比较");
+    parser.addHelpOption();
+
+    QCommandLineOption filterOption("filter", "只运行名称匹配正则表达式的基准，如 'crc|reassembly'", "regex");
+    QCommandLineOption jsonOption("json", "结果写入 JSON 文件，'-' 表示标准输出", "file");
+    QCommandLineOption baselineOption("baseline", "与之前保存的 JSON 结果比较", "file");
+    QCommandLineOption thresholdOption("threshold", "中位数变慢超过该百分比视为回退（默认 10）", "percent", "10");
+    QCommandLineOption minTimeOption("min-time", "微基准每轮最短时间（默认 200）", "ms", "200");
+    QCommandLineOption repeatsOption("repeats", "微基准重复轮数，取中位数（默认 5）", "n", "5");
+    QCommandLineOption samplesOption("samples", "延迟基准采样次数（默认 500）", "n", "500");
+    QCommandLineOption noLatencyOption("no-latency", "不运行端到端延迟基准");
+    parser.addOptions({filterOption, jsonOption, baselineOption, thresholdOption, minTimeOption,
+                       repeatsOption, samplesOption, noLatencyOption});
+    parser.process(app);
+
+    QLoggingCategory::setFilterRules("h7.*.debug=false");
+
+    BenchRunner runner;
+    runner.setFilter(parser.value(filterOption));
+    runner.setMinTimeMs(parser.value(minTimeOption).toInt());
+    runner.setRepeats(parser.value(repeatsOption).toInt());
+
+    // 先读基线，文件有误时不浪费一次完整运行
+    QJsonObject baseline;
+    if (parser.isSet(baselineOption)) {
+        QFile file(parser.value(baselineOption));
+        if (!file.open(QIODevice::ReadOnly)) {
+            fprintf(stderr, "无法读取基线 %s: %s\n", qPrintable(file.fileName()), qPrintable(file.errorString()));
+            return BenchUsage;
+        }
+        QJsonParseError parseError;
+        const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+        if (!document.isObject()) {
+            fprintf(stderr, "基线格式错误 %s: %s\n", qPrintable(file.fileName()), qPrintable(parseError.errorString()));
+            return BenchUsage;
+        }
+        baseline = document.object();
+    }
+
+    runMicroBenchmarks(runner);
+    if (!parser.isSet(noLatencyOption)) {
+        runLatencyBenchmarks(runner, qMax(1, parser.value(samplesOption).toInt()));
+    }
+
+    if (parser.isSet(jsonOption)) {
+        const QByteArray json = QJsonDocument(runner.toJson()).toJson(QJsonDocument::Indented);
+        const QString path = parser.value(jsonOption);
+        if (path == "-") {
+            fwrite(json.constData(), 1, static_cast<size_t>(json.size()), stdout);
+        } else {
+            QFile file(path);
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+                fprintf(stderr, "无法写入 %s: %s\n", qPrintable(path), qPrintable(file.errorString()));
+                return BenchUsage;
+            }
+        }
+    }
+
+    int exitCode = BenchOk;
+    if (parser.isSet(baselineOption)) {
+        const double threshold = parser.value(thresholdOption).toDouble();
+        const QList<BenchRunner::Comparison> comparisons = runner.compare(baseline, threshold);
+        fprintf(stderr, "\n与基线比较（阈值 %.1f%%）:\n", threshold);
+        int regressions = 0;
+        for (const BenchRunner::Comparison& comparison : comparisons) {
+            fprintf(stderr, "%-36s %10.1f -> %10.1f  %+7.1f%%%s\n",
+                    qPrintable(comparison.name), comparison.baseline, comparison.current,
+                    comparison.changePercent, comparison.regression ? "  回退" : "");
+            if (comparison.regression) {
+                regressions++;
+            }
+        }
+        if (regressions > 0) {
+            fprintf(stderr, "%d 项回退\n", regressions);
+            exitCode = BenchRegression;
+        }
+    }
+    return exitCode;
+}
@@ -0,0 +1,276 @@
+#include "benchmarks.h"
+#include "bench_runner.h"
+#include "device_simulator.h"
+#include "common/log.h"
+#include "protocol/field_descriptor.h"
+#include "protocol/frame_pipeline.h"
+#include "protocol/protocol_frame.h"
+#include "protocol/vcu_decoder.h"
+#include <QDebug>
+#include <QLoggingCategory>
+#include <cstring>
+
+namespace {
+
+const int kHeaderSize = static_cast<int>(sizeof(pc_comm_protocol__head_t));
+
+void benchCrc(BenchRunner& runner)
+{
+    // 查询帧和VCU应答帧的校验长度
+    const int sizes[] = { kHeaderSize, kHeaderSize + static_cast<int>(sizeof(state_def_t)) };
+    for (int size : sizes) {
+        QByteArray data(size, '\x5a');
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(data.data());
+        runner.runMicro(QString("crc16/%1B").arg(size), "ns/op", size, 1, [bytes, size](qint64 n) {
+            quint64 sum = 0;
+            for (qint64 i = 0; i < n; ++i) {
+                sum += CRC16(bytes, static_cast<unsigned int>(size));
+            }
+            benchKeep(sum);
+        });
+    }
+}
+
+void benchBuild(BenchRunner& runner)
+{
+    runner.runMicro("frame/build_vcu_get", "ns/op", 0, 1, [](qint64 n) {
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            sum += ProtocolFrame::buildVcuInfoGetFrame().size();
+        }
+        benchKeep(sum);
+    });
+
+    const QString ip("192.168.1.100");
+    runner.runMicro("frame/build_ip_set", "ns/op", 0, 1, [&ip](qint64 n) {
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            sum += ProtocolFrame::buildIpSetFrame(ip).size();
+        }
+        benchKeep(sum);
+    });
+
+    const QList<QByteArray> queries = {
+        ProtocolFrame::buildMacQueryFrame(), ProtocolFrame::buildIpQueryFrame(),
+        ProtocolFrame::buildMaskQueryFrame(), ProtocolFrame::buildGatewayQueryFrame()
+    };
+    runner.runMicro("frame/join_split_4", "ns/op", 0, 1, [&queries](qint64 n) {
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            sum += ProtocolFrame::splitFrames(ProtocolFrame::joinFrames(queries)).size();
+        }
+        benchKeep(sum);
+    });
+}
+
+void benchParse(BenchRunner& runner, const QByteArray& vcuFrame)
+{
+    runner.runMicro("frame/parse_vcu", "ns/op", vcuFrame.size(), 1, [&vcuFrame](qint64 n) {
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            sum += ProtocolFrame::parseFrame(vcuFrame).data.size();
+        }
+        benchKeep(sum);
+    });
+
+    runner.runMicro("frame/validate_vcu", "ns/op", vcuFrame.size(), 1, [&vcuFrame](qint64 n) {
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            sum += ProtocolFrame::validateFrame(vcuFrame) ? 1 : 0;
+        }
+        benchKeep(sum);
+    });
+}
+
+void benchReassembly(BenchRunner& runner, const QByteArray& vcuFrame)
+{
+    // VCU应答和IP应答交替的 64 帧字节流，按不同大小切片输入
+    const QByteArray ipFrame = DeviceSimulator::buildReply(PC_IP_ADDR_QUERY);
+    const int frameCount = 64;
+    QByteArray stream;
+    for (int i = 0; i < frameCount; ++i) {
+        stream.append(i % 2 ? ipFrame : vcuFrame);
+    }
+    const double bytesPerFrame = static_cast<double>(stream.size()) / frameCount;
+
+    const int chunkSizes[] = { 1, 7, 64, 512, 0 };
+    for (int chunkSize : chunkSizes) {
+        const int chunk = chunkSize > 0 ? chunkSize : static_cast<int>(stream.size());
+        const QString name = chunkSize > 0 ? QString("reassembly/chunk_%1B").arg(chunkSize)
+                                           : QString("reassembly/whole");
+        runner.runMicro(name, "ns/frame", bytesPerFrame, frameCount, [&stream, chunk](qint64 n) {
+            FramePipeline pipeline;
+            const int size = static_cast<int>(stream.size());
+            quint64 sum = 0;
+            for (qint64 i = 0; i < n; ++i) {
+                for (int offset = 0; offset < size; offset += chunk) {
+                    sum += pipeline.feed(stream.constData() + offset, qMin(chunk, size - offset)).size();
+                }
+            }
+            benchKeep(sum);
+        });
+    }
+}
+
+// trace 开启时丢弃格式化好的日志，只测量格式化开销，不计终端输出
+void discardMessage(QtMsgType, const QMessageLogContext&, const QString&)
+{
+}
+
+// 作用域内打开 h7.serial.trace 的 debug 输出并丢弃日志；析构时恢复原来的过滤器和消息处理函数，
+// 不改动调用方设置的过滤规则
+class ScopedTraceCapture
+{
+public:
+    ScopedTraceCapture()
+    {
+        s_previousFilter = QLoggingCategory::installFilter(filter);
+        m_previousHandler = qInstallMessageHandler(discardMessage);
+    }
+
+    ~ScopedTraceCapture()
+    {
+        qInstallMessageHandler(m_previousHandler);
+        // 重新安装时对所有分类重新生效
+        QLoggingCategory::installFilter(s_previousFilter);
+        s_previousFilter = nullptr;
+    }
+
+    ScopedTraceCapture(const ScopedTraceCapture&) = delete;
+    ScopedTraceCapture& operator=(const ScopedTraceCapture&) = delete;
+
+private:
+    static void filter(QLoggingCategory* category)
+    {
+        if (s_previousFilter) {
+            s_previousFilter(category);
+        }
+        if (qstrcmp(category->categoryName(), lcSerialTrace().categoryName()) == 0) {
+            category->setEnabled(QtDebugMsg, true);
+        }
+    }
+
+    static QLoggingCategory::CategoryFilter s_previousFilter;
+    QtMessageHandler m_previousHandler;
+};
+
+QLoggingCategory::CategoryFilter ScopedTraceCapture::s_previousFilter = nullptr;
+
+void benchTraceReceive(BenchRunner& runner, const QByteArray& vcuFrame)
+{
+    // 与串口接收路径相同：每个读取块先经 H7_TRACE 输出十六进制内容，再进入帧处理流水线
+    const int frameCount = 64;
+    const int chunk = 64;
+    QByteArray stream;
+    for (int i = 0; i < frameCount; ++i) {
+        stream.append(vcuFrame);
+    }
+    const double bytesPerFrame = vcuFrame.size();
+
+    auto body = [&stream, chunk](qint64 n) {
+        FramePipeline pipeline;
+        const int size = static_cast<int>(stream.size());
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            for (int offset = 0; offset < size; offset += chunk) {
+                const int length = qMin(chunk, size - offset);
+                H7_TRACE(lcSerialTrace) << "串口接收数据:" << hexDump(stream.constData() + offset, length);
+                sum += pipeline.feed(stream.constData() + offset, length).size();
+            }
+        }
+        benchKeep(sum);
+    };
+
+    runner.runMicro("rx_trace/off", "ns/frame", bytesPerFrame, frameCount, body);
+
+#ifdef H7_NO_TRACE_LOG
+    runner.skip("rx_trace/on", "编译时定义了 H7_NO_TRACE_LOG，trace 语句已被消除");
+#else
+    {
+        ScopedTraceCapture capture;
+        runner.runMicro("rx_trace/on", "ns/frame", bytesPerFrame, frameCount, body);
+    }
+#endif
+}
+
+void benchDecode(BenchRunner& runner, const QByteArray& vcuFrame)
+{
+    runner.runMicro("decode/frame_vcu", "ns/op", vcuFrame.size(), 1, [&vcuFrame](qint64 n) {
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            sum += FramePipeline::decodeFrame(vcuFrame).type;
+        }
+        benchKeep(sum);
+    });
+
+    const char* payload = vcuFrame.constData() + kHeaderSize;
+    runner.runMicro("decode/vcu_state", "ns/op", sizeof(state_def_t), 1, [payload](qint64 n) {
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            const VcuState state = decodeVcuState(payload);
+            sum += static_cast<quint64>(state.voltage);
+        }
+        benchKeep(sum);
+    });
+
+    // 归档记录形式：8 字节时间戳 + state_def_t
+    const int recordCount = 1024;
+    const int stride = 8 + static_cast<int>(sizeof(state_def_t));
+    QByteArray records(recordCount * stride, '\0');
+    for (int i = 0; i < recordCount; ++i) {
+        const qint64 timestamp = 1700000000000LL + i * 100;
+        memcpy(records.data() + i * stride, &timestamp, sizeof(timestamp));
+        memcpy(records.data() + i * stride + 8, payload, sizeof(state_def_t));
+    }
+    runner.runMicro("decode/vcu_batch", "ns/record", stride, recordCount, [&records, stride](qint64 n) {
+        VcuColumns columns;
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            columns.clear();
+            decodeVcuBatch(records.constData(), stride, recordCount, 0, 8, &columns);
+            sum += columns.size();
+        }
+        benchKeep(sum);
+    });
+}
+
+void benchFormat(BenchRunner& runner, const QByteArray& vcuFrame)
+{
+    // 状态页刷新：全部VCU字段格式化为显示文本
+    const state_def_t state = DeviceSimulator::sampleVcuState();
+    runner.runMicro("format/vcu_fields", "ns/field", 0, kVcuFieldCount, [&state](qint64 n) {
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            for (int field = 0; field < kVcuFieldCount; ++field) {
+                sum += formatFieldValue(kVcuFields[field], &state).size();
+            }
+        }
+        benchKeep(sum);
+    });
+
+    // 收发数据的十六进制显示
+    runner.runMicro("format/hex_dump_vcu", "ns/op", vcuFrame.size(), 1, [&vcuFrame](qint64 n) {
+        quint64 sum = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            QString text;
+            QDebug(&text).noquote() << hexDump(vcuFrame);
+            sum += text.size();
+        }
+        benchKeep(sum);
+    });
+}
+
+} // namespace
+
+void runMicroBenchmarks(BenchRunner& runner)
+{
+    const QByteArray vcuFrame = DeviceSimulator::buildReply(PC_VCU_INFO_GET);
+
+    benchCrc(runner);
+    benchBuild(runner);
+    benchParse(runner, vcuFrame);
+    benchReassembly(runner, vcuFrame);
+    benchTraceReceive(runner, vcuFrame);
+    benchDecode(runner, vcuFrame);
+    benchFormat(runner, vcuFrame);
+}
@@ -0,0 +1,101 @@
+#include "command_frames.h"
+#include "protocol/protocol_frame.h"
+
+namespace CommandFrames {
+
+bool buildQueries(const QStringList& targets, QList<Request>* requests, QString* error)
+{
+    if (targets.isEmpty()) {
+        *error = "需要指定查询目标";
+        return false;
+    }
+
+    for (const QString& target : targets) {
+        const bool network = target == "network";
+        if (target == "mac" || network) {
+            requests->append(Request{"mac", PC_MAC_ADDR_QUERY, ProtocolFrame::buildMacQueryFrame()});
+        }
+        if (target == "ip" || network) {
+            requests->append(Request{"ip", PC_IP_ADDR_QUERY, ProtocolFrame::buildIpQueryFrame()});
+        }
+        if (target == "mask" || network) {
+            requests->append(Request{"mask", PC_MASK_ADDR_QUERY, ProtocolFrame::buildMaskQueryFrame()});
+        }
+        if (target == "gateway" || network) {
+            requests->append(Request{"gateway", PC_GATEWAY_ADDR_QUERY, ProtocolFrame::buildGatewayQueryFrame()});
+        }
+        if (target == "vcu") {
+            requests->append(Request{"vcu", PC_VCU_INFO_GET, ProtocolFrame::buildVcuInfoGetFrame()});
+        }
+        if (target == "hardfault") {
+            requests->append(Request{"hardfault", PC_HARDFAULT_INFO_GET, ProtocolFrame::buildHardFaultInfoGetFrame()});
+        }
+        if (!network && target != "mac" && target != "ip" && target != "mask" && target != "gateway"
+            && target != "vcu" && target != "hardfault") {
+            *error = QString("未知查询目标: %1").arg(target);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool buildSet(const QStringList& arguments, Request* request, QString* error)
+{
+    const QString target = arguments.value(0);
+    QByteArray frame;
+    quint16 functionCode = 0;
+
+    if (target == "ip" || target == "mask" || target == "gateway") {
+        if (arguments.size() != 2) {
+            *error = QString("设置 %1 需要一个地址参数").arg(target);
+            return false;
+        }
+        if (target == "ip") {
+            frame = ProtocolFrame::buildIpSetFrame(arguments[1]);
+            functionCode = PC_IP_ADDR_SET;
+        } else if (target == "mask") {
+            frame = ProtocolFrame::buildMaskSetFrame(arguments[1]);
+            functionCode = PC_MASK_ADDR_SET;
+        } else {
+            frame = ProtocolFrame::buildGatewaySetFrame(arguments[1]);
+            functionCode = PC_GATEWAY_ADDR_SET;
+        }
+    } else if (target == "mac") {
+        bool ok = false;
+        const uint value = arguments.value(1).toUInt(&ok, 0);
+        if (arguments.size() != 2 || !ok || value > 0xFF) {
+            *error = "设置 mac 需要一个 0~255 的高字节参数";
+            return false;
+        }
+        frame = ProtocolFrame::buildMacSetFrame(static_cast<uint8_t>(value));
+        functionCode = PC_MAC_ADDR_SET;
+    } else if (target == "vcu-param") {
+        if (arguments.size() != 5) {
+            *error = "设置 vcu-param 需要 4 个参数: 前减速距离 前停车距离 后避障距离 速度校正系数";
+            return false;
+        }
+        for (int i = 1; i < 5; ++i) {
+            bool ok = false;
+            arguments[i].toFloat(&ok);
+            if (!ok) {
+                *error = QString("参数不是数字: %1").arg(arguments[i]);
+                return false;
+            }
+        }
+        frame = ProtocolFrame::buildVcuParamSetFrame(arguments[1], arguments[2], arguments[3], arguments[4]);
+        functionCode = PC_VCU_PARAM_SET;
+    } else {
+        *error = QString("未知设置目标: %1").arg(target);
+        return false;
+    }
+
+    if (frame.isEmpty()) {
+        *error = QString("参数格式错误: %1").arg(arguments.mid(1).join(' '));
+        return false;
+    }
+
+    *request = Request{target, functionCode, frame};
+    return true;
+}
+
+}
@@ -0,0 +1,26 @@
+#ifndef COMMAND_FRAMES_H
+#define COMMAND_FRAMES_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// 命令行和设备共享服务共用的命令 -> 请求帧转换
+namespace CommandFrames {
+
+struct Request {
+    QString target;         // 目标名称：mac、ip、mask、gateway、vcu、hardfault、vcu-param
+    quint16 functionCode;   // 期望的应答功能码
+    QByteArray frame;
+};
+
+// 查询目标：mac ip mask gateway vcu hardfault，network 展开为四项网络配置
+bool buildQueries(const QStringList& targets, QList<Request>* requests, QString* error);
+
+// 设置：<ip|mask|gateway> <地址> / mac <高字节> / vcu-param <前减速> <前停车> <后避障> <速度系数>
+bool buildSet(const QStringList& arguments, Request* request, QString* error);
+
+}
+
+#endif // COMMAND_FRAMES_H
@@ -0,0 +1,528 @@
+#include "device_daemon.h"
+#include "common/log.h"
+#include "protocol/message_json.h"
+#include "protocol/protocol_frame.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLocalSocket>
+
+DeviceDaemon::DeviceDaemon(const Options& options, QObject *parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_shmPublisher(TelemetryShmPublisher::configuredName())
+    , m_nextRequest(1)
+    , m_linkQueries(0)
+    , m_mergedQueries(0)
+    , m_skippedPolls(0)
+    , m_congested(false)
+{
+    m_clock.start();
+
+    connect(&m_server, &QLocalServer::newConnection, this, &DeviceDaemon::onNewConnection);
+    connect(&m_pollTimer, &QTimer::timeout, this, &DeviceDaemon::onPollTick);
+    connect(&m_expireTimer, &QTimer::timeout, this, &DeviceDaemon::onExpireTick);
+}
+
+DeviceDaemon::~DeviceDaemon()
+{
+    m_server.close();
+}
+
+bool DeviceDaemon::start(QString* error)
+{
+    // 先试连接：已有服务在运行时不能抢占它的套接字，否则两个服务会同时驱动同一个设备
+    QLocalSocket probe;
+    probe.connectToServer(m_options.socketName);
+    if (probe.waitForConnected(ProbeTimeoutMs)) {
+        probe.disconnectFromServer();
+        *error = QString("本地套接字 %1 上已有设备共享服务在运行").arg(m_options.socketName);
+        return false;
+    }
+    if (probe.error() == QLocalSocket::ConnectionRefusedError) {
+        // 无人监听的套接字文件是上次异常退出遗留的，清理后再监听
+        QLocalServer::removeServer(m_options.socketName);
+    } else if (probe.error() != QLocalSocket::ServerNotFoundError) {
+        *error = QString("本地套接字 %1 检查失败: %2").arg(m_options.socketName, probe.errorString());
+        return false;
+    }
+
+    m_server.setSocketOptions(QLocalServer::UserAccessOption);
+    if (!m_server.listen(m_options.socketName)) {
+        *error = QString("本地套接字 %1 监听失败: %2").arg(m_options.socketName, m_server.errorString());
+        return false;
+    }
+
+    if (!m_shmPublisher.name().isEmpty() && !m_shmPublisher.open()) {
+        // 共享内存只是附加输出，失败不影响服务
+        qCWarning(lcTelemetry) << "遥测共享内存不可用:" << m_shmPublisher.lastError();
+    }
+
+    DeviceLink::Options linkOptions = m_options.link;
+    linkOptions.connectTimeoutMs = m_options.timeoutMs;
+    linkOptions.autoReconnect = true;
+
+    m_link.reset(new DeviceLink(linkOptions));
+    connect(m_link.data(), &DeviceLink::connectionStateChanged, this, &DeviceDaemon::onLinkStateChanged);
+    connect(m_link.data(), &DeviceLink::messageReceived, this, &DeviceDaemon::onMessageReceived);
+    connect(m_link.data(), &DeviceLink::alarmChanged, this, &DeviceDaemon::onAlarmChanged);
+    connect(m_link.data(), &DeviceLink::dataSent, this, &DeviceDaemon::onDataSent);
+    connect(m_link.data(), &DeviceLink::backpressureChanged, this, &DeviceDaemon::onBackpressureChanged);
+    connect(m_link.data(), &DeviceLink::errorOccurred, this, [](const QString& message) {
+        qCWarning(lcSocket) << "设备连接错误:" << message;
+    });
+    m_link->open();
+
+    m_expireTimer.start(qBound(50, m_options.timeoutMs / 10, 500));
+
+    qCDebug(lcSocket) << "设备共享服务已启动:" << m_server.fullServerName() << "连接" << m_link->description();
+    return true;
+}
+
+void DeviceDaemon::onNewConnection()
+{
+    while (QLocalSocket* socket = m_server.nextPendingConnection()) {
+        m_clients.insert(socket, Client{QByteArray(), 0, 0});
+        connect(socket, &QLocalSocket::readyRead, this, &DeviceDaemon::onClientReadyRead);
+        connect(socket, &QLocalSocket::disconnected, this, &DeviceDaemon::onClientDisconnected);
+    }
+}
+
+void DeviceDaemon::onClientReadyRead()
+{
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+    auto it = m_clients.find(socket);
+    if (it == m_clients.end()) {
+        return;
+    }
+
+    it->buffer += socket->readAll();
+    int start = 0;
+    int end;
+    while ((end = it->buffer.indexOf('\n', start)) >= 0) {
+        const QByteArray line = it->buffer.mid(start, end - start).trimmed();
+        start = end + 1;
+        if (!line.isEmpty()) {
+            handleRequest(socket, line);
+        }
+        // 处理请求时客户端可能已被移除
+        it = m_clients.find(socket);
+        if (it == m_clients.end()) {
+            return;
+        }
+    }
+    it->buffer.remove(0, start);
+
+    if (it->buffer.size() > MaxRequestLine) {
+        reply(socket, QJsonValue(), false, QJsonObject(), "请求过长");
+        socket->disconnectFromServer();
+    }
+}
+
+void DeviceDaemon::onClientDisconnected()
+{
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+    m_clients.remove(socket);
+
+    // 丢弃该客户端未完成的请求，在途查询照常完成（可能还有其他等待者）
+    for (auto it = m_requests.begin(); it != m_requests.end();) {
+        if (it->socket == socket) {
+            it = m_requests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    socket->deleteLater();
+    updatePolling();
+}
+
+void DeviceDaemon::handleRequest(QLocalSocket* socket, const QByteArray& line)
+{
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+    if (!document.isObject()) {
+        reply(socket, QJsonValue(), false, QJsonObject(), QString("JSON 格式错误: %1").arg(parseError.errorString()));
+        return;
+    }
+
+    const QJsonObject request = document.object();
+    const QJsonValue id = request.value("id");
+    const QString op = request.value("op").toString();
+
+    // 参数既可以是数组也可以是单个字符串
+    auto stringList = [&request](const char* arrayKey, const char* singleKey) {
+        QStringList list;
+        const QJsonValue value = request.value(arrayKey);
+        if (value.isArray()) {
+            for (const QJsonValue& item : value.toArray()) {
+                list.append(item.isString() ? item.toString() : QString::number(item.toDouble()));
+            }
+        } else if (request.contains(singleKey)) {
+            list.append(request.value(singleKey).toString());
+        }
+        return list;
+    };
+
+    if (op == "query") {
+        handleQuery(socket, id, stringList("targets", "target"));
+    } else if (op == "set") {
+        handleSet(socket, id, stringList("args", "arg"));
+    } else if (op == "subscribe" || op == "unsubscribe") {
+        handleSubscribe(socket, id, stringList("topics", "topic"), op == "subscribe");
+    } else if (op == "status") {
+        handleStatus(socket, id);
+    } else {
+        reply(socket, id, false, QJsonObject(), QString("未知操作: %1").arg(op));
+    }
+}
+
+void DeviceDaemon::handleQuery(QLocalSocket* socket, const QJsonValue& id, const QStringList& targets)
+{
+    QList<CommandFrames::Request> requests;
+    QString error;
+    if (!CommandFrames::buildQueries(targets, &requests, &error)) {
+        reply(socket, id, false, QJsonObject(), error);
+        return;
+    }
+    if (!m_link->isConnected()) {
+        reply(socket, id, false, QJsonObject(), "设备未连接");
+        return;
+    }
+
+    const quint64 serial = m_nextRequest++;
+    m_requests.insert(serial, PendingRequest{socket, id, QJsonObject(), static_cast<int>(requests.size())});
+    // 需要新下发的查询帧一次写出
+    QList<QByteArray> frames;
+    for (const CommandFrames::Request& request : requests) {
+        if (joinQuery(request, serial)) {
+            frames.append(request.frame);
+        }
+    }
+    if (!frames.isEmpty()) {
+        m_link->sendBatch(frames, SendQueue::OneShotQuery);
+    }
+}
+
+void DeviceDaemon::handleSet(QLocalSocket* socket, const QJsonValue& id, const QStringList& arguments)
+{
+    CommandFrames::Request request;
+    QString error;
+    if (!CommandFrames::buildSet(arguments, &request, &error)) {
+        reply(socket, id, false, QJsonObject(), error);
+        return;
+    }
+    if (!m_link->isConnected()) {
+        reply(socket, id, false, QJsonObject(), "设备未连接");
+        return;
+    }
+
+    // 设置帧不合并，按到达顺序写出
+    const quint64 serial = m_nextRequest++;
+    m_requests.insert(serial, PendingRequest{socket, id, QJsonObject(), 1});
+    m_pendingWrites.append(PendingWrite{serial, request.frame, m_clock.elapsed()});
+    m_link->sendFrame(request.frame, SendQueue::ConfigWrite);
+}
+
+void DeviceDaemon::handleSubscribe(QLocalSocket* socket, const QJsonValue& id, const QStringList& topics, bool subscribe)
+{
+    int mask = 0;
+    for (const QString& name : topics) {
+        const int topic = topicFromName(name);
+        if (topic == 0) {
+            reply(socket, id, false, QJsonObject(), QString("未知主题: %1").arg(name));
+            return;
+        }
+        mask |= topic;
+    }
+
+    Client& client = m_clients[socket];
+    client.topics = subscribe ? (client.topics | mask) : (client.topics & ~mask);
+
+    QJsonArray current;
+    for (const char* name : {"vcu", "hardfault", "alarm", "link"}) {
+        if (client.topics & topicFromName(name)) {
+            current.append(name);
+        }
+    }
+    reply(socket, id, true, QJsonObject{{"topics", current}});
+
+    if (subscribe && (mask & TopicLink)) {
+        writeLine(socket, QJsonObject{{"event", "link"}, {"connected", m_link->isConnected()}});
+    }
+    updatePolling();
+}
+
+void DeviceDaemon::handleStatus(QLocalSocket* socket, const QJsonValue& id)
+{
+    QJsonObject status;
+    status.insert("link", m_link->description());
+    status.insert("connected", m_link->isConnected());
+    status.insert("clients", static_cast<int>(m_clients.size()));
+    status.insert("inFlight", static_cast<int>(m_inFlight.size()));
+    status.insert("linkQueries", static_cast<double>(m_linkQueries));
+    status.insert("mergedQueries", static_cast<double>(m_mergedQueries));
+    status.insert("congested", m_congested);
+    status.insert("skippedPolls", static_cast<double>(m_skippedPolls));
+    reply(socket, id, true, status);
+}
+
+bool DeviceDaemon::joinQuery(const CommandFrames::Request& request, quint64 waiter)
+{
+    auto it = m_inFlight.find(request.functionCode);
+    if (it != m_inFlight.end()) {
+        if (waiter != 0) {
+            it->waiters.append(waiter);
+        }
+        ++m_mergedQueries;
+        return false;
+    }
+
+    InFlightQuery query;
+    query.target = request.target;
+    query.sentAtMs = m_clock.elapsed();
+    if (waiter != 0) {
+        query.waiters.append(waiter);
+    }
+    m_inFlight.insert(request.functionCode, query);
+    ++m_linkQueries;
+    return true;
+}
+
+void DeviceDaemon::completeWaiter(quint64 waiter, const QString& target, const QJsonValue& value, const QString& error)
+{
+    auto it = m_requests.find(waiter);
+    if (it == m_requests.end()) {
+        return;
+    }
+
+    if (!error.isEmpty()) {
+        PendingRequest request = it.value();
+        m_requests.erase(it);
+        QJsonObject fields;
+        if (!request.results.isEmpty()) {
+            fields.insert("results", request.results);
+        }
+        reply(request.socket, request.id, false, fields, QString("%1: %2").arg(target, error));
+        return;
+    }
+
+    it->results.insert(target, value);
+    if (--it->remaining > 0) {
+        return;
+    }
+
+    PendingRequest request = it.value();
+    m_requests.erase(it);
+    reply(request.socket, request.id, true, QJsonObject{{"results", request.results}});
+}
+
+void DeviceDaemon::failAll(const QString& error)
+{
+    const QHash<quint16, InFlightQuery> inFlight = m_inFlight;
+    m_inFlight.clear();
+    for (const InFlightQuery& query : inFlight) {
+        for (quint64 waiter : query.waiters) {
+            completeWaiter(waiter, query.target, QJsonValue(), error);
+        }
+    }
+
+    const QList<PendingWrite> writes = m_pendingWrites;
+    m_pendingWrites.clear();
+    for (const PendingWrite& write : writes) {
+        completeWaiter(write.request, "set", QJsonValue(), error);
+    }
+}
+
+void DeviceDaemon::onLinkStateChanged(bool connected)
+{
+    qCDebug(lcSocket) << "设备连接" << (connected ? "已建立" : "已断开") << m_link->description();
+    if (!connected) {
+        failAll("设备连接已断开");
+    }
+    publish(TopicLink, QJsonObject{{"event", "link"}, {"connected", connected}});
+    updatePolling();
+}
+
+void DeviceDaemon::onMessageReceived(const DeviceMessage& message)
+{
+    const QJsonObject object = MessageJson::toJson(message);
+
+    // 先分发给等待该功能码应答的请求
+    auto it = m_inFlight.find(message.functionCode);
+    if (it != m_inFlight.end() && message.type != DeviceMessage::InvalidFrame) {
+        const InFlightQuery query = it.value();
+        m_inFlight.erase(it);
+        for (quint64 waiter : query.waiters) {
+            if (message.isValid()) {
+                completeWaiter(waiter, query.target, object.value("value"), QString());
+            } else {
+                completeWaiter(waiter, query.target, QJsonValue(), message.errorMessage);
+            }
+        }
+    }
+
+    if (message.type == DeviceMessage::VcuInfo) {
+        m_shmPublisher.publish(*message.vcuInfo);
+        publish(TopicVcu, QJsonObject{{"event", "vcu"}, {"data", object}});
+    } else if (message.type == DeviceMessage::HardFaultInfo) {
+        publish(TopicHardFault, QJsonObject{{"event", "hardfault"}, {"data", object}});
+    }
+}
+
+void DeviceDaemon::onAlarmChanged(const AlarmEvent& event)
+{
+    QJsonObject data;
+    data.insert("deviceId", event.deviceId);
+    data.insert("ruleId", event.ruleId);
+    data.insert("field", event.field);
+    data.insert("message", event.message);
+    data.insert("severity", event.severity == AlarmRule::Critical ? "critical" : "warning");
+    data.insert("active", event.active);
+    data.insert("value", event.value);
+    data.insert("timestampMs", static_cast<double>(event.timestampMs));
+    publish(TopicAlarm, QJsonObject{{"event", "alarm"}, {"data", data}});
+}
+
+void DeviceDaemon::onDataSent(const QByteArray& data)
+{
+    for (int i = 0; i < m_pendingWrites.size(); ++i) {
+        if (m_pendingWrites[i].frame == data) {
+            const PendingWrite write = m_pendingWrites.takeAt(i);
+            auto it = m_requests.find(write.request);
+            if (it != m_requests.end()) {
+                PendingRequest request = it.value();
+                m_requests.erase(it);
+                reply(request.socket, request.id, true, QJsonObject{{"written", true}});
+            }
+            return;
+        }
+    }
+}
+
+void DeviceDaemon::onPollTick()
+{
+    if (!m_link->isConnected()) {
+        return;
+    }
+    // 发送队列拥塞时跳过本次轮询并加大间隔，优先让客户端的查询和设置写出
+    if (m_congested) {
+        ++m_skippedPolls;
+        m_pollTimer.setInterval(qMin(qMax(m_pollTimer.interval(), 1) * 2,
+                                     qMax(m_options.pollIntervalMs, 1) * MaxPollBackoff));
+        return;
+    }
+    const CommandFrames::Request request{"vcu", PC_VCU_INFO_GET, ProtocolFrame::buildVcuInfoGetFrame()};
+    if (joinQuery(request, 0)) {
+        m_link->sendFrame(request.frame, SendQueue::PeriodicPoll);
+    }
+}
+
+void DeviceDaemon::onBackpressureChanged(bool congested)
+{
+    m_congested = congested;
+    qCDebug(lcSocket) << "发送队列" << (congested ? "拥塞，降低轮询频率" : "恢复");
+    if (!congested && m_pollTimer.isActive() && m_pollTimer.interval() != m_options.pollIntervalMs) {
+        m_pollTimer.setInterval(m_options.pollIntervalMs);
+    }
+}
+
+void DeviceDaemon::onExpireTick()
+{
+    const qint64 now = m_clock.elapsed();
+
+    QList<quint16> expired;
+    for (auto it = m_inFlight.constBegin(); it != m_inFlight.constEnd(); ++it) {
+        if (now - it->sentAtMs > m_options.timeoutMs) {
+            expired.append(it.key());
+        }
+    }
+    for (quint16 functionCode : expired) {
+        const InFlightQuery query = m_inFlight.take(functionCode);
+        for (quint64 waiter : query.waiters) {
+            completeWaiter(waiter, query.target, QJsonValue(), "设备应答超时");
+        }
+    }
+
+    while (!m_pendingWrites.isEmpty() && now - m_pendingWrites.first().queuedAtMs > m_options.timeoutMs) {
+        const PendingWrite write = m_pendingWrites.takeFirst();
+        completeWaiter(write.request, "set", QJsonValue(), "写出超时");
+    }
+}
+
+void DeviceDaemon::reply(QLocalSocket* socket, const QJsonValue& id, bool ok, const QJsonObject& fields,
+                         const QString& error)
+{
+    if (!m_clients.contains(socket)) {
+        return;
+    }
+
+    QJsonObject object = fields;
+    object.insert("id", id);
+    object.insert("ok", ok);
+    if (!error.isEmpty()) {
+        object.insert("error", error);
+    }
+    writeLine(socket, object);
+}
+
+void DeviceDaemon::publish(int topic, const QJsonObject& event)
+{
+    QByteArray line;
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        if (!(it->topics & topic)) {
+            continue;
+        }
+        // 慢客户端跳过本次推送
+        if (it.key()->bytesToWrite() > MaxClientBacklog) {
+            ++it->droppedEvents;
+            continue;
+        }
+        if (line.isEmpty()) {
+            line = QJsonDocument(event).toJson(QJsonDocument::Compact) + '\n';
+        }
+        it.key()->write(line);
+    }
+}
+
+void DeviceDaemon::writeLine(QLocalSocket* socket, const QJsonObject& object)
+{
+    socket->write(QJsonDocument(object).toJson(QJsonDocument::Compact) + '\n');
+}
+
+void DeviceDaemon::updatePolling()
+{
+    bool wanted = m_options.pollIntervalMs > 0 && m_link && m_link->isConnected();
+    if (wanted && !m_shmPublisher.isOpen()) {
+        wanted = false;
+        for (const Client& client : m_clients) {
+            if (client.topics & TopicVcu) {
+                wanted = true;
+                break;
+            }
+        }
+    }
+
+    if (wanted && !m_pollTimer.isActive()) {
+        m_pollTimer.start(m_options.pollIntervalMs);
+        onPollTick();
+    } else if (!wanted && m_pollTimer.isActive()) {
+        m_pollTimer.stop();
+    }
+}
+
+int DeviceDaemon::topicFromName(const QString& name)
+{
+    if (name == "vcu") {
+        return TopicVcu;
+    }
+    if (name == "hardfault") {
+        return TopicHardFault;
+    }
+    if (name == "alarm") {
+        return TopicAlarm;
+    }
+    if (name == "link") {
+        return TopicLink;
+    }
+    return 0;
+}
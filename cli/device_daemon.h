@@ -0,0 +1,156 @@
+#ifndef DEVICE_DAEMON_H
+#define DEVICE_DAEMON_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QScopedPointer>
+#include <QTimer>
+#include "command_frames.h"
+#include "device_link.h"
+#include "telemetry/telemetry_shm_publisher.h"
+
+class QLocalSocket;
+
+/*
+    设备共享服务：独占一条物理连接，通过本地套接字（Unix 域套接字 / Windows 命名管道）
+    为多个本机客户端提供服务
+    1. 协议为按行分隔的 JSON，请求中的 id 原样带回：
+         {"id":1,"op":"query","targets":["ip","mask"]}      -> {"id":1,"ok":true,"results":{...}}
+         {"id":2,"op":"set","args":["ip","192.168.1.120"]}  -> {"id":2,"ok":true,"written":true}
+         {"id":3,"op":"subscribe","topics":["vcu","alarm"]} -> 之后推送 {"event":"vcu","data":{...}}
+         {"id":4,"op":"unsubscribe","topics":["vcu"]}
+         {"id":5,"op":"status"}
+       可订阅的主题：vcu、hardfault、alarm、link
+    2. 查询按应答功能码合并：同一功能码已有请求在途时不再下发，应答到达后分发给所有等待者
+    3. 有客户端订阅 vcu 时按 pollIntervalMs 周期查询VCU综合信息，与客户端的 vcu 查询同样合并，
+       N 个订阅者只占用一路查询
+    4. 推送积压超过上限的慢客户端直接跳过推送事件，不影响链路和其他客户端
+    5. VCU综合信息同时发布到遥测共享内存（H7_SHM_NAME），共享内存开启时不论有无订阅者都周期查询
+ */
+class DeviceDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        DeviceLink::Options link;
+        QString socketName;         // 本地套接字名称或路径
+        int pollIntervalMs;         // vcu 订阅的查询周期
+        int timeoutMs;              // 设备应答超时
+
+        Options() {
+            socketName = "h7_ipset";
+            pollIntervalMs = 1000;
+            timeoutMs = 3000;
+        }
+    };
+
+    explicit DeviceDaemon(const Options& options, QObject *parent = nullptr);
+    ~DeviceDaemon();
+
+    bool start(QString* error);
+
+private slots:
+    void onNewConnection();
+    void onClientReadyRead();
+    void onClientDisconnected();
+
+    void onLinkStateChanged(bool connected);
+    void onMessageReceived(const DeviceMessage& message);
+    void onAlarmChanged(const AlarmEvent& event);
+    void onDataSent(const QByteArray& data);
+    void onBackpressureChanged(bool congested);
+
+    void onPollTick();
+    void onExpireTick();
+
+private:
+    // 推送事件的积压上限，超过后跳过该客户端的推送
+    static constexpr qint64 MaxClientBacklog = 4 * 1024 * 1024;
+    // 单行请求长度上限
+    static constexpr int MaxRequestLine = 64 * 1024;
+    // 启动时检测是否已有服务在监听的连接超时
+    static constexpr int ProbeTimeoutMs = 1000;
+    // 发送队列拥塞时轮询间隔逐次加倍，最多为设定间隔的倍数
+    static constexpr int MaxPollBackoff = 8;
+
+    enum Topic {
+        TopicVcu = 0x1,
+        TopicHardFault = 0x2,
+        TopicAlarm = 0x4,
+        TopicLink = 0x8
+    };
+
+    struct Client {
+        QByteArray buffer;          // 未收全的请求行
+        int topics;
+        qint64 droppedEvents;
+    };
+
+    // 一个客户端请求，可能等待多个应答
+    struct PendingRequest {
+        QLocalSocket* socket;
+        QJsonValue id;
+        QJsonObject results;
+        int remaining;
+    };
+
+    // 在途的设备查询（按应答功能码），waiters 为等待该应答的请求序号
+    struct InFlightQuery {
+        QString target;
+        qint64 sentAtMs;
+        QVector<quint64> waiters;
+    };
+
+    // 已入队、等待写出的设置帧
+    struct PendingWrite {
+        quint64 request;
+        QByteArray frame;
+        qint64 queuedAtMs;
+    };
+
+    void handleRequest(QLocalSocket* socket, const QByteArray& line);
+    void handleQuery(QLocalSocket* socket, const QJsonValue& id, const QStringList& targets);
+    void handleSet(QLocalSocket* socket, const QJsonValue& id, const QStringList& arguments);
+    void handleSubscribe(QLocalSocket* socket, const QJsonValue& id, const QStringList& topics, bool subscribe);
+    void handleStatus(QLocalSocket* socket, const QJsonValue& id);
+
+    // 加入在途查询；没有在途查询时登记并返回 true，由调用方下发请求帧
+    bool joinQuery(const CommandFrames::Request& request, quint64 waiter);
+    void completeWaiter(quint64 waiter, const QString& target, const QJsonValue& value, const QString& error);
+    void failAll(const QString& error);
+
+    void reply(QLocalSocket* socket, const QJsonValue& id, bool ok, const QJsonObject& fields,
+               const QString& error = QString());
+    void publish(int topic, const QJsonObject& event);
+    void writeLine(QLocalSocket* socket, const QJsonObject& object);
+    void updatePolling();
+
+    static int topicFromName(const QString& name);
+
+    Options m_options;
+    QLocalServer m_server;
+    QScopedPointer<DeviceLink> m_link;
+    TelemetryShmPublisher m_shmPublisher;
+
+    QHash<QLocalSocket*, Client> m_clients;
+    QHash<quint64, PendingRequest> m_requests;
+    QHash<quint16, InFlightQuery> m_inFlight;
+    QList<PendingWrite> m_pendingWrites;
+    quint64 m_nextRequest;
+
+    QTimer m_pollTimer;
+    QTimer m_expireTimer;
+    QElapsedTimer m_clock;
+
+    // 统计
+    qint64 m_linkQueries;       // 实际下发的查询
+    qint64 m_mergedQueries;     // 合并到在途查询的次数
+    qint64 m_skippedPolls;      // 发送队列拥塞时跳过的轮询
+    bool m_congested;
+};
+
+#endif // DEVICE_DAEMON_H
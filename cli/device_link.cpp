@@ -0,0 +1,136 @@
+#include "device_link.h"
+#include <QTimer>
+
+DeviceLink::DeviceLink(const Options& options, QObject *parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_connected(false)
+    , m_closing(false)
+    , m_reopenScheduled(false)
+{
+    if (!m_options.serialPort.isEmpty()) {
+        m_serial.reset(new SerialThread());
+        forwardSignals(m_serial.data());
+    } else {
+        m_socket.reset(new SocketThread());
+        forwardSignals(m_socket.data());
+    }
+}
+
+DeviceLink::~DeviceLink()
+{
+    close();
+}
+
+template <typename Link>
+void DeviceLink::forwardSignals(Link* link)
+{
+    connect(link, &Link::connectionStateChanged, this, &DeviceLink::onConnectionStateChanged);
+    connect(link, &Link::messageReceived, this, &DeviceLink::messageReceived);
+    connect(link, &Link::alarmChanged, this, &DeviceLink::alarmChanged);
+    connect(link, &Link::dataSent, this, &DeviceLink::dataSent);
+    connect(link, &Link::backpressureChanged, this, &DeviceLink::backpressureChanged);
+    connect(link, &Link::errorOccurred, this, &DeviceLink::errorOccurred);
+    connect(link, &Link::errorOccurred, this, &DeviceLink::onErrorOccurred);
+}
+
+void DeviceLink::open()
+{
+    m_closing = false;
+
+    if (m_serial) {
+        SerialThread::SerialConfig config;
+        config.portName = m_options.serialPort;
+        config.baudRate = static_cast<QSerialPort::BaudRate>(m_options.baudRate);
+        m_serial->openSerial(config);
+    } else {
+        SocketThread::SocketConfig config;
+        config.hostAddress = m_options.host;
+        config.port = m_options.port;
+        config.connectTimeout = m_options.connectTimeoutMs;
+        config.autoReconnect = m_options.autoReconnect;
+        config.reconnectInterval = m_options.reconnectIntervalMs;
+        m_socket->connectToHost(config);
+    }
+}
+
+void DeviceLink::close()
+{
+    m_closing = true;
+    if (m_serial) {
+        m_serial->closeSerial();
+    }
+    if (m_socket) {
+        m_socket->disconnectFromHost();
+    }
+}
+
+bool DeviceLink::isConnected() const
+{
+    return m_connected;
+}
+
+void DeviceLink::sendFrame(const QByteArray& frame, SendQueue::Priority priority)
+{
+    if (m_serial) {
+        m_serial->sendData(frame, priority);
+    } else {
+        m_socket->sendData(frame, priority);
+    }
+}
+
+void DeviceLink::sendBatch(const QList<QByteArray>& frames, SendQueue::Priority priority)
+{
+    if (m_serial) {
+        m_serial->sendBatch(frames, priority);
+    } else {
+        m_socket->sendBatch(frames, priority);
+    }
+}
+
+QString DeviceLink::description() const
+{
+    if (m_serial) {
+        return QString("serial:%1").arg(m_options.serialPort);
+    }
+    return QString("tcp:%1:%2").arg(m_options.host).arg(m_options.port);
+}
+
+void DeviceLink::onConnectionStateChanged(bool connected)
+{
+    if (connected == m_connected) {
+        return;
+    }
+    m_connected = connected;
+    emit connectionStateChanged(connected);
+
+    if (!connected) {
+        scheduleReopen();
+    }
+}
+
+void DeviceLink::onErrorOccurred(const QString& errorString)
+{
+    Q_UNUSED(errorString);
+
+    // 串口打开失败只报错误，不会有连接状态变化
+    if (!m_connected) {
+        scheduleReopen();
+    }
+}
+
+void DeviceLink::scheduleReopen()
+{
+    // Socket 由工作线程自动重连；串口在这里定时重新打开
+    if (!m_serial || !m_options.autoReconnect || m_closing || m_reopenScheduled) {
+        return;
+    }
+
+    m_reopenScheduled = true;
+    QTimer::singleShot(m_options.reconnectIntervalMs, this, [this]() {
+        m_reopenScheduled = false;
+        if (!m_connected && !m_closing) {
+            open();
+        }
+    });
+}
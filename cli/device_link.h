@@ -0,0 +1,73 @@
+#ifndef DEVICE_LINK_H
+#define DEVICE_LINK_H
+
+#include <QObject>
+#include <QScopedPointer>
+#include "communication/serial_thread.h"
+#include "communication/socket_thread.h"
+
+// 命令行程序使用的设备连接：按配置创建串口线程或Socket线程，统一转发信号
+class DeviceLink : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString serialPort;         // 串口名，与 host 二选一
+        int baudRate;
+        QString host;               // TCP 主机地址
+        quint16 port;
+        int connectTimeoutMs;
+        bool autoReconnect;         // 断开后自动重连（串口按 reconnectIntervalMs 重新打开）
+        int reconnectIntervalMs;
+
+        Options() {
+            baudRate = 115200;
+            port = 0;
+            connectTimeoutMs = 3000;
+            autoReconnect = false;
+            reconnectIntervalMs = 3000;
+        }
+    };
+
+    explicit DeviceLink(const Options& options, QObject *parent = nullptr);
+    ~DeviceLink();
+
+    void open();
+    void close();
+    bool isConnected() const;
+
+    void sendFrame(const QByteArray& frame, SendQueue::Priority priority);
+    // 多帧一次写出
+    void sendBatch(const QList<QByteArray>& frames, SendQueue::Priority priority);
+
+    // 连接描述，例如 "serial:COM3"、"tcp:192.168.1.100:8080"
+    QString description() const;
+
+signals:
+    void connectionStateChanged(bool connected);
+    void messageReceived(const DeviceMessage& message);
+    void alarmChanged(const AlarmEvent& event);
+    void dataSent(const QByteArray& data);
+    void errorOccurred(const QString& errorString);
+    // 发送队列进入/解除拥塞，周期轮询方据此降低频率
+    void backpressureChanged(bool congested);
+
+private slots:
+    void onConnectionStateChanged(bool connected);
+    void onErrorOccurred(const QString& errorString);
+
+private:
+    template <typename Link>
+    void forwardSignals(Link* link);
+    void scheduleReopen();
+
+    Options m_options;
+    bool m_connected;
+    bool m_closing;
+    bool m_reopenScheduled;
+    QScopedPointer<SerialThread> m_serial;
+    QScopedPointer<SocketThread> m_socket;
+};
+
+#endif // DEVICE_LINK_H
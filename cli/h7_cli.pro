@@ -0,0 +1,28 @@
+# 无界面命令行程序：不链接 QtGui/QtWidgets，启动只需初始化 QtCore
+QT       = core serialport network
+
+# 协程设备接口（DeviceSession）需要 C++20；c++2a 兼容 Qt5 的 qmake
+CONFIG += c++2a console
+CONFIG -= app_bundle
+
+TARGET = h7_cli
+
+include(../h7_core.pri)
+
+SOURCES += \
+    main.cpp \
+    command_frames.cpp \
+    device_daemon.cpp \
+    device_link.cpp \
+    headless_client.cpp
+
+HEADERS += \
+    command_frames.h \
+    device_daemon.h \
+    device_link.h \
+    headless_client.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
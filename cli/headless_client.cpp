@@ -0,0 +1,415 @@
+#include "headless_client.h"
+#include "protocol/message_json.h"
+#include "protocol/protocol_frame.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <cstdio>
+
+HeadlessClient::HeadlessClient(const Options& options, QObject *parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_mode(Query)
+    , m_connected(false)
+    , m_finished(false)
+    , m_written(false)
+    , m_acknowledged(false)
+    , m_samples(0)
+    , m_congested(false)
+{
+    m_timeoutTimer.setSingleShot(true);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, &HeadlessClient::onTimeout);
+    connect(&m_pollTimer, &QTimer::timeout, this, &HeadlessClient::onPollTick);
+}
+
+bool HeadlessClient::prepare(QString* error)
+{
+    if (m_options.link.serialPort.isEmpty() == m_options.link.host.isEmpty()) {
+        *error = "必须且只能指定 --serial 或 --tcp 之一";
+        return false;
+    }
+    if (m_options.command.isEmpty()) {
+        *error = "缺少命令";
+        return false;
+    }
+
+    m_command = m_options.command.first();
+    const QStringList arguments = m_options.command.mid(1);
+
+    if (m_command == "query") {
+        m_mode = Query;
+        return CommandFrames::buildQueries(arguments, &m_requests, error);
+    }
+    if (m_command == "set") {
+        m_mode = Set;
+        Request request;
+        if (!CommandFrames::buildSet(arguments, &request, error)) {
+            return false;
+        }
+        m_requests.append(request);
+        return true;
+    }
+    if (m_command == "apply") {
+        m_mode = Apply;
+        if (arguments.isEmpty()) {
+            *error = "apply 需要至少一项 <目标>=<值>";
+            return false;
+        }
+        for (const QString& argument : arguments) {
+            const int equals = argument.indexOf('=');
+            if (equals <= 0) {
+                *error = QString("apply 参数格式应为 <目标>=<值>: %1").arg(argument);
+                return false;
+            }
+            // vcu-param 的 4 个值用逗号分隔
+            QStringList setArguments;
+            setArguments << argument.left(equals) << argument.mid(equals + 1).split(',');
+            Request request;
+            if (!CommandFrames::buildSet(setArguments, &request, error)) {
+                return false;
+            }
+            if (!m_transaction.add(request.target, request.frame, error)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (m_command == "poll" || m_command == "record") {
+        m_mode = m_command == "poll" ? Poll : Record;
+        if (m_options.intervalMs <= 0) {
+            *error = "采样间隔必须大于 0";
+            return false;
+        }
+        if (m_mode == Record) {
+            if (m_options.archiveDir.isEmpty()) {
+                *error = "record 需要指定 --archive";
+                return false;
+            }
+            m_archive.reset(new TelemetryArchive(m_options.archiveDir));
+        }
+        return true;
+    }
+
+    *error = QString("未知命令: %1").arg(m_command);
+    return false;
+}
+
+void HeadlessClient::start()
+{
+    m_elapsed.start();
+
+    DeviceLink::Options linkOptions = m_options.link;
+    linkOptions.connectTimeoutMs = m_options.timeoutMs;
+    linkOptions.autoReconnect = false;
+
+    m_link.reset(new DeviceLink(linkOptions));
+    connect(m_link.data(), &DeviceLink::connectionStateChanged, this, &HeadlessClient::onConnectionStateChanged);
+    connect(m_link.data(), &DeviceLink::messageReceived, this, &HeadlessClient::onMessageReceived);
+    connect(m_link.data(), &DeviceLink::dataSent, this, &HeadlessClient::onDataSent);
+    connect(m_link.data(), &DeviceLink::errorOccurred, this, &HeadlessClient::onErrorOccurred);
+    connect(m_link.data(), &DeviceLink::backpressureChanged, this, &HeadlessClient::onBackpressureChanged);
+    // 会话在上面的连接之后建立：断开时先由本对象输出连接错误，再由会话结束等待中的请求
+    m_session.reset(new DeviceSession(m_link.data()));
+    m_link->open();
+
+    // 连接超时（Socket 自带超时，串口打开失败会立即报错，这里兜底）
+    restartTimeout(m_options.timeoutMs + 1000);
+}
+
+void HeadlessClient::onConnectionStateChanged(bool connected)
+{
+    if (m_finished) {
+        return;
+    }
+
+    if (!connected) {
+        if (m_connected) {
+            fail(ExitLinkError, "连接已断开");
+        }
+        return;
+    }
+    if (m_connected) {
+        return;
+    }
+    m_connected = true;
+
+    switch (m_mode) {
+    case Query:
+    case Set:
+        // 每个请求各自计时，不再使用整体超时
+        m_timeoutTimer.stop();
+        runRequests();
+        break;
+
+    case Apply:
+        // 设置帧和回读查询一次写出
+        m_link->sendBatch(m_transaction.frames(), SendQueue::ConfigWrite);
+        m_transaction.start(m_options.timeoutMs);
+        restartTimeout(m_options.timeoutMs);
+        break;
+
+    case Poll:
+    case Record:
+        onPollTick();
+        m_pollTimer.start(m_options.intervalMs);
+        restartTimeout(qMax(m_options.timeoutMs, 2 * m_options.intervalMs));
+        break;
+    }
+}
+
+void HeadlessClient::onMessageReceived(const DeviceMessage& message)
+{
+    if (m_finished) {
+        return;
+    }
+
+    if (m_mode == Poll || m_mode == Record) {
+        if (message.type == DeviceMessage::VcuInfo) {
+            handleSample(message);
+        }
+        return;
+    }
+
+    if (m_mode == Apply) {
+        if (m_transaction.accept(message) && m_transaction.isComplete()) {
+            finishApply();
+        }
+    }
+}
+
+void HeadlessClient::onDataSent(const QByteArray& data)
+{
+    if (m_finished || m_mode != Set) {
+        return;
+    }
+
+    // 等待应答时写出确认只用于输出 written 字段
+    for (const Request& request : m_requests) {
+        if (request.frame == data) {
+            m_written = true;
+        }
+    }
+}
+
+void HeadlessClient::onErrorOccurred(const QString& errorString)
+{
+    if (m_finished) {
+        return;
+    }
+    fail(m_connected ? ExitDeviceError : ExitLinkError, errorString);
+}
+
+void HeadlessClient::onTimeout()
+{
+    if (m_finished) {
+        return;
+    }
+
+    if (!m_connected) {
+        fail(ExitLinkError, "连接超时");
+        return;
+    }
+
+    if (m_mode == Apply) {
+        finishApply();
+        return;
+    }
+
+    fail(ExitTimeout, QString("%1 ms 内未收到VCU综合信息").arg(m_timeoutTimer.interval()));
+}
+
+DeviceTask<> HeadlessClient::runRequests()
+{
+    // 所有请求帧首尾相接一次写出，应答按功能码匹配
+    // set 不等待应答时写出即完成，等待应答时按设置帧的功能码匹配应答
+    QList<DeviceRequest> requests;
+    for (const Request& request : m_requests) {
+        if (m_mode == Set && !m_options.requireAck) {
+            requests.append(m_session->set(request.frame).withTimeout(m_options.timeoutMs));
+        } else {
+            requests.append(m_session->request(request.frame, request.functionCode)
+                                .withPriority(m_mode == Set ? SendQueue::ConfigWrite : SendQueue::OneShotQuery)
+                                .withTimeout(m_options.timeoutMs));
+        }
+    }
+
+    const QList<DeviceResult> results = co_await m_session->whenAll(requests);
+
+    // 会话销毁（客户端析构中）时不再访问其他成员
+    for (const DeviceResult& result : results) {
+        if (result.status == DeviceResult::Cancelled) {
+            co_return;
+        }
+    }
+    // 连接断开或出错时已输出结果
+    if (m_finished) {
+        co_return;
+    }
+
+    QJsonArray missing;
+    QString invalid;
+    for (int i = 0; i < results.size(); ++i) {
+        const Request& request = m_requests[i];
+        const DeviceResult& result = results[i];
+        switch (result.status) {
+        case DeviceResult::Ok:
+            if (m_mode == Query) {
+                m_results.insert(request.target, MessageJson::toJson(result.message).value("value"));
+            } else {
+                m_written = true;
+                m_acknowledged = m_options.requireAck;
+            }
+            break;
+        case DeviceResult::InvalidReply:
+            if (invalid.isEmpty()) {
+                invalid = QString("%1 应答无效: %2").arg(request.target, result.error);
+            }
+            break;
+        case DeviceResult::Disconnected:
+            fail(ExitLinkError, result.error);
+            co_return;
+        default:
+            missing.append(request.target);
+            break;
+        }
+    }
+
+    if (!invalid.isEmpty()) {
+        fail(ExitDeviceError, invalid);
+    } else if (!missing.isEmpty()) {
+        m_results.insert("missing", missing);
+        fail(ExitTimeout, "设备应答超时");
+    } else {
+        finish(ExitOk);
+    }
+}
+
+void HeadlessClient::onPollTick()
+{
+    if (m_mode == Record && m_options.durationSec > 0
+        && m_elapsed.elapsed() >= static_cast<qint64>(m_options.durationSec) * 1000) {
+        finish(ExitOk);
+        return;
+    }
+    
+    // 发送队列拥塞时不再追加轮询帧（否则只会在队列中互相挤掉），跳过本次并加大间隔
+    if (m_congested) {
+        m_pollTimer.setInterval(qMin(qMax(m_pollTimer.interval(), 1) * 2,
+                                     qMax(m_options.intervalMs, 1) * MaxPollBackoff));
+        return;
+    }
+    m_link->sendFrame(ProtocolFrame::buildVcuInfoGetFrame(), SendQueue::PeriodicPoll);
+}
+
+void HeadlessClient::onBackpressureChanged(bool congested)
+{
+    m_congested = congested;
+    if (!congested && m_pollTimer.isActive() && m_pollTimer.interval() != m_options.intervalMs) {
+        m_pollTimer.setInterval(m_options.intervalMs);
+    }
+}
+
+void HeadlessClient::handleSample(const DeviceMessage& message)
+{
+    ++m_samples;
+    restartTimeout(qMax(m_options.timeoutMs, 2 * m_pollTimer.interval()));
+
+    if (m_mode == Poll) {
+        writeJson(MessageJson::toJson(message));
+    } else if (!m_archive->append(*message.vcuInfo)) {
+        fail(ExitDeviceError, m_archive->lastError());
+        return;
+    }
+
+    if (m_options.count > 0 && m_samples >= m_options.count) {
+        finish(ExitOk);
+    }
+}
+
+void HeadlessClient::finishApply()
+{
+    m_transaction.finish();
+
+    // 有不一致或无效应答时按设备错误退出，只有超时未应答时按超时退出
+    ExitCode code = ExitOk;
+    for (const ConfigTransaction::Field& field : m_transaction.fields()) {
+        QJsonObject result;
+        result.insert("result", ConfigTransaction::resultName(field.result));
+        result.insert("expected", ConfigTransaction::displayValue(field.name, field.expected));
+        if (!field.actual.isEmpty()) {
+            result.insert("actual", ConfigTransaction::displayValue(field.name, field.actual));
+        }
+        m_results.insert(field.name, result);
+
+        if (field.result == ConfigTransaction::Mismatch || field.result == ConfigTransaction::InvalidReply) {
+            code = ExitDeviceError;
+        } else if (field.result == ConfigTransaction::NoReply && code == ExitOk) {
+            code = ExitTimeout;
+        }
+    }
+    finish(code);
+}
+
+void HeadlessClient::restartTimeout(int timeoutMs)
+{
+    m_timeoutTimer.start(timeoutMs);
+}
+
+void HeadlessClient::writeJson(const QJsonObject& object)
+{
+    const QByteArray line = QJsonDocument(object).toJson(QJsonDocument::Compact) + '\n';
+    fwrite(line.constData(), 1, static_cast<size_t>(line.size()), stdout);
+    fflush(stdout);
+}
+
+void HeadlessClient::fail(ExitCode code, const QString& error)
+{
+    QJsonObject object;
+    object.insert("ok", false);
+    object.insert("command", m_command);
+    object.insert("error", error);
+    if (!m_results.isEmpty()) {
+        object.insert("results", m_results);
+    }
+    writeJson(object);
+
+    m_finished = true;
+    m_pollTimer.stop();
+    m_timeoutTimer.stop();
+    emit finished(code);
+}
+
+void HeadlessClient::finish(ExitCode code)
+{
+    QJsonObject object;
+    object.insert("ok", code == ExitOk);
+    object.insert("command", m_command);
+    object.insert("elapsedMs", static_cast<double>(m_elapsed.elapsed()));
+
+    switch (m_mode) {
+    case Query:
+        object.insert("results", m_results);
+        break;
+    case Apply:
+        object.insert("results", m_results);
+        break;
+    case Set:
+        object.insert("target", m_requests.first().target);
+        object.insert("written", m_written);
+        object.insert("acknowledged", m_acknowledged);
+        break;
+    case Poll:
+        object.insert("samples", m_samples);
+        break;
+    case Record:
+        m_archive->flush();
+        object.insert("samples", m_samples);
+        object.insert("archive", m_archive->rootPath());
+        break;
+    }
+    writeJson(object);
+
+    m_finished = true;
+    m_pollTimer.stop();
+    m_timeoutTimer.stop();
+    emit finished(code);
+}
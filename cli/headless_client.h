@@ -0,0 +1,132 @@
+#ifndef HEADLESS_CLIENT_H
+#define HEADLESS_CLIENT_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QScopedPointer>
+#include <QStringList>
+#include <QTimer>
+#include "command_frames.h"
+#include "device_link.h"
+#include "communication/device_session.h"
+#include "protocol/config_transaction.h"
+#include "telemetry/telemetry_archive.h"
+
+// 无界面客户端：建立串口或TCP连接，执行一条命令，结果以 JSON 输出到标准输出
+// 与图形界面共用工作线程、发送队列和帧处理流水线，只是把显示换成 JSON
+//
+// 命令：
+//   query <mac|ip|mask|gateway|network|vcu|hardfault>...   查询，多个目标流水线发送
+//   set <ip|mask|gateway> <地址> / set mac <高字节> / set vcu-param <前减速> <前停车> <后避障> <速度系数>
+//   apply ip=<地址> mask=<地址> gateway=<地址> mac=<高字节> vcu-param=<a,b,c,d>
+//                                                         一次写出全部设置和回读查询，逐项输出验证结果
+//   poll                                                  周期读取VCU综合信息，每个采样一行
+//   record                                                周期读取并写入遥测归档
+class HeadlessClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 进程退出码
+    enum ExitCode {
+        ExitOk = 0,
+        ExitUsage = 1,          // 命令行错误
+        ExitLinkError = 2,      // 连接失败或连接中断
+        ExitTimeout = 3,        // 设备未在超时时间内应答
+        ExitDeviceError = 4     // 设备应答无效
+    };
+
+    struct Options {
+        DeviceLink::Options link;
+        int timeoutMs;              // 连接和应答超时
+        int intervalMs;             // poll/record 采样间隔
+        int count;                  // poll/record 采样数，0 表示不限
+        int durationSec;            // record 持续时间，0 表示不限
+        QString archiveDir;         // record 归档目录
+        bool requireAck;            // set 是否等待设备应答
+        QStringList command;        // 命令及参数
+
+        Options() {
+            timeoutMs = 3000;
+            intervalMs = 1000;
+            count = 0;
+            durationSec = 0;
+            requireAck = false;
+        }
+    };
+
+    explicit HeadlessClient(const Options& options, QObject *parent = nullptr);
+
+    // 解析命令并构建请求帧，失败时返回 false
+    bool prepare(QString* error);
+
+    // 打开连接，连接成功后执行命令
+    void start();
+
+signals:
+    // 命令执行结束（已输出结果）
+    void finished(int exitCode);
+
+private slots:
+    void onConnectionStateChanged(bool connected);
+    void onMessageReceived(const DeviceMessage& message);
+    void onDataSent(const QByteArray& data);
+    void onErrorOccurred(const QString& errorString);
+    void onTimeout();
+    void onPollTick();
+    void onBackpressureChanged(bool congested);
+
+private:
+    enum Mode {
+        Query,
+        Set,
+        Apply,
+        Poll,
+        Record
+    };
+
+    using Request = CommandFrames::Request;
+
+    // 发送队列拥塞时轮询间隔逐次加倍，最多为设定间隔的倍数
+    static constexpr int MaxPollBackoff = 8;
+
+    // query / set：请求经设备会话一次写出，全部应答或超时后输出结果
+    DeviceTask<> runRequests();
+    void restartTimeout(int timeoutMs);
+    void handleSample(const DeviceMessage& message);
+    void finishApply();
+    void writeJson(const QJsonObject& object);
+    void fail(ExitCode code, const QString& error);
+    void finish(ExitCode code);
+
+    Options m_options;
+    Mode m_mode;
+    bool m_connected;
+    bool m_finished;
+
+    QScopedPointer<DeviceLink> m_link;
+
+    QList<Request> m_requests;
+    QJsonObject m_results;
+    bool m_written;
+    bool m_acknowledged;
+
+    // apply
+    ConfigTransaction m_transaction;
+
+    // poll / record
+    QScopedPointer<TelemetryArchive> m_archive;
+    QTimer m_pollTimer;
+    QTimer m_timeoutTimer;
+    QElapsedTimer m_elapsed;
+    int m_samples;
+    bool m_congested;
+
+    QString m_command;
+
+    // 放在最后，先于连接和其他成员销毁；销毁时等待中的请求以 Cancelled 结束
+    QScopedPointer<DeviceSession> m_session;
+};
+
+#endif // HEADLESS_CLIENT_H
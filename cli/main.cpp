@@ -0,0 +1,107 @@
+#include "device_daemon.h"
+#include "headless_client.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+#include <cstdio>
+
+// 无界面命令行入口：只创建 QCoreApplication，不加载任何界面组件
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("h7_cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "H7 IPSet 无界面命令行，结果以 JSON 输出到标准输出\n\n"
+        "命令:\n"
+        "  query <mac|ip|mask|gateway|network|vcu|hardfault>...\n"
+        "  set <ip|mask|gateway> <地址>\n"
+        "  set mac <高字节>\n"
+        "  set vcu-param <前减速距离> <前停车距离> <后避障距离> <速度校正系数>\n"
+        "  apply ip=<地址> mask=<地址> gateway=<地址> mac=<高字节> vcu-param=<a,b,c,d>\n"
+        "            全部设置和回读查询一次写出，逐项验证\n"
+        "  poll      周期读取VCU综合信息，每个采样输出一行\n"
+        "  record    周期读取VCU综合信息并写入 --archive 目录\n"
+        "  daemon    独占设备连接，在 --socket 本地套接字上为多个客户端提供查询、设置和订阅");
+    parser.addHelpOption();
+
+    QCommandLineOption serialOption(QStringList() << "s" << "serial", "串口名称", "port");
+    QCommandLineOption baudOption(QStringList() << "b" << "baud", "波特率（默认 115200）", "rate", "115200");
+    QCommandLineOption tcpOption(QStringList() << "t" << "tcp", "TCP 地址", "host:port");
+    QCommandLineOption timeoutOption("timeout", "连接和应答超时（默认 3000）", "ms", "3000");
+    QCommandLineOption intervalOption("interval", "poll/record/daemon 采样间隔（默认 1000）", "ms", "1000");
+    QCommandLineOption countOption("count", "poll/record 采样数，0 表示不限", "n", "0");
+    QCommandLineOption durationOption("duration", "record 持续时间，0 表示不限", "s", "0");
+    QCommandLineOption archiveOption("archive", "record 归档目录", "dir");
+    QCommandLineOption ackOption("ack", "set 等待设备应答后才算成功");
+    QCommandLineOption socketOption("socket", "daemon 本地套接字名称或路径（默认 h7_ipset）", "name", "h7_ipset");
+    QCommandLineOption verboseOption(QStringList() << "v" << "verbose", "输出调试日志到标准错误");
+    parser.addOptions({serialOption, baudOption, tcpOption, timeoutOption, intervalOption,
+                       countOption, durationOption, archiveOption, ackOption, socketOption, verboseOption});
+    parser.addPositionalArgument("command", "命令及参数");
+    parser.process(app);
+
+    if (!parser.isSet(verboseOption)) {
+        QLoggingCategory::setFilterRules("h7.*.debug=false");
+    }
+
+    DeviceLink::Options link;
+    link.serialPort = parser.value(serialOption);
+    link.baudRate = parser.value(baudOption).toInt();
+    if (parser.isSet(tcpOption)) {
+        const QString address = parser.value(tcpOption);
+        const int colon = address.lastIndexOf(':');
+        bool ok = false;
+        const uint port = colon > 0 ? address.mid(colon + 1).toUInt(&ok) : 0;
+        if (!ok || port == 0 || port > 65535) {
+            fprintf(stderr, "TCP 地址格式应为 host:port\n");
+            return HeadlessClient::ExitUsage;
+        }
+        link.host = address.left(colon);
+        link.port = static_cast<quint16>(port);
+    }
+
+    const QStringList positional = parser.positionalArguments();
+    if (!positional.isEmpty() && positional.first() == "daemon") {
+        if (link.serialPort.isEmpty() == link.host.isEmpty()) {
+            fprintf(stderr, "必须且只能指定 --serial 或 --tcp 之一\n\n%s", qPrintable(parser.helpText()));
+            return HeadlessClient::ExitUsage;
+        }
+
+        DeviceDaemon::Options options;
+        options.link = link;
+        options.socketName = parser.value(socketOption);
+        options.pollIntervalMs = parser.value(intervalOption).toInt();
+        options.timeoutMs = qMax(1, parser.value(timeoutOption).toInt());
+
+        DeviceDaemon daemon(options);
+        QString error;
+        if (!daemon.start(&error)) {
+            fprintf(stderr, "%s\n", qPrintable(error));
+            return HeadlessClient::ExitLinkError;
+        }
+        return app.exec();
+    }
+
+    HeadlessClient::Options options;
+    options.link = link;
+    options.timeoutMs = qMax(1, parser.value(timeoutOption).toInt());
+    options.intervalMs = parser.value(intervalOption).toInt();
+    options.count = qMax(0, parser.value(countOption).toInt());
+    options.durationSec = qMax(0, parser.value(durationOption).toInt());
+    options.archiveDir = parser.value(archiveOption);
+    options.requireAck = parser.isSet(ackOption);
+    options.command = positional;
+
+    HeadlessClient client(options);
+    QString error;
+    if (!client.prepare(&error)) {
+        fprintf(stderr, "%s\n\n%s", qPrintable(error), qPrintable(parser.helpText()));
+        return HeadlessClient::ExitUsage;
+    }
+
+    QObject::connect(&client, &HeadlessClient::finished, &app, &QCoreApplication::exit, Qt::QueuedConnection);
+    client.start();
+    return app.exec();
+}
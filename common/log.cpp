@@ -0,0 +1,20 @@
+#include "log.h"
+
+Q_LOGGING_CATEGORY(lcSerial, "h7.serial")
+Q_LOGGING_CATEGORY(lcSocket, "h7.socket")
+Q_LOGGING_CATEGORY(lcProtocol, "h7.protocol")
+Q_LOGGING_CATEGORY(lcTelemetry, "h7.telemetry")
+Q_LOGGING_CATEGORY(lcMetrics, "h7.metrics")
+Q_LOGGING_CATEGORY(lcIo, "h7.io")
+Q_LOGGING_CATEGORY(lcUi, "h7.ui")
+
+// trace 分类默认只输出 info 及以上级别，即 debug 级别的数据内容默认不输出
+Q_LOGGING_CATEGORY(lcSerialTrace, "h7.serial.trace", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcSocketTrace, "h7.socket.trace", QtInfoMsg)
+
+QDebug operator<<(QDebug debug, const HexDump& dump)
+{
+    QDebugStateSaver saver(debug);
+    debug.noquote() << QByteArray::fromRawData(dump.data, dump.size).toHex(' ');
+    return debug;
+}
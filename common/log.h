@@ -0,0 +1,57 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <QLoggingCategory>
+#include <QDebug>
+#include <QByteArray>
+
+/*
+    日志分类说明：
+    1. 每个子系统一个分类，级别开关通过 QT_LOGGING_RULES 环境变量或
+       QLoggingCategory::setFilterRules() 设置，例如：
+           QT_LOGGING_RULES="h7.socket.debug=false;h7.serial.trace.debug=true"
+    2. qCDebug/qCWarning 在分类关闭时只做一次判断，后面的参数不会被求值
+    3. *.trace 分类用于输出收发数据内容，默认关闭；
+       qmake CONFIG+=h7_no_trace 编译时整条 trace 语句被消除
+ */
+
+// 子系统日志分类
+Q_DECLARE_LOGGING_CATEGORY(lcSerial)        // h7.serial     串口
+Q_DECLARE_LOGGING_CATEGORY(lcSocket)        // h7.socket     Socket
+Q_DECLARE_LOGGING_CATEGORY(lcProtocol)      // h7.protocol   协议帧处理
+Q_DECLARE_LOGGING_CATEGORY(lcTelemetry)     // h7.telemetry  遥测存储与归档
+Q_DECLARE_LOGGING_CATEGORY(lcMetrics)       // h7.metrics    运行指标服务
+Q_DECLARE_LOGGING_CATEGORY(lcIo)            // h7.io         共享I/O线程池
+Q_DECLARE_LOGGING_CATEGORY(lcUi)            // h7.ui         界面（启动耗时等）
+
+// trace 分类：收发数据内容（默认关闭）
+Q_DECLARE_LOGGING_CATEGORY(lcSerialTrace)   // h7.serial.trace
+Q_DECLARE_LOGGING_CATEGORY(lcSocketTrace)   // h7.socket.trace
+
+// trace 日志宏
+#ifdef H7_NO_TRACE_LOG
+#  define H7_TRACE(category) while (false) QMessageLogger().noDebug()
+#else
+#  define H7_TRACE(category) qCDebug(category)
+#endif
+
+// 十六进制数据延迟格式化
+// 只保存数据指针，真正输出到日志时才格式化，数据必须在该语句执行期间有效
+struct HexDump {
+    const char* data;
+    int size;
+};
+
+inline HexDump hexDump(const char* data, int size)
+{
+    return HexDump{data, size};
+}
+
+inline HexDump hexDump(const QByteArray& data)
+{
+    return HexDump{data.constData(), static_cast<int>(data.size())};
+}
+
+QDebug operator<<(QDebug debug, const HexDump& dump);
+
+#endif // LOG_H
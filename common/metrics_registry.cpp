@@ -0,0 +1,270 @@
+#include "metrics_registry.h"
+#include <QMutexLocker>
+#include <algorithm>
+#include <cstring>
+
+namespace MetricsDetail {
+
+int shardIndex()
+{
+    // 每个线程第一次使用时按顺序分配分片
+    static std::atomic<int> s_nextShard(0);
+    thread_local int t_shard = s_nextShard.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+    return t_shard;
+}
+
+} // namespace MetricsDetail
+
+namespace {
+
+quint64 doubleBits(double value)
+{
+    quint64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(quint64 bits)
+{
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+QByteArray formatDouble(double value)
+{
+    return QByteArray::number(value, 'g', 12);
+}
+
+// {labels} 或 {labels,extra}
+QByteArray labelSet(const QString& labels, const QByteArray& extra = QByteArray())
+{
+    if (labels.isEmpty() && extra.isEmpty()) {
+        return QByteArray();
+    }
+    QByteArray result = "{" + labels.toUtf8();
+    if (!extra.isEmpty()) {
+        if (!labels.isEmpty()) {
+            result += ',';
+        }
+        result += extra;
+    }
+    result += '}';
+    return result;
+}
+
+} // namespace
+
+MetricCounter::MetricCounter()
+{
+    for (Shard& shard : m_shards) {
+        shard.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+quint64 MetricCounter::value() const
+{
+    quint64 total = 0;
+    for (const Shard& shard : m_shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+MetricGauge::MetricGauge()
+    : m_value(0)
+{
+}
+
+MetricHistogram::MetricHistogram(const QVector<double>& upperBounds)
+    : m_bounds(upperBounds)
+{
+    std::sort(m_bounds.begin(), m_bounds.end());
+    if (m_bounds.size() > MaxBuckets) {
+        m_bounds.resize(MaxBuckets);
+    }
+
+    for (Shard& shard : m_shards) {
+        for (std::atomic<quint64>& bucket : shard.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        shard.sumBits.store(doubleBits(0.0), std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::observe(double value)
+{
+    Shard& shard = m_shards[MetricsDetail::shardIndex()];
+
+    const int bucket = static_cast<int>(std::lower_bound(m_bounds.constBegin(), m_bounds.constEnd(), value)
+                                        - m_bounds.constBegin());
+    shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    // 分片基本只有一个线程写入，比较交换几乎总是一次成功
+    quint64 expected = shard.sumBits.load(std::memory_order_relaxed);
+    while (!shard.sumBits.compare_exchange_weak(expected, doubleBits(bitsDouble(expected) + value),
+                                                std::memory_order_relaxed)) {
+    }
+}
+
+void MetricHistogram::collect(QVector<quint64>* bucketCounts, quint64* count, double* sum) const
+{
+    bucketCounts->fill(0, m_bounds.size() + 1);
+    *count = 0;
+    *sum = 0.0;
+    for (const Shard& shard : m_shards) {
+        for (int i = 0; i <= m_bounds.size(); ++i) {
+            const quint64 n = shard.buckets[i].load(std::memory_order_relaxed);
+            (*bucketCounts)[i] += n;
+            *count += n;
+        }
+        *sum += bitsDouble(shard.sumBits.load(std::memory_order_relaxed));
+    }
+}
+
+MetricsRegistry::MetricsRegistry()
+{
+}
+
+MetricsRegistry* MetricsRegistry::instance()
+{
+    // 有意不释放：工作线程可能在静态析构阶段仍持有指标指针
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return registry;
+}
+
+QVector<double> MetricsRegistry::latencyBuckets()
+{
+    return QVector<double>{0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0};
+}
+
+void* MetricsRegistry::find(Type type, const QString& name, const QString& labels, bool* conflict) const
+{
+    *conflict = false;
+    for (const Entry& entry : m_entries) {
+        if (entry.name != name) {
+            continue;
+        }
+        if (entry.type != type) {
+            *conflict = true;
+            return nullptr;
+        }
+        if (entry.labels == labels) {
+            return entry.metric;
+        }
+    }
+    return nullptr;
+}
+
+MetricCounter* MetricsRegistry::counter(const QString& name, const QString& help, const QString& labels)
+{
+    QMutexLocker locker(&m_mutex);
+    bool conflict = false;
+    if (void* existing = find(Counter, name, labels, &conflict)) {
+        return static_cast<MetricCounter*>(existing);
+    }
+    if (conflict) {
+        return nullptr;
+    }
+
+    MetricCounter* metric = new MetricCounter();
+    m_entries.append(Entry{Counter, name, help, labels, metric});
+    return metric;
+}
+
+MetricGauge* MetricsRegistry::gauge(const QString& name, const QString& help, const QString& labels)
+{
+    QMutexLocker locker(&m_mutex);
+    bool conflict = false;
+    if (void* existing = find(Gauge, name, labels, &conflict)) {
+        return static_cast<MetricGauge*>(existing);
+    }
+    if (conflict) {
+        return nullptr;
+    }
+
+    MetricGauge* metric = new MetricGauge();
+    m_entries.append(Entry{Gauge, name, help, labels, metric});
+    return metric;
+}
+
+MetricHistogram* MetricsRegistry::histogram(const QString& name, const QString& help, const QString& labels,
+                                            const QVector<double>& upperBounds)
+{
+    QMutexLocker locker(&m_mutex);
+    bool conflict = false;
+    if (void* existing = find(Histogram, name, labels, &conflict)) {
+        return static_cast<MetricHistogram*>(existing);
+    }
+    if (conflict) {
+        return nullptr;
+    }
+
+    MetricHistogram* metric = new MetricHistogram(upperBounds);
+    m_entries.append(Entry{Histogram, name, help, labels, metric});
+    return metric;
+}
+
+QByteArray MetricsRegistry::renderPrometheus() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QByteArray out;
+    out.reserve(8192);
+
+    // 同名指标归为一组，HELP/TYPE 只输出一次
+    QVector<bool> written(m_entries.size(), false);
+    for (int first = 0; first < m_entries.size(); ++first) {
+        if (written[first]) {
+            continue;
+        }
+
+        const Entry& head = m_entries[first];
+        const QByteArray name = head.name.toUtf8();
+        const char* typeName = head.type == Counter ? "counter" : head.type == Gauge ? "gauge" : "histogram";
+        out += "# HELP " + name + ' ' + head.help.toUtf8() + '\n';
+        out += "# TYPE " + name + ' ' + typeName + '\n';
+
+        for (int i = first; i < m_entries.size(); ++i) {
+            const Entry& entry = m_entries[i];
+            if (written[i] || entry.name != head.name) {
+                continue;
+            }
+            written[i] = true;
+
+            switch (entry.type) {
+            case Counter:
+                out += name + labelSet(entry.labels) + ' '
+                     + QByteArray::number(static_cast<MetricCounter*>(entry.metric)->value()) + '\n';
+                break;
+
+            case Gauge:
+                out += name + labelSet(entry.labels) + ' '
+                     + QByteArray::number(static_cast<MetricGauge*>(entry.metric)->value()) + '\n';
+                break;
+
+            case Histogram: {
+                const MetricHistogram* histogram = static_cast<MetricHistogram*>(entry.metric);
+                const QVector<double> bounds = histogram->upperBounds();
+                QVector<quint64> buckets;
+                quint64 count = 0;
+                double sum = 0.0;
+                histogram->collect(&buckets, &count, &sum);
+
+                // Prometheus 的桶计数是累计的
+                quint64 cumulative = 0;
+                for (int b = 0; b < bounds.size(); ++b) {
+                    cumulative += buckets[b];
+                    out += name + "_bucket" + labelSet(entry.labels, "le=\"" + formatDouble(bounds[b]) + '"') + ' '
+                         + QByteArray::number(cumulative) + '\n';
+                }
+                out += name + "_bucket" + labelSet(entry.labels, "le=\"+Inf\"") + ' ' + QByteArray::number(count) + '\n';
+                out += name + "_sum" + labelSet(entry.labels) + ' ' + formatDouble(sum) + '\n';
+                out += name + "_count" + labelSet(entry.labels) + ' ' + QByteArray::number(count) + '\n';
+                break;
+            }
+            }
+        }
+    }
+    return out;
+}
@@ -0,0 +1,131 @@
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+/*
+    运行指标（Prometheus 文本格式导出）：
+    1. 计数器和直方图按线程分片，每个分片独占一条缓存行，
+       各线程只对自己的分片做 relaxed 原子加，互不争用；导出时把分片累加
+    2. 仪表（当前值）只有一个原子变量，set/add 直接覆盖
+    3. 指标对象在首次登记时创建，直到程序退出都不释放，
+       各模块在初始化时取得指针后直接使用，不再查表
+    4. 同名指标可以带不同标签登记多次，导出时按名称归组
+ */
+
+namespace MetricsDetail {
+// 分片数，线程数多于分片数时多个线程共享分片（仍然正确，只是会有争用）
+constexpr int ShardCount = 16;
+
+// 当前线程使用的分片下标
+int shardIndex();
+}
+
+// 单调递增计数器
+class MetricCounter
+{
+public:
+    MetricCounter();
+
+    void add(quint64 value = 1)
+    {
+        m_shards[MetricsDetail::shardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    quint64 value() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<quint64> value;
+    };
+    Shard m_shards[MetricsDetail::ShardCount];
+};
+
+// 仪表：可增可减的当前值
+class MetricGauge
+{
+public:
+    MetricGauge();
+
+    void set(qint64 value) { m_value.store(value, std::memory_order_relaxed); }
+    void add(qint64 delta) { m_value.fetch_add(delta, std::memory_order_relaxed); }
+    qint64 value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<qint64> m_value;
+};
+
+// 直方图：固定桶上界（升序），另有 +Inf 桶
+class MetricHistogram
+{
+public:
+    static constexpr int MaxBuckets = 16;
+
+    explicit MetricHistogram(const QVector<double>& upperBounds);
+
+    void observe(double value);
+
+    QVector<double> upperBounds() const { return m_bounds; }
+
+    // 各桶的非累计计数（最后一个为 +Inf 桶）、总数和总和
+    void collect(QVector<quint64>* bucketCounts, quint64* count, double* sum) const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<quint64> buckets[MaxBuckets + 1];
+        std::atomic<quint64> sumBits;   // double 的位模式
+    };
+
+    QVector<double> m_bounds;
+    Shard m_shards[MetricsDetail::ShardCount];
+};
+
+class MetricsRegistry
+{
+public:
+    // 进程内唯一的注册表
+    static MetricsRegistry* instance();
+
+    // 取得（首次调用时登记）一个指标；labels 为 Prometheus 标签文本，例如 transport="serial"
+    // 同名指标的类型必须一致，类型冲突时返回 nullptr
+    MetricCounter* counter(const QString& name, const QString& help, const QString& labels = QString());
+    MetricGauge* gauge(const QString& name, const QString& help, const QString& labels = QString());
+    MetricHistogram* histogram(const QString& name, const QString& help, const QString& labels,
+                               const QVector<double>& upperBounds);
+
+    // 按 Prometheus 文本格式（0.0.4）输出全部指标
+    QByteArray renderPrometheus() const;
+
+    // 常用的延迟桶上界（秒）：1ms ~ 5s
+    static QVector<double> latencyBuckets();
+
+private:
+    enum Type {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    struct Entry {
+        Type type;
+        QString name;
+        QString help;
+        QString labels;
+        void* metric;
+    };
+
+    MetricsRegistry();
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    void* find(Type type, const QString& name, const QString& labels, bool* conflict) const;
+
+    mutable QMutex m_mutex;
+    QVector<Entry> m_entries;   // 登记顺序
+};
+
+#endif // METRICS_REGISTRY_H
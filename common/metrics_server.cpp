@@ -0,0 +1,130 @@
+#include "metrics_server.h"
+#include "log.h"
+#include "metrics_registry.h"
+#include <QHostAddress>
+#include <QTcpSocket>
+
+MetricsServer::MetricsServer(QObject *parent)
+    : QObject(parent)
+{
+    connect(&m_server, &QTcpServer::newConnection, this, &MetricsServer::handleNewConnection);
+}
+
+quint16 MetricsServer::configuredPort()
+{
+    bool ok = false;
+    const int port = qEnvironmentVariableIntValue("H7_METRICS_PORT", &ok);
+    if (!ok) {
+        return DefaultPort;
+    }
+    return static_cast<quint16>(qBound(0, port, 65535));
+}
+
+bool MetricsServer::listen(quint16 port)
+{
+    if (m_server.isListening()) {
+        m_server.close();
+    }
+
+    if (!m_server.listen(QHostAddress::LocalHost, port)) {
+        m_lastError = QString("指标服务监听端口 %1 失败: %2").arg(port).arg(m_server.errorString());
+        qCWarning(lcMetrics) << m_lastError;
+        return false;
+    }
+
+    qCDebug(lcMetrics) << "指标服务已启动: http://127.0.0.1:" << m_server.serverPort() << "/metrics";
+    return true;
+}
+
+void MetricsServer::close()
+{
+    m_server.close();
+}
+
+bool MetricsServer::isListening() const
+{
+    return m_server.isListening();
+}
+
+quint16 MetricsServer::port() const
+{
+    return m_server.serverPort();
+}
+
+QString MetricsServer::lastError() const
+{
+    return m_lastError;
+}
+
+void MetricsServer::handleNewConnection()
+{
+    while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+        m_requests.insert(socket, QByteArray());
+        connect(socket, &QTcpSocket::readyRead, this, &MetricsServer::handleReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_requests.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MetricsServer::handleReadyRead()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket || !m_requests.contains(socket)) {
+        return;
+    }
+
+    QByteArray& request = m_requests[socket];
+    request += socket->readAll();
+
+    if (request.size() > MaxRequestSize) {
+        m_requests.remove(socket);
+        socket->abort();
+        return;
+    }
+
+    // 等待请求头收全
+    if (!request.contains("\r\n\r\n") && !request.contains("\n\n")) {
+        return;
+    }
+
+    const int lineEnd = request.indexOf('\n');
+    const QList<QByteArray> requestLine = request.left(lineEnd).trimmed().split(' ');
+    m_requests.remove(socket);
+
+    if (requestLine.size() < 2 || (requestLine[0] != "GET" && requestLine[0] != "HEAD")) {
+        respond(socket, "405 Method Not Allowed", "text/plain; charset=utf-8", "method not allowed\n");
+        return;
+    }
+
+    QByteArray path = requestLine[1];
+    const int query = path.indexOf('?');
+    if (query >= 0) {
+        path.truncate(query);
+    }
+
+    if (path != "/metrics") {
+        respond(socket, "404 Not Found", "text/plain; charset=utf-8", "not found\n");
+        return;
+    }
+
+    const QByteArray body = requestLine[0] == "HEAD" ? QByteArray()
+                                                     : MetricsRegistry::instance()->renderPrometheus();
+    respond(socket, "200 OK", "text/plain; version=0.0.4; charset=utf-8", body);
+}
+
+void MetricsServer::respond(QTcpSocket* socket, const QByteArray& status, const QByteArray& contentType,
+                            const QByteArray& body)
+{
+    QByteArray response;
+    response.reserve(body.size() + 128);
+    response += "HTTP/1.1 " + status + "\r\n";
+    response += "Content-Type: " + contentType + "\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+
+    socket->write(response);
+    socket->disconnectFromHost();
+}
@@ -0,0 +1,49 @@
+#ifndef METRICS_SERVER_H
+#define METRICS_SERVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QTcpServer>
+
+class QTcpSocket;
+
+// 运行指标 HTTP 服务
+// 只监听本机回环地址，GET /metrics 返回 Prometheus 文本格式，其余路径返回 404；
+// 每个请求回复后即关闭连接。输出由 MetricsRegistry 生成，开销只在被抓取时产生
+class MetricsServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 默认端口，可用环境变量 H7_METRICS_PORT 覆盖（0 表示不启动）
+    static constexpr quint16 DefaultPort = 9464;
+
+    explicit MetricsServer(QObject *parent = nullptr);
+
+    bool listen(quint16 port);
+    void close();
+
+    bool isListening() const;
+    quint16 port() const;
+    QString lastError() const;
+
+    // 读取环境变量后的端口
+    static quint16 configuredPort();
+
+private slots:
+    void handleNewConnection();
+    void handleReadyRead();
+
+private:
+    // 请求头最大长度，超过直接断开
+    static constexpr int MaxRequestSize = 8192;
+
+    void respond(QTcpSocket* socket, const QByteArray& status, const QByteArray& contentType,
+                 const QByteArray& body);
+
+    QTcpServer m_server;
+    QHash<QTcpSocket*, QByteArray> m_requests;   // 未收全的请求头
+    QString m_lastError;
+};
+
+#endif // METRICS_SERVER_H
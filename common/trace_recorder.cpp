@@ -0,0 +1,227 @@
+#include "trace_recorder.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QIODevice>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+
+namespace {
+
+struct TraceEvent {
+    const char* category;
+    const char* name;
+    qint64 beginNs;
+    qint64 durationNs;      // < 0 表示瞬时事件
+};
+
+// 线程缓冲：只由所属线程写入，count 以 release 语义发布已写入的事件数
+// 缓冲在线程退出后保留（线程数量固定且很少），以便导出其事件
+struct ThreadBuffer {
+    int threadId;
+    QString threadName;
+    std::atomic<int> generation;
+    std::atomic<int> count;
+    std::atomic<qint64> dropped;
+    TraceEvent events[TraceRecorder::EventsPerThread];
+};
+
+QMutex s_registryMutex;
+QVector<ThreadBuffer*> s_registry;
+std::atomic<int> s_generation(0);
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+const QElapsedTimer& monotonicClock()
+{
+    static const QElapsedTimer clock = []() {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock;
+}
+
+ThreadBuffer* currentBuffer()
+{
+    ThreadBuffer* buffer = t_buffer;
+    if (!buffer) {
+        buffer = new ThreadBuffer();
+        buffer->generation.store(-1, std::memory_order_relaxed);
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+
+        QThread* thread = QThread::currentThread();
+        QCoreApplication* app = QCoreApplication::instance();
+
+        QMutexLocker locker(&s_registryMutex);
+        buffer->threadId = s_registry.size() + 1;
+        if (app && app->thread() == thread) {
+            buffer->threadName = "主线程";
+        } else if (thread && !thread->objectName().isEmpty()) {
+            buffer->threadName = thread->objectName();
+        } else {
+            buffer->threadName = QString("线程 %1").arg(buffer->threadId);
+        }
+        s_registry.append(buffer);
+        t_buffer = buffer;
+    }
+
+    // 新一轮记录开始后由写入线程自己清空缓冲，避免与写入竞争
+    const int generation = s_generation.load(std::memory_order_acquire);
+    if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+        buffer->generation.store(generation, std::memory_order_release);
+    }
+    return buffer;
+}
+
+void appendEvent(const char* category, const char* name, qint64 beginNs, qint64 durationNs)
+{
+    ThreadBuffer* buffer = currentBuffer();
+    const int index = buffer->count.load(std::memory_order_relaxed);
+    if (index >= TraceRecorder::EventsPerThread) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    TraceEvent& event = buffer->events[index];
+    event.category = category;
+    event.name = name;
+    event.beginNs = beginNs;
+    event.durationNs = durationNs;
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+void appendJsonString(QByteArray* out, const QByteArray& text)
+{
+    out->append('"');
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out->append('\\');
+            out->append(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out->append(' ');
+        } else {
+            out->append(c);
+        }
+    }
+    out->append('"');
+}
+
+// 纳秒 -> 微秒，保留 3 位小数
+void appendMicroseconds(QByteArray* out, qint64 ns)
+{
+    out->append(QByteArray::number(ns / 1000));
+    out->append('.');
+    const int fraction = static_cast<int>(ns % 1000);
+    out->append(static_cast<char>('0' + fraction / 100));
+    out->append(static_cast<char>('0' + fraction / 10 % 10));
+    out->append(static_cast<char>('0' + fraction % 10));
+}
+
+} // namespace
+
+std::atomic<bool> TraceRecorder::s_enabled(false);
+
+void TraceRecorder::start()
+{
+    monotonicClock();
+    s_generation.fetch_add(1, std::memory_order_acq_rel);
+    s_enabled.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::stop()
+{
+    s_enabled.store(false, std::memory_order_release);
+}
+
+qint64 TraceRecorder::now()
+{
+    return monotonicClock().nsecsElapsed();
+}
+
+void TraceRecorder::complete(const char* category, const char* name, qint64 beginNs, qint64 endNs)
+{
+    appendEvent(category, name, beginNs, qMax<qint64>(0, endNs - beginNs));
+}
+
+void TraceRecorder::instant(const char* category, const char* name)
+{
+    appendEvent(category, name, now(), -1);
+}
+
+qint64 TraceRecorder::droppedEvents()
+{
+    const int generation = s_generation.load(std::memory_order_acquire);
+    qint64 dropped = 0;
+    QMutexLocker locker(&s_registryMutex);
+    for (ThreadBuffer* buffer : s_registry) {
+        if (buffer->generation.load(std::memory_order_acquire) == generation) {
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return dropped;
+}
+
+int TraceRecorder::exportJson(QIODevice* device)
+{
+    const int generation = s_generation.load(std::memory_order_acquire);
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+
+    QByteArray out;
+    out.reserve(1024 * 1024);
+    out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    int exported = 0;
+    bool first = true;
+    QMutexLocker locker(&s_registryMutex);
+    for (ThreadBuffer* buffer : s_registry) {
+        if (buffer->generation.load(std::memory_order_acquire) != generation) {
+            continue;
+        }
+
+        const QByteArray tid = QByteArray::number(buffer->threadId);
+
+        // 线程名元数据
+        out.append(first ? "\n" : ",\n");
+        first = false;
+        out.append("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + pid + ",\"tid\":" + tid + ",\"args\":{\"name\":");
+        appendJsonString(&out, buffer->threadName.toUtf8());
+        out.append("}}");
+
+        const int count = buffer->count.load(std::memory_order_acquire);
+        for (int i = 0; i < count; ++i) {
+            const TraceEvent& event = buffer->events[i];
+            out.append(",\n{\"name\":");
+            appendJsonString(&out, QByteArray::fromRawData(event.name, static_cast<int>(qstrlen(event.name))));
+            out.append(",\"cat\":");
+            appendJsonString(&out, QByteArray::fromRawData(event.category, static_cast<int>(qstrlen(event.category))));
+            if (event.durationNs >= 0) {
+                out.append(",\"ph\":\"X\",\"ts\":");
+                appendMicroseconds(&out, event.beginNs);
+                out.append(",\"dur\":");
+                appendMicroseconds(&out, event.durationNs);
+            } else {
+                out.append(",\"ph\":\"i\",\"s\":\"t\",\"ts\":");
+                appendMicroseconds(&out, event.beginNs);
+            }
+            out.append(",\"pid\":" + pid + ",\"tid\":" + tid + "}");
+            ++exported;
+
+            if (out.size() >= 1024 * 1024) {
+                if (device->write(out) != out.size()) {
+                    return -1;
+                }
+                out.clear();
+            }
+        }
+    }
+
+    out.append("\n]}\n");
+    if (device->write(out) != out.size()) {
+        return -1;
+    }
+    return exported;
+}
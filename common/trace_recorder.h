@@ -0,0 +1,100 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <QtGlobal>
+#include <QString>
+#include <atomic>
+
+class QIODevice;
+
+/*
+    性能跟踪（Chrome trace event / Perfetto 格式）：
+    1. H7_SPAN("分类", "名称") 在当前作用域内记录一个耗时区间，名称和分类必须是字符串常量
+    2. 每个线程写自己的固定大小缓冲（线程局部，无锁），缓冲满后丢弃后续事件；
+       只有线程第一次记录时加锁登记一次缓冲
+    3. 时间戳为单调时钟（QElapsedTimer，纳秒），导出时换算为微秒
+    4. 未开启记录时每个埋点只读一次原子标志；
+       qmake CONFIG+=h7_no_span 编译时埋点被完全消除
+    5. 导出的 JSON 可直接用 chrome://tracing 或 ui.perfetto.dev 打开
+ */
+class TraceRecorder
+{
+public:
+    // 每个线程缓冲的事件数
+    static constexpr int EventsPerThread = 1 << 16;
+
+    // 开始记录（清空之前的事件）/ 停止记录
+    static void start();
+    static void stop();
+
+    static bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    // 单调时钟，纳秒
+    static qint64 now();
+
+    // 记录一个已完成的区间（可用于跨线程：begin 在其他线程取得）
+    static void complete(const char* category, const char* name, qint64 beginNs, qint64 endNs);
+
+    // 记录一个瞬时事件
+    static void instant(const char* category, const char* name);
+
+    // 导出为 Chrome trace JSON，返回导出的事件数，失败返回 -1
+    static int exportJson(QIODevice* device);
+
+    // 记录期间因缓冲满被丢弃的事件数
+    static qint64 droppedEvents();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+// 作用域区间
+class TraceSpan
+{
+public:
+    TraceSpan(const char* category, const char* name)
+        : m_category(category)
+        , m_name(name)
+        , m_beginNs(TraceRecorder::isEnabled() ? TraceRecorder::now() : -1)
+    {
+    }
+
+    ~TraceSpan()
+    {
+        if (m_beginNs >= 0) {
+            TraceRecorder::complete(m_category, m_name, m_beginNs, TraceRecorder::now());
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    qint64 m_beginNs;
+};
+
+#define H7_SPAN_CONCAT_INNER(a, b) a##b
+#define H7_SPAN_CONCAT(a, b) H7_SPAN_CONCAT_INNER(a, b)
+
+#ifdef H7_NO_SPAN
+#  define H7_SPAN(category, name) do {} while (false)
+#  define H7_SPAN_INSTANT(category, name) do {} while (false)
+#  define H7_SPAN_NOW() qint64(-1)
+#  define H7_SPAN_SINCE(category, name, beginNs) do {} while (false)
+#else
+#  define H7_SPAN(category, name) TraceSpan H7_SPAN_CONCAT(h7Span_, __LINE__)(category, name)
+#  define H7_SPAN_INSTANT(category, name) \
+       do { if (TraceRecorder::isEnabled()) TraceRecorder::instant(category, name); } while (false)
+// 跨线程区间：起点线程取 H7_SPAN_NOW()，终点线程调用 H7_SPAN_SINCE
+#  define H7_SPAN_NOW() (TraceRecorder::isEnabled() ? TraceRecorder::now() : qint64(-1))
+#  define H7_SPAN_SINCE(category, name, beginNs) \
+       do { if ((beginNs) >= 0 && TraceRecorder::isEnabled()) \
+                TraceRecorder::complete(category, name, beginNs, TraceRecorder::now()); } while (false)
+#endif
+
+#endif // TRACE_RECORDER_H
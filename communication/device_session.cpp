@@ -0,0 +1,350 @@
+#include "device_session.h"
+#include "../common/log.h"
+#include "../protocol/protocol_frame.h"
+
+DeviceCancelToken::DeviceCancelToken()
+    : m_state(std::make_shared<State>())
+{
+}
+
+void DeviceCancelToken::cancel()
+{
+    if (m_state->cancelled) {
+        return;
+    }
+    m_state->cancelled = true;
+
+    // 回调可能恢复协程并登记新的回调，先取出
+    QMap<quint64, std::function<void()>> callbacks;
+    callbacks.swap(m_state->callbacks);
+    for (const std::function<void()>& callback : callbacks) {
+        callback();
+    }
+}
+
+bool DeviceCancelToken::isCancelled() const
+{
+    return m_state->cancelled;
+}
+
+int DeviceCancelToken::pendingCount() const
+{
+    return m_state->callbacks.size();
+}
+
+quint64 DeviceCancelToken::addCallback(std::function<void()> callback)
+{
+    const quint64 key = m_state->nextKey++;
+    m_state->callbacks.insert(key, std::move(callback));
+    return key;
+}
+
+void DeviceCancelToken::removeCallback(quint64 key)
+{
+    m_state->callbacks.remove(key);
+}
+
+DeviceRequest DeviceRequest::withTimeout(int timeoutMs) const
+{
+    DeviceRequest copy = *this;
+    copy.timeoutMs = timeoutMs;
+    return copy;
+}
+
+DeviceRequest DeviceRequest::withCancel(const DeviceCancelToken& token) const
+{
+    DeviceRequest copy = *this;
+    copy.token = token;
+    copy.hasToken = true;
+    return copy;
+}
+
+DeviceRequest DeviceRequest::withPriority(SendQueue::Priority priority) const
+{
+    DeviceRequest copy = *this;
+    copy.priority = priority;
+    return copy;
+}
+
+DeviceRequest::Awaiter DeviceRequest::operator co_await() const
+{
+    return Awaiter{session, QList<DeviceRequest>{*this}, QList<DeviceResult>()};
+}
+
+bool DeviceRequest::Awaiter::await_ready()
+{
+    return requests.isEmpty();
+}
+
+bool DeviceRequest::Awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    // submit 返回 false 时结果已填好，不挂起
+    return session->submit(this, handle);
+}
+
+DeviceResult DeviceRequest::Awaiter::await_resume()
+{
+    return results.value(0);
+}
+
+DeviceSession::~DeviceSession()
+{
+    // 之后恢复的协程再发起请求会立即以 Cancelled 结束
+    m_closing = true;
+    failAll(DeviceResult::Cancelled, "会话已关闭");
+}
+
+void DeviceSession::initialize(bool connected)
+{
+    m_nextId = 1;
+    m_connected = connected;
+    m_closing = false;
+    m_clock.start();
+
+    m_expireTimer.setInterval(50);
+    connect(&m_expireTimer, &QTimer::timeout, this, &DeviceSession::onExpireTick);
+}
+
+DeviceRequest DeviceSession::query(quint16 functionCode)
+{
+    QByteArray frame;
+    switch (functionCode) {
+    case PC_MAC_ADDR_QUERY:
+        frame = ProtocolFrame::buildMacQueryFrame();
+        break;
+    case PC_IP_ADDR_QUERY:
+        frame = ProtocolFrame::buildIpQueryFrame();
+        break;
+    case PC_MASK_ADDR_QUERY:
+        frame = ProtocolFrame::buildMaskQueryFrame();
+        break;
+    case PC_GATEWAY_ADDR_QUERY:
+        frame = ProtocolFrame::buildGatewayQueryFrame();
+        break;
+    case PC_VCU_INFO_GET:
+        frame = ProtocolFrame::buildVcuInfoGetFrame();
+        break;
+    case PC_HARDFAULT_INFO_GET:
+        frame = ProtocolFrame::buildHardFaultInfoGetFrame();
+        break;
+    default:
+        qCWarning(lcProtocol) << "不支持的查询功能码:" << Qt::hex << functionCode;
+        break;
+    }
+    return request(frame, functionCode);
+}
+
+DeviceRequest DeviceSession::request(const QByteArray& frame, quint16 replyCode)
+{
+    DeviceRequest request;
+    request.session = this;
+    request.kind = DeviceRequest::Query;
+    request.frame = frame;
+    request.replyCode = replyCode;
+    return request;
+}
+
+DeviceRequest DeviceSession::set(const QByteArray& setFrame)
+{
+    DeviceRequest request;
+    request.session = this;
+    request.kind = DeviceRequest::Write;
+    request.priority = SendQueue::ConfigWrite;
+    request.frame = setFrame;
+    request.replyCode = ProtocolFrame::functionCodeOf(setFrame);
+    return request;
+}
+
+DeviceRequest::GroupAwaiter DeviceSession::whenAll(const QList<DeviceRequest>& requests)
+{
+    DeviceRequest::GroupAwaiter awaiter;
+    awaiter.session = this;
+    awaiter.requests = requests;
+    return awaiter;
+}
+
+void DeviceSession::cancelAll()
+{
+    failAll(DeviceResult::Cancelled, "已取消");
+}
+
+int DeviceSession::pendingCount() const
+{
+    return m_waiters.size();
+}
+
+bool DeviceSession::submit(DeviceRequest::Awaiter* awaiter, std::coroutine_handle<> handle)
+{
+    const int count = awaiter->requests.size();
+    awaiter->results = QList<DeviceResult>();
+    for (int i = 0; i < count; ++i) {
+        awaiter->results.append(DeviceResult());
+    }
+
+    // 不可用时直接给出结果，协程不挂起
+    QString unavailable;
+    DeviceResult::Status status = DeviceResult::Ok;
+    if (m_closing) {
+        status = DeviceResult::Cancelled;
+        unavailable = "会话已关闭";
+    } else if (!m_connected) {
+        status = DeviceResult::Disconnected;
+        unavailable = "设备未连接";
+    }
+
+    std::shared_ptr<Group> group = std::make_shared<Group>(Group{awaiter, handle, 0});
+    QList<QByteArray> frames;
+    SendQueue::Priority priority = SendQueue::PeriodicPoll;
+    // 取消令牌只引用请求号，会话销毁后回调什么也不做
+    QPointer<DeviceSession> self(this);
+
+    for (int i = 0; i < count; ++i) {
+        const DeviceRequest& request = awaiter->requests[i];
+        DeviceResult& result = awaiter->results[i];
+        if (!unavailable.isEmpty()) {
+            result.status = status;
+            result.error = unavailable;
+            continue;
+        }
+        if (request.frame.isEmpty()) {
+            result.status = DeviceResult::InvalidReply;
+            result.error = "请求帧为空";
+            continue;
+        }
+        if (request.hasToken && request.token.isCancelled()) {
+            result.status = DeviceResult::Cancelled;
+            result.error = "已取消";
+            continue;
+        }
+
+        Waiter waiter;
+        waiter.id = m_nextId++;
+        waiter.group = group;
+        waiter.index = i;
+        waiter.kind = request.kind;
+        waiter.replyCode = request.replyCode;
+        waiter.frame = request.frame;
+        waiter.deadlineMs = m_clock.elapsed() + request.timeoutMs;
+        waiter.tokenKey = 0;
+        if (request.hasToken) {
+            const quint64 id = waiter.id;
+            waiter.token = request.token;
+            waiter.tokenKey = waiter.token.addCallback([self, id]() {
+                if (self) {
+                    self->completeById(id, DeviceResult::Cancelled, "已取消");
+                }
+            });
+        }
+        m_waiters.append(waiter);
+        ++group->remaining;
+
+        frames.append(request.frame);
+        priority = qMin(priority, request.priority);
+    }
+
+    if (group->remaining == 0) {
+        return false;
+    }
+
+    if (!m_expireTimer.isActive()) {
+        m_expireTimer.start();
+    }
+    m_send(frames, priority);
+    return true;
+}
+
+void DeviceSession::complete(int waiterIndex, DeviceResult::Status status, const DeviceMessage& message,
+                             const QString& error)
+{
+    Waiter waiter = m_waiters.takeAt(waiterIndex);
+    if (waiter.tokenKey != 0) {
+        waiter.token.removeCallback(waiter.tokenKey);
+    }
+    DeviceResult& result = waiter.group->awaiter->results[waiter.index];
+    result.status = status;
+    result.message = message;
+    result.error = error;
+
+    if (m_waiters.isEmpty()) {
+        m_expireTimer.stop();
+    }
+
+    // 组内全部结束后恢复协程；恢复后协程可能立即发起新请求
+    if (--waiter.group->remaining == 0) {
+        waiter.group->handle.resume();
+    }
+}
+
+void DeviceSession::completeById(quint64 id, DeviceResult::Status status, const QString& error)
+{
+    for (int i = 0; i < m_waiters.size(); ++i) {
+        if (m_waiters[i].id == id) {
+            complete(i, status, DeviceMessage(), error);
+            return;
+        }
+    }
+}
+
+void DeviceSession::failAll(DeviceResult::Status status, const QString& error)
+{
+    // 逐个结束；恢复的协程可能追加新请求，只处理当前已有的
+    QList<quint64> ids;
+    for (const Waiter& waiter : m_waiters) {
+        ids.append(waiter.id);
+    }
+    for (quint64 id : ids) {
+        completeById(id, status, error);
+    }
+}
+
+void DeviceSession::onMessageReceived(const DeviceMessage& message)
+{
+    if (message.type == DeviceMessage::InvalidFrame) {
+        return;
+    }
+
+    for (int i = 0; i < m_waiters.size(); ++i) {
+        const Waiter& waiter = m_waiters[i];
+        if (waiter.kind == DeviceRequest::Query && waiter.replyCode == message.functionCode) {
+            if (message.isValid()) {
+                complete(i, DeviceResult::Ok, message, QString());
+            } else {
+                complete(i, DeviceResult::InvalidReply, message, message.errorMessage);
+            }
+            return;
+        }
+    }
+}
+
+void DeviceSession::onDataSent(const QByteArray& data)
+{
+    for (int i = 0; i < m_waiters.size(); ++i) {
+        const Waiter& waiter = m_waiters[i];
+        if (waiter.kind == DeviceRequest::Write && waiter.frame == data) {
+            complete(i, DeviceResult::Ok, DeviceMessage(), QString());
+            return;
+        }
+    }
+}
+
+void DeviceSession::onConnectionStateChanged(bool connected)
+{
+    m_connected = connected;
+    if (!connected) {
+        failAll(DeviceResult::Disconnected, "连接已断开");
+    }
+}
+
+void DeviceSession::onExpireTick()
+{
+    const qint64 now = m_clock.elapsed();
+    QList<quint64> expired;
+    for (const Waiter& waiter : m_waiters) {
+        if (now >= waiter.deadlineMs) {
+            expired.append(waiter.id);
+        }
+    }
+    for (quint64 id : expired) {
+        completeById(id, DeviceResult::Timeout, "设备应答超时");
+    }
+}
@@ -0,0 +1,204 @@
+#ifndef DEVICE_SESSION_H
+#define DEVICE_SESSION_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
+#include <QPointer>
+#include <QTimer>
+#include <functional>
+#include <memory>
+#include "device_task.h"
+#include "send_queue.h"
+#include "../protocol/device_message.h"
+
+// 设备请求结果
+struct DeviceResult {
+    enum Status {
+        Ok = 0,
+        Timeout,            // 截止时间内未收到应答 / 未写出
+        Cancelled,          // 被取消或会话已销毁
+        Disconnected,       // 连接断开
+        InvalidReply        // 应答载荷解码失败
+    };
+
+    Status status;
+    DeviceMessage message;  // 查询的应答；设置请求为空
+    QString error;
+
+    DeviceResult() : status(Cancelled) {}
+    bool ok() const { return status == Ok; }
+};
+
+// 取消令牌：cancel() 后，使用该令牌且尚未完成的请求立即以 Cancelled 结束
+class DeviceCancelToken
+{
+public:
+    DeviceCancelToken();
+
+    void cancel();
+    bool isCancelled() const;
+    // 使用该令牌且尚未结束的请求数
+    int pendingCount() const;
+
+private:
+    friend class DeviceSession;
+    // 请求结束时按编号移除回调，长期复用的令牌不会积累回调
+    quint64 addCallback(std::function<void()> callback);
+    void removeCallback(quint64 key);
+
+    struct State {
+        bool cancelled = false;
+        quint64 nextKey = 1;
+        QMap<quint64, std::function<void()>> callbacks;
+    };
+    std::shared_ptr<State> m_state;
+};
+
+class DeviceSession;
+
+// 一个待发送的设备请求；co_await 时才写出，多个请求可用 DeviceSession::whenAll 一次写出
+class DeviceRequest
+{
+public:
+    enum Kind {
+        Query,          // 等待同功能码的应答
+        Write           // 等待请求帧写出
+    };
+
+    DeviceRequest withTimeout(int timeoutMs) const;
+    DeviceRequest withCancel(const DeviceCancelToken& token) const;
+    // 发送优先级：查询默认 OneShotQuery，设置默认 ConfigWrite；一组请求按其中最高的优先级写出
+    DeviceRequest withPriority(SendQueue::Priority priority) const;
+
+    // 单个请求的等待体
+    struct Awaiter {
+        DeviceSession* session;
+        QList<DeviceRequest> requests;
+        QList<DeviceResult> results;
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+        DeviceResult await_resume();
+    };
+    Awaiter operator co_await() const;
+
+    // 一组请求的等待体，按请求顺序返回全部结果
+    struct GroupAwaiter : Awaiter {
+        QList<DeviceResult> await_resume() { return results; }
+    };
+
+private:
+    friend class DeviceSession;
+    DeviceRequest()
+        : session(nullptr), kind(Query), replyCode(0), timeoutMs(3000), priority(SendQueue::OneShotQuery) {}
+
+    DeviceSession* session;
+    Kind kind;
+    QByteArray frame;
+    quint16 replyCode;
+    int timeoutMs;
+    SendQueue::Priority priority;
+    DeviceCancelToken token;
+    bool hasToken = false;
+};
+
+/*
+    协程式设备会话（C++20）：
+        DeviceTask<> provision(DeviceSession& dev, QString ip) {
+            DeviceResult written = co_await dev.set(ProtocolFrame::buildIpSetFrame(ip));
+            QList<DeviceResult> replies = co_await dev.whenAll({dev.query(PC_IP_ADDR_QUERY),
+                                                                dev.query(PC_MASK_ADDR_QUERY)});
+            ...
+        }
+    1. 会话挂在一个传输对象（SerialThread、SocketThread 或接口相同的类）上，
+       协程在会话所在线程的事件循环中恢复，不为每个操作创建线程
+    2. 应答按功能码匹配最早的未完成查询，到达顺序不限；whenAll 的请求作为一个批次一次写出
+    3. 每个请求有超时（默认 3000 ms），可附加取消令牌；连接断开时全部以 Disconnected 结束，
+       会话销毁时以 Cancelled 结束
+    4. 多台设备各建一个会话，同时启动多个 DeviceTask 即为并发执行
+ */
+class DeviceSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    template <typename Transport>
+    explicit DeviceSession(Transport* transport, QObject *parent = nullptr)
+        : QObject(parent)
+    {
+        QPointer<Transport> guarded(transport);
+        m_send = [guarded](const QList<QByteArray>& frames, SendQueue::Priority priority) {
+            if (guarded) {
+                guarded->sendBatch(frames, priority);
+            }
+        };
+        connect(transport, &Transport::messageReceived, this, &DeviceSession::onMessageReceived);
+        connect(transport, &Transport::dataSent, this, &DeviceSession::onDataSent);
+        connect(transport, &Transport::connectionStateChanged, this, &DeviceSession::onConnectionStateChanged);
+        initialize(transport->isConnected());
+    }
+    ~DeviceSession();
+
+    // 查询：PC_MAC_ADDR_QUERY、PC_IP_ADDR_QUERY、PC_MASK_ADDR_QUERY、PC_GATEWAY_ADDR_QUERY、
+    // PC_VCU_INFO_GET、PC_HARDFAULT_INFO_GET
+    DeviceRequest query(quint16 functionCode);
+    // 任意请求帧，等待 replyCode 的应答
+    DeviceRequest request(const QByteArray& frame, quint16 replyCode);
+    // 设置帧，写出即完成（需要回读验证时再 co_await 对应查询）
+    DeviceRequest set(const QByteArray& setFrame);
+
+    // 多个请求一次写出，全部结束后按顺序返回结果
+    DeviceRequest::GroupAwaiter whenAll(const QList<DeviceRequest>& requests);
+
+    // 取消全部未完成的请求
+    void cancelAll();
+
+    int pendingCount() const;
+
+private slots:
+    void onMessageReceived(const DeviceMessage& message);
+    void onDataSent(const QByteArray& data);
+    void onConnectionStateChanged(bool connected);
+    void onExpireTick();
+
+private:
+    friend struct DeviceRequest::Awaiter;
+
+    // 同一次 co_await 的请求组，全部结束时恢复协程
+    struct Group {
+        DeviceRequest::Awaiter* awaiter;
+        std::coroutine_handle<> handle;
+        int remaining;
+    };
+
+    struct Waiter {
+        quint64 id;
+        std::shared_ptr<Group> group;
+        int index;                  // 在组内的序号
+        DeviceRequest::Kind kind;
+        quint16 replyCode;
+        QByteArray frame;
+        qint64 deadlineMs;
+        DeviceCancelToken token;
+        quint64 tokenKey;           // 0 表示未使用取消令牌
+    };
+
+    void initialize(bool connected);
+    // 登记并写出一组请求；会话不可用时直接填入结果并返回 false（不挂起）
+    bool submit(DeviceRequest::Awaiter* awaiter, std::coroutine_handle<> handle);
+    void complete(int waiterIndex, DeviceResult::Status status, const DeviceMessage& message, const QString& error);
+    void completeById(quint64 id, DeviceResult::Status status, const QString& error);
+    void failAll(DeviceResult::Status status, const QString& error);
+
+    std::function<void(const QList<QByteArray>&, SendQueue::Priority)> m_send;
+    QList<Waiter> m_waiters;        // 按写出顺序
+    quint64 m_nextId;
+    bool m_connected;
+    bool m_closing;
+    QTimer m_expireTimer;
+    QElapsedTimer m_clock;
+};
+
+#endif // DEVICE_SESSION_H
@@ -0,0 +1,197 @@
+#ifndef DEVICE_TASK_H
+#define DEVICE_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+    设备命令序列的协程返回类型（C++20）
+    1. 立即开始执行，遇到 co_await 设备请求时挂起，应答到达后在会话所在线程的事件循环中恢复
+    2. 可以被另一个协程 co_await，也可以用 then() 注册完成回调后直接丢弃（协程执行完自行释放）
+    3. 多个任务本身就是并发的：先全部启动，再 whenAll() 等待全部结束，不需要额外线程
+    4. 协程内不使用异常，错误通过返回值（DeviceResult 等）传递
+ */
+template <typename T = void>
+class DeviceTask;
+
+namespace DeviceTaskDetail {
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    bool detached = false;          // 任务对象已销毁，协程结束后自行释放
+
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    void unhandled_exception() noexcept { std::terminate(); }
+};
+
+template <typename Promise>
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+    {
+        Promise& promise = handle.promise();
+        promise.notifyDone();
+        if (promise.continuation) {
+            return promise.continuation;
+        }
+        if (promise.detached) {
+            handle.destroy();
+        }
+        return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+template <typename T>
+struct ValuePromise : PromiseBase {
+    std::optional<T> value;
+    std::function<void(const T&)> onDone;
+
+    DeviceTask<T> get_return_object() noexcept;
+    FinalAwaiter<ValuePromise> final_suspend() noexcept { return {}; }
+    void return_value(T result) { value = std::move(result); }
+
+    void notifyDone()
+    {
+        if (onDone) {
+            onDone(*value);
+        }
+    }
+};
+
+struct VoidPromise : PromiseBase {
+    std::function<void()> onDone;
+
+    DeviceTask<void> get_return_object() noexcept;
+    FinalAwaiter<VoidPromise> final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+
+    void notifyDone()
+    {
+        if (onDone) {
+            onDone();
+        }
+    }
+};
+
+} // namespace DeviceTaskDetail
+
+template <typename T>
+class DeviceTask
+{
+public:
+    using promise_type = std::conditional_t<std::is_void_v<T>, DeviceTaskDetail::VoidPromise,
+                                            DeviceTaskDetail::ValuePromise<T>>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    DeviceTask() noexcept = default;
+    explicit DeviceTask(Handle handle) noexcept : m_handle(handle) {}
+    DeviceTask(DeviceTask&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    DeviceTask& operator=(DeviceTask&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+    DeviceTask(const DeviceTask&) = delete;
+    DeviceTask& operator=(const DeviceTask&) = delete;
+
+    ~DeviceTask() { release(); }
+
+    bool isValid() const { return static_cast<bool>(m_handle); }
+    bool isDone() const { return !m_handle || m_handle.done(); }
+
+    // 已完成任务的结果
+    template <typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+    const U& result() const { return *m_handle.promise().value; }
+
+    // 完成回调；已完成时立即调用
+    template <typename Callback>
+    void then(Callback callback)
+    {
+        if (!m_handle) {
+            return;
+        }
+        if (m_handle.done()) {
+            if constexpr (std::is_void_v<T>) {
+                callback();
+            } else {
+                callback(*m_handle.promise().value);
+            }
+            return;
+        }
+        m_handle.promise().onDone = std::move(callback);
+    }
+
+    // 被另一个协程等待
+    bool await_ready() const noexcept { return isDone(); }
+    void await_suspend(std::coroutine_handle<> continuation) noexcept { m_handle.promise().continuation = continuation; }
+    T await_resume()
+    {
+        if constexpr (!std::is_void_v<T>) {
+            return *m_handle.promise().value;
+        }
+    }
+
+private:
+    void release()
+    {
+        if (!m_handle) {
+            return;
+        }
+        // 未完成的任务继续执行，结束时自行释放
+        if (m_handle.done()) {
+            m_handle.destroy();
+        } else {
+            m_handle.promise().detached = true;
+        }
+        m_handle = {};
+    }
+
+    Handle m_handle;
+};
+
+namespace DeviceTaskDetail {
+
+template <typename T>
+DeviceTask<T> ValuePromise<T>::get_return_object() noexcept
+{
+    return DeviceTask<T>(std::coroutine_handle<ValuePromise<T>>::from_promise(*this));
+}
+
+inline DeviceTask<void> VoidPromise::get_return_object() noexcept
+{
+    return DeviceTask<void>(std::coroutine_handle<VoidPromise>::from_promise(*this));
+}
+
+} // namespace DeviceTaskDetail
+
+// 等待一组已启动的任务全部结束，结果按任务顺序排列（任务在启动时已并发执行）
+template <typename T>
+DeviceTask<std::vector<T>> whenAll(std::vector<DeviceTask<T>> tasks)
+{
+    std::vector<T> results;
+    results.reserve(tasks.size());
+    for (DeviceTask<T>& task : tasks) {
+        results.push_back(co_await task);
+    }
+    co_return results;
+}
+
+inline DeviceTask<void> whenAll(std::vector<DeviceTask<void>> tasks)
+{
+    for (DeviceTask<void>& task : tasks) {
+        co_await task;
+    }
+}
+
+#endif // DEVICE_TASK_H
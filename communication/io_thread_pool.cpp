@@ -0,0 +1,130 @@
+#include "io_thread_pool.h"
+#include "../common/log.h"
+#include <QCoreApplication>
+#include <QGlobalStatic>
+#include <QMutexLocker>
+#include <QThread>
+
+Q_GLOBAL_STATIC(IoThreadPool, g_ioThreadPool)
+
+namespace {
+
+// QCoreApplication 析构时调用，此时界面和传输对象已销毁
+void shutdownIoThreadPool()
+{
+    if (g_ioThreadPool.exists()) {
+        g_ioThreadPool()->shutdown();
+    }
+}
+
+int configuredThreadCount()
+{
+    bool ok = false;
+    const int configured = qEnvironmentVariableIntValue("H7_IO_THREADS", &ok);
+    if (ok && configured > 0) {
+        return configured;
+    }
+    return qMax(1, QThread::idealThreadCount());
+}
+
+} // namespace
+
+IoThreadPool::IoThreadPool()
+    : m_maxThreads(configuredThreadCount())
+    , m_stopped(false)
+    , m_postRoutineAdded(false)
+{
+}
+
+IoThreadPool::~IoThreadPool()
+{
+    shutdown();
+}
+
+IoThreadPool* IoThreadPool::instance()
+{
+    return g_ioThreadPool();
+}
+
+QThread* IoThreadPool::acquire()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_stopped) {
+        qCWarning(lcIo) << "I/O线程池已停止";
+        return nullptr;
+    }
+
+    if (!m_postRoutineAdded && QCoreApplication::instance()) {
+        qAddPostRoutine(shutdownIoThreadPool);
+        m_postRoutineAdded = true;
+    }
+
+    // 会话最少的已启动线程
+    int best = -1;
+    for (int i = 0; i < m_loops.size(); ++i) {
+        if (best < 0 || m_loops[i].sessions < m_loops[best].sessions) {
+            best = i;
+        }
+    }
+
+    // 已启动的线程都有会话且未达上限时启动新线程
+    if (best < 0 || (m_loops[best].sessions > 0 && m_loops.size() < m_maxThreads)) {
+        Loop loop;
+        loop.thread = new QThread();
+        loop.thread->setObjectName(QString("I/O事件循环%1").arg(m_loops.size()));
+        loop.sessions = 0;
+        loop.thread->start();
+        m_loops.append(loop);
+        best = m_loops.size() - 1;
+        qCDebug(lcIo) << "启动I/O线程" << best + 1 << "/" << m_maxThreads;
+    }
+
+    m_loops[best].sessions++;
+    return m_loops[best].thread;
+}
+
+void IoThreadPool::release(QThread* thread)
+{
+    QMutexLocker locker(&m_mutex);
+    for (Loop& loop : m_loops) {
+        if (loop.thread == thread) {
+            loop.sessions = qMax(0, loop.sessions - 1);
+            return;
+        }
+    }
+}
+
+void IoThreadPool::shutdown()
+{
+    QVector<Loop> loops;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopped = true;
+        loops.swap(m_loops);
+    }
+
+    // 线程结束前会处理已投递的 deleteLater，工作对象在各自线程中析构
+    for (const Loop& loop : loops) {
+        loop.thread->quit();
+    }
+    for (const Loop& loop : loops) {
+        if (!loop.thread->wait(3000)) {
+            qCWarning(lcIo) << loop.thread->objectName() << "未能正常退出，强制终止";
+            loop.thread->terminate();
+            loop.thread->wait(1000);
+        }
+        delete loop.thread;
+    }
+}
+
+IoThreadPool::Stats IoThreadPool::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    Stats stats;
+    stats.maxThreads = m_maxThreads;
+    stats.startedThreads = m_loops.size();
+    for (const Loop& loop : m_loops) {
+        stats.sessions += loop.sessions;
+    }
+    return stats;
+}
@@ -0,0 +1,64 @@
+#ifndef IO_THREAD_POOL_H
+#define IO_THREAD_POOL_H
+
+#include <QMutex>
+#include <QVector>
+
+class QThread;
+
+/*
+    共享 I/O 事件循环池，串口和Socket工作对象共用
+    1. 线程数固定，默认取CPU核心数，可用环境变量 H7_IO_THREADS 指定
+    2. 线程按需启动：程序启动时不创建线程，第一个工作对象需要时才启动；
+       已启动的线程都有会话时才启动新线程，否则分配到会话最少的线程
+    3. 工作对象在创建时分配线程，之后一直固定在该线程，直到释放
+    4. 同一线程上的会话共用一个事件循环，工作对象中不能有阻塞等待（waitFor* 等）
+    5. QCoreApplication 析构时统一停止，停止前会处理完待删除的工作对象
+ */
+class IoThreadPool
+{
+public:
+    struct Stats {
+        int maxThreads;         // 线程数上限
+        int startedThreads;     // 已启动的线程数
+        int sessions;           // 已分配的会话数
+
+        Stats() {
+            maxThreads = 0;
+            startedThreads = 0;
+            sessions = 0;
+        }
+    };
+
+    IoThreadPool();
+    ~IoThreadPool();
+
+    static IoThreadPool* instance();
+
+    // 为一个会话分配事件循环线程；已停止时返回 nullptr
+    QThread* acquire();
+    // 会话结束后归还（工作对象已 deleteLater）
+    void release(QThread* thread);
+
+    // 停止全部线程，之后 acquire 返回 nullptr
+    void shutdown();
+
+    Stats stats() const;
+
+private:
+    IoThreadPool(const IoThreadPool&) = delete;
+    IoThreadPool& operator=(const IoThreadPool&) = delete;
+
+    struct Loop {
+        QThread* thread;
+        int sessions;
+    };
+
+    mutable QMutex m_mutex;
+    QVector<Loop> m_loops;
+    int m_maxThreads;
+    bool m_stopped;
+    bool m_postRoutineAdded;
+};
+
+#endif // IO_THREAD_POOL_H
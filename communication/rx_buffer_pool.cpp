@@ -0,0 +1,209 @@
+#include "rx_buffer_pool.h"
+#include <QAtomicInt>
+#include <QMutexLocker>
+#include <QGlobalStatic>
+
+// 数据块：引用计数 + 有效长度 + 固定容量的数据区
+struct RxChunk::Block
+{
+    QAtomicInt ref;
+    int size;
+    RxBufferPool* pool;
+    Block* next;
+    char data[RxBufferPool::ChunkSize];
+};
+
+Q_GLOBAL_STATIC(RxBufferPool, g_rxBufferPool)
+
+// ---------------- RxChunk ----------------
+
+RxChunk::RxChunk()
+    : m_block(nullptr)
+{
+}
+
+RxChunk::RxChunk(Block* block)
+    : m_block(block)
+{
+}
+
+RxChunk::RxChunk(const RxChunk& other)
+    : m_block(other.m_block)
+{
+    if (m_block) {
+        m_block->ref.ref();
+    }
+}
+
+RxChunk::RxChunk(RxChunk&& other) noexcept
+    : m_block(other.m_block)
+{
+    other.m_block = nullptr;
+}
+
+RxChunk& RxChunk::operator=(const RxChunk& other)
+{
+    if (m_block != other.m_block) {
+        if (other.m_block) {
+            other.m_block->ref.ref();
+        }
+        release();
+        m_block = other.m_block;
+    }
+    return *this;
+}
+
+RxChunk& RxChunk::operator=(RxChunk&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_block = other.m_block;
+        other.m_block = nullptr;
+    }
+    return *this;
+}
+
+RxChunk::~RxChunk()
+{
+    release();
+}
+
+bool RxChunk::isNull() const
+{
+    return m_block == nullptr;
+}
+
+bool RxChunk::isEmpty() const
+{
+    return m_block == nullptr || m_block->size == 0;
+}
+
+const char* RxChunk::constData() const
+{
+    return m_block ? m_block->data : nullptr;
+}
+
+char* RxChunk::data()
+{
+    return m_block ? m_block->data : nullptr;
+}
+
+int RxChunk::size() const
+{
+    return m_block ? m_block->size : 0;
+}
+
+int RxChunk::capacity() const
+{
+    return m_block ? RxBufferPool::ChunkSize : 0;
+}
+
+void RxChunk::setSize(int size)
+{
+    if (m_block) {
+        m_block->size = qBound(0, size, RxBufferPool::ChunkSize);
+    }
+}
+
+QByteArray RxChunk::rawData() const
+{
+    if (!m_block) {
+        return QByteArray();
+    }
+    return QByteArray::fromRawData(m_block->data, m_block->size);
+}
+
+QByteArray RxChunk::toByteArray() const
+{
+    if (!m_block) {
+        return QByteArray();
+    }
+    return QByteArray(m_block->data, m_block->size);
+}
+
+void RxChunk::release()
+{
+    if (m_block && !m_block->ref.deref()) {
+        m_block->pool->recycle(m_block);
+    }
+    m_block = nullptr;
+}
+
+// ---------------- RxBufferPool ----------------
+
+RxBufferPool::RxBufferPool(int preallocatedChunks)
+    : m_freeList(nullptr)
+{
+    // 预分配数据块，避免首次接收时申请内存
+    for (int i = 0; i < preallocatedChunks; ++i) {
+        RxChunk::Block* block = new RxChunk::Block;
+        block->pool = this;
+        block->next = m_freeList;
+        m_freeList = block;
+        m_stats.totalChunks++;
+        m_stats.freeChunks++;
+    }
+}
+
+RxBufferPool::~RxBufferPool()
+{
+    // 只释放空闲数据块，仍被持有的数据块由持有者负责，正常退出时应已全部归还
+    QMutexLocker locker(&m_mutex);
+    while (m_freeList) {
+        RxChunk::Block* block = m_freeList;
+        m_freeList = block->next;
+        delete block;
+    }
+}
+
+RxBufferPool* RxBufferPool::instance()
+{
+    return g_rxBufferPool();
+}
+
+RxChunk RxBufferPool::acquire()
+{
+    RxChunk::Block* block = nullptr;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stats.acquireCount++;
+
+        if (m_freeList) {
+            block = m_freeList;
+            m_freeList = block->next;
+            m_stats.freeChunks--;
+        } else {
+            // 空闲链表耗尽，新申请的数据块归还后同样进入空闲链表循环使用
+            block = new RxChunk::Block;
+            block->pool = this;
+            m_stats.totalChunks++;
+            m_stats.allocationCount++;
+        }
+
+        m_stats.inUseChunks++;
+        if (m_stats.inUseChunks > m_stats.peakInUseChunks) {
+            m_stats.peakInUseChunks = m_stats.inUseChunks;
+        }
+    }
+
+    block->next = nullptr;
+    block->size = 0;
+    block->ref.storeRelaxed(1);
+    return RxChunk(block);
+}
+
+RxBufferPool::Stats RxBufferPool::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+void RxBufferPool::recycle(RxChunk::Block* block)
+{
+    QMutexLocker locker(&m_mutex);
+    block->next = m_freeList;
+    m_freeList = block;
+    m_stats.freeChunks++;
+    m_stats.inUseChunks--;
+    m_stats.recycleCount++;
+}
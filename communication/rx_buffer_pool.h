@@ -0,0 +1,106 @@
+#ifndef RX_BUFFER_POOL_H
+#define RX_BUFFER_POOL_H
+
+#include <QByteArray>
+#include <QMetaType>
+#include <QMutex>
+
+class RxBufferPool;
+
+// 接收数据块句柄
+// 数据块来自 RxBufferPool，句柄之间拷贝只增加引用计数，不复制数据；
+// 最后一个句柄释放时数据块自动归还缓冲池
+class RxChunk
+{
+public:
+    RxChunk();
+    RxChunk(const RxChunk& other);
+    RxChunk(RxChunk&& other) noexcept;
+    RxChunk& operator=(const RxChunk& other);
+    RxChunk& operator=(RxChunk&& other) noexcept;
+    ~RxChunk();
+
+    bool isNull() const;
+    bool isEmpty() const;
+
+    // 数据访问
+    const char* constData() const;
+    char* data();
+    int size() const;
+    int capacity() const;
+    void setSize(int size);
+
+    // 零拷贝视图：返回的QByteArray直接引用数据块内存，只能在本句柄存活期间使用
+    QByteArray rawData() const;
+
+    // 深拷贝：需要长期保存数据时使用
+    QByteArray toByteArray() const;
+
+private:
+    friend class RxBufferPool;
+
+    struct Block;
+    explicit RxChunk(Block* block);
+    void release();
+
+    Block* m_block;
+};
+
+Q_DECLARE_METATYPE(RxChunk)
+
+// 接收缓冲池
+// 预先分配固定大小的数据块并循环使用，稳态接收时不再向系统申请内存
+class RxBufferPool
+{
+public:
+    // 单个数据块容量
+    static constexpr int ChunkSize = 4096;
+
+    // 缓冲池统计信息
+    struct Stats {
+        qint64 totalChunks;       // 已分配的数据块总数
+        qint64 freeChunks;        // 空闲数据块数
+        qint64 inUseChunks;       // 正在使用的数据块数
+        qint64 peakInUseChunks;   // 同时使用数据块的峰值
+        qint64 acquireCount;      // 申请次数
+        qint64 allocationCount;   // 向系统申请内存的次数（空闲链表为空时）
+        qint64 recycleCount;      // 归还次数
+
+        Stats() {
+            totalChunks = 0;
+            freeChunks = 0;
+            inUseChunks = 0;
+            peakInUseChunks = 0;
+            acquireCount = 0;
+            allocationCount = 0;
+            recycleCount = 0;
+        }
+    };
+
+    explicit RxBufferPool(int preallocatedChunks = 16);
+    ~RxBufferPool();
+
+    // 全局接收缓冲池，串口和Socket共用
+    static RxBufferPool* instance();
+
+    // 申请一个空数据块（size为0，capacity为ChunkSize）
+    RxChunk acquire();
+
+    // 获取统计信息
+    Stats stats() const;
+
+private:
+    friend class RxChunk;
+
+    RxBufferPool(const RxBufferPool&) = delete;
+    RxBufferPool& operator=(const RxBufferPool&) = delete;
+
+    // 数据块归还
+    void recycle(RxChunk::Block* block);
+
+    mutable QMutex m_mutex;
+    RxChunk::Block* m_freeList;
+    Stats m_stats;
+};
+
+#endif // RX_BUFFER_POOL_H
@@ -0,0 +1,157 @@
+#include "send_queue.h"
+#include <QMutexLocker>
+#include <QString>
+#include <cstring>
+
+extern "C" {
+#include "../pc_protocol.h"
+}
+
+SendQueue::SendQueue()
+    : m_highWatermark(16)
+    , m_lowWatermark(4)
+    , m_reportedCongested(false)
+{
+    // 配置写入不能被静默丢弃，队列满时拒绝并由调用方报错
+    setClassLimit(ConfigWrite, 32, Reject);
+    // 单次查询保留最新的请求
+    setClassLimit(OneShotQuery, 64, DropOldest);
+    // 周期轮询只需要最新的几次，积压没有意义
+    setClassLimit(PeriodicPoll, 8, DropOldest);
+}
+
+void SendQueue::setClassLimit(Priority priority, int capacity, OverflowPolicy policy)
+{
+    QMutexLocker locker(&m_mutex);
+    m_stats.capacity[priority] = qMax(1, capacity);
+    m_policies[priority] = policy;
+}
+
+void SendQueue::setWatermarks(int highWatermark, int lowWatermark)
+{
+    QMutexLocker locker(&m_mutex);
+    m_highWatermark = qMax(1, highWatermark);
+    m_lowWatermark = qBound(0, lowWatermark, m_highWatermark - 1);
+    updateCongestion();
+}
+
+SendQueue::EnqueueResult SendQueue::enqueue(const QByteArray& data, Priority priority)
+{
+    QMutexLocker locker(&m_mutex);
+    QQueue<QByteArray>& queue = m_queues[priority];
+    EnqueueResult result = Accepted;
+
+    if (queue.size() >= m_stats.capacity[priority]) {
+        if (m_policies[priority] == Reject) {
+            m_stats.rejected[priority]++;
+            return Rejected;
+        }
+        queue.dequeue();
+        m_stats.dropped[priority]++;
+        m_stats.totalDepth--;
+        result = AcceptedDroppedOldest;
+    }
+
+    queue.enqueue(data);
+    m_stats.enqueued[priority]++;
+    m_stats.totalDepth++;
+    m_stats.depth[priority] = queue.size();
+    updateCongestion();
+    return result;
+}
+
+bool SendQueue::dequeue(QByteArray* data)
+{
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < PriorityCount; ++i) {
+        if (!m_queues[i].isEmpty()) {
+            *data = m_queues[i].dequeue();
+            m_stats.depth[i] = m_queues[i].size();
+            m_stats.totalDepth--;
+            updateCongestion();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SendQueue::isEmpty() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats.totalDepth == 0;
+}
+
+void SendQueue::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < PriorityCount; ++i) {
+        m_queues[i].clear();
+        m_stats.depth[i] = 0;
+    }
+    m_stats.totalDepth = 0;
+    updateCongestion();
+}
+
+SendQueue::Stats SendQueue::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+bool SendQueue::takeCongestionChange(bool* congested)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_reportedCongested == m_stats.congested) {
+        return false;
+    }
+    m_reportedCongested = m_stats.congested;
+    if (congested) {
+        *congested = m_stats.congested;
+    }
+    return true;
+}
+
+SendQueue::Priority SendQueue::priorityForFrame(const QByteArray& frameData)
+{
+    if (frameData.size() < static_cast<int>(sizeof(pc_comm_protocol__head_t))) {
+        return OneShotQuery;
+    }
+
+    pc_comm_protocol__head_t header;
+    memcpy(&header, frameData.constData(), sizeof(header));
+
+    switch (header.function_code) {
+    case PC_MAC_ADDR_SET:
+    case PC_IP_ADDR_SET:
+    case PC_MASK_ADDR_SET:
+    case PC_GATEWAY_ADDR_SET:
+    case PC_VCU_PARAM_SET:
+        return ConfigWrite;
+    default:
+        return OneShotQuery;
+    }
+}
+
+QString SendQueue::priorityName(Priority priority)
+{
+    switch (priority) {
+    case ConfigWrite:
+        return "配置写入";
+    case OneShotQuery:
+        return "单次查询";
+    case PeriodicPoll:
+        return "周期轮询";
+    default:
+        return "未知";
+    }
+}
+
+void SendQueue::updateCongestion()
+{
+    // 调用方已持有 m_mutex
+    if (!m_stats.congested && m_stats.totalDepth >= m_highWatermark) {
+        m_stats.congested = true;
+    } else if (m_stats.congested && m_stats.totalDepth <= m_lowWatermark) {
+        m_stats.congested = false;
+    }
+}
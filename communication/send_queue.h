@@ -0,0 +1,103 @@
+#ifndef SEND_QUEUE_H
+#define SEND_QUEUE_H
+
+#include <QByteArray>
+#include <QMetaType>
+#include <QMutex>
+#include <QString>
+#include <QQueue>
+
+// 有界发送队列
+// 按优先级分类排队：配置写入 > 单次查询 > 周期轮询，每类有独立容量和溢出策略；
+// 队列总深度超过高水位时进入拥塞状态，周期轮询方应降低频率，降到低水位以下解除
+class SendQueue
+{
+public:
+    // 优先级分类，数值越小优先级越高
+    enum Priority {
+        ConfigWrite = 0,      // 配置写入（IP、掩码、网关、MAC、VCU参数）
+        OneShotQuery = 1,     // 单次查询（用户点击读取/查询）
+        PeriodicPoll = 2,     // 周期轮询
+        PriorityCount = 3
+    };
+
+    // 队列满时的处理策略
+    enum OverflowPolicy {
+        DropOldest = 0,       // 丢弃该类中最早的一帧，新帧入队
+        Reject = 1            // 拒绝新帧
+    };
+
+    // 入队结果
+    enum EnqueueResult {
+        Accepted = 0,
+        AcceptedDroppedOldest = 1,
+        Rejected = 2
+    };
+
+    // 队列统计信息
+    struct Stats {
+        int depth[PriorityCount];         // 各类当前深度
+        int capacity[PriorityCount];      // 各类容量
+        qint64 enqueued[PriorityCount];   // 各类累计入队数
+        qint64 dropped[PriorityCount];    // 各类因 DropOldest 丢弃的帧数
+        qint64 rejected[PriorityCount];   // 各类因 Reject 拒绝的帧数
+        int totalDepth;                   // 总深度
+        bool congested;                   // 是否处于拥塞（背压）状态
+
+        Stats() {
+            for (int i = 0; i < PriorityCount; ++i) {
+                depth[i] = 0;
+                capacity[i] = 0;
+                enqueued[i] = 0;
+                dropped[i] = 0;
+                rejected[i] = 0;
+            }
+            totalDepth = 0;
+            congested = false;
+        }
+    };
+
+    SendQueue();
+
+    // 配置某一类的容量和溢出策略
+    void setClassLimit(Priority priority, int capacity, OverflowPolicy policy);
+
+    // 配置背压高低水位（按总深度）
+    void setWatermarks(int highWatermark, int lowWatermark);
+
+    // 入队
+    EnqueueResult enqueue(const QByteArray& data, Priority priority);
+
+    // 按优先级出队，队列为空时返回 false
+    bool dequeue(QByteArray* data);
+
+    bool isEmpty() const;
+    void clear();
+
+    // 获取统计信息
+    Stats stats() const;
+
+    // 检查拥塞状态是否发生变化；变化时返回 true 并通过 congested 返回当前状态
+    bool takeCongestionChange(bool* congested);
+
+    // 根据帧功能码判断默认优先级：设置类为 ConfigWrite，其余为 OneShotQuery
+    static Priority priorityForFrame(const QByteArray& frameData);
+
+    // 优先级名称（用于显示）
+    static QString priorityName(Priority priority);
+
+private:
+    void updateCongestion();
+
+    mutable QMutex m_mutex;
+    QQueue<QByteArray> m_queues[PriorityCount];
+    OverflowPolicy m_policies[PriorityCount];
+    Stats m_stats;
+    int m_highWatermark;
+    int m_lowWatermark;
+    bool m_reportedCongested;
+};
+
+Q_DECLARE_METATYPE(SendQueue::Stats)
+
+#endif // SEND_QUEUE_H
@@ -1,13 +1,20 @@
 #include "serial_thread.h"
-#include <QDebug>
+#include "io_thread_pool.h"
+#include "../common/log.h"
+#include "../protocol/protocol_frame.h"
 
 SerialThread::SerialThread(QObject *parent)
     : QObject(parent)
     , m_workerThread(nullptr)
     , m_worker(nullptr)
     , m_connected(false)
+    , m_hasAlarmRules(false)
 {
-    setupWorker();
+    // 工作对象在第一次打开时才创建，并分配到共享I/O线程池
+    qRegisterMetaType<RxChunk>("RxChunk");
+    qRegisterMetaType<DeviceMessage>("DeviceMessage");
+    qRegisterMetaType<AlarmEvent>("AlarmEvent");
+    qRegisterMetaType<QList<AlarmRule>>("QList<AlarmRule>");
 }
 
 SerialThread::~SerialThread()
@@ -17,8 +24,8 @@ SerialThread::~SerialThread()
 
 bool SerialThread::openSerial(const SerialConfig& config)
 {
-    if (!m_worker) {
-        qWarning() << "Worker not initialized";
+    if (!setupWorker()) {
+        emit errorOccurred("I/O线程池已停止");
         return false;
     }
     
@@ -46,16 +53,43 @@ bool SerialThread::isConnected() const
     return m_connected;
 }
 
-void SerialThread::sendData(const QByteArray& data)
+void SerialThread::sendData(const QByteArray& data, SendQueue::Priority priority)
 {
     if (!m_worker) {
-        emit errorOccurred("Worker not initialized");
+        emit errorOccurred("串口未连接，无法发送数据");
         return;
     }
     
     QMetaObject::invokeMethod(m_worker, "sendData", 
                              Qt::QueuedConnection,
-                             Q_ARG(QByteArray, data));
+                             Q_ARG(QByteArray, data),
+                             Q_ARG(int, static_cast<int>(priority)));
+}
+
+void SerialThread::sendBatch(const QList<QByteArray>& frames, SendQueue::Priority priority)
+{
+    if (frames.isEmpty()) {
+        return;
+    }
+    sendData(ProtocolFrame::joinFrames(frames), priority);
+}
+
+void SerialThread::setAlarmRules(const QList<AlarmRule>& rules)
+{
+    // 工作对象尚未创建时先保存，创建后再下发
+    m_alarmRules = rules;
+    m_hasAlarmRules = true;
+    if (m_worker) {
+        QMetaObject::invokeMethod(m_worker, "setAlarmRules",
+                                 Qt::QueuedConnection,
+                                 Q_ARG(QList<AlarmRule>, rules));
+    }
+}
+
+SendQueue::Stats SerialThread::sendQueueStats() const
+{
+    // SendQueue 内部加锁，可在界面线程直接读取
+    return m_worker ? m_worker->sendQueueStats() : SendQueue::Stats();
 }
 
 QStringList SerialThread::getAvailablePorts()
@@ -68,64 +102,67 @@ SerialThread::SerialConfig SerialThread::getCurrentConfig() const
     return m_config;
 }
 
-void SerialThread::setupWorker()
+bool SerialThread::setupWorker()
 {
-    // 创建工作线程
-    m_workerThread = new QThread(this);
+    if (m_worker) {
+        return true;
+    }
+    
+    // 从共享I/O线程池分配事件循环，会话固定在该线程直到销毁
+    m_workerThread = IoThreadPool::instance()->acquire();
+    if (!m_workerThread) {
+        return false;
+    }
     
     // 创建 Worker 对象（无父对象）
     m_worker = new SerialWorker();
     
-    // 将 Worker 移动到工作线程
+    // 将 Worker 移动到分配的线程
     m_worker->moveToThread(m_workerThread);
     
     // 连接 Worker 信号到本对象的信号（转发）
     connect(m_worker, &SerialWorker::dataReceived,
             this, &SerialThread::dataReceived);
+    connect(m_worker, &SerialWorker::messageReceived,
+            this, &SerialThread::messageReceived);
+    connect(m_worker, &SerialWorker::alarmChanged,
+            this, &SerialThread::alarmChanged);
     connect(m_worker, &SerialWorker::connectionStateChanged,
             this, &SerialThread::connectionStateChanged);
     connect(m_worker, &SerialWorker::errorOccurred,
             this, &SerialThread::errorOccurred);
     connect(m_worker, &SerialWorker::dataSent,
             this, &SerialThread::dataSent);
+    connect(m_worker, &SerialWorker::backpressureChanged,
+            this, &SerialThread::backpressureChanged);
     connect(m_worker, &SerialWorker::openResult,
             this, &SerialThread::onWorkerOpenResult);
     
-    // 连接线程启动信号到 Worker 初始化
-    connect(m_workerThread, &QThread::started,
-            m_worker, &SerialWorker::initialize);
-    
-    // 连接线程结束信号到 Worker 清理
-    connect(m_workerThread, &QThread::finished,
-            m_worker, &SerialWorker::cleanup);
-    connect(m_workerThread, &QThread::finished,
-            m_worker, &SerialWorker::deleteLater);
-    
-    // 启动工作线程
-    m_workerThread->start();
+    // 在分配的线程中初始化，之后的调用按投递顺序执行
+    QMetaObject::invokeMethod(m_worker, "initialize", Qt::QueuedConnection);
+    if (m_hasAlarmRules) {
+        QMetaObject::invokeMethod(m_worker, "setAlarmRules",
+                                 Qt::QueuedConnection,
+                                 Q_ARG(QList<AlarmRule>, m_alarmRules));
+    }
     
-    qDebug() << "串口线程系统已初始化";
+    qCDebug(lcSerial) << "串口工作对象已创建于" << m_workerThread->objectName();
+    return true;
 }
 
 void SerialThread::cleanupWorker()
 {
-    if (m_workerThread) {
-        // 停止工作线程
-        m_workerThread->quit();
-        if (!m_workerThread->wait(3000)) {
-            qWarning() << "串口工作线程未能正常退出，强制终止";
-            m_workerThread->terminate();
-            m_workerThread->wait(1000);
-        }
+    if (m_worker) {
+        // 在所属线程中析构（析构时关闭连接），线程继续为其他会话服务
+        disconnect(m_worker, nullptr, this, nullptr);
+        m_worker->deleteLater();
+        m_worker = nullptr;
         
-        m_workerThread->deleteLater();
+        IoThreadPool::instance()->release(m_workerThread);
         m_workerThread = nullptr;
+        
+        qCDebug(lcSerial) << "串口工作对象已释放";
     }
-    
-    // Worker 对象会通过 deleteLater 自动清理
-    m_worker = nullptr;
-    
-    qDebug() << "串口线程系统已清理";
 }
 
 void SerialThread::onWorkerOpenResult(bool success, const QString& message)
@@ -134,5 +171,5 @@ void SerialThread::onWorkerOpenResult(bool success, const QString& message)
     if (!success) {
         emit errorOccurred(message);
     }
-    qDebug() << "串口打开结果:" << (success ? "成功" : "失败") << message;
+    qCDebug(lcSerial) << "串口打开结果:" << (success ? "成功" : "失败") << message;
 } 
\ No newline at end of file
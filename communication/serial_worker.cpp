@@ -1,5 +1,7 @@
 #include "serial_worker.h"
-#include <QDebug>
+#include "../common/log.h"
+#include "../common/trace_recorder.h"
+#include "../protocol/protocol_frame.h"
 #include <QSerialPortInfo>
 
 SerialWorker::SerialWorker(QObject *parent)
@@ -7,7 +9,12 @@ SerialWorker::SerialWorker(QObject *parent)
     , m_serialPort(nullptr)
     , m_connected(false)
     , m_sendTimer(nullptr)
+    , m_writingBytes(0)
+    , m_writeStartNs(-1)
+    , m_abandonedBytes(0)
+    , m_metrics("serial")
 {
+    m_alarmEngine.setRules(AlarmEngine::defaultRules());
 }
 
 SerialWorker::~SerialWorker()
@@ -55,12 +62,15 @@ void SerialWorker::openSerial(const SerialConfig& config)
     // 连接信号槽
     connect(m_serialPort, &QSerialPort::readyRead, 
             this, &SerialWorker::handleReadyRead);
+    connect(m_serialPort, &QSerialPort::bytesWritten,
+            this, &SerialWorker::handleBytesWritten);
     connect(m_serialPort, QOverload<QSerialPort::SerialPortError>::of(&QSerialPort::errorOccurred),
             this, &SerialWorker::handleErrorOccurred);
     
     // 尝试打开串口
     if (m_serialPort->open(QIODevice::ReadWrite)) {
         m_connected = true;
+        m_metrics.connectionChanged(true);
         emit connectionStateChanged(true);
         
         // 启动发送定时器
@@ -68,13 +78,13 @@ void SerialWorker::openSerial(const SerialConfig& config)
             m_sendTimer->start();
         }
         
-        qDebug() << "串口打开成功:" << config.portName;
+        qCDebug(lcSerial) << "串口打开成功:" << config.portName;
         emit openResult(true, QString("串口打开成功: %1").arg(config.portName));
     } else {
         QString errorMsg = QString("无法打开串口 %1: %2")
                           .arg(config.portName)
                           .arg(m_serialPort->errorString());
-        qWarning() << errorMsg;
+        qCWarning(lcSerial) << errorMsg;
         emit errorOccurred(errorMsg);
         emit openResult(false, errorMsg);
         
@@ -94,24 +104,47 @@ void SerialWorker::closeSerial()
         
         // 关闭串口
         m_serialPort->close();
+        m_metrics.connectionChanged(false);
         emit connectionStateChanged(false);
         
-        qDebug() << "串口已关闭:" << m_config.portName;
+        qCDebug(lcSerial) << "串口已关闭:" << m_config.portName;
     }
     
     cleanupSerial();
 }
 
-void SerialWorker::sendData(const QByteArray& data)
+void SerialWorker::sendData(const QByteArray& data, int priority)
 {
+    H7_SPAN("io", "enqueue");
     if (!m_connected || !m_serialPort || !m_serialPort->isOpen()) {
         emit errorOccurred("串口未连接，无法发送数据");
         return;
     }
     
-    // 将数据加入发送队列
-    QMutexLocker locker(&m_sendMutex);
-    m_sendQueue.enqueue(data);
+    // 将数据按优先级加入发送队列
+    SendQueue::Priority sendPriority = static_cast<SendQueue::Priority>(
+        qBound(0, priority, static_cast<int>(SendQueue::PriorityCount) - 1));
+    SendQueue::EnqueueResult result = m_sendQueue.enqueue(data, sendPriority);
+    if (result == SendQueue::Rejected) {
+        qCWarning(lcSerial) << "发送队列已满，拒绝" << SendQueue::priorityName(sendPriority) << "帧";
+        emit errorOccurred(QString("发送队列已满，%1命令被拒绝").arg(SendQueue::priorityName(sendPriority)));
+    } else if (result == SendQueue::AcceptedDroppedOldest) {
+        qCDebug(lcSerial) << "发送队列已满，丢弃最早的" << SendQueue::priorityName(sendPriority) << "帧";
+    }
+    
+    notifyBackpressure();
+}
+
+void SerialWorker::setAlarmRules(const QList<AlarmRule>& rules)
+{
+    if (!m_alarmEngine.setRules(rules)) {
+        emit errorOccurred(m_alarmEngine.lastError());
+    }
+}
+
+SendQueue::Stats SerialWorker::sendQueueStats() const
+{
+    return m_sendQueue.stats();
 }
 
 QStringList SerialWorker::getAvailablePorts()
@@ -128,14 +161,38 @@ QStringList SerialWorker::getAvailablePorts()
 
 void SerialWorker::handleReadyRead()
 {
+    H7_SPAN("io", "readyRead");
     if (!m_serialPort) {
         return;
     }
     
-    QByteArray data = m_serialPort->readAll();
-    if (!data.isEmpty()) {
-        qDebug() << "串口接收数据:" << data.toHex(' ');
-        emit dataReceived(data);
+    // 直接读入缓冲池数据块，数据块通过引用计数传递给下游，不再逐次申请内存
+    while (m_serialPort->bytesAvailable() > 0) {
+        RxChunk chunk = RxBufferPool::instance()->acquire();
+        qint64 bytesRead = m_serialPort->read(chunk.data(), chunk.capacity());
+        if (bytesRead <= 0) {
+            break;
+        }
+        chunk.setSize(static_cast<int>(bytesRead));
+        m_metrics.bytesReceived(bytesRead);
+        
+        H7_TRACE(lcSerialTrace) << "串口接收数据:" << hexDump(chunk.constData(), chunk.size());
+        emit dataReceived(chunk);
+        
+        // 在工作线程中完成帧重组、校验和解码
+        QVector<DeviceMessage> messages = m_framePipeline.feed(chunk.constData(), chunk.size());
+        m_metrics.framesReceived(messages, m_framePipeline.stats());
+        for (DeviceMessage& message : messages) {
+            message.traceEmitNs = H7_SPAN_NOW();
+            emit messageReceived(message);
+            
+            if (message.type == DeviceMessage::VcuInfo) {
+                const QVector<AlarmEvent> alarms = m_alarmEngine.evaluate(*message.vcuInfo);
+                for (const AlarmEvent& alarm : alarms) {
+                    emit alarmChanged(alarm);
+                }
+            }
+        }
     }
 }
 
@@ -176,7 +233,7 @@ void SerialWorker::handleErrorOccurred(QSerialPort::SerialPortError error)
         break;
     }
     
-    qWarning() << "串口错误:" << errorString;
+    qCWarning(lcSerial) << "串口错误:" << errorString;
     emit errorOccurred(errorString);
     
     // 严重错误时断开连接
@@ -192,29 +249,72 @@ void SerialWorker::processSendQueue()
         return;
     }
     
-    QMutexLocker locker(&m_sendMutex);
+    // 上一次写入尚未完成时不写新数据；超时后放弃等待，继续发送后续数据
+    if (m_writingBytes > 0) {
+        if (!m_writeClock.hasExpired(WriteTimeoutMs)) {
+            return;
+        }
+        qCWarning(lcSerial) << "串口发送数据超时";
+        emit errorOccurred("数据发送超时");
+        m_abandonedBytes += m_writingBytes;
+        m_writing.clear();
+        m_writingBytes = 0;
+    }
     
-    while (!m_sendQueue.isEmpty()) {
-        QByteArray data = m_sendQueue.dequeue();
-        locker.unlock();
-        
+    QByteArray data;
+    while (m_writingBytes == 0 && m_sendQueue.dequeue(&data)) {
         // 发送数据
-        qint64 bytesWritten = m_serialPort->write(data);
+        qint64 bytesWritten;
+        m_writeStartNs = H7_SPAN_NOW();
+        {
+            H7_SPAN("io", "write");
+            bytesWritten = m_serialPort->write(data);
+        }
         if (bytesWritten == data.size()) {
-            if (m_serialPort->waitForBytesWritten(1000)) {
-                qDebug() << "串口发送数据成功:" << data.toHex(' ');
-                emit dataSent(data);
-            } else {
-                qWarning() << "串口发送数据超时";
-                emit errorOccurred("数据发送超时");
-            }
+            // 不阻塞等待写出，写完后由 bytesWritten 信号确认（同一事件循环上还有其他会话）
+            m_writing = data;
+            m_writingBytes = bytesWritten;
+            m_writeClock.start();
         } else {
-            qWarning() << "串口数据发送不完整";
+            qCWarning(lcSerial) << "串口数据发送不完整";
             emit errorOccurred("数据发送不完整");
         }
-        
-        locker.relock();
     }
+    
+    notifyBackpressure();
+}
+
+void SerialWorker::handleBytesWritten(qint64 bytes)
+{
+    // 先抵扣超时放弃的写入迟到的确认
+    if (m_abandonedBytes > 0) {
+        const qint64 stale = qMin(bytes, m_abandonedBytes);
+        m_abandonedBytes -= stale;
+        bytes -= stale;
+    }
+    if (m_writingBytes <= 0 || bytes <= 0) {
+        return;
+    }
+    m_writingBytes -= bytes;
+    if (m_writingBytes > 0) {
+        return;
+    }
+    m_writingBytes = 0;
+    // 写入到全部写出确认的耗时
+    H7_SPAN_SINCE("io", "bytesWritten", m_writeStartNs);
+    
+    const QByteArray data = m_writing;
+    m_writing.clear();
+    H7_TRACE(lcSerialTrace) << "串口发送数据成功:" << hexDump(data);
+    // 批量写出的多帧逐帧上报，便于按帧匹配和统计
+    const QList<QByteArray> frames = ProtocolFrame::splitFrames(data);
+    for (const QByteArray& frame : frames) {
+        m_metrics.frameSent(frame);
+        emit dataSent(frame);
+    }
+    
+    // 队列中还有数据时立即继续，不等下一次定时器
+    processSendQueue();
 }
 
 void SerialWorker::cleanupSerial()
@@ -224,7 +324,25 @@ void SerialWorker::cleanupSerial()
         m_serialPort = nullptr;
     }
     
-    // 清空发送队列
-    QMutexLocker locker(&m_sendMutex);
+    // 丢弃未完成的帧
+    m_framePipeline.reset();
+    m_metrics.connectionReset();
+    
+    // 清空发送队列和未确认的写入
     m_sendQueue.clear();
+    m_writing.clear();
+    m_writingBytes = 0;
+    m_abandonedBytes = 0;
+    notifyBackpressure();
+}
+
+void SerialWorker::notifyBackpressure()
+{
+    m_metrics.sendQueueChanged(m_sendQueue.stats());
+    
+    bool congested = false;
+    if (m_sendQueue.takeCongestionChange(&congested)) {
+        qCDebug(lcSerial) << "发送队列" << (congested ? "拥塞" : "恢复") << m_sendQueue.stats().totalDepth;
+        emit backpressureChanged(congested);
+    }
 } 
\ No newline at end of file
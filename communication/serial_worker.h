@@ -5,9 +5,13 @@
 #include <QSerialPort>
 #include <QSerialPortInfo>
 #include <QByteArray>
-#include <QMutex>
-#include <QQueue>
 #include <QTimer>
+#include <QElapsedTimer>
+#include "rx_buffer_pool.h"
+#include "send_queue.h"
+#include "transport_metrics.h"
+#include "../protocol/frame_pipeline.h"
+#include "../telemetry/alarm_engine.h"
 
 class SerialWorker : public QObject
 {
@@ -38,12 +42,18 @@ public:
 
     // 获取可用串口列表
     static QStringList getAvailablePorts();
+    
+    // 获取发送队列统计（线程安全）
+    SendQueue::Stats sendQueueStats() const;
 
 public slots:
     // 串口控制槽函数
     void openSerial(const SerialConfig& config);
     void closeSerial();
-    void sendData(const QByteArray& data);
+    void sendData(const QByteArray& data, int priority = SendQueue::OneShotQuery);
+    
+    // 替换报警规则
+    void setAlarmRules(const QList<AlarmRule>& rules);
     
     // 初始化和清理
     void initialize();
@@ -51,7 +61,13 @@ public slots:
 
 signals:
     // 数据接收信号
-    void dataReceived(const QByteArray& data);
+    void dataReceived(const RxChunk& chunk);
+    
+    // 解码后的设备消息信号
+    void messageReceived(const DeviceMessage& message);
+    
+    // 报警状态变化信号（触发和解除）
+    void alarmChanged(const AlarmEvent& event);
     
     // 连接状态改变信号
     void connectionStateChanged(bool connected);
@@ -62,6 +78,9 @@ signals:
     // 数据发送完成信号
     void dataSent(const QByteArray& data);
     
+    // 发送队列背压信号：congested 为 true 时周期轮询应降低频率
+    void backpressureChanged(bool congested);
+    
     // 操作结果信号
     void openResult(bool success, const QString& message);
 
@@ -69,21 +88,40 @@ private slots:
     void handleReadyRead();
     void handleErrorOccurred(QSerialPort::SerialPortError error);
     void processSendQueue();
+    void handleBytesWritten(qint64 bytes);
 
 private:
     QSerialPort* m_serialPort;
     SerialConfig m_config;
     bool m_connected;
     
-    // 发送队列
-    QQueue<QByteArray> m_sendQueue;
-    QMutex m_sendMutex;
+    // 接收帧处理流水线
+    FramePipeline m_framePipeline;
+    
+    // 报警规则引擎，对解码后的VCU采样增量评估
+    AlarmEngine m_alarmEngine;
+    
+    // 发送队列（按优先级分类，有界）
+    SendQueue m_sendQueue;
     
     // 发送处理定时器
     QTimer* m_sendTimer;
     
+    // 已写入、等待 bytesWritten 确认的数据（同一时刻最多一项）
+    static constexpr int WriteTimeoutMs = 1000;
+    QByteArray m_writing;
+    qint64 m_writingBytes;
+    QElapsedTimer m_writeClock;
+    qint64 m_writeStartNs;          // 性能跟踪：写入时刻，未记录时为 -1
+    // 超时放弃的写入中尚未确认的字节数；其迟到的 bytesWritten 先抵扣这部分，不算到后续写入上
+    qint64 m_abandonedBytes;
+    
+    // 收发与协议指标
+    TransportMetrics m_metrics;
+    
     // 内部方法
     void cleanupSerial();
+    void notifyBackpressure();
 };
 
 #endif // SERIAL_WORKER_H 
\ No newline at end of file
@@ -1,13 +1,20 @@
 #include "socket_thread.h"
-#include <QDebug>
+#include "io_thread_pool.h"
+#include "../common/log.h"
+#include "../protocol/protocol_frame.h"
 
 SocketThread::SocketThread(QObject *parent)
     : QObject(parent)
     , m_workerThread(nullptr)
     , m_worker(nullptr)
     , m_connected(false)
+    , m_hasAlarmRules(false)
 {
-    setupWorker();
+    // 工作对象在第一次打开时才创建，并分配到共享I/O线程池
+    qRegisterMetaType<RxChunk>("RxChunk");
+    qRegisterMetaType<DeviceMessage>("DeviceMessage");
+    qRegisterMetaType<AlarmEvent>("AlarmEvent");
+    qRegisterMetaType<QList<AlarmRule>>("QList<AlarmRule>");
 }
 
 SocketThread::~SocketThread()
@@ -17,8 +24,8 @@ SocketThread::~SocketThread()
 
 bool SocketThread::connectToHost(const SocketConfig& config)
 {
-    if (!m_worker) {
-        qWarning() << "Socket Worker not initialized";
+    if (!setupWorker()) {
+        emit errorOccurred("I/O线程池已停止");
         return false;
     }
     
@@ -45,16 +52,43 @@ bool SocketThread::isConnected() const
     return m_connected;
 }
 
-void SocketThread::sendData(const QByteArray& data)
+void SocketThread::sendData(const QByteArray& data, SendQueue::Priority priority)
 {
     if (!m_worker) {
-        emit errorOccurred("Socket Worker not initialized");
+        emit errorOccurred("Socket未连接，无法发送数据");
         return;
     }
     
     QMetaObject::invokeMethod(m_worker, "sendData", 
                              Qt::QueuedConnection,
-                             Q_ARG(QByteArray, data));
+                             Q_ARG(QByteArray, data),
+                             Q_ARG(int, static_cast<int>(priority)));
+}
+
+void SocketThread::sendBatch(const QList<QByteArray>& frames, SendQueue::Priority priority)
+{
+    if (frames.isEmpty()) {
+        return;
+    }
+    sendData(ProtocolFrame::joinFrames(frames), priority);
+}
+
+void SocketThread::setAlarmRules(const QList<AlarmRule>& rules)
+{
+    // 工作对象尚未创建时先保存，创建后再下发
+    m_alarmRules = rules;
+    m_hasAlarmRules = true;
+    if (m_worker) {
+        QMetaObject::invokeMethod(m_worker, "setAlarmRules",
+                                 Qt::QueuedConnection,
+                                 Q_ARG(QList<AlarmRule>, rules));
+    }
+}
+
+SendQueue::Stats SocketThread::sendQueueStats() const
+{
+    // SendQueue 内部加锁，可在界面线程直接读取
+    return m_worker ? m_worker->sendQueueStats() : SendQueue::Stats();
 }
 
 SocketThread::SocketConfig SocketThread::getCurrentConfig() const
@@ -71,26 +105,39 @@ QString SocketThread::getConnectionInfo() const
     return "未连接";
 }
 
-void SocketThread::setupWorker()
+bool SocketThread::setupWorker()
 {
-    // 创建工作线程
-    m_workerThread = new QThread(this);
+    if (m_worker) {
+        return true;
+    }
+    
+    // 从共享I/O线程池分配事件循环，会话固定在该线程直到销毁
+    m_workerThread = IoThreadPool::instance()->acquire();
+    if (!m_workerThread) {
+        return false;
+    }
     
     // 创建 Worker 对象（无父对象）
     m_worker = new SocketWorker();
     
-    // 将 Worker 移动到工作线程
+    // 将 Worker 移动到分配的线程
     m_worker->moveToThread(m_workerThread);
     
     // 连接 Worker 信号到本对象的信号（转发）
     connect(m_worker, &SocketWorker::dataReceived,
             this, &SocketThread::dataReceived);
+    connect(m_worker, &SocketWorker::messageReceived,
+            this, &SocketThread::messageReceived);
+    connect(m_worker, &SocketWorker::alarmChanged,
+            this, &SocketThread::alarmChanged);
     connect(m_worker, &SocketWorker::connectionStateChanged,
             this, &SocketThread::connectionStateChanged);
     connect(m_worker, &SocketWorker::errorOccurred,
             this, &SocketThread::errorOccurred);
     connect(m_worker, &SocketWorker::dataSent,
             this, &SocketThread::dataSent);
+    connect(m_worker, &SocketWorker::backpressureChanged,
+            this, &SocketThread::backpressureChanged);
     connect(m_worker, &SocketWorker::connected,
             this, &SocketThread::connected);
     connect(m_worker, &SocketWorker::disconnected,
@@ -98,41 +145,31 @@ void SocketThread::setupWorker()
     connect(m_worker, &SocketWorker::connectResult,
             this, &SocketThread::onWorkerConnectResult);
     
-    // 连接线程启动信号到 Worker 初始化
-    connect(m_workerThread, &QThread::started,
-            m_worker, &SocketWorker::initialize);
-    
-    // 连接线程结束信号到 Worker 清理
-    connect(m_workerThread, &QThread::finished,
-            m_worker, &SocketWorker::cleanup);
-    connect(m_workerThread, &QThread::finished,
-            m_worker, &SocketWorker::deleteLater);
-    
-    // 启动工作线程
-    m_workerThread->start();
+    // 在分配的线程中初始化，之后的调用按投递顺序执行
+    QMetaObject::invokeMethod(m_worker, "initialize", Qt::QueuedConnection);
+    if (m_hasAlarmRules) {
+        QMetaObject::invokeMethod(m_worker, "setAlarmRules",
+                                 Qt::QueuedConnection,
+                                 Q_ARG(QList<AlarmRule>, m_alarmRules));
+    }
     
-    qDebug() << "Socket线程系统已初始化";
+    qCDebug(lcSocket) << "Socket工作对象已创建于" << m_workerThread->objectName();
+    return true;
 }
 
 void SocketThread::cleanupWorker()
 {
-    if (m_workerThread) {
-        // 停止工作线程
-        m_workerThread->quit();
-        if (!m_workerThread->wait(3000)) {
-            qWarning() << "Socket工作线程未能正常退出，强制终止";
-            m_workerThread->terminate();
-            m_workerThread->wait(1000);
-        }
+    if (m_worker) {
+        // 在所属线程中析构（析构时关闭连接），线程继续为其他会话服务
+        disconnect(m_worker, nullptr, this, nullptr);
+        m_worker->deleteLater();
+        m_worker = nullptr;
         
-        m_workerThread->deleteLater();
+        IoThreadPool::instance()->release(m_workerThread);
         m_workerThread = nullptr;
+        
+        qCDebug(lcSocket) << "Socket工作对象已释放";
     }
-    
-    // Worker 对象会通过 deleteLater 自动清理
-    m_worker = nullptr;
-    
-    qDebug() << "Socket线程系统已清理";
 }
 
 void SocketThread::onWorkerConnectResult(bool success, const QString& message)
@@ -141,5 +178,5 @@ void SocketThread::onWorkerConnectResult(bool success, const QString& message)
     if (!success) {
         emit errorOccurred(message);
     }
-    qDebug() << "Socket连接结果:" << (success ? "成功" : "失败") << message;
+    qCDebug(lcSocket) << "Socket连接结果:" << (success ? "成功" : "失败") << message;
 } 
\ No newline at end of file
@@ -22,8 +22,17 @@ public:
     void disconnectFromHost();
     bool isConnected() const;
     
-    // 数据发送
-    void sendData(const QByteArray& data);
+    // 数据发送（按优先级进入工作线程的发送队列）
+    void sendData(const QByteArray& data, SendQueue::Priority priority = SendQueue::OneShotQuery);
+    
+    // 批量发送：多帧作为一个队列项一次写出，应答仍按帧到达
+    void sendBatch(const QList<QByteArray>& frames, SendQueue::Priority priority = SendQueue::OneShotQuery);
+    
+    // 获取发送队列统计
+    SendQueue::Stats sendQueueStats() const;
+    
+    // 替换报警规则（在工作线程中编译）
+    void setAlarmRules(const QList<AlarmRule>& rules);
     
     // 获取当前配置
     SocketConfig getCurrentConfig() const;
@@ -33,7 +42,13 @@ public:
 
 signals:
     // 数据接收信号
-    void dataReceived(const QByteArray& data);
+    void dataReceived(const RxChunk& chunk);
+    
+    // 解码后的设备消息信号
+    void messageReceived(const DeviceMessage& message);
+    
+    // 报警状态变化信号（触发和解除）
+    void alarmChanged(const AlarmEvent& event);
     
     // 连接状态改变信号
     void connectionStateChanged(bool connected);
@@ -44,6 +59,9 @@ signals:
     // 数据发送完成信号
     void dataSent(const QByteArray& data);
     
+    // 发送队列背压信号
+    void backpressureChanged(bool congested);
+    
     // 连接成功信号
     void connected();
     
@@ -55,13 +73,15 @@ private slots:
     void onWorkerConnectResult(bool success, const QString& message);
 
 private:
-    QThread* m_workerThread;
+    QThread* m_workerThread;           // 共享I/O线程池分配的线程，不归本对象所有
     SocketWorker* m_worker;
     SocketConfig m_config;
     bool m_connected;
+    QList<AlarmRule> m_alarmRules;     // 工作对象创建前设置的报警规则
+    bool m_hasAlarmRules;
     
     // 内部方法
-    void setupWorker();
+    bool setupWorker();
     void cleanupWorker();
 };
 
@@ -1,5 +1,7 @@
 #include "socket_worker.h"
-#include <QDebug>
+#include "../common/log.h"
+#include "../common/trace_recorder.h"
+#include "../protocol/protocol_frame.h"
 #include <QHostAddress>
 
 SocketWorker::SocketWorker(QObject *parent)
@@ -7,9 +9,17 @@ SocketWorker::SocketWorker(QObject *parent)
     , m_socket(nullptr)
     , m_connected(false)
     , m_shouldReconnect(false)
+    , m_connecting(false)
+    , m_reconnecting(false)
     , m_sendTimer(nullptr)
+    , m_writingBytes(0)
+    , m_writeStartNs(-1)
+    , m_abandonedBytes(0)
     , m_reconnectTimer(nullptr)
+    , m_connectTimer(nullptr)
+    , m_metrics("socket")
 {
+    m_alarmEngine.setRules(AlarmEngine::defaultRules());
 }
 
 SocketWorker::~SocketWorker()
@@ -29,6 +39,11 @@ void SocketWorker::initialize()
     m_reconnectTimer = new QTimer(this);
     connect(m_reconnectTimer, &QTimer::timeout, this, &SocketWorker::attemptReconnect);
     m_reconnectTimer->setSingleShot(true);
+    
+    // 连接超时定时器（连接过程不阻塞事件循环）
+    m_connectTimer = new QTimer(this);
+    connect(m_connectTimer, &QTimer::timeout, this, &SocketWorker::handleConnectTimeout);
+    m_connectTimer->setSingleShot(true);
 }
 
 void SocketWorker::cleanup()
@@ -47,60 +62,83 @@ void SocketWorker::cleanup()
         m_reconnectTimer->deleteLater();
         m_reconnectTimer = nullptr;
     }
+    
+    if (m_connectTimer) {
+        m_connectTimer->stop();
+        m_connectTimer->deleteLater();
+        m_connectTimer = nullptr;
+    }
 }
 
 void SocketWorker::connectToHost(const SocketConfig& config)
 {
-    if (m_connected) {
+    if (m_connected || m_connecting) {
         disconnectFromHost();
     }
     
     m_config = config;
     m_shouldReconnect = config.autoReconnect;
+    m_reconnecting = false;
     
-    // 设置Socket
+    // 发起连接，结果由 handleConnected / handleErrorOccurred / handleConnectTimeout 给出
+    qCDebug(lcSocket) << "尝试连接到" << config.hostAddress << ":" << config.port;
+    startConnecting();
+}
+
+void SocketWorker::startConnecting()
+{
     setupSocket();
+    m_connecting = true;
+    if (m_connectTimer) {
+        m_connectTimer->start(m_config.connectTimeout);
+    }
+    m_socket->connectToHost(QHostAddress(m_config.hostAddress), m_config.port);
+}
+
+void SocketWorker::failConnecting(const QString& reason)
+{
+    m_connecting = false;
+    if (m_connectTimer) {
+        m_connectTimer->stop();
+    }
+    cleanupSocket();
     
-    // 尝试连接
-    qDebug() << "尝试连接到" << config.hostAddress << ":" << config.port;
-    m_socket->connectToHost(QHostAddress(config.hostAddress), config.port);
-    
-    // 等待连接结果
-    if (m_socket->waitForConnected(config.connectTimeout)) {
-        m_connected = true;
-        emit connectionStateChanged(true);
-        emit connected();
-        
-        // 启动发送定时器
-        if (m_sendTimer) {
-            m_sendTimer->start();
-        }
-        
-        qDebug() << "Socket连接成功:" << getConnectionInfo();
-        emit connectResult(true, QString("Socket连接成功: %1").arg(getConnectionInfo()));
+    if (m_reconnecting) {
+        qCDebug(lcSocket) << "重连失败，将在" << m_config.reconnectInterval << "ms后再次尝试";
     } else {
         QString errorMsg = QString("无法连接到 %1:%2 - %3")
-                          .arg(config.hostAddress)
-                          .arg(config.port)
-                          .arg(m_socket->errorString());
-        qWarning() << errorMsg;
+                          .arg(m_config.hostAddress)
+                          .arg(m_config.port)
+                          .arg(reason);
+        qCWarning(lcSocket) << errorMsg;
         emit errorOccurred(errorMsg);
         emit connectResult(false, errorMsg);
-        
-        // 如果需要自动重连，启动重连定时器
-        if (m_shouldReconnect) {
-            m_reconnectTimer->start(config.reconnectInterval);
-        }
+    }
+    
+    // 如果需要自动重连，启动重连定时器
+    if (m_shouldReconnect && m_reconnectTimer) {
+        m_reconnectTimer->start(m_config.reconnectInterval);
+    }
+}
+
+void SocketWorker::handleConnectTimeout()
+{
+    if (m_connecting) {
+        failConnecting(socketErrorToString(QAbstractSocket::SocketTimeoutError));
     }
 }
 
 void SocketWorker::disconnectFromHost()
 {
     m_shouldReconnect = false;
+    m_connecting = false;
     
     if (m_reconnectTimer) {
         m_reconnectTimer->stop();
     }
+    if (m_connectTimer) {
+        m_connectTimer->stop();
+    }
     
     if (m_socket && m_connected) {
         m_connected = false;
@@ -110,67 +148,86 @@ void SocketWorker::disconnectFromHost()
             m_sendTimer->stop();
         }
         
-        m_socket->disconnectFromHost();
-        
-        if (m_socket->state() != QAbstractSocket::UnconnectedState) {
-            m_socket->waitForDisconnected(3000);
-        }
-        
+        // 缓冲中的数据由 cleanupSocket 在后台写完后再关闭，不阻塞等待
+        m_metrics.connectionChanged(false);
         emit connectionStateChanged(false);
         emit disconnected();
-        qDebug() << "Socket已断开连接";
+        qCDebug(lcSocket) << "Socket已断开连接";
     }
     
     cleanupSocket();
 }
 
-void SocketWorker::sendData(const QByteArray& data)
+void SocketWorker::sendData(const QByteArray& data, int priority)
 {
+    H7_SPAN("io", "enqueue");
     if (!m_connected || !m_socket || m_socket->state() != QAbstractSocket::ConnectedState) {
         emit errorOccurred("Socket未连接，无法发送数据");
         return;
     }
     
-    // 将数据加入发送队列
-    QMutexLocker locker(&m_sendMutex);
-    m_sendQueue.enqueue(data);
+    // 将数据按优先级加入发送队列
+    SendQueue::Priority sendPriority = static_cast<SendQueue::Priority>(
+        qBound(0, priority, static_cast<int>(SendQueue::PriorityCount) - 1));
+    SendQueue::EnqueueResult result = m_sendQueue.enqueue(data, sendPriority);
+    if (result == SendQueue::Rejected) {
+        qCWarning(lcSocket) << "发送队列已满，拒绝" << SendQueue::priorityName(sendPriority) << "帧";
+        emit errorOccurred(QString("发送队列已满，%1命令被拒绝").arg(SendQueue::priorityName(sendPriority)));
+    } else if (result == SendQueue::AcceptedDroppedOldest) {
+        qCDebug(lcSocket) << "发送队列已满，丢弃最早的" << SendQueue::priorityName(sendPriority) << "帧";
+    }
+    
+    notifyBackpressure();
+}
+
+void SocketWorker::setAlarmRules(const QList<AlarmRule>& rules)
+{
+    if (!m_alarmEngine.setRules(rules)) {
+        emit errorOccurred(m_alarmEngine.lastError());
+    }
+}
+
+SendQueue::Stats SocketWorker::sendQueueStats() const
+{
+    return m_sendQueue.stats();
 }
 
 void SocketWorker::attemptReconnect()
 {
-    if (m_shouldReconnect && !m_connected) {
-        qDebug() << "尝试重新连接...";
-        
-        // 清理旧的socket
-        cleanupSocket();
-        
-        // 重新连接
-        setupSocket();
-        m_socket->connectToHost(QHostAddress(m_config.hostAddress), m_config.port);
-        
-        if (m_socket->waitForConnected(m_config.connectTimeout)) {
-            m_connected = true;
-            emit connectionStateChanged(true);
-            emit connected();
-            
-            if (m_sendTimer) {
-                m_sendTimer->start();
-            }
-            
-            qDebug() << "重连成功:" << getConnectionInfo();
-        } else {
-            qDebug() << "重连失败，将在" << m_config.reconnectInterval << "ms后再次尝试";
-            m_reconnectTimer->start(m_config.reconnectInterval);
-        }
+    if (m_shouldReconnect && !m_connected && !m_connecting) {
+        qCDebug(lcSocket) << "尝试重新连接...";
+        m_reconnecting = true;
+        startConnecting();
     }
 }
 
 void SocketWorker::handleConnected()
 {
+    m_connecting = false;
+    if (m_connectTimer) {
+        m_connectTimer->stop();
+    }
+    
     m_connected = true;
+    if (m_reconnecting) {
+        m_metrics.reconnected();
+    }
+    m_metrics.connectionChanged(true);
     emit connectionStateChanged(true);
     emit connected();
-    qDebug() << "Socket连接建立:" << getConnectionInfo();
+    
+    // 启动发送定时器
+    if (m_sendTimer) {
+        m_sendTimer->start();
+    }
+    
+    if (m_reconnecting) {
+        qCDebug(lcSocket) << "重连成功:" << getConnectionInfo();
+    } else {
+        qCDebug(lcSocket) << "Socket连接成功:" << getConnectionInfo();
+        emit connectResult(true, QString("Socket连接成功: %1").arg(getConnectionInfo()));
+    }
+    m_reconnecting = false;
 }
 
 void SocketWorker::handleDisconnected()
@@ -182,14 +239,18 @@ void SocketWorker::handleDisconnected()
         m_sendTimer->stop();
     }
     
+    // 与串口关闭时相同：断开前排队的请求和半帧数据不带到重连后的连接上
+    discardPendingData();
+    
     if (wasConnected) {
+        m_metrics.connectionChanged(false);
         emit connectionStateChanged(false);
         emit disconnected();
-        qDebug() << "Socket连接断开";
+        qCDebug(lcSocket) << "Socket连接断开";
         
         // 如果需要自动重连且不是主动断开
         if (m_shouldReconnect) {
-            qDebug() << "启动自动重连，间隔:" << m_config.reconnectInterval << "ms";
+            qCDebug(lcSocket) << "启动自动重连，间隔:" << m_config.reconnectInterval << "ms";
             m_reconnectTimer->start(m_config.reconnectInterval);
         }
     }
@@ -197,21 +258,50 @@ void SocketWorker::handleDisconnected()
 
 void SocketWorker::handleReadyRead()
 {
+    H7_SPAN("io", "readyRead");
     if (!m_socket) {
         return;
     }
     
-    QByteArray data = m_socket->readAll();
-    if (!data.isEmpty()) {
-        qDebug() << "Socket接收数据:" << data.toHex(' ');
-        emit dataReceived(data);
+    // 直接读入缓冲池数据块，数据块通过引用计数传递给下游，不再逐次申请内存
+    while (m_socket->bytesAvailable() > 0) {
+        RxChunk chunk = RxBufferPool::instance()->acquire();
+        qint64 bytesRead = m_socket->read(chunk.data(), chunk.capacity());
+        if (bytesRead <= 0) {
+            break;
+        }
+        chunk.setSize(static_cast<int>(bytesRead));
+        m_metrics.bytesReceived(bytesRead);
+        
+        H7_TRACE(lcSocketTrace) << "Socket接收数据:" << hexDump(chunk.constData(), chunk.size());
+        emit dataReceived(chunk);
+        
+        // 在工作线程中完成帧重组、校验和解码
+        QVector<DeviceMessage> messages = m_framePipeline.feed(chunk.constData(), chunk.size());
+        m_metrics.framesReceived(messages, m_framePipeline.stats());
+        for (DeviceMessage& message : messages) {
+            message.traceEmitNs = H7_SPAN_NOW();
+            emit messageReceived(message);
+            
+            if (message.type == DeviceMessage::VcuInfo) {
+                const QVector<AlarmEvent> alarms = m_alarmEngine.evaluate(*message.vcuInfo);
+                for (const AlarmEvent& alarm : alarms) {
+                    emit alarmChanged(alarm);
+                }
+            }
+        }
     }
 }
 
 void SocketWorker::handleErrorOccurred(QAbstractSocket::SocketError error)
 {
     QString errorString = socketErrorToString(error);
-    qWarning() << "Socket错误:" << errorString;
+    if (m_connecting) {
+        // 连接过程中的错误按连接失败处理
+        failConnecting(m_socket ? m_socket->errorString() : errorString);
+        return;
+    }
+    qCWarning(lcSocket) << "Socket错误:" << errorString;
     emit errorOccurred(errorString);
 }
 
@@ -221,41 +311,117 @@ void SocketWorker::processSendQueue()
         return;
     }
     
-    QMutexLocker locker(&m_sendMutex);
+    // 上一次写入尚未完成时不写新数据；超时后放弃等待，继续发送后续数据
+    if (m_writingBytes > 0) {
+        if (!m_writeClock.hasExpired(WriteTimeoutMs)) {
+            return;
+        }
+        qCWarning(lcSocket) << "Socket发送数据超时";
+        emit errorOccurred("数据发送超时");
+        m_abandonedBytes += m_writingBytes;
+        m_writing.clear();
+        m_writingBytes = 0;
+    }
     
-    while (!m_sendQueue.isEmpty()) {
-        QByteArray data = m_sendQueue.dequeue();
-        locker.unlock();
-        
+    QByteArray data;
+    while (m_writingBytes == 0 && m_sendQueue.dequeue(&data)) {
         // 发送数据
-        qint64 bytesWritten = m_socket->write(data);
+        qint64 bytesWritten;
+        m_writeStartNs = H7_SPAN_NOW();
+        {
+            H7_SPAN("io", "write");
+            bytesWritten = m_socket->write(data);
+        }
         if (bytesWritten == data.size()) {
-            if (m_socket->waitForBytesWritten(3000)) {
-                qDebug() << "Socket发送数据成功:" << data.toHex(' ');
-                emit dataSent(data);
-            } else {
-                qWarning() << "Socket发送数据超时";
-                emit errorOccurred("数据发送超时");
-            }
+            // 不阻塞等待写出，写完后由 bytesWritten 信号确认（同一事件循环上还有其他会话）
+            m_writing = data;
+            m_writingBytes = bytesWritten;
+            m_writeClock.start();
         } else {
-            qWarning() << "Socket数据发送不完整";
+            qCWarning(lcSocket) << "Socket数据发送不完整";
             emit errorOccurred("数据发送不完整");
         }
-        
-        locker.relock();
     }
+    
+    notifyBackpressure();
+}
+
+void SocketWorker::handleBytesWritten(qint64 bytes)
+{
+    // 先抵扣超时放弃的写入迟到的确认
+    if (m_abandonedBytes > 0) {
+        const qint64 stale = qMin(bytes, m_abandonedBytes);
+        m_abandonedBytes -= stale;
+        bytes -= stale;
+    }
+    if (m_writingBytes <= 0 || bytes <= 0) {
+        return;
+    }
+    m_writingBytes -= bytes;
+    if (m_writingBytes > 0) {
+        return;
+    }
+    m_writingBytes = 0;
+    // 写入到全部写出确认的耗时
+    H7_SPAN_SINCE("io", "bytesWritten", m_writeStartNs);
+    
+    const QByteArray data = m_writing;
+    m_writing.clear();
+    H7_TRACE(lcSocketTrace) << "Socket发送数据成功:" << hexDump(data);
+    // 批量写出的多帧逐帧上报，便于按帧匹配和统计
+    const QList<QByteArray> frames = ProtocolFrame::splitFrames(data);
+    for (const QByteArray& frame : frames) {
+        m_metrics.frameSent(frame);
+        emit dataSent(frame);
+    }
+    
+    // 队列中还有数据时立即继续，不等下一次定时器
+    processSendQueue();
 }
 
 void SocketWorker::cleanupSocket()
 {
     if (m_socket) {
-        m_socket->deleteLater();
+        QTcpSocket* socket = m_socket;
         m_socket = nullptr;
+        disconnect(socket, nullptr, this, nullptr);
+        if (socket->state() == QAbstractSocket::ConnectedState) {
+            // 写完缓冲中的数据后关闭并释放，最多等待3秒
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            QTimer::singleShot(3000, socket, &QTcpSocket::abort);
+            socket->disconnectFromHost();
+        } else {
+            socket->abort();
+            socket->deleteLater();
+        }
     }
     
-    // 清空发送队列
-    QMutexLocker locker(&m_sendMutex);
+    discardPendingData();
+}
+
+void SocketWorker::discardPendingData()
+{
+    // 丢弃未完成的帧
+    m_framePipeline.reset();
+    m_metrics.connectionReset();
+    
+    // 清空发送队列和未确认的写入
     m_sendQueue.clear();
+    m_writing.clear();
+    m_writingBytes = 0;
+    m_abandonedBytes = 0;
+    notifyBackpressure();
+}
+
+void SocketWorker::notifyBackpressure()
+{
+    m_metrics.sendQueueChanged(m_sendQueue.stats());
+    
+    bool congested = false;
+    if (m_sendQueue.takeCongestionChange(&congested)) {
+        qCDebug(lcSocket) << "发送队列" << (congested ? "拥塞" : "恢复") << m_sendQueue.stats().totalDepth;
+        emit backpressureChanged(congested);
+    }
 }
 
 void SocketWorker::setupSocket()
@@ -268,6 +434,7 @@ void SocketWorker::setupSocket()
     connect(m_socket, &QTcpSocket::connected, this, &SocketWorker::handleConnected);
     connect(m_socket, &QTcpSocket::disconnected, this, &SocketWorker::handleDisconnected);
     connect(m_socket, &QTcpSocket::readyRead, this, &SocketWorker::handleReadyRead);
+    connect(m_socket, &QTcpSocket::bytesWritten, this, &SocketWorker::handleBytesWritten);
     connect(m_socket, QOverload<QAbstractSocket::SocketError>::of(&QTcpSocket::errorOccurred),
             this, &SocketWorker::handleErrorOccurred);
 }
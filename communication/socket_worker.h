@@ -5,9 +5,13 @@
 #include <QTcpSocket>
 #include <QHostAddress>
 #include <QByteArray>
-#include <QMutex>
-#include <QQueue>
 #include <QTimer>
+#include <QElapsedTimer>
+#include "rx_buffer_pool.h"
+#include "send_queue.h"
+#include "transport_metrics.h"
+#include "../protocol/frame_pipeline.h"
+#include "../telemetry/alarm_engine.h"
 
 class SocketWorker : public QObject
 {
@@ -36,11 +40,17 @@ public:
     explicit SocketWorker(QObject *parent = nullptr);
     ~SocketWorker();
 
+    // 获取发送队列统计（线程安全）
+    SendQueue::Stats sendQueueStats() const;
+
 public slots:
     // Socket控制槽函数
     void connectToHost(const SocketConfig& config);
     void disconnectFromHost();
-    void sendData(const QByteArray& data);
+    void sendData(const QByteArray& data, int priority = SendQueue::OneShotQuery);
+    
+    // 替换报警规则
+    void setAlarmRules(const QList<AlarmRule>& rules);
     
     // 初始化和清理
     void initialize();
@@ -51,7 +61,13 @@ public slots:
 
 signals:
     // 数据接收信号
-    void dataReceived(const QByteArray& data);
+    void dataReceived(const RxChunk& chunk);
+    
+    // 解码后的设备消息信号
+    void messageReceived(const DeviceMessage& message);
+    
+    // 报警状态变化信号（触发和解除）
+    void alarmChanged(const AlarmEvent& event);
     
     // 连接状态改变信号
     void connectionStateChanged(bool connected);
@@ -62,6 +78,9 @@ signals:
     // 数据发送完成信号
     void dataSent(const QByteArray& data);
     
+    // 发送队列背压信号：congested 为 true 时周期轮询应降低频率
+    void backpressureChanged(bool congested);
+    
     // 连接成功信号
     void connected();
     
@@ -77,25 +96,53 @@ private slots:
     void handleReadyRead();
     void handleErrorOccurred(QAbstractSocket::SocketError error);
     void processSendQueue();
+    void handleConnectTimeout();
+    void handleBytesWritten(qint64 bytes);
 
 private:
     QTcpSocket* m_socket;
     SocketConfig m_config;
     bool m_connected;
     bool m_shouldReconnect;
+    bool m_connecting;          // 已发起连接，尚未成功或失败
+    bool m_reconnecting;        // 当前连接是自动重连（不发送 connectResult）
     
-    // 发送队列
-    QQueue<QByteArray> m_sendQueue;
-    QMutex m_sendMutex;
+    // 接收帧处理流水线
+    FramePipeline m_framePipeline;
+    
+    // 报警规则引擎，对解码后的VCU采样增量评估
+    AlarmEngine m_alarmEngine;
+    
+    // 发送队列（按优先级分类，有界）
+    SendQueue m_sendQueue;
     
     // 发送处理定时器
     QTimer* m_sendTimer;
     
+    // 已写入、等待 bytesWritten 确认的数据（同一时刻最多一项）
+    static constexpr int WriteTimeoutMs = 3000;
+    QByteArray m_writing;
+    qint64 m_writingBytes;
+    QElapsedTimer m_writeClock;
+    qint64 m_writeStartNs;          // 性能跟踪：写入时刻，未记录时为 -1
+    // 超时放弃的写入中尚未确认的字节数；其迟到的 bytesWritten 先抵扣这部分，不算到后续写入上
+    qint64 m_abandonedBytes;
+    
     // 重连定时器
     QTimer* m_reconnectTimer;
     
+    // 连接超时定时器
+    QTimer* m_connectTimer;
+    
+    // 收发与协议指标
+    TransportMetrics m_metrics;
+    
     // 内部方法
+    void startConnecting();
+    void failConnecting(const QString& reason);
     void cleanupSocket();
+    void discardPendingData();
+    void notifyBackpressure();
     void setupSocket();
     QString socketErrorToString(QAbstractSocket::SocketError error);
     QString getConnectionInfo() const;
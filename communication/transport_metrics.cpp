@@ -0,0 +1,134 @@
+#include "transport_metrics.h"
+#include <cstring>
+
+namespace {
+
+const char* const kQueueClassNames[SendQueue::PriorityCount] = {"config", "query", "poll"};
+
+} // namespace
+
+TransportMetrics::TransportMetrics(const QString& transport)
+    : m_lastQueueDropped(0)
+    , m_lastQueueRejected(0)
+{
+    MetricsRegistry* registry = MetricsRegistry::instance();
+    const QString label = QString("transport=\"%1\"").arg(transport);
+    const QString rx = label + ",direction=\"rx\"";
+    const QString tx = label + ",direction=\"tx\"";
+
+    m_bytesSent = registry->counter("h7_transport_bytes_total", "收发字节数", tx);
+    m_bytesReceived = registry->counter("h7_transport_bytes_total", "收发字节数", rx);
+    m_framesSent = registry->counter("h7_transport_frames_total", "收发帧数（接收为解出的帧，含校验失败）", tx);
+    m_framesReceived = registry->counter("h7_transport_frames_total", "收发帧数（接收为解出的帧，含校验失败）", rx);
+    m_crcErrors = registry->counter("h7_protocol_crc_errors_total", "CRC校验失败次数", label);
+    m_payloadErrors = registry->counter("h7_protocol_payload_errors_total", "数据长度与功能码不符的帧数", label);
+    m_discardedBytes = registry->counter("h7_protocol_resync_discarded_bytes_total", "帧头重新同步时丢弃的字节数", label);
+    m_reconnects = registry->counter("h7_transport_reconnects_total", "自动重连成功次数", label);
+    m_connected = registry->gauge("h7_transport_connected", "当前是否已连接", label);
+    for (int i = 0; i < SendQueue::PriorityCount; ++i) {
+        m_queueDepth[i] = registry->gauge("h7_send_queue_depth", "发送队列当前深度",
+                                          label + QString(",class=\"%1\"").arg(kQueueClassNames[i]));
+    }
+    m_queueDropped = registry->counter("h7_send_queue_dropped_total", "发送队列满时丢弃的帧数", label);
+    m_queueRejected = registry->counter("h7_send_queue_rejected_total", "发送队列满时拒绝的帧数", label);
+    m_requestLatency = registry->histogram("h7_request_latency_seconds", "请求发出到收到同功能码应答的时间",
+                                           label, MetricsRegistry::latencyBuckets());
+
+    m_clock.start();
+}
+
+void TransportMetrics::frameSent(const QByteArray& frame)
+{
+    m_bytesSent->add(static_cast<quint64>(frame.size()));
+    m_framesSent->add();
+
+    if (frame.size() < static_cast<int>(sizeof(pc_comm_protocol__head_t))) {
+        return;
+    }
+
+    pc_comm_protocol__head_t header;
+    memcpy(&header, frame.constData(), sizeof(header));
+
+    QVector<qint64>& pending = m_pendingRequests[header.function_code];
+    if (pending.size() >= MaxPendingPerCode) {
+        pending.removeFirst();
+    }
+    pending.append(m_clock.elapsed());
+}
+
+void TransportMetrics::bytesReceived(qint64 size)
+{
+    m_bytesReceived->add(static_cast<quint64>(size));
+}
+
+void TransportMetrics::framesReceived(const QVector<DeviceMessage>& messages, const FramePipeline::Stats& pipelineStats)
+{
+    m_framesReceived->add(static_cast<quint64>(messages.size()));
+    m_crcErrors->add(static_cast<quint64>(pipelineStats.crcErrors - m_lastPipelineStats.crcErrors));
+    m_discardedBytes->add(static_cast<quint64>(pipelineStats.discardedBytes - m_lastPipelineStats.discardedBytes));
+    m_lastPipelineStats = pipelineStats;
+
+    const qint64 now = m_clock.elapsed();
+    for (const DeviceMessage& message : messages) {
+        if (message.type == DeviceMessage::InvalidFrame) {
+            continue;
+        }
+        if (message.type == DeviceMessage::PayloadError) {
+            m_payloadErrors->add();
+        }
+
+        auto it = m_pendingRequests.find(message.functionCode);
+        if (it == m_pendingRequests.end()) {
+            continue;
+        }
+
+        // 丢掉已过期的请求，应答对应最早的一个未应答请求
+        QVector<qint64>& pending = it.value();
+        while (!pending.isEmpty() && now - pending.first() > RequestExpireMs) {
+            pending.removeFirst();
+        }
+        if (!pending.isEmpty()) {
+            m_requestLatency->observe((now - pending.first()) / 1000.0);
+            pending.removeFirst();
+        }
+        if (pending.isEmpty()) {
+            m_pendingRequests.erase(it);
+        }
+    }
+}
+
+void TransportMetrics::connectionReset()
+{
+    m_pendingRequests.clear();
+}
+
+void TransportMetrics::sendQueueChanged(const SendQueue::Stats& stats)
+{
+    qint64 dropped = 0;
+    qint64 rejected = 0;
+    for (int i = 0; i < SendQueue::PriorityCount; ++i) {
+        m_queueDepth[i]->set(stats.depth[i]);
+        dropped += stats.dropped[i];
+        rejected += stats.rejected[i];
+    }
+
+    // 队列统计是累计值，按增量计入计数器
+    if (dropped > m_lastQueueDropped) {
+        m_queueDropped->add(static_cast<quint64>(dropped - m_lastQueueDropped));
+    }
+    if (rejected > m_lastQueueRejected) {
+        m_queueRejected->add(static_cast<quint64>(rejected - m_lastQueueRejected));
+    }
+    m_lastQueueDropped = dropped;
+    m_lastQueueRejected = rejected;
+}
+
+void TransportMetrics::connectionChanged(bool connected)
+{
+    m_connected->set(connected ? 1 : 0);
+}
+
+void TransportMetrics::reconnected()
+{
+    m_reconnects->add();
+}
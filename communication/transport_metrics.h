@@ -0,0 +1,65 @@
+#ifndef TRANSPORT_METRICS_H
+#define TRANSPORT_METRICS_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVector>
+#include "send_queue.h"
+#include "../common/metrics_registry.h"
+#include "../protocol/frame_pipeline.h"
+
+// 单个通道（串口 / Socket）的收发与协议指标
+// 只在所属工作线程中调用；指标本身写入 MetricsRegistry，由指标服务导出
+class TransportMetrics
+{
+public:
+    // transport: 标签值，例如 "serial"、"socket"
+    explicit TransportMetrics(const QString& transport);
+
+    // 一帧已写出
+    void frameSent(const QByteArray& frame);
+
+    // 收到一段原始数据
+    void bytesReceived(qint64 size);
+
+    // 一批解码结果；pipelineStats 为流水线当前累计统计
+    void framesReceived(const QVector<DeviceMessage>& messages, const FramePipeline::Stats& pipelineStats);
+
+    // 连接关闭或重建，未应答的请求不再计入延迟
+    void connectionReset();
+
+    void sendQueueChanged(const SendQueue::Stats& stats);
+    void connectionChanged(bool connected);
+    void reconnected();
+
+private:
+    // 请求超过该时间仍未收到应答视为丢失，不再计入延迟
+    static constexpr qint64 RequestExpireMs = 10000;
+    // 每个功能码最多跟踪的未应答请求数
+    static constexpr int MaxPendingPerCode = 8;
+
+    MetricCounter* m_bytesSent;
+    MetricCounter* m_bytesReceived;
+    MetricCounter* m_framesSent;
+    MetricCounter* m_framesReceived;
+    MetricCounter* m_crcErrors;
+    MetricCounter* m_payloadErrors;
+    MetricCounter* m_discardedBytes;
+    MetricCounter* m_reconnects;
+    MetricGauge* m_connected;
+    MetricGauge* m_queueDepth[SendQueue::PriorityCount];
+    MetricCounter* m_queueDropped;
+    MetricCounter* m_queueRejected;
+    MetricHistogram* m_requestLatency;
+
+    FramePipeline::Stats m_lastPipelineStats;
+    qint64 m_lastQueueDropped;
+    qint64 m_lastQueueRejected;
+
+    // 功能码 -> 未应答请求的发送时刻（按发送顺序）
+    QElapsedTimer m_clock;
+    QHash<quint16, QVector<qint64>> m_pendingRequests;
+};
+
+#endif // TRANSPORT_METRICS_H
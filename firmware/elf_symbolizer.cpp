@@ -0,0 +1,722 @@
+#include "elf_symbolizer.h"
+#include <QFileInfo>
+#include <QDateTime>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// ELF 常量
+const int kElfHeaderSize = 52;
+const int kSectionHeaderSize = 40;
+const int kSymbolSize = 16;
+const quint32 kSectionSymtab = 2;
+const quint32 kSectionNote = 7;
+const quint32 kSectionNobits = 8;
+const quint8 kSymbolFunction = 2;
+const quint32 kNoteGnuBuildId = 3;
+const quint16 kSectionIndexExtended = 0xFFFF;
+
+// DWARF 行号程序
+const quint8 DW_LNS_copy = 1;
+const quint8 DW_LNS_advance_pc = 2;
+const quint8 DW_LNS_advance_line = 3;
+const quint8 DW_LNS_set_file = 4;
+const quint8 DW_LNS_const_add_pc = 8;
+const quint8 DW_LNS_fixed_advance_pc = 9;
+const quint8 DW_LNE_end_sequence = 1;
+const quint8 DW_LNE_set_address = 2;
+const quint8 DW_LNE_define_file = 3;
+const quint64 DW_LNCT_path = 1;
+const quint64 DW_LNCT_directory_index = 2;
+
+const quint64 DW_FORM_block = 0x09;
+const quint64 DW_FORM_data1 = 0x0b;
+const quint64 DW_FORM_data2 = 0x05;
+const quint64 DW_FORM_data4 = 0x06;
+const quint64 DW_FORM_data8 = 0x07;
+const quint64 DW_FORM_data16 = 0x1e;
+const quint64 DW_FORM_sdata = 0x0d;
+const quint64 DW_FORM_udata = 0x0f;
+const quint64 DW_FORM_string = 0x08;
+const quint64 DW_FORM_strp = 0x0e;
+const quint64 DW_FORM_line_strp = 0x1f;
+
+// 缓存的固件数量上限
+const int kMaxCachedFirmware = 8;
+// 每个固件缓存的地址解析结果上限
+const int kMaxResolvedAddresses = 4096;
+
+inline quint16 read16(const uchar* p)
+{
+    return qFromLittleEndian<quint16>(p);
+}
+
+inline quint32 read32(const uchar* p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+// 带边界检查的顺序读取，越界后 ok 置为 false，后续读取均返回 0
+struct Reader {
+    const uchar* p;
+    const uchar* end;
+    bool ok;
+
+    Reader(const uchar* begin, const uchar* limit) : p(begin), end(limit), ok(true) {}
+
+    bool has(quint64 count) {
+        if (static_cast<quint64>(end - p) < count) {
+            ok = false;
+            p = end;
+            return false;
+        }
+        return true;
+    }
+
+    quint8 u8() { return has(1) ? *p++ : 0; }
+    quint16 u16() { if (!has(2)) return 0; quint16 v = read16(p); p += 2; return v; }
+    quint32 u32() { if (!has(4)) return 0; quint32 v = read32(p); p += 4; return v; }
+    quint64 u64() { if (!has(8)) return 0; quint64 v = qFromLittleEndian<quint64>(p); p += 8; return v; }
+    quint64 offset(int size) { return size == 8 ? u64() : u32(); }
+    void skip(quint64 count) { if (has(count)) p += count; }
+
+    quint64 uleb() {
+        quint64 result = 0;
+        int shift = 0;
+        while (p < end) {
+            const uchar byte = *p++;
+            if (shift < 64) {
+                result |= static_cast<quint64>(byte & 0x7f) << shift;
+            }
+            shift += 7;
+            if (!(byte & 0x80)) {
+                return result;
+            }
+        }
+        ok = false;
+        return result;
+    }
+
+    qint64 sleb() {
+        qint64 result = 0;
+        int shift = 0;
+        uchar byte = 0;
+        do {
+            if (p >= end) {
+                ok = false;
+                return result;
+            }
+            byte = *p++;
+            if (shift < 64) {
+                result |= static_cast<qint64>(byte & 0x7f) << shift;
+            }
+            shift += 7;
+        } while (byte & 0x80);
+        if (shift < 64 && (byte & 0x40)) {
+            result |= -(static_cast<qint64>(1) << shift);
+        }
+        return result;
+    }
+
+    const char* cstr() {
+        const uchar* begin = p;
+        while (p < end && *p) {
+            ++p;
+        }
+        if (p >= end) {
+            ok = false;
+            return "";
+        }
+        ++p;
+        return reinterpret_cast<const char*>(begin);
+    }
+};
+
+QString joinPath(const QString& directory, const QString& name)
+{
+    if (directory.isEmpty() || name.startsWith('/') || (name.size() > 1 && name[1] == ':')) {
+        return name;
+    }
+    return directory + "/" + name;
+}
+
+} // namespace
+
+QString ElfSymbolizer::Location::toString() const
+{
+    if (!valid && file.isEmpty()) {
+        return "未知位置";
+    }
+
+    QString text = valid ? QString("%1+0x%2").arg(function).arg(offset, 0, 16) : QString("??");
+    if (!file.isEmpty()) {
+        text += QString(" (%1:%2)").arg(file).arg(line);
+    }
+    return text;
+}
+
+ElfSymbolizer::ElfSymbolizer()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_strtab(nullptr)
+    , m_strtabSize(0)
+    , m_linesLoaded(false)
+    , m_resolved(kMaxResolvedAddresses)
+{
+}
+
+ElfSymbolizer::~ElfSymbolizer()
+{
+    m_file.close();
+}
+
+QCache<QByteArray, QSharedPointer<ElfSymbolizer>>& ElfSymbolizer::cache()
+{
+    // 每项开销为 1，超过上限时淘汰最久未使用的固件
+    static QCache<QByteArray, QSharedPointer<ElfSymbolizer>> instances(kMaxCachedFirmware);
+    return instances;
+}
+
+QSharedPointer<ElfSymbolizer> ElfSymbolizer::open(const QString& path, QString* error)
+{
+    QSharedPointer<ElfSymbolizer> symbolizer(new ElfSymbolizer());
+    if (!symbolizer->mapFile(path, error) || !symbolizer->parseSections(error)) {
+        return QSharedPointer<ElfSymbolizer>();
+    }
+    symbolizer->parseBuildId();
+
+    // 同一固件（build id 相同）只建立一次索引
+    QByteArray key = symbolizer->m_buildId;
+    if (key.isEmpty()) {
+        const QFileInfo info(path);
+        key = QString("%1|%2|%3").arg(info.absoluteFilePath()).arg(info.size())
+              .arg(info.lastModified().toMSecsSinceEpoch()).toUtf8();
+    }
+
+    QCache<QByteArray, QSharedPointer<ElfSymbolizer>>& instances = cache();
+    if (QSharedPointer<ElfSymbolizer>* cached = instances.object(key)) {
+        return *cached;
+    }
+
+    if (!symbolizer->loadFunctions(error)) {
+        return QSharedPointer<ElfSymbolizer>();
+    }
+
+    instances.insert(key, new QSharedPointer<ElfSymbolizer>(symbolizer));
+    return symbolizer;
+}
+
+QString ElfSymbolizer::path() const
+{
+    return m_path;
+}
+
+QByteArray ElfSymbolizer::buildId() const
+{
+    return m_buildId;
+}
+
+int ElfSymbolizer::functionCount() const
+{
+    return m_functions.size();
+}
+
+bool ElfSymbolizer::hasLineInfo() const
+{
+    return findSection(".debug_line") != nullptr;
+}
+
+ElfSymbolizer::Location ElfSymbolizer::resolve(quint32 address)
+{
+    address &= ~1u;
+
+    if (const Location* cached = m_resolved.object(address)) {
+        return *cached;
+    }
+
+    Location location;
+
+    // 最后一个起始地址 <= address 的函数
+    QVector<FunctionRange>::const_iterator function = std::upper_bound(
+        m_functions.constBegin(), m_functions.constEnd(), address,
+        [](quint32 value, const FunctionRange& range) { return value < range.start; });
+    if (function != m_functions.constBegin()) {
+        --function;
+        if (address < function->end) {
+            location.valid = true;
+            location.function = QString::fromUtf8(functionName(*function));
+            location.offset = address - function->start;
+        }
+    }
+
+    if (!m_linesLoaded) {
+        loadLines();
+    }
+
+    QVector<LineRow>::const_iterator row = std::upper_bound(
+        m_lines.constBegin(), m_lines.constEnd(), address,
+        [](quint32 value, const LineRow& entry) { return value < entry.address; });
+    if (row != m_lines.constBegin()) {
+        --row;
+        if (!row->endSequence && row->file < static_cast<quint32>(m_lineFiles.size())) {
+            location.file = m_lineFiles[row->file];
+            location.line = static_cast<int>(row->line);
+        }
+    }
+
+    m_resolved.insert(address, new Location(location));
+    return location;
+}
+
+bool ElfSymbolizer::mapFile(const QString& path, QString* error)
+{
+    m_path = path;
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        *error = QString("打开固件文件失败: %1").arg(m_file.errorString());
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size < kElfHeaderSize) {
+        *error = "不是有效的ELF文件";
+        return false;
+    }
+
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        *error = QString("映射固件文件失败: %1").arg(m_file.errorString());
+        return false;
+    }
+
+    if (memcmp(m_data, "\x7f" "ELF", 4) != 0) {
+        *error = "不是有效的ELF文件";
+        return false;
+    }
+    if (m_data[4] != 1 || m_data[5] != 1) {
+        *error = "仅支持32位小端ELF文件";
+        return false;
+    }
+    return true;
+}
+
+bool ElfSymbolizer::parseSections(QString* error)
+{
+    const quint32 sectionOffset = read32(m_data + 32);
+    const quint16 entrySize = read16(m_data + 46);
+    quint32 sectionCount = read16(m_data + 48);
+    quint32 nameSectionIndex = read16(m_data + 50);
+
+    if (sectionOffset == 0 || entrySize != kSectionHeaderSize
+        || static_cast<qint64>(sectionOffset) + kSectionHeaderSize > m_size) {
+        *error = "ELF文件缺少节表";
+        return false;
+    }
+
+    // 节数量或节名表下标超出 16 位时保存在第 0 个节头中
+    const uchar* first = m_data + sectionOffset;
+    if (sectionCount == 0) {
+        sectionCount = read32(first + 20);
+    }
+    if (nameSectionIndex == kSectionIndexExtended) {
+        nameSectionIndex = read32(first + 24);
+    }
+
+    if (static_cast<qint64>(sectionOffset) + static_cast<qint64>(sectionCount) * kSectionHeaderSize > m_size
+        || nameSectionIndex >= sectionCount) {
+        *error = "ELF节表损坏";
+        return false;
+    }
+
+    m_sections.resize(static_cast<int>(sectionCount));
+    for (quint32 i = 0; i < sectionCount; ++i) {
+        const uchar* header = first + i * kSectionHeaderSize;
+        Section& section = m_sections[static_cast<int>(i)];
+        section.type = read32(header + 4);
+        section.offset = read32(header + 16);
+        section.size = read32(header + 20);
+        section.link = read32(header + 24);
+        section.name = "";
+
+        // 无文件内容或越界的节按空节处理
+        if (section.type == kSectionNobits
+            || static_cast<qint64>(section.offset) + section.size > m_size) {
+            section.size = 0;
+        }
+    }
+
+    const Section& names = m_sections[static_cast<int>(nameSectionIndex)];
+    for (quint32 i = 0; i < sectionCount; ++i) {
+        const quint32 nameOffset = read32(first + i * kSectionHeaderSize);
+        if (nameOffset < names.size) {
+            const char* name = reinterpret_cast<const char*>(m_data + names.offset + nameOffset);
+            if (memchr(name, 0, names.size - nameOffset)) {
+                m_sections[static_cast<int>(i)].name = name;
+            }
+        }
+    }
+    return true;
+}
+
+void ElfSymbolizer::parseBuildId()
+{
+    for (const Section& section : m_sections) {
+        if (section.type != kSectionNote) {
+            continue;
+        }
+
+        Reader reader(m_data + section.offset, m_data + section.offset + section.size);
+        while (reader.ok && reader.p < reader.end) {
+            const quint32 nameSize = reader.u32();
+            const quint32 descSize = reader.u32();
+            const quint32 type = reader.u32();
+            const uchar* name = reader.p;
+            reader.skip((static_cast<quint64>(nameSize) + 3) & ~3ULL);
+            const uchar* desc = reader.p;
+            reader.skip((static_cast<quint64>(descSize) + 3) & ~3ULL);
+            if (!reader.ok) {
+                break;
+            }
+
+            if (type == kNoteGnuBuildId && nameSize == 4 && memcmp(name, "GNU", 4) == 0) {
+                m_buildId = QByteArray(reinterpret_cast<const char*>(desc), static_cast<int>(descSize));
+                return;
+            }
+        }
+    }
+}
+
+bool ElfSymbolizer::loadFunctions(QString* error)
+{
+    const Section* symtab = nullptr;
+    for (const Section& section : m_sections) {
+        if (section.type == kSectionSymtab) {
+            symtab = &section;
+            break;
+        }
+    }
+
+    if (!symtab || symtab->link >= static_cast<quint32>(m_sections.size())) {
+        *error = "ELF文件没有符号表（固件可能已被strip）";
+        return false;
+    }
+
+    const Section& strtab = m_sections[static_cast<int>(symtab->link)];
+    if (strtab.size == 0 || m_data[strtab.offset + strtab.size - 1] != 0) {
+        *error = "ELF字符串表损坏";
+        return false;
+    }
+    m_strtab = reinterpret_cast<const char*>(m_data + strtab.offset);
+    m_strtabSize = strtab.size;
+
+    const quint32 count = symtab->size / kSymbolSize;
+    m_functions.reserve(static_cast<int>(count / 2));
+    for (quint32 i = 0; i < count; ++i) {
+        const uchar* symbol = m_data + symtab->offset + i * kSymbolSize;
+        const quint8 info = symbol[12];
+        const quint16 sectionIndex = read16(symbol + 14);
+        if ((info & 0xf) != kSymbolFunction || sectionIndex == 0) {
+            continue;
+        }
+
+        FunctionRange range;
+        range.start = read32(symbol + 4) & ~1u;
+        range.end = range.start + read32(symbol + 8);
+        range.nameOffset = read32(symbol);
+        m_functions.append(range);
+    }
+
+    // 起始地址相同的别名保留有长度的一个；长度为 0 的符号延伸到下一个函数
+    std::sort(m_functions.begin(), m_functions.end(), [](const FunctionRange& a, const FunctionRange& b) {
+        return a.start != b.start ? a.start < b.start : a.end > b.end;
+    });
+    m_functions.erase(std::unique(m_functions.begin(), m_functions.end(),
+                                  [](const FunctionRange& a, const FunctionRange& b) { return a.start == b.start; }),
+                      m_functions.end());
+    for (int i = 0; i < m_functions.size(); ++i) {
+        if (m_functions[i].end == m_functions[i].start) {
+            m_functions[i].end = i + 1 < m_functions.size() ? m_functions[i + 1].start : m_functions[i].start + 1;
+        }
+    }
+
+    if (m_functions.isEmpty()) {
+        *error = "ELF符号表中没有函数";
+        return false;
+    }
+    return true;
+}
+
+void ElfSymbolizer::loadLines()
+{
+    m_linesLoaded = true;
+
+    const Section* debugLine = findSection(".debug_line");
+    if (!debugLine || debugLine->size == 0) {
+        return;
+    }
+
+    const uchar* p = m_data + debugLine->offset;
+    const uchar* end = p + debugLine->size;
+    while (p < end) {
+        // 单元长度（32 位或 64 位 DWARF）
+        Reader reader(p, end);
+        quint64 unitLength = reader.u32();
+        if (unitLength == 0xffffffffULL) {
+            unitLength = reader.u64();
+        }
+        if (!reader.ok || unitLength > static_cast<quint64>(end - reader.p)) {
+            break;
+        }
+
+        const uchar* unitEnd = reader.p + unitLength;
+        parseLineUnit(p, unitEnd);
+        p = unitEnd;
+    }
+
+    // 同一地址上序列结束行排在下一序列的首行之前
+    std::stable_sort(m_lines.begin(), m_lines.end(), [](const LineRow& a, const LineRow& b) {
+        return a.address != b.address ? a.address < b.address : (a.endSequence && !b.endSequence);
+    });
+    m_lines.squeeze();
+}
+
+bool ElfSymbolizer::parseLineUnit(const uchar* unit, const uchar* end)
+{
+    Reader reader(unit, end);
+    int offsetSize = 4;
+    if (reader.u32() == 0xffffffffu) {
+        reader.u64();
+        offsetSize = 8;
+    }
+
+    const quint16 version = reader.u16();
+    if (version < 2 || version > 5) {
+        return false;
+    }
+    if (version >= 5) {
+        reader.u8();    // address_size
+        reader.u8();    // segment_selector_size
+    }
+
+    const quint64 headerLength = reader.offset(offsetSize);
+    if (!reader.ok || headerLength > static_cast<quint64>(end - reader.p)) {
+        return false;
+    }
+    const uchar* program = reader.p + headerLength;
+
+    const quint8 minInstructionLength = reader.u8();
+    if (version >= 4) {
+        reader.u8();    // maximum_operations_per_instruction
+    }
+    reader.u8();        // default_is_stmt
+    const qint8 lineBase = static_cast<qint8>(reader.u8());
+    const quint8 lineRange = reader.u8();
+    const quint8 opcodeBase = reader.u8();
+    if (!reader.ok || lineRange == 0 || opcodeBase == 0) {
+        return false;
+    }
+
+    QVector<quint8> standardLengths(opcodeBase, 0);
+    for (int i = 1; i < opcodeBase; ++i) {
+        standardLengths[i] = reader.u8();
+    }
+
+    // 文件表：unitFiles[文件号] 为 m_lineFiles 下标
+    QStringList directories;
+    QVector<quint32> unitFiles;
+    const Section* debugStr = findSection(".debug_str");
+    const Section* debugLineStr = findSection(".debug_line_str");
+
+    auto sectionString = [this](const Section* section, quint64 offset) -> QString {
+        if (!section || offset >= section->size) {
+            return QString();
+        }
+        const char* text = reinterpret_cast<const char*>(m_data + section->offset + offset);
+        return QString::fromUtf8(text, static_cast<int>(strnlen(text, section->size - offset)));
+    };
+
+    if (version < 5) {
+        directories.append(QString());      // 0 为编译目录
+        for (;;) {
+            const char* directory = reader.cstr();
+            if (!reader.ok || !*directory) {
+                break;
+            }
+            directories.append(QString::fromUtf8(directory));
+        }
+
+        unitFiles.append(~0u);              // 文件号从 1 开始
+        for (;;) {
+            const char* name = reader.cstr();
+            if (!reader.ok || !*name) {
+                break;
+            }
+            const quint64 directory = reader.uleb();
+            reader.uleb();      // 修改时间
+            reader.uleb();      // 文件长度
+            unitFiles.append(static_cast<quint32>(m_lineFiles.size()));
+            m_lineFiles.append(joinPath(directory < static_cast<quint64>(directories.size())
+                                            ? directories[static_cast<int>(directory)] : QString(),
+                                        QString::fromUtf8(name)));
+        }
+    } else {
+        // DWARF 5：目录表和文件表由 (内容类型, 格式) 描述
+        for (int table = 0; table < 2 && reader.ok; ++table) {
+            const quint8 formatCount = reader.u8();
+            QVector<QPair<quint64, quint64>> formats;
+            for (int i = 0; i < formatCount; ++i) {
+                const quint64 contentType = reader.uleb();
+                const quint64 form = reader.uleb();
+                formats.append(qMakePair(contentType, form));
+            }
+
+            const quint64 entryCount = reader.uleb();
+            for (quint64 entry = 0; entry < entryCount && reader.ok; ++entry) {
+                QString path;
+                quint64 directory = 0;
+                for (const QPair<quint64, quint64>& format : formats) {
+                    QString text;
+                    quint64 number = 0;
+                    switch (format.second) {
+                    case DW_FORM_string: text = QString::fromUtf8(reader.cstr()); break;
+                    case DW_FORM_line_strp: text = sectionString(debugLineStr, reader.offset(offsetSize)); break;
+                    case DW_FORM_strp: text = sectionString(debugStr, reader.offset(offsetSize)); break;
+                    case DW_FORM_udata: number = reader.uleb(); break;
+                    case DW_FORM_sdata: reader.sleb(); break;
+                    case DW_FORM_data1: number = reader.u8(); break;
+                    case DW_FORM_data2: number = reader.u16(); break;
+                    case DW_FORM_data4: number = reader.u32(); break;
+                    case DW_FORM_data8: number = reader.u64(); break;
+                    case DW_FORM_data16: reader.skip(16); break;
+                    case DW_FORM_block: reader.skip(reader.uleb()); break;
+                    default:
+                        // 无法跳过的格式，放弃该单元
+                        return false;
+                    }
+
+                    if (format.first == DW_LNCT_path) {
+                        path = text;
+                    } else if (format.first == DW_LNCT_directory_index) {
+                        directory = number;
+                    }
+                }
+
+                if (table == 0) {
+                    directories.append(path);
+                } else {
+                    unitFiles.append(static_cast<quint32>(m_lineFiles.size()));
+                    m_lineFiles.append(joinPath(directory < static_cast<quint64>(directories.size())
+                                                    ? directories[static_cast<int>(directory)] : QString(),
+                                                path));
+                }
+            }
+        }
+    }
+
+    if (!reader.ok) {
+        return false;
+    }
+
+    // 执行行号程序；被链接器丢弃的函数其序列地址为 0，整段跳过
+    const bool zeroAddressValid = !m_functions.isEmpty() && m_functions.first().start == 0;
+    QVector<LineRow> sequence;
+    quint32 address = 0;
+    quint64 file = 1;
+    qint64 line = 1;
+
+    auto emitRow = [&](bool endSequence) {
+        LineRow row;
+        row.address = address;
+        row.file = file < static_cast<quint64>(unitFiles.size()) ? unitFiles[static_cast<int>(file)] : ~0u;
+        row.line = static_cast<quint32>(line);
+        row.endSequence = endSequence;
+        sequence.append(row);
+    };
+
+    reader = Reader(program, end);
+    while (reader.ok && reader.p < reader.end) {
+        const quint8 opcode = reader.u8();
+        if (opcode >= opcodeBase) {
+            const int adjusted = opcode - opcodeBase;
+            address += static_cast<quint32>(adjusted / lineRange) * minInstructionLength;
+            line += lineBase + adjusted % lineRange;
+            emitRow(false);
+            continue;
+        }
+
+        switch (opcode) {
+        case 0: {
+            const quint64 length = reader.uleb();
+            if (length == 0 || !reader.has(length)) {
+                break;
+            }
+            const uchar* next = reader.p + length;
+            const quint8 extended = reader.u8();
+            if (extended == DW_LNE_end_sequence) {
+                emitRow(true);
+                if (sequence.first().address != 0 || zeroAddressValid) {
+                    m_lines += sequence;
+                }
+                sequence.clear();
+                address = 0;
+                file = 1;
+                line = 1;
+            } else if (extended == DW_LNE_set_address) {
+                address = length >= 5 ? reader.u32() : 0;
+            } else if (extended == DW_LNE_define_file) {
+                const char* name = reader.cstr();
+                const quint64 directory = reader.uleb();
+                unitFiles.append(static_cast<quint32>(m_lineFiles.size()));
+                m_lineFiles.append(joinPath(directory < static_cast<quint64>(directories.size())
+                                                ? directories[static_cast<int>(directory)] : QString(),
+                                            QString::fromUtf8(name)));
+            }
+            reader.p = next;
+            break;
+        }
+        case DW_LNS_copy:
+            emitRow(false);
+            break;
+        case DW_LNS_advance_pc:
+            address += static_cast<quint32>(reader.uleb()) * minInstructionLength;
+            break;
+        case DW_LNS_advance_line:
+            line += reader.sleb();
+            break;
+        case DW_LNS_set_file:
+            file = reader.uleb();
+            break;
+        case DW_LNS_const_add_pc:
+            address += static_cast<quint32>((255 - opcodeBase) / lineRange) * minInstructionLength;
+            break;
+        case DW_LNS_fixed_advance_pc:
+            address += reader.u16();
+            break;
+        default:
+            // 其余标准操作码只需按参数个数跳过 ULEB128 参数
+            for (int i = 0; i < standardLengths[opcode]; ++i) {
+                reader.uleb();
+            }
+            break;
+        }
+    }
+
+    return reader.ok;
+}
+
+const ElfSymbolizer::Section* ElfSymbolizer::findSection(const char* name) const
+{
+    for (const Section& section : m_sections) {
+        if (strcmp(section.name, name) == 0) {
+            return &section;
+        }
+    }
+    return nullptr;
+}
+
+const char* ElfSymbolizer::functionName(const FunctionRange& range) const
+{
+    return range.nameOffset < m_strtabSize ? m_strtab + range.nameOffset : "";
+}
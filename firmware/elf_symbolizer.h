@@ -0,0 +1,110 @@
+#ifndef ELF_SYMBOLIZER_H
+#define ELF_SYMBOLIZER_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QCache>
+#include <QFile>
+#include <QSharedPointer>
+
+// 固件 ELF 地址解析（HardFault 的 PC/LR -> 函数+偏移、源文件:行号）
+// 1. 通过 QFile::map 映射文件，只解析文件头、节表和 .symtab，
+//    函数名直接引用映射中的 .strtab，不复制
+// 2. 函数按起始地址排序成区间表，二分查找
+// 3. .debug_line（DWARF 2~5）在第一次查询行号时才解析
+// 4. 已加载的固件按 build id（无 build id 时按路径、大小和修改时间）缓存，
+//    重复加载同一固件直接复用；每个固件的查询结果也会缓存，两者都按最近最少使用淘汰
+// 仅支持 32 位小端 ELF（Cortex-M 固件）；非线程安全，在界面线程使用
+class ElfSymbolizer
+{
+public:
+    struct Location {
+        bool valid;             // 地址落在某个函数内
+        QString function;
+        quint32 offset;         // 相对函数起始地址的偏移
+        QString file;           // 无行号信息时为空
+        int line;
+
+        Location() {
+            valid = false;
+            offset = 0;
+            line = 0;
+        }
+
+        // “函数+0x偏移 (文件:行号)”
+        QString toString() const;
+    };
+
+    // 加载固件，失败返回空指针并设置 error
+    static QSharedPointer<ElfSymbolizer> open(const QString& path, QString* error);
+
+    ~ElfSymbolizer();
+
+    QString path() const;
+    QByteArray buildId() const;     // 无 build id 时为空
+    int functionCount() const;
+    bool hasLineInfo() const;
+
+    // 解析地址（Thumb 位会被忽略）
+    Location resolve(quint32 address);
+
+private:
+    struct Section {
+        quint32 type;
+        quint32 offset;
+        quint32 size;
+        quint32 link;
+        const char* name;
+    };
+
+    // 函数区间 [start, end)
+    struct FunctionRange {
+        quint32 start;
+        quint32 end;
+        quint32 nameOffset;     // 在 .strtab 中的偏移
+    };
+
+    // 行号表中的一行
+    struct LineRow {
+        quint32 address;
+        quint32 file;           // m_lineFiles 下标
+        quint32 line;
+        bool endSequence;
+    };
+
+    ElfSymbolizer();
+
+    bool mapFile(const QString& path, QString* error);
+    bool parseSections(QString* error);
+    void parseBuildId();
+    bool loadFunctions(QString* error);
+    void loadLines();
+    bool parseLineUnit(const uchar* unit, const uchar* end);
+
+    const Section* findSection(const char* name) const;
+    const char* functionName(const FunctionRange& range) const;
+
+    static QCache<QByteArray, QSharedPointer<ElfSymbolizer>>& cache();
+
+    QString m_path;
+    QFile m_file;
+    const uchar* m_data;
+    qint64 m_size;
+
+    QVector<Section> m_sections;
+    QByteArray m_buildId;
+
+    const char* m_strtab;
+    quint32 m_strtabSize;
+    QVector<FunctionRange> m_functions;
+
+    bool m_linesLoaded;
+    QVector<LineRow> m_lines;
+    QStringList m_lineFiles;
+
+    QCache<quint32, Location> m_resolved;
+};
+
+#endif // ELF_SYMBOLIZER_H
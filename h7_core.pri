@@ -0,0 +1,79 @@
+# 与界面无关的通信、协议和遥测模块
+# 图形界面程序、无界面命令行程序等共用，路径相对于本文件
+INCLUDEPATH += $$PWD
+
+# 编译时去除 trace 级别日志（收发数据内容）: qmake CONFIG+=h7_no_trace
+h7_no_trace: DEFINES += H7_NO_TRACE_LOG
+
+# 编译时去除性能跟踪埋点: qmake CONFIG+=h7_no_span
+h7_no_span: DEFINES += H7_NO_SPAN
+
+# 遥测共享内存发布使用 shm_open，旧版 glibc 需要链接 librt
+linux: LIBS += -lrt
+
+SOURCES += \
+    $$PWD/pc_protocol.c \
+    $$PWD/common/log.cpp \
+    $$PWD/common/metrics_registry.cpp \
+    $$PWD/common/metrics_server.cpp \
+    $$PWD/common/trace_recorder.cpp \
+    $$PWD/firmware/elf_symbolizer.cpp \
+    $$PWD/protocol/config_transaction.cpp \
+    $$PWD/protocol/field_descriptor.cpp \
+    $$PWD/protocol/frame_pipeline.cpp \
+    $$PWD/protocol/message_json.cpp \
+    $$PWD/protocol/protocol_frame.cpp \
+    $$PWD/protocol/request_batch.cpp \
+    $$PWD/protocol/vcu_decoder.cpp \
+    $$PWD/communication/device_session.cpp \
+    $$PWD/communication/io_thread_pool.cpp \
+    $$PWD/communication/rx_buffer_pool.cpp \
+    $$PWD/communication/send_queue.cpp \
+    $$PWD/communication/serial_thread.cpp \
+    $$PWD/communication/serial_worker.cpp \
+    $$PWD/communication/socket_thread.cpp \
+    $$PWD/communication/socket_worker.cpp \
+    $$PWD/communication/transport_metrics.cpp \
+    $$PWD/telemetry/alarm_engine.cpp \
+    $$PWD/telemetry/hardfault_history.cpp \
+    $$PWD/telemetry/minmax_pyramid.cpp \
+    $$PWD/telemetry/snapshot_history.cpp \
+    $$PWD/telemetry/telemetry_archive.cpp \
+    $$PWD/telemetry/telemetry_exporter.cpp \
+    $$PWD/telemetry/telemetry_shm_publisher.cpp \
+    $$PWD/telemetry/telemetry_store.cpp
+
+HEADERS += \
+    $$PWD/pc_protocol.h \
+    $$PWD/common/log.h \
+    $$PWD/common/metrics_registry.h \
+    $$PWD/common/metrics_server.h \
+    $$PWD/common/trace_recorder.h \
+    $$PWD/firmware/elf_symbolizer.h \
+    $$PWD/protocol/config_transaction.h \
+    $$PWD/protocol/device_message.h \
+    $$PWD/protocol/field_descriptor.h \
+    $$PWD/protocol/frame_pipeline.h \
+    $$PWD/protocol/message_json.h \
+    $$PWD/protocol/protocol_frame.h \
+    $$PWD/protocol/request_batch.h \
+    $$PWD/protocol/vcu_decoder.h \
+    $$PWD/communication/device_session.h \
+    $$PWD/communication/device_task.h \
+    $$PWD/communication/io_thread_pool.h \
+    $$PWD/communication/rx_buffer_pool.h \
+    $$PWD/communication/send_queue.h \
+    $$PWD/communication/serial_thread.h \
+    $$PWD/communication/serial_worker.h \
+    $$PWD/communication/socket_thread.h \
+    $$PWD/communication/socket_worker.h \
+    $$PWD/communication/transport_metrics.h \
+    $$PWD/telemetry/alarm_engine.h \
+    $$PWD/telemetry/hardfault_history.h \
+    $$PWD/telemetry/minmax_pyramid.h \
+    $$PWD/telemetry/shm_layout.h \
+    $$PWD/telemetry/snapshot_history.h \
+    $$PWD/telemetry/telemetry_archive.h \
+    $$PWD/telemetry/telemetry_exporter.h \
+    $$PWD/telemetry/telemetry_shm_publisher.h \
+    $$PWD/telemetry/telemetry_store.h
@@ -2,36 +2,29 @@ QT       += core gui serialport network
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
-CONFIG += c++17
+# 协程设备接口（DeviceSession）需要 C++20；c++2a 兼容 Qt5 的 qmake
+CONFIG += c++2a
 
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+include(h7_core.pri)
+
 SOURCES += \
     main.cpp \
     mainwindow.cpp \
-    pc_protocol.c \
-    protocol/protocol_frame.cpp \
-    communication/serial_thread.cpp \
-    communication/serial_worker.cpp \
-    communication/socket_thread.cpp \
-    communication/socket_worker.cpp \
     ui/config_widget.cpp \
     ui/debug_widget.cpp \
-    ui/status_widget.cpp
+    ui/status_widget.cpp \
+    ui/telemetry_chart_widget.cpp
 
 HEADERS += \
     mainwindow.h \
-    pc_protocol.h \
-    protocol/protocol_frame.h \
-    communication/serial_thread.h \
-    communication/serial_worker.h \
-    communication/socket_thread.h \
-    communication/socket_worker.h \
     ui/config_widget.h \
     ui/debug_widget.h \
-    ui/status_widget.h
+    ui/status_widget.h \
+    ui/telemetry_chart_widget.h
 
 FORMS += \
     mainwindow.ui
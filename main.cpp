@@ -1,11 +1,58 @@
 #include "mainwindow.h"
+#include "common/log.h"
+#include "common/metrics_registry.h"
 
 #include <QApplication>
+#include <QElapsedTimer>
+#include <QTimer>
+
+/*
+    启动耗时：从进入 main 到主窗口第一次绘制
+    1. 结果输出到 h7.ui 日志并记入 h7_startup_first_paint_ms 指标
+    2. 设置环境变量 H7_STARTUP_EXIT=1 时第一次绘制后立即退出，便于脚本重复测量冷启动时间
+ */
+class FirstPaintProbe : public QObject
+{
+public:
+    FirstPaintProbe(QWidget* window, const QElapsedTimer& clock, qint64 constructedMs)
+        : m_window(window)
+        , m_clock(clock)
+        , m_constructedMs(constructedMs)
+    {
+    }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override
+    {
+        if (event->type() == QEvent::Paint && watched->isWidgetType()
+            && static_cast<QWidget*>(watched)->window() == m_window) {
+            const qint64 firstPaintMs = m_clock.elapsed();
+            qApp->removeEventFilter(this);
+            qCInfo(lcUi) << "启动耗时: 主窗口构建" << m_constructedMs << "ms, 首次绘制" << firstPaintMs << "ms";
+            MetricsRegistry::instance()->gauge("h7_startup_first_paint_ms", "启动到主窗口首次绘制的耗时(ms)")
+                ->set(firstPaintMs);
+            if (qEnvironmentVariableIntValue("H7_STARTUP_EXIT") != 0) {
+                QTimer::singleShot(0, qApp, &QCoreApplication::quit);
+            }
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    QWidget* m_window;
+    QElapsedTimer m_clock;
+    qint64 m_constructedMs;
+};
 
 int main(int argc, char *argv[])
 {
+    QElapsedTimer startupClock;
+    startupClock.start();
+
     QApplication a(argc, argv);
     MainWindow w;
+    FirstPaintProbe probe(&w, startupClock, startupClock.elapsed());
+    a.installEventFilter(&probe);
     w.show();
     return a.exec();
 }
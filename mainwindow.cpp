@@ -1,9 +1,13 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "common/trace_recorder.h"
 #include <QApplication>
 #include <QDateTime>
+#include <QFile>
 #include <QFileDialog>
+#include <QInputDialog>
 #include <QSettings>
+#include <QStandardPaths>
 #include <QDebug>
 
 MainWindow::MainWindow(QWidget *parent)
@@ -16,6 +20,15 @@ MainWindow::MainWindow(QWidget *parent)
     , m_statusTimer(nullptr)
     , m_serialThread(nullptr)
     , m_socketThread(nullptr)
+    , m_telemetryArchive(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/telemetry")
+    , m_shmPublisher(TelemetryShmPublisher::configuredName())
+    , m_hardFaultHistory(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/hardfault/history.h7hf")
+    , m_exportThread(nullptr)
+    , m_exporter(nullptr)
+    , m_exportProgress(nullptr)
+    , m_requestBatchTimer(nullptr)
+    , m_configTransactionTimer(nullptr)
+    , m_metricsServer(nullptr)
     , m_isConnected(false)
     , m_currentConnectionType(ConfigWidget::Serial)
 {
@@ -24,8 +37,18 @@ MainWindow::MainWindow(QWidget *parent)
     // 初始化各个组件
     setupUI();
     setupStatusBar();
+    
+    // 加载故障历史；失败原因（含不兼容文件的备份位置）在窗口显示后提示
+    if (!m_hardFaultHistory.load()) {
+        const QString error = m_hardFaultHistory.lastError();
+        m_debugWidget->addErrorMessage(error);
+        QTimer::singleShot(0, this, [this, error]() { showError(error); });
+    }
+    m_statusWidget->displayHardFaultLocations(m_hardFaultHistory.topLocations(50));
     setupMenuActions();
     setupCommunication();
+    setupMetricsServer();
+    setupShmPublisher();
     setupConnections();
     
     // 更新窗口标题
@@ -38,6 +61,16 @@ MainWindow::MainWindow(QWidget *parent)
     m_statusTimer = new QTimer(this);
     connect(m_statusTimer, &QTimer::timeout, this, &MainWindow::updateConnectionStatus);
     m_statusTimer->start(1000); // 每秒更新一次
+    
+    // 批量请求截止定时器
+    m_requestBatchTimer = new QTimer(this);
+    m_requestBatchTimer->setSingleShot(true);
+    connect(m_requestBatchTimer, &QTimer::timeout, this, &MainWindow::onRequestBatchTimeout);
+    
+    // 配置写入回读验证截止定时器
+    m_configTransactionTimer = new QTimer(this);
+    m_configTransactionTimer->setSingleShot(true);
+    connect(m_configTransactionTimer, &QTimer::timeout, this, &MainWindow::onConfigTransactionTimeout);
 }
 
 MainWindow::~MainWindow()
@@ -58,6 +91,13 @@ MainWindow::~MainWindow()
         m_socketThread->deleteLater();
     }
     
+    // 停止导出线程
+    if (m_exportThread) {
+        m_exporter->cancel();
+        m_exportThread->quit();
+        m_exportThread->wait();
+    }
+    
     delete ui;
 }
 
@@ -71,6 +111,7 @@ void MainWindow::setupUI()
     
     // 创建状态读取组件
     m_statusWidget = new StatusWidget(this);
+    m_statusWidget->setTelemetryStore(&m_telemetryStore);
     
     // 将组件添加到Tab页面中
     QVBoxLayout* configLayout = qobject_cast<QVBoxLayout*>(ui->configTab->layout());
@@ -134,6 +175,9 @@ void MainWindow::setupMenuActions()
     // 连接菜单动作
     connect(ui->actionSaveConfig, &QAction::triggered, this, &MainWindow::onSaveConfig);
     connect(ui->actionLoadConfig, &QAction::triggered, this, &MainWindow::onLoadConfig);
+    connect(ui->actionExportTelemetry, &QAction::triggered, this, &MainWindow::onExportTelemetry);
+    connect(ui->actionTraceRecord, &QAction::toggled, this, &MainWindow::onTraceRecordToggled);
+    connect(ui->actionTraceExport, &QAction::triggered, this, &MainWindow::onTraceExport);
     connect(ui->actionExit, &QAction::triggered, this, &MainWindow::onExit);
     connect(ui->actionAbout, &QAction::triggered, this, &MainWindow::onAbout);
 }
@@ -145,6 +189,56 @@ void MainWindow::setupCommunication()
     m_socketThread = new SocketThread(this);
 }
 
+void MainWindow::ensureExporter()
+{
+    // 导出器运行在独立线程中，避免大文件导出阻塞界面；第一次导出时才创建线程
+    // （导出是长时间的磁盘和压缩任务，不放到共享I/O线程上，以免阻塞收发）
+    if (m_exportThread) {
+        return;
+    }
+    
+    m_exportThread = new QThread(this);
+    m_exportThread->setObjectName("导出线程");
+    m_exporter = new TelemetryExporter();
+    m_exporter->moveToThread(m_exportThread);
+    
+    connect(m_exportThread, &QThread::finished, m_exporter, &QObject::deleteLater);
+    connect(m_exporter, &TelemetryExporter::progressChanged,
+            this, &MainWindow::onExportProgressChanged);
+    connect(m_exporter, &TelemetryExporter::exportFinished,
+            this, &MainWindow::onExportFinished);
+    
+    m_exportThread->start();
+}
+
+void MainWindow::setupMetricsServer()
+{
+    const quint16 port = MetricsServer::configuredPort();
+    if (port == 0) {
+        return;
+    }
+    
+    m_metricsServer = new MetricsServer(this);
+    if (m_metricsServer->listen(port)) {
+        m_debugWidget->addStatusMessage(QString("指标服务: http://127.0.0.1:%1/metrics").arg(m_metricsServer->port()));
+    } else {
+        m_debugWidget->addErrorMessage(m_metricsServer->lastError());
+    }
+}
+
+void MainWindow::setupShmPublisher()
+{
+    if (m_shmPublisher.name().isEmpty()) {
+        return;
+    }
+    
+    if (m_shmPublisher.open()) {
+        m_debugWidget->addStatusMessage(QString("遥测共享内存: %1").arg(m_shmPublisher.name()));
+    } else {
+        m_debugWidget->addErrorMessage(m_shmPublisher.lastError());
+    }
+}
+
 void MainWindow::setupConnections()
 {
     // 配置组件信号连接
@@ -178,10 +272,18 @@ void MainWindow::setupConnections()
             this, &MainWindow::onMaskAddressQueryRequested);
     connect(m_statusWidget, &StatusWidget::gatewayAddressQueryRequested,
             this, &MainWindow::onGatewayAddressQueryRequested);
+    connect(m_statusWidget, &StatusWidget::networkConfigReadRequested,
+            this, &MainWindow::onNetworkConfigReadRequested);
     
     // 串口通信信号连接
     connect(m_serialThread, &SerialThread::dataReceived,
             this, &MainWindow::onSerialDataReceived);
+    connect(m_serialThread, &SerialThread::messageReceived,
+            this, &MainWindow::onDeviceMessageReceived);
+    connect(m_serialThread, &SerialThread::alarmChanged,
+            this, &MainWindow::onAlarmChanged);
+    connect(m_serialThread, &SerialThread::backpressureChanged,
+            this, &MainWindow::onSendBackpressureChanged);
     connect(m_serialThread, &SerialThread::dataSent,
             this, &MainWindow::onSerialDataSent);
     connect(m_serialThread, &SerialThread::connectionStateChanged,
@@ -192,6 +294,12 @@ void MainWindow::setupConnections()
     // Socket通信信号连接
     connect(m_socketThread, &SocketThread::dataReceived,
             this, &MainWindow::onSocketDataReceived);
+    connect(m_socketThread, &SocketThread::messageReceived,
+            this, &MainWindow::onDeviceMessageReceived);
+    connect(m_socketThread, &SocketThread::alarmChanged,
+            this, &MainWindow::onAlarmChanged);
+    connect(m_socketThread, &SocketThread::backpressureChanged,
+            this, &MainWindow::onSendBackpressureChanged);
     connect(m_socketThread, &SocketThread::dataSent,
             this, &MainWindow::onSocketDataSent);
     connect(m_socketThread, &SocketThread::connectionStateChanged,
@@ -275,6 +383,144 @@ void MainWindow::onAbout()
         "<p>Copyright © 2024</p>");
 }
 
+void MainWindow::onTraceRecordToggled(bool checked)
+{
+    if (checked) {
+        TraceRecorder::start();
+        showMessage("开始记录性能跟踪");
+    } else {
+        TraceRecorder::stop();
+        showMessage("已停止记录性能跟踪");
+    }
+}
+
+void MainWindow::onTraceExport()
+{
+    // 导出前先停止记录，保证导出的是一份完整的数据
+    if (ui->actionTraceRecord->isChecked()) {
+        ui->actionTraceRecord->setChecked(false);
+    }
+    
+    QString fileName = QFileDialog::getSaveFileName(this,
+        "导出性能跟踪",
+        QString("h7_trace_%1.json").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss")),
+        "Chrome跟踪文件 (*.json)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        QMessageBox::warning(this, "导出性能跟踪", QString("无法创建文件: %1").arg(file.errorString()));
+        return;
+    }
+    
+    const int count = TraceRecorder::exportJson(&file);
+    file.close();
+    if (count < 0) {
+        QMessageBox::warning(this, "导出性能跟踪", QString("写入文件失败: %1").arg(file.errorString()));
+        return;
+    }
+    
+    QString message = QString("已导出 %1 个性能跟踪事件").arg(count);
+    const qint64 dropped = TraceRecorder::droppedEvents();
+    if (dropped > 0) {
+        message += QString("，缓冲已满丢弃 %1 个").arg(dropped);
+    }
+    showMessage(message);
+    m_debugWidget->addStatusMessage(message);
+}
+
+void MainWindow::onExportTelemetry()
+{
+    if (m_exportProgress) {
+        showMessage("已有导出任务正在进行");
+        return;
+    }
+    
+    // 先落盘，保证导出包含最新数据
+    m_telemetryArchive.flush();
+    
+    QStringList vehicles = m_telemetryArchive.vehicles();
+    if (vehicles.isEmpty()) {
+        QMessageBox::information(this, "导出遥测数据", "没有已归档的遥测数据");
+        return;
+    }
+    
+    QString vehicleId = vehicles.first();
+    if (vehicles.size() > 1) {
+        bool ok = false;
+        vehicleId = QInputDialog::getItem(this, "导出遥测数据", "选择车辆序列号:", vehicles, 0, false, &ok);
+        if (!ok) {
+            return;
+        }
+    }
+    
+    QPair<qint64, qint64> span = m_telemetryArchive.timeSpan(vehicleId);
+    if (span.first < 0) {
+        QMessageBox::information(this, "导出遥测数据", "该车辆没有遥测数据");
+        return;
+    }
+    
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName(this,
+        "导出遥测数据",
+        QString("telemetry_%1.csv").arg(vehicleId),
+        "CSV文件 (*.csv);;列式二进制文件 (*.h7c)",
+        &selectedFilter);
+    
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    int format = TelemetryExporter::Csv;
+    if (fileName.endsWith(".h7c", Qt::CaseInsensitive) || selectedFilter.contains("*.h7c")) {
+        format = TelemetryExporter::Columnar;
+    }
+    
+    ensureExporter();
+    
+    m_exportProgress = new QProgressDialog("正在导出遥测数据...", "取消", 0, 100, this);
+    m_exportProgress->setWindowModality(Qt::WindowModal);
+    m_exportProgress->setMinimumDuration(0);
+    m_exportProgress->setAutoClose(false);
+    m_exportProgress->setAutoReset(false);
+    connect(m_exportProgress, &QProgressDialog::canceled, this, [this]() {
+        m_exporter->cancel();
+    });
+    m_exportProgress->setValue(0);
+    
+    m_exporter->beginExport();
+    QMetaObject::invokeMethod(m_exporter, "exportArchive", Qt::QueuedConnection,
+                              Q_ARG(QString, m_telemetryArchive.rootPath()),
+                              Q_ARG(QString, vehicleId),
+                              Q_ARG(qint64, span.first),
+                              Q_ARG(qint64, span.second),
+                              Q_ARG(QString, fileName),
+                              Q_ARG(int, format));
+}
+
+void MainWindow::onExportProgressChanged(int percent)
+{
+    if (m_exportProgress) {
+        m_exportProgress->setValue(percent);
+    }
+}
+
+void MainWindow::onExportFinished(bool success, const QString& message)
+{
+    if (m_exportProgress) {
+        m_exportProgress->deleteLater();
+        m_exportProgress = nullptr;
+    }
+    
+    if (success) {
+        showMessage(message);
+    } else {
+        showError(message);
+    }
+}
+
 // 通信控制槽函数
 void MainWindow::onConnectRequested(ConfigWidget::CommunicationType type)
 {
@@ -286,6 +532,10 @@ void MainWindow::onConnectRequested(ConfigWidget::CommunicationType type)
     m_currentConnectionType = type;
     bool success = false;
     
+    // 新连接的车辆在收到VCU信息前未知
+    m_currentVehicleId.clear();
+    discardPendingHardFaults();
+    
     if (type == ConfigWidget::Serial) {
         auto config = m_configWidget->getSerialConfig();
         success = m_serialThread->openSerial(config);
@@ -323,6 +573,7 @@ void MainWindow::onDisconnectRequested()
         m_debugWidget->addStatusMessage("Socket连接已断开");
     }
     
+    discardPendingHardFaults();
     m_isConnected = false;
     m_configWidget->setConnectionState(false, m_currentConnectionType);
     updateWindowTitle();
@@ -338,7 +589,7 @@ void MainWindow::onMacAddressSetRequested(uint8_t macHighByte)
     }
     
     QByteArray frame = ProtocolFrame::buildMacSetFrame(macHighByte);
-    if (sendProtocolFrame(frame)) {
+    if (submitConfigWrite("mac", frame)) {
         m_debugWidget->addStatusMessage(QString("MAC地址设置命令已发送，高字节: 0x%1")
                                       .arg(macHighByte, 2, 16, QChar('0')).toUpper());
     }
@@ -352,7 +603,7 @@ void MainWindow::onIpAddressSetRequested(const QString& ipAddress)
     }
     
     QByteArray frame = ProtocolFrame::buildIpSetFrame(ipAddress);
-    if (!frame.isEmpty() && sendProtocolFrame(frame)) {
+    if (!frame.isEmpty() && submitConfigWrite("ip", frame)) {
         m_debugWidget->addStatusMessage(QString("IP地址设置命令已发送: %1").arg(ipAddress));
     } else {
         if (frame.isEmpty()) {
@@ -371,7 +622,7 @@ void MainWindow::onMaskAddressSetRequested(const QString& maskAddress)
     }
 
     QByteArray frame = ProtocolFrame::buildMaskSetFrame(maskAddress);
-    if (!frame.isEmpty() && sendProtocolFrame(frame)) {
+    if (!frame.isEmpty() && submitConfigWrite("mask", frame)) {
         m_debugWidget->addStatusMessage(QString("子网掩码设置命令已发送: %1").arg(maskAddress));
     } else {
         if (frame.isEmpty()) {
@@ -390,7 +641,7 @@ void MainWindow::onGatewayAddressSetRequested(const QString& gatewayAddress)
     }
 
     QByteArray frame = ProtocolFrame::buildGatewaySetFrame(gatewayAddress);
-    if (!frame.isEmpty() && sendProtocolFrame(frame)) {
+    if (!frame.isEmpty() && submitConfigWrite("gateway", frame)) {
         m_debugWidget->addStatusMessage(QString("网关地址设置命令已发送: %1").arg(gatewayAddress));
     } else {
         if (frame.isEmpty()) {
@@ -409,7 +660,7 @@ void MainWindow::onVcuParamSetRequested(const QString& frontDecObstacleDistance,
     }
 
     QByteArray frame = ProtocolFrame::buildVcuParamSetFrame(frontDecObstacleDistance, frontStopObstacleDistance, rearObstacleDistance, speedCorrectionFactor);
-    if (!frame.isEmpty() && sendProtocolFrame(frame)) {
+    if (!frame.isEmpty() && submitConfigWrite("vcu-param", frame)) {
         m_debugWidget->addStatusMessage(QString("VCU参数设置命令已发送: 前避障减速距离: %1, 前避障停止距离: %2, 后避障距离: %3, 速度校正系数: %4")
                                       .arg(frontDecObstacleDistance).arg(frontStopObstacleDistance).arg(rearObstacleDistance).arg(speedCorrectionFactor));
     } else {
@@ -439,6 +690,7 @@ void MainWindow::onHardFaultInfoReadRequested()
 
 void MainWindow::onVcuInfoReadRequested()
 {
+    H7_SPAN("ui", "readRequest");
     if (!m_isConnected) {
         m_statusWidget->showErrorMessage("请先建立通信连接");
         return;
@@ -512,11 +764,151 @@ void MainWindow::onGatewayAddressQueryRequested()
     }
 }
 
+void MainWindow::onNetworkConfigReadRequested()
+{
+    if (!m_isConnected) {
+        m_statusWidget->showErrorMessage("请先建立通信连接");
+        return;
+    }
+    if (m_requestBatch.isStarted()) {
+        m_statusWidget->showErrorMessage("上一次批量请求尚未完成");
+        return;
+    }
+    
+    // 四项查询首尾相接一次写出，串口上约一个往返即可完成
+    m_requestBatch = RequestBatch::networkConfigQuery();
+    if (!sendProtocolBatch(m_requestBatch.frames(), SendQueue::OneShotQuery)) {
+        m_requestBatch = RequestBatch();
+        m_statusWidget->showErrorMessage("网络配置读取发送失败");
+        return;
+    }
+    m_requestBatch.start(RequestBatchTimeoutMs);
+    m_requestBatchTimer->start(RequestBatchTimeoutMs);
+    m_statusWidget->setReadingStatus(true, "正在读取网络配置...");
+    m_debugWidget->addStatusMessage(QString("网络配置读取命令已发送（%1 帧批量）").arg(m_requestBatch.size()));
+}
+
+void MainWindow::onRequestBatchTimeout()
+{
+    if (!m_requestBatch.isStarted()) {
+        return;
+    }
+    finishRequestBatch();
+}
+
+void MainWindow::finishRequestBatch()
+{
+    m_requestBatchTimer->stop();
+    
+    const QStringList pending = m_requestBatch.pendingNames();
+    const QStringList failed = m_requestBatch.failedNames();
+    const qint64 elapsed = m_requestBatch.elapsedMs();
+    m_requestBatch = RequestBatch();
+    
+    m_statusWidget->setReadingStatus(false, "就绪");
+    if (pending.isEmpty() && failed.isEmpty()) {
+        m_debugWidget->addStatusMessage(QString("网络配置读取完成，用时 %1 ms").arg(elapsed));
+        return;
+    }
+    
+    QStringList problems;
+    if (!pending.isEmpty()) {
+        problems.append(QString("未应答: %1").arg(pending.join(", ")));
+    }
+    if (!failed.isEmpty()) {
+        problems.append(QString("应答无效: %1").arg(failed.join(", ")));
+    }
+    m_debugWidget->addErrorMessage(QString("网络配置读取未完成（%1 ms）: %2").arg(elapsed).arg(problems.join("; ")));
+    m_statusWidget->showErrorMessage("网络配置读取不完整");
+}
+
+bool MainWindow::submitConfigWrite(const QString& name, const QByteArray& setFrame)
+{
+    ConfigTransaction transaction;
+    QString error;
+    if (!transaction.add(name, setFrame, &error)) {
+        m_debugWidget->addErrorMessage(error);
+        return false;
+    }
+    
+    // 事务串行执行：上一项回读完成后再写下一项，保证回读值对应本次设置
+    m_pendingTransactions.append(transaction);
+    if (!m_configTransaction.isStarted()) {
+        startNextConfigTransaction();
+    }
+    return true;
+}
+
+void MainWindow::startNextConfigTransaction()
+{
+    m_configTransaction = ConfigTransaction();
+    while (!m_pendingTransactions.isEmpty()) {
+        ConfigTransaction transaction = m_pendingTransactions.takeFirst();
+        
+        // 设置帧和回读查询作为一个批次写出
+        if (sendProtocolBatch(transaction.frames(), SendQueue::ConfigWrite)) {
+            m_configTransaction = transaction;
+            m_configTransaction.start(ConfigTransactionTimeoutMs);
+            m_configTransactionTimer->start(ConfigTransactionTimeoutMs);
+            return;
+        }
+        m_debugWidget->addErrorMessage("配置写入发送失败：连接已断开");
+    }
+}
+
+void MainWindow::onConfigTransactionTimeout()
+{
+    if (!m_configTransaction.isStarted()) {
+        return;
+    }
+    finishConfigTransaction();
+}
+
+void MainWindow::finishConfigTransaction()
+{
+    m_configTransactionTimer->stop();
+    m_configTransaction.finish();
+    
+    static const QHash<QString, QString> labels = {
+        {"mac", "MAC地址"}, {"ip", "IP地址"}, {"mask", "子网掩码"}, {"gateway", "网关地址"}, {"vcu-param", "VCU参数"}
+    };
+    
+    const qint64 elapsed = m_configTransaction.elapsedMs();
+    for (const ConfigTransaction::Field& field : m_configTransaction.fields()) {
+        const QString label = labels.value(field.name, field.name);
+        const QString expected = ConfigTransaction::displayValue(field.name, field.expected);
+        switch (field.result) {
+        case ConfigTransaction::Verified:
+            m_debugWidget->addStatusMessage(QString("%1设置成功，回读一致: %2（%3 ms）").arg(label, expected).arg(elapsed));
+            break;
+        case ConfigTransaction::Unverifiable:
+            m_debugWidget->addStatusMessage(QString("%1已写入，设备不支持回读验证").arg(label));
+            break;
+        case ConfigTransaction::Mismatch:
+            m_debugWidget->addErrorMessage(QString("%1回读不一致: 设置 %2，设备 %3")
+                                           .arg(label, expected, ConfigTransaction::displayValue(field.name, field.actual)));
+            break;
+        case ConfigTransaction::InvalidReply:
+            m_debugWidget->addErrorMessage(QString("%1回读应答无效").arg(label));
+            break;
+        case ConfigTransaction::NoReply:
+        case ConfigTransaction::Pending:
+            m_debugWidget->addErrorMessage(QString("%1回读超时（%2 ms）").arg(label).arg(elapsed));
+            break;
+        }
+    }
+    if (!m_configTransaction.succeeded()) {
+        showError("配置写入验证失败，详见调试信息");
+    }
+    
+    startNextConfigTransaction();
+}
+
 // 串口通信槽函数
-void MainWindow::onSerialDataReceived(const QByteArray& data)
+void MainWindow::onSerialDataReceived(const RxChunk& chunk)
 {
-    m_debugWidget->addReceivedData(data);
-    processReceivedFrame(data);
+    // rawData() 直接引用缓冲池数据块，不复制数据；帧解析已在工作线程完成
+    m_debugWidget->addReceivedData(chunk.rawData());
 }
 
 void MainWindow::onSerialDataSent(const QByteArray& data)
@@ -541,10 +933,10 @@ void MainWindow::onSerialError(const QString& error)
 }
 
 // Socket通信槽函数
-void MainWindow::onSocketDataReceived(const QByteArray& data)
+void MainWindow::onSocketDataReceived(const RxChunk& chunk)
 {
-    m_debugWidget->addReceivedData(data);
-    processReceivedFrame(data);
+    // rawData() 直接引用缓冲池数据块，不复制数据；帧解析已在工作线程完成
+    m_debugWidget->addReceivedData(chunk.rawData());
 }
 
 void MainWindow::onSocketDataSent(const QByteArray& data)
@@ -568,6 +960,31 @@ void MainWindow::onSocketError(const QString& error)
     showError(QString("Socket错误: %1").arg(error));
 }
 
+void MainWindow::onAlarmChanged(const AlarmEvent& event)
+{
+    QString text = QString("%1 [%2] %3=%4")
+                   .arg(event.message, event.deviceId, event.field)
+                   .arg(event.value, 0, 'f', 2);
+    
+    if (event.active) {
+        QString level = event.severity == AlarmRule::Critical ? "严重报警" : "报警";
+        m_debugWidget->addErrorMessage(QString("%1: %2").arg(level, text));
+        showMessage(QString("%1: %2").arg(level, event.message), 10000);
+    } else {
+        m_debugWidget->addStatusMessage(QString("报警解除: %1").arg(text));
+    }
+}
+
+void MainWindow::onSendBackpressureChanged(bool congested)
+{
+    // 界面程序只有用户触发的单次请求，没有周期轮询可降频，只提示用户
+    if (congested) {
+        m_debugWidget->addErrorMessage("发送队列拥塞，请降低请求频率");
+    } else {
+        m_debugWidget->addStatusMessage("发送队列恢复正常");
+    }
+}
+
 // 工具方法
 void MainWindow::updateConnectionStatus()
 {
@@ -581,6 +998,16 @@ void MainWindow::updateConnectionStatus()
     } else {
         m_statusLabel->setText("就绪");
     }
+    
+    // 更新发送队列统计
+    if (m_currentConnectionType == ConfigWidget::Serial) {
+        m_debugWidget->setSendQueueStats(m_serialThread->sendQueueStats());
+    } else {
+        m_debugWidget->setSendQueueStats(m_socketThread->sendQueueStats());
+    }
+    
+    // 归档数据每秒落盘一次
+    m_telemetryArchive.flush();
 }
 
 void MainWindow::showMessage(const QString& message, int timeout)
@@ -606,103 +1033,157 @@ void MainWindow::updateWindowTitle()
 }
 
 bool MainWindow::sendProtocolFrame(const QByteArray& frameData)
+{
+    // 按功能码确定优先级：设置命令优先于查询
+    return sendProtocolFrame(frameData, SendQueue::priorityForFrame(frameData));
+}
+
+bool MainWindow::sendProtocolFrame(const QByteArray& frameData, SendQueue::Priority priority)
 {
     if (!m_isConnected || frameData.isEmpty()) {
         return false;
     }
     
     if (m_currentConnectionType == ConfigWidget::Serial) {
-        m_serialThread->sendData(frameData);
+        m_serialThread->sendData(frameData, priority);
     } else {
-        m_socketThread->sendData(frameData);
+        m_socketThread->sendData(frameData, priority);
     }
     
     return true;
 }
 
-void MainWindow::processReceivedFrame(const QByteArray& frameData)
+bool MainWindow::sendProtocolBatch(const QList<QByteArray>& frames, SendQueue::Priority priority)
 {
-    // 解析接收到的帧数据
-    auto parsedData = ProtocolFrame::parseFrame(frameData);
+    if (!m_isConnected || frames.isEmpty()) {
+        return false;
+    }
     
-    if (parsedData.isValid) {
-        QString info = QString("收到有效帧: 功能码 0x%1, 数据长度 %2")
-                      .arg(parsedData.functionCode, 4, 16, QChar('0'))
-                      .arg(parsedData.data.size());
-        m_debugWidget->addStatusMessage(info);
-        
-        // 处理特定功能码的响应数据
-        switch (parsedData.functionCode) {
-            case PC_HARDFAULT_INFO_GET:
-                if (parsedData.data.size() == sizeof(hardfault_info_t)) {
-                    const hardfault_info_t* hardFaultInfo = 
-                        reinterpret_cast<const hardfault_info_t*>(parsedData.data.constData());
-                    m_statusWidget->displayHardFaultInfo(*hardFaultInfo);
-                    m_debugWidget->addStatusMessage("HardFault故障信息解析成功");
-                } else {
-                    m_statusWidget->showErrorMessage(QString("HardFault数据长度错误: 期望 %1, 实际 %2")
-                                                   .arg(sizeof(hardfault_info_t)).arg(parsedData.data.size()));
-                }
-                break;
-                
-            case PC_VCU_INFO_GET:
-                if (parsedData.data.size() == sizeof(state_def_t)) {
-                    const state_def_t* vcuInfo = 
-                        reinterpret_cast<const state_def_t*>(parsedData.data.constData());
-                    m_statusWidget->displayVcuInfo(*vcuInfo);
-                    m_debugWidget->addStatusMessage("VCU综合信息解析成功");
-                } else {
-                    m_statusWidget->showErrorMessage(QString("VCU数据长度错误: 期望 %1, 实际 %2")
-                                                   .arg(sizeof(state_def_t)).arg(parsedData.data.size()));
-                }
-                break;
-                
-            case PC_MAC_ADDR_QUERY:
-                if (parsedData.data.size() == 6) {
-                    m_statusWidget->displayMacAddress(parsedData.data);
-                    m_debugWidget->addStatusMessage("MAC地址查询成功");
-                } else {
-                    m_statusWidget->showErrorMessage(QString("MAC地址数据长度错误: 期望 6, 实际 %1")
-                                                   .arg(parsedData.data.size()));
-                }
-                break;
-                
-            case PC_IP_ADDR_QUERY:
-                if (parsedData.data.size() == 4) {
-                    m_statusWidget->displayIpAddress(parsedData.data);
-                    m_debugWidget->addStatusMessage("IP地址查询成功");
-                } else {
-                    m_statusWidget->showErrorMessage(QString("IP地址数据长度错误: 期望 4, 实际 %1")
-                                                   .arg(parsedData.data.size()));
-                }
-                break;
-                
-            case PC_MASK_ADDR_QUERY:
-                if (parsedData.data.size() == 4) {
-                    m_statusWidget->displayMaskAddress(parsedData.data);
-                    m_debugWidget->addStatusMessage("子网掩码查询成功");
-                } else {
-                    m_statusWidget->showErrorMessage(QString("子网掩码数据长度错误: 期望 4, 实际 %1")
-                                                   .arg(parsedData.data.size()));
-                }
-                break;
-                
-            case PC_GATEWAY_ADDR_QUERY:
-                if (parsedData.data.size() == 4) {
-                    m_statusWidget->displayGatewayAddress(parsedData.data);
-                    m_debugWidget->addStatusMessage("网关地址查询成功");
-                } else {
-                    m_statusWidget->showErrorMessage(QString("网关地址数据长度错误: 期望 4, 实际 %1")
-                                                   .arg(parsedData.data.size()));
-                }
+    if (m_currentConnectionType == ConfigWidget::Serial) {
+        m_serialThread->sendBatch(frames, priority);
+    } else {
+        m_socketThread->sendBatch(frames, priority);
+    }
+    
+    return true;
+}
+
+void MainWindow::onDeviceMessageReceived(const DeviceMessage& message)
+{
+    // 工作线程发出到界面线程开始处理的排队时间
+    H7_SPAN_SINCE("ui", "deliver", message.traceEmitNs);
+    H7_SPAN("ui", "widgetUpdate");
+    
+    // 帧重组、CRC校验和解码均已在工作线程完成，这里只负责显示
+    if (message.type == DeviceMessage::InvalidFrame) {
+        m_debugWidget->addErrorMessage(QString("帧解析失败: %1").arg(message.errorMessage));
+        m_statusWidget->showErrorMessage(QString("数据解析失败: %1").arg(message.errorMessage));
+        return;
+    }
+    
+    QString info = QString("收到有效帧: 功能码 0x%1, 数据长度 %2")
+                  .arg(message.functionCode, 4, 16, QChar('0'))
+                  .arg(message.dataLength);
+    m_debugWidget->addStatusMessage(info);
+    
+    switch (message.type) {
+        case DeviceMessage::PayloadError:
+            m_statusWidget->showErrorMessage(message.errorMessage);
+            break;
+            
+        case DeviceMessage::HardFaultInfo: {
+            // 设备没有故障时应答全零结构，只提示，不显示寄存器也不记入历史
+            if (!HardFaultHistory::isFaultRecord(message.hardFaultInfo->info)) {
+                m_statusWidget->displayNoHardFault();
+                m_debugWidget->addStatusMessage("设备无HardFault故障记录");
                 break;
-                
-            default:
-                // 其他功能码的处理保持原样
+            }
+            
+            m_statusWidget->displayHardFaultInfo(message.hardFaultInfo->info);
+            m_debugWidget->addStatusMessage("HardFault故障信息解析成功");
+            
+            if (!m_currentVehicleId.isEmpty()) {
+                recordHardFault(m_currentVehicleId, message.hardFaultInfo->receivedAtMs, message.hardFaultInfo->info);
                 break;
+            }
+            
+            // 车辆未知时不记录，否则不同车辆的故障会按同一标识去重合并
+            HardFaultHistory::Record pending;
+            pending.receivedAtMs = message.hardFaultInfo->receivedAtMs;
+            pending.info = message.hardFaultInfo->info;
+            m_pendingHardFaults.append(pending);
+            if (m_pendingHardFaults.size() == 1) {
+                sendProtocolFrame(ProtocolFrame::buildVcuInfoGetFrame());
+            }
+            m_debugWidget->addStatusMessage("车辆序列号未知，已查询VCU综合信息，收到后记录该故障");
+            break;
         }
-    } else {
-        m_debugWidget->addErrorMessage(QString("帧解析失败: %1").arg(parsedData.errorMessage));
-        m_statusWidget->showErrorMessage(QString("数据解析失败: %1").arg(parsedData.errorMessage));
+            
+        case DeviceMessage::VcuInfo:
+            m_currentVehicleId = TelemetryArchive::vehicleIdOf(message.vcuInfo->state);
+            for (const HardFaultHistory::Record& pending : m_pendingHardFaults) {
+                recordHardFault(m_currentVehicleId, pending.receivedAtMs, pending.info);
+            }
+            m_pendingHardFaults.clear();
+            m_telemetryStore.append(*message.vcuInfo);
+            m_telemetryArchive.append(*message.vcuInfo);
+            m_shmPublisher.publish(*message.vcuInfo);
+            m_statusWidget->notifyTelemetryAppended();
+            m_statusWidget->displayVcuInfo(message.vcuInfo->state);
+            m_debugWidget->addStatusMessage("VCU综合信息解析成功");
+            break;
+            
+        case DeviceMessage::MacAddress:
+            m_statusWidget->displayMacAddress(message.payload);
+            m_debugWidget->addStatusMessage("MAC地址查询成功");
+            break;
+            
+        case DeviceMessage::IpAddress:
+            m_statusWidget->displayIpAddress(message.payload);
+            m_debugWidget->addStatusMessage("IP地址查询成功");
+            break;
+            
+        case DeviceMessage::MaskAddress:
+            m_statusWidget->displayMaskAddress(message.payload);
+            m_debugWidget->addStatusMessage("子网掩码查询成功");
+            break;
+            
+        case DeviceMessage::GatewayAddress:
+            m_statusWidget->displayGatewayAddress(message.payload);
+            m_debugWidget->addStatusMessage("网关地址查询成功");
+            break;
+            
+        default:
+            // 其他功能码的处理保持原样
+            break;
+    }
+    
+    // 批量请求按功能码收集应答，到达顺序不限
+    if (m_requestBatch.isStarted() && m_requestBatch.accept(message) && m_requestBatch.isComplete()) {
+        finishRequestBatch();
+    }
+    if (m_configTransaction.isStarted() && m_configTransaction.accept(message) && m_configTransaction.isComplete()) {
+        finishConfigTransaction();
+    }
+}
+
+void MainWindow::recordHardFault(const QString& vehicleId, qint64 receivedAtMs, const hardfault_info_t& info)
+{
+    HardFaultHistory::AddResult result = m_hardFaultHistory.add(vehicleId, receivedAtMs, info);
+    if (result == HardFaultHistory::Added) {
+        m_debugWidget->addStatusMessage(QString("已记录车辆 %1 的新故障").arg(vehicleId));
+        m_statusWidget->displayHardFaultLocations(m_hardFaultHistory.topLocations(50));
+    } else if (result == HardFaultHistory::Failed) {
+        m_debugWidget->addErrorMessage(m_hardFaultHistory.lastError());
+    }
+}
+
+void MainWindow::discardPendingHardFaults()
+{
+    if (m_pendingHardFaults.isEmpty()) {
+        return;
     }
+    m_debugWidget->addErrorMessage(QString("连接期间未收到VCU综合信息，%1 条HardFault故障因车辆未知未记录到历史")
+                                   .arg(m_pendingHardFaults.size()));
+    m_pendingHardFaults.clear();
 }
@@ -7,12 +7,22 @@
 #include <QLabel>
 #include <QTimer>
 #include <QMessageBox>
+#include <QThread>
+#include <QProgressDialog>
 #include "ui/config_widget.h"
 #include "ui/debug_widget.h"
 #include "ui/status_widget.h"
 #include "communication/serial_thread.h"
 #include "communication/socket_thread.h"
 #include "protocol/protocol_frame.h"
+#include "protocol/config_transaction.h"
+#include "protocol/request_batch.h"
+#include "telemetry/telemetry_store.h"
+#include "telemetry/telemetry_archive.h"
+#include "telemetry/telemetry_exporter.h"
+#include "telemetry/telemetry_shm_publisher.h"
+#include "telemetry/hardfault_history.h"
+#include "common/metrics_server.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -34,6 +44,15 @@ private slots:
     void onLoadConfig();
     void onExit();
     void onAbout();
+    void onExportTelemetry();
+    
+    // 遥测导出进度和结果
+    void onExportProgressChanged(int percent);
+    void onExportFinished(bool success, const QString& message);
+    
+    // 性能跟踪
+    void onTraceRecordToggled(bool checked);
+    void onTraceExport();
     
     // 通信控制槽函数
     void onConnectRequested(ConfigWidget::CommunicationType type);
@@ -55,19 +74,31 @@ private slots:
     void onIpAddressQueryRequested();
     void onMaskAddressQueryRequested();
     void onGatewayAddressQueryRequested();
+    void onNetworkConfigReadRequested();
+    void onRequestBatchTimeout();
+    void onConfigTransactionTimeout();
     
     // 串口通信槽函数
-    void onSerialDataReceived(const QByteArray& data);
+    void onSerialDataReceived(const RxChunk& chunk);
     void onSerialDataSent(const QByteArray& data);
     void onSerialConnectionChanged(bool connected);
     void onSerialError(const QString& error);
     
     // Socket通信槽函数
-    void onSocketDataReceived(const QByteArray& data);
+    void onSocketDataReceived(const RxChunk& chunk);
     void onSocketDataSent(const QByteArray& data);
     void onSocketConnectionChanged(bool connected);
     void onSocketError(const QString& error);
     
+    // 解码后的设备消息（串口和Socket共用）
+    void onDeviceMessageReceived(const DeviceMessage& message);
+    
+    // 报警状态变化（串口和Socket共用）
+    void onAlarmChanged(const AlarmEvent& event);
+    
+    // 发送队列背压（串口和Socket共用）
+    void onSendBackpressureChanged(bool congested);
+    
     // 状态更新
     void updateConnectionStatus();
 
@@ -86,6 +117,38 @@ private:
     SerialThread* m_serialThread;
     SocketThread* m_socketThread;
     
+    // 遥测时间序列
+    TelemetryStore m_telemetryStore;
+    TelemetryArchive m_telemetryArchive;
+    
+    // 遥测共享内存发布，供本机其他进程读取最新样本
+    TelemetryShmPublisher m_shmPublisher;
+    
+    // HardFault故障历史；HardFault帧不含序列号，按最近一次VCU信息中的车辆记录
+    // 连接后尚未收到VCU信息时先暂存，并主动查询VCU信息，收到后再按车辆记录
+    HardFaultHistory m_hardFaultHistory;
+    QString m_currentVehicleId;
+    QList<HardFaultHistory::Record> m_pendingHardFaults;
+    
+    // 遥测导出（独立线程，第一次导出时启动）
+    QThread* m_exportThread;
+    TelemetryExporter* m_exporter;
+    QProgressDialog* m_exportProgress;
+    
+    // 流水线批量请求（网络配置一次读取），同一时间只有一个批次
+    static constexpr int RequestBatchTimeoutMs = 3000;
+    RequestBatch m_requestBatch;
+    QTimer* m_requestBatchTimer;
+    
+    // 配置写入并回读验证，按提交顺序逐个执行
+    static constexpr int ConfigTransactionTimeoutMs = 3000;
+    ConfigTransaction m_configTransaction;
+    QList<ConfigTransaction> m_pendingTransactions;
+    QTimer* m_configTransactionTimer;
+    
+    // 运行指标服务（本机 HTTP，Prometheus 格式）
+    MetricsServer* m_metricsServer;
+    
     // 当前连接状态
     bool m_isConnected;
     ConfigWidget::CommunicationType m_currentConnectionType;
@@ -96,13 +159,23 @@ private:
     void setupStatusBar();
     void setupConnections();
     void setupCommunication();
+    void ensureExporter();
+    void setupMetricsServer();
+    void setupShmPublisher();
     
     // 工具方法
     void showMessage(const QString& message, int timeout = 3000);
     void showError(const QString& error);
     void updateWindowTitle();
     bool sendProtocolFrame(const QByteArray& frameData);
-    void processReceivedFrame(const QByteArray& frameData);
+    bool sendProtocolFrame(const QByteArray& frameData, SendQueue::Priority priority);
+    bool sendProtocolBatch(const QList<QByteArray>& frames, SendQueue::Priority priority);
+    void finishRequestBatch();
+    bool submitConfigWrite(const QString& name, const QByteArray& setFrame);
+    void startNextConfigTransaction();
+    void finishConfigTransaction();
+    void recordHardFault(const QString& vehicleId, qint64 receivedAtMs, const hardfault_info_t& info);
+    void discardPendingHardFaults();
 };
 
 #endif // MAINWINDOW_H
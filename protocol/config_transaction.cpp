@@ -0,0 +1,219 @@
+#include "config_transaction.h"
+#include "message_json.h"
+#include "protocol_frame.h"
+#include <QStringList>
+#include <cstring>
+
+namespace {
+
+// 设置功能码对应的查询功能码，没有查询时返回 0
+quint16 queryCodeFor(quint16 setCode)
+{
+    switch (setCode) {
+    case PC_MAC_ADDR_SET:
+        return PC_MAC_ADDR_QUERY;
+    case PC_IP_ADDR_SET:
+        return PC_IP_ADDR_QUERY;
+    case PC_MASK_ADDR_SET:
+        return PC_MASK_ADDR_QUERY;
+    case PC_GATEWAY_ADDR_SET:
+        return PC_GATEWAY_ADDR_QUERY;
+    default:
+        return 0;
+    }
+}
+
+QByteArray queryFrameFor(quint16 queryCode)
+{
+    switch (queryCode) {
+    case PC_MAC_ADDR_QUERY:
+        return ProtocolFrame::buildMacQueryFrame();
+    case PC_IP_ADDR_QUERY:
+        return ProtocolFrame::buildIpQueryFrame();
+    case PC_MASK_ADDR_QUERY:
+        return ProtocolFrame::buildMaskQueryFrame();
+    case PC_GATEWAY_ADDR_QUERY:
+        return ProtocolFrame::buildGatewayQueryFrame();
+    default:
+        return QByteArray();
+    }
+}
+
+} // namespace
+
+ConfigTransaction::ConfigTransaction()
+{
+}
+
+bool ConfigTransaction::add(const QString& name, const QByteArray& setFrame, QString* error)
+{
+    const int headerSize = static_cast<int>(sizeof(pc_comm_protocol__head_t));
+    if (setFrame.size() < headerSize + 2) {
+        if (error) {
+            *error = QString("%1 设置帧无效").arg(name);
+        }
+        return false;
+    }
+    for (const Field& field : m_fields) {
+        if (field.name == name) {
+            if (error) {
+                *error = QString("%1 重复设置").arg(name);
+            }
+            return false;
+        }
+    }
+
+    pc_comm_protocol__head_t header;
+    memcpy(&header, setFrame.constData(), sizeof(header));
+    if (queryCodeFor(header.function_code) == 0 && header.function_code != PC_VCU_PARAM_SET) {
+        if (error) {
+            *error = QString("%1 不是设置帧").arg(name);
+        }
+        return false;
+    }
+
+    Field field;
+    field.name = name;
+    field.setFrame = setFrame;
+    field.expected = setFrame.mid(headerSize, header.data_length);
+    field.result = Pending;
+
+    const quint16 queryCode = queryCodeFor(header.function_code);
+    if (queryCode != 0) {
+        m_queries.add(name, queryFrameFor(queryCode), queryCode);
+    } else {
+        field.result = Unverifiable;
+    }
+    m_fields.append(field);
+    return true;
+}
+
+bool ConfigTransaction::isEmpty() const
+{
+    return m_fields.isEmpty();
+}
+
+const QList<ConfigTransaction::Field>& ConfigTransaction::fields() const
+{
+    return m_fields;
+}
+
+QList<QByteArray> ConfigTransaction::frames() const
+{
+    QList<QByteArray> frames;
+    for (const Field& field : m_fields) {
+        frames.append(field.setFrame);
+    }
+    frames.append(m_queries.frames());
+    return frames;
+}
+
+void ConfigTransaction::start(int timeoutMs)
+{
+    m_queries.start(timeoutMs);
+}
+
+bool ConfigTransaction::isStarted() const
+{
+    return m_queries.isStarted();
+}
+
+qint64 ConfigTransaction::elapsedMs() const
+{
+    return m_queries.elapsedMs();
+}
+
+int ConfigTransaction::remainingMs() const
+{
+    return m_queries.remainingMs();
+}
+
+bool ConfigTransaction::accept(const DeviceMessage& message)
+{
+    if (!m_queries.accept(message)) {
+        return false;
+    }
+
+    // 按查询名称找到刚应答的项
+    for (const RequestBatch::Item& item : m_queries.items()) {
+        if (item.state == RequestBatch::Pending) {
+            continue;
+        }
+        for (Field& field : m_fields) {
+            if (field.name != item.name || field.result != Pending) {
+                continue;
+            }
+            if (item.state == RequestBatch::Failed) {
+                field.result = InvalidReply;
+            } else {
+                field.actual = item.reply.payload;
+                field.result = field.actual == field.expected ? Verified : Mismatch;
+            }
+        }
+    }
+    return true;
+}
+
+bool ConfigTransaction::isComplete() const
+{
+    return m_queries.isComplete();
+}
+
+void ConfigTransaction::finish()
+{
+    for (Field& field : m_fields) {
+        if (field.result == Pending) {
+            field.result = NoReply;
+        }
+    }
+}
+
+bool ConfigTransaction::succeeded() const
+{
+    for (const Field& field : m_fields) {
+        if (field.result != Verified && field.result != Unverifiable) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString ConfigTransaction::resultName(FieldResult result)
+{
+    switch (result) {
+    case Pending:
+        return "pending";
+    case Verified:
+        return "verified";
+    case Mismatch:
+        return "mismatch";
+    case NoReply:
+        return "no_reply";
+    case InvalidReply:
+        return "invalid_reply";
+    case Unverifiable:
+        return "unverifiable";
+    }
+    return QString();
+}
+
+QString ConfigTransaction::displayValue(const QString& name, const QByteArray& data)
+{
+    if (name == "mac") {
+        return MessageJson::macToString(data);
+    }
+    if (name == "ip" || name == "mask" || name == "gateway") {
+        return MessageJson::ipv4ToString(data);
+    }
+    if (data.size() == 4 * static_cast<int>(sizeof(float))) {
+        // VCU参数：4 个 float
+        QStringList values;
+        for (int i = 0; i < 4; ++i) {
+            float value;
+            memcpy(&value, data.constData() + i * sizeof(float), sizeof(float));
+            values.append(QString::number(value));
+        }
+        return values.join(", ");
+    }
+    return QString::fromLatin1(data.toHex());
+}
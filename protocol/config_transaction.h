@@ -0,0 +1,72 @@
+#ifndef CONFIG_TRANSACTION_H
+#define CONFIG_TRANSACTION_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include "request_batch.h"
+
+// 配置写入并回读验证
+// 1. 若干设置帧在前、对应的查询帧在后，全部首尾相接作为一个批次一次写出；
+//    设备按顺序处理，查询读到的是设置之后的值
+// 2. 查询应答的数据与设置帧数据逐字节比较（地址类数据两者字节序相同），得到每项结果
+// 3. 没有对应查询功能码的设置（VCU参数）只写入，结果为 Unverifiable
+// 批量配置多台设备时，每台只需一次写出和一个往返；非线程安全
+class ConfigTransaction
+{
+public:
+    enum FieldResult {
+        Pending,        // 等待回读
+        Verified,       // 回读值与设置值一致
+        Mismatch,       // 回读值与设置值不一致
+        NoReply,        // 截止时间内未收到回读应答
+        InvalidReply,   // 回读应答无法解码
+        Unverifiable    // 设备不支持回读，只确认已写出
+    };
+
+    struct Field {
+        QString name;           // ip、mask、gateway、mac、vcu-param
+        QByteArray setFrame;
+        QByteArray expected;    // 设置帧的数据部分
+        QByteArray actual;      // 回读数据
+        FieldResult result;
+    };
+
+    ConfigTransaction();
+
+    // 添加一项设置，setFrame 由 ProtocolFrame::build*SetFrame 生成；
+    // 同一项重复添加或不是设置帧时返回 false
+    bool add(const QString& name, const QByteArray& setFrame, QString* error = nullptr);
+
+    bool isEmpty() const;
+    const QList<Field>& fields() const;
+
+    // 设置帧在前、查询帧在后的全部帧，作为一个批次写出
+    QList<QByteArray> frames() const;
+
+    void start(int timeoutMs);
+    bool isStarted() const;
+    qint64 elapsedMs() const;
+    int remainingMs() const;
+
+    // 匹配一条回读应答，属于本事务时返回 true
+    bool accept(const DeviceMessage& message);
+    // 所有可回读项都已应答
+    bool isComplete() const;
+    // 结束事务：未应答的项记为 NoReply
+    void finish();
+
+    // 所有项均为 Verified 或 Unverifiable
+    bool succeeded() const;
+
+    // 结果名称：verified、mismatch、no_reply、invalid_reply、unverifiable、pending
+    static QString resultName(FieldResult result);
+    // 设置值 / 回读值的显示文本
+    static QString displayValue(const QString& name, const QByteArray& data);
+
+private:
+    QList<Field> m_fields;
+    RequestBatch m_queries;     // 回读查询，名称与 Field::name 相同
+};
+
+#endif // CONFIG_TRANSACTION_H
@@ -0,0 +1,67 @@
+#ifndef DEVICE_MESSAGE_H
+#define DEVICE_MESSAGE_H
+
+#include <QByteArray>
+#include <QString>
+#include <QSharedPointer>
+#include <QMetaType>
+#include <cstdint>
+
+extern "C" {
+#include "../pc_protocol.h"
+}
+
+// VCU综合信息快照 - 解码完成后只读，在线程间共享传递
+struct VcuSnapshot {
+    qint64 receivedAtMs;      // 接收时间(ms, Unix时间)
+    state_def_t state;        // 原始VCU综合信息（打包结构，用于存档和按描述表显示；需要对齐结构时用 decodeVcuState）
+};
+using VcuSnapshotPtr = QSharedPointer<const VcuSnapshot>;
+
+// HardFault故障信息快照
+struct HardFaultSnapshot {
+    qint64 receivedAtMs;      // 接收时间(ms, Unix时间)
+    hardfault_info_t info;    // 解码后的HardFault信息
+};
+using HardFaultSnapshotPtr = QSharedPointer<const HardFaultSnapshot>;
+
+// 设备消息 - 工作线程完成帧重组、CRC校验和解码后发往界面线程
+struct DeviceMessage {
+    enum Type {
+        InvalidFrame = 0,     // 帧校验失败
+        PayloadError,         // 帧有效但数据长度与功能码不符
+        VcuInfo,              // VCU综合信息
+        HardFaultInfo,        // HardFault故障信息
+        MacAddress,           // MAC地址查询结果
+        IpAddress,            // IP地址查询结果
+        MaskAddress,          // 子网掩码查询结果
+        GatewayAddress,       // 网关地址查询结果
+        OtherFrame            // 其他功能码
+    };
+
+    Type type;
+    uint16_t functionCode;
+    int dataLength;                   // 帧数据部分长度
+    QByteArray payload;               // 网络配置等小数据帧的原始数据
+    VcuSnapshotPtr vcuInfo;           // type == VcuInfo 时有效
+    HardFaultSnapshotPtr hardFaultInfo; // type == HardFaultInfo 时有效
+    QString errorMessage;             // type == InvalidFrame / PayloadError 时有效
+    int skippedBytes;                 // type == InvalidFrame 时重新同步丢弃的字节数
+    qint64 traceEmitNs;               // 性能跟踪：工作线程发出时刻，未记录时为 -1
+
+    DeviceMessage() {
+        type = InvalidFrame;
+        functionCode = 0;
+        dataLength = 0;
+        skippedBytes = 0;
+        traceEmitNs = -1;
+    }
+
+    bool isValid() const {
+        return type != InvalidFrame && type != PayloadError;
+    }
+};
+
+Q_DECLARE_METATYPE(DeviceMessage)
+
+#endif // DEVICE_MESSAGE_H
@@ -0,0 +1,92 @@
+#include "field_descriptor.h"
+#include <QByteArray>
+#include <QString>
+#include <cstring>
+
+int findField(const FieldDescriptor* fields, int count, const char* name)
+{
+    for (int i = 0; i < count; ++i) {
+        if (strcmp(fields[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+double readFieldValue(const FieldDescriptor& field, const void* base)
+{
+    const char* p = static_cast<const char*>(base) + field.offset;
+    switch (field.type) {
+    case FieldType::UInt8:
+        return static_cast<uint8_t>(*p);
+    case FieldType::Int8:
+        return static_cast<int8_t>(*p);
+    case FieldType::UInt16: {
+        uint16_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+    case FieldType::UInt32: {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+    case FieldType::Float32: {
+        float value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+    default:
+        return 0.0;
+    }
+}
+
+QString formatFieldValue(const FieldDescriptor& field, const void* base)
+{
+    const char* p = static_cast<const char*>(base) + field.offset;
+
+    switch (field.format) {
+    case FieldFormat::Version: {
+        // 查找第一个'\0'或到达最大长度
+        QByteArray text(p, fieldTypeSize(field.type));
+        int nullIndex = text.indexOf('\0');
+        if (nullIndex >= 0) {
+            text.truncate(nullIndex);
+        }
+        return QString::fromUtf8(text);
+    }
+
+    case FieldFormat::Address: {
+        const uint8_t* ip = reinterpret_cast<const uint8_t*>(p);
+        return QString("%1.%2.%3.%4").arg(ip[0]).arg(ip[1]).arg(ip[2]).arg(ip[3]);
+    }
+
+    case FieldFormat::Hex:
+        return QString("0x%1").arg(static_cast<uint32_t>(readFieldValue(field, base)), 8, 16, QChar('0')).toUpper();
+
+    case FieldFormat::Uptime: {
+        uint32_t timestamp = static_cast<uint32_t>(readFieldValue(field, base));
+        uint32_t seconds = timestamp / 1000;
+        return QString("%1:%2:%3.%4")
+               .arg(seconds / 3600, 2, 10, QChar('0'))
+               .arg((seconds % 3600) / 60, 2, 10, QChar('0'))
+               .arg(seconds % 60, 2, 10, QChar('0'))
+               .arg(timestamp % 1000, 3, 10, QChar('0'));
+    }
+
+    case FieldFormat::Fixed:
+        return QString::number(readFieldValue(field, base), 'f', field.precision);
+
+    case FieldFormat::Decimal:
+    default:
+        return QString::number(static_cast<qint64>(readFieldValue(field, base)));
+    }
+}
+
+QString fieldDisplayLabel(const FieldDescriptor& field)
+{
+    if (field.unit[0] == '\0') {
+        return QString::fromUtf8(field.label);
+    }
+    return QString("%1(%2)").arg(QString::fromUtf8(field.label), QString::fromUtf8(field.unit));
+}
@@ -0,0 +1,197 @@
+#ifndef FIELD_DESCRIPTOR_H
+#define FIELD_DESCRIPTOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+#include "../pc_protocol.h"
+}
+
+class QString;
+
+/*
+    协议结构体字段描述表：
+    1. state_def_t 和 hardfault_info_t 的每个字段在下面的 X 宏表中登记一次
+       （字段名、偏移、类型、显示格式、小数位数、单位、显示名称、分组），
+       表的顺序即界面显示顺序
+    2. 偏移按协议文档填写，编译时用 static_assert 与 offsetof/sizeof 核对，
+       结构体修改后表未同步会直接编译失败
+    3. 解码、界面显示、遥测存储、导出和比较都遍历该表，不再逐字段手写
+ */
+
+// 字段存储类型
+enum class FieldType : uint8_t {
+    UInt8,
+    Int8,
+    UInt16,
+    UInt32,
+    Float32,
+    Text16,     // char[16]，以 '\0' 结尾的字符串
+    Ipv4        // uint8_t[4]
+};
+
+// 字段显示格式
+enum class FieldFormat : uint8_t {
+    Decimal,    // 十进制整数
+    Fixed,      // 定点小数，位数由 precision 指定
+    Hex,        // 0x%08X
+    Version,    // 版本字符串
+    Address,    // 点分十进制地址
+    Uptime      // 运行时间 hh:mm:ss.zzz（毫秒计数）
+};
+
+struct FieldDescriptor {
+    const char* name;       // 字段名（与结构体成员一致）
+    uint16_t offset;        // 在打包结构体中的偏移
+    FieldType type;
+    FieldFormat format;
+    uint8_t precision;      // Fixed 格式的小数位数
+    const char* unit;       // 单位，可为空串
+    const char* label;      // 显示名称
+    const char* group;      // 分组名称，可为空串
+};
+
+// 类型占用字节数
+constexpr int fieldTypeSize(FieldType type)
+{
+    return type == FieldType::UInt8 || type == FieldType::Int8 ? 1
+         : type == FieldType::UInt16 ? 2
+         : type == FieldType::Text16 ? 16
+         : 4;
+}
+
+// 是否为可作为时间序列的数值字段（十六进制显示的寄存器/位域/序列号除外）
+constexpr bool isNumericField(const FieldDescriptor& field)
+{
+    return field.type != FieldType::Text16 && field.type != FieldType::Ipv4 && field.format != FieldFormat::Hex;
+}
+
+// X(名称, 成员, 偏移, 类型, 格式, 小数位, 单位, 显示名称, 分组)
+#define H7_VCU_FIELDS(X) \
+    X(software_version,  software_version,  0,   Text16,  Version, 0, "",   "软件版本",        "版本信息") \
+    X(hardware_version,  hardware_version,  16,  Text16,  Version, 0, "",   "硬件版本",        "版本信息") \
+    X(boot_version,      boot_version,      145, Text16,  Version, 0, "",   "Boot版本",        "版本信息") \
+    X(electric,          electric,          32,  UInt8,   Decimal, 0, "%",  "电量",            "电源信息") \
+    X(voltage,           voltage,           33,  Float32, Fixed,   2, "V",  "电压",            "电源信息") \
+    X(current,           current,           37,  Float32, Fixed,   2, "A",  "电流",            "电源信息") \
+    X(wireless_voltage,  wireless_voltage,  41,  Float32, Fixed,   2, "V",  "无线充电电压",    "电源信息") \
+    X(wireless_current,  wireless_current,  45,  Float32, Fixed,   2, "A",  "无线充电电流",    "电源信息") \
+    X(bat_temperature,   bat_temperature,   85,  Float32, Fixed,   2, "℃",  "电池温度",        "电源信息") \
+    X(temperature,       temperature,       49,  Float32, Fixed,   2, "℃",  "温度",            "环境信息") \
+    X(humidity,          humidity,          53,  Float32, Fixed,   2, "%",  "湿度",            "环境信息") \
+    X(ip,                ip,                57,  Ipv4,    Address, 0, "",   "IP地址",          "网络信息") \
+    X(port,              port,              61,  UInt16,  Decimal, 0, "",   "端口",            "网络信息") \
+    X(crash_head,        crash_head,        63,  UInt8,   Decimal, 0, "",   "前碰撞",          "传感器状态") \
+    X(crash_rear,        crash_rear,        64,  UInt8,   Decimal, 0, "",   "后碰撞",          "传感器状态") \
+    X(proximity,         proximity,         65,  UInt8,   Decimal, 0, "",   "接近开关",        "传感器状态") \
+    X(emergency_stop,    emergency_stop,    66,  UInt8,   Decimal, 0, "",   "急停",            "传感器状态") \
+    X(fire_sensor,       fire_sensor,       174, UInt8,   Decimal, 0, "",   "火焰传感",        "传感器状态") \
+    X(fall_sensor,       fall_sensor,       175, UInt8,   Decimal, 0, "",   "跌落传感",        "传感器状态") \
+    X(ultrasonic_f,      ultrasonic_f,      229, UInt8,   Decimal, 0, "",   "前超声波避障",    "超声波传感器") \
+    X(ultrasonic_r,      ultrasonic_r,      230, UInt8,   Decimal, 0, "",   "后超声波避障",    "超声波传感器") \
+    X(ultrasonic_tl,     ultrasonic_tl,     231, UInt8,   Decimal, 0, "",   "左转超声波避障",  "超声波传感器") \
+    X(ultrasonic_tr,     ultrasonic_tr,     232, UInt8,   Decimal, 0, "",   "右转超声波避障",  "超声波传感器") \
+    X(air_h2s,           air_h2s,           89,  Float32, Fixed,   2, "",   "air_h2s",         "气体传感器") \
+    X(air_co,            air_co,            93,  Float32, Fixed,   2, "",   "air_co",          "气体传感器") \
+    X(air_o2,            air_o2,            97,  Float32, Fixed,   2, "",   "air_o2",          "气体传感器") \
+    X(air_ex,            air_ex,            101, Float32, Fixed,   2, "",   "air_ex",          "气体传感器") \
+    X(air_edc,           air_edc,           176, Float32, Fixed,   2, "",   "air_edc",         "气体传感器") \
+    X(air_c2h4,          air_c2h4,          180, Float32, Fixed,   2, "",   "air_c2h4",        "气体传感器") \
+    X(air_hcl,           air_hcl,           184, Float32, Fixed,   2, "",   "air_hcl",         "气体传感器") \
+    X(air_cl2,           air_cl2,           188, Float32, Fixed,   2, "",   "air_cl2",         "气体传感器") \
+    X(air_c3h6,          air_c3h6,          192, Float32, Fixed,   2, "",   "air_c3h6",        "气体传感器") \
+    X(air_h2,            air_h2,            196, Float32, Fixed,   2, "",   "air_h2",          "气体传感器") \
+    X(air_temp,          air_temp,          200, Float32, Fixed,   2, "",   "air_temp",        "气体传感器") \
+    X(air_hum,           air_hum,           204, Float32, Fixed,   2, "",   "air_hum",         "气体传感器") \
+    X(air_sf6,           air_sf6,           208, Float32, Fixed,   2, "",   "air_sf6",         "气体传感器") \
+    X(cocl2,             cocl2,             212, Float32, Fixed,   2, "",   "cocl2",           "气体传感器") \
+    X(c2h6o,             c2h6o,             216, Float32, Fixed,   2, "",   "c2h6o",           "气体传感器") \
+    X(ch4,               ch4,               220, Float32, Fixed,   2, "",   "ch4",             "气体传感器") \
+    X(drv0_current_ch0,  drv0_current_ch0,  105, Float32, Fixed,   2, "",   "drv0_current_ch0", "驱动器电流") \
+    X(drv0_current_ch1,  drv0_current_ch1,  109, Float32, Fixed,   2, "",   "drv0_current_ch1", "驱动器电流") \
+    X(drv1_current_ch0,  drv1_current_ch0,  113, Float32, Fixed,   2, "",   "drv1_current_ch0", "驱动器电流") \
+    X(drv1_current_ch1,  drv1_current_ch1,  117, Float32, Fixed,   2, "",   "drv1_current_ch1", "驱动器电流") \
+    X(joy_ch0,           joy_ch0,           129, Float32, Fixed,   2, "",   "joy_ch0",         "遥控器通道") \
+    X(joy_ch1,           joy_ch1,           133, Float32, Fixed,   2, "",   "joy_ch1",         "遥控器通道") \
+    X(joy_ch2,           joy_ch2,           137, Float32, Fixed,   2, "",   "joy_ch2",         "遥控器通道") \
+    X(joy_ch3,           joy_ch3,           141, Float32, Fixed,   2, "",   "joy_ch3",         "遥控器通道") \
+    X(serial_number0,    serial_number[0],  161, UInt32,  Hex,     0, "",   "serial_number[0]", "序列号") \
+    X(serial_number1,    serial_number[1],  165, UInt32,  Hex,     0, "",   "serial_number[1]", "序列号") \
+    X(serial_number2,    serial_number[2],  169, UInt32,  Hex,     0, "",   "serial_number[2]", "序列号") \
+    X(sts_bms,           sts_bms,           224, UInt32,  Hex,     0, "",   "sts_bms",         "BMS和标志位") \
+    X(flag_air_invail,   flag_air_invail,   228, UInt8,   Decimal, 0, "",   "flag_air_invail", "BMS和标志位") \
+    X(lf_motor_current,  lf_motor_current,  233, Float32, Fixed,   2, "",   "lf_motor_current", "电机电流") \
+    X(rf_motor_current,  rf_motor_current,  237, Float32, Fixed,   2, "",   "rf_motor_current", "电机电流") \
+    X(rr_motor_current,  rr_motor_current,  241, Float32, Fixed,   2, "",   "rr_motor_current", "电机电流") \
+    X(lr_motor_current,  lr_motor_current,  245, Float32, Fixed,   2, "",   "lr_motor_current", "电机电流") \
+    X(ctrl_mode,         ctrl_mode,         67,  UInt8,   Decimal, 0, "",   "控制模式",        "控制信息") \
+    X(clear_mode,        clear_mode,        68,  UInt8,   Decimal, 0, "",   "清除模式",        "控制信息") \
+    X(joy_vc,            joy_vc,            69,  Float32, Fixed,   3, "",   "遥控线速度",      "控制信息") \
+    X(joy_vw,            joy_vw,            73,  Float32, Fixed,   3, "",   "遥控角速度",      "控制信息") \
+    X(twist_vc,          twist_vc,          77,  Float32, Fixed,   3, "",   "反馈线速度",      "控制信息") \
+    X(twist_vw,          twist_vw,          81,  Float32, Fixed,   3, "",   "反馈角速度",      "控制信息") \
+    X(cmd_vc,            cmd_vc,            121, Float32, Fixed,   3, "",   "指令线速度",      "控制信息") \
+    X(cmd_vw,            cmd_vw,            125, Float32, Fixed,   3, "",   "指令角速度",      "控制信息") \
+    X(dev_lock_sta,      dev_lock_sta,      173, Int8,    Decimal, 0, "",   "设备锁状态",      "设备状态") \
+    X(lifter_h,          lifter_h,          249, UInt8,   Decimal, 0, "",   "升降机高度",      "设备状态")
+
+#define H7_HARDFAULT_FIELDS(X) \
+    X(magic_number,      magic_number,      0,   UInt32,  Hex,     0, "",   "魔数标识",          "") \
+    X(timestamp,         timestamp,         4,   UInt32,  Uptime,  0, "",   "时间戳(运行时间)",  "") \
+    X(sp_value,          sp_value,          8,   UInt32,  Hex,     0, "",   "堆栈指针值(SP)",    "") \
+    X(r0_value,          r0_value,          12,  UInt32,  Hex,     0, "",   "r0寄存器值",        "") \
+    X(r1_value,          r1_value,          16,  UInt32,  Hex,     0, "",   "r1寄存器值",        "") \
+    X(r2_value,          r2_value,          20,  UInt32,  Hex,     0, "",   "r2寄存器值",        "") \
+    X(r3_value,          r3_value,          24,  UInt32,  Hex,     0, "",   "r3寄存器值",        "") \
+    X(r12_value,         r12_value,         28,  UInt32,  Hex,     0, "",   "r12寄存器值",       "") \
+    X(lr_value,          lr_value,          32,  UInt32,  Hex,     0, "",   "链接寄存器值(LR)",  "") \
+    X(pc_value,          pc_value,          36,  UInt32,  Hex,     0, "",   "程序计数器值(PC)",  "") \
+    X(xpsr_value,        xpsr_value,        40,  UInt32,  Hex,     0, "",   "xpsr寄存器值",      "") \
+    X(fault_count,       fault_count,       44,  UInt32,  Decimal, 0, "",   "故障计数器",        "")
+
+#define H7_FIELD_DESCRIPTOR(name, member, offset, type, format, precision, unit, label, group) \
+    { #name, offset, FieldType::type, FieldFormat::format, precision, unit, label, group },
+
+inline constexpr FieldDescriptor kVcuFields[] = { H7_VCU_FIELDS(H7_FIELD_DESCRIPTOR) };
+inline constexpr FieldDescriptor kHardFaultFields[] = { H7_HARDFAULT_FIELDS(H7_FIELD_DESCRIPTOR) };
+
+inline constexpr int kVcuFieldCount = static_cast<int>(sizeof(kVcuFields) / sizeof(kVcuFields[0]));
+inline constexpr int kHardFaultFieldCount = static_cast<int>(sizeof(kHardFaultFields) / sizeof(kHardFaultFields[0]));
+
+// 编译时核对表与结构体定义
+#define H7_FIELD_CHECK(structType, name, member, offset, type, format, precision, unit, label, group) \
+    static_assert(offsetof(structType, member) == offset, #structType "::" #name " 偏移与描述表不一致"); \
+    static_assert(sizeof(structType::member) == fieldTypeSize(FieldType::type), #structType "::" #name " 类型与描述表不一致");
+#define H7_VCU_FIELD_CHECK(...) H7_FIELD_CHECK(state_def_t, __VA_ARGS__)
+#define H7_HARDFAULT_FIELD_CHECK(...) H7_FIELD_CHECK(hardfault_info_t, __VA_ARGS__)
+
+H7_VCU_FIELDS(H7_VCU_FIELD_CHECK)
+H7_HARDFAULT_FIELDS(H7_HARDFAULT_FIELD_CHECK)
+
+#undef H7_VCU_FIELD_CHECK
+#undef H7_HARDFAULT_FIELD_CHECK
+#undef H7_FIELD_CHECK
+
+// 表中的字段数应覆盖结构体全部字节（序列号按三个元素登记）
+constexpr int totalFieldSize(const FieldDescriptor* fields, int count)
+{
+    return count == 0 ? 0 : fieldTypeSize(fields[0].type) + totalFieldSize(fields + 1, count - 1);
+}
+static_assert(totalFieldSize(kVcuFields, kVcuFieldCount) == sizeof(state_def_t), "state_def_t 存在未登记的字段");
+static_assert(totalFieldSize(kHardFaultFields, kHardFaultFieldCount) + 8 == sizeof(hardfault_info_t),
+              "hardfault_info_t 存在未登记的字段（reserved 除外）");
+
+// 按名称查找字段，未找到返回 -1
+int findField(const FieldDescriptor* fields, int count, const char* name);
+
+// 读取数值字段（memcpy 读取，不要求对齐）；非数值类型返回 0
+double readFieldValue(const FieldDescriptor& field, const void* base);
+
+// 按描述表的格式把字段格式化为显示文本
+QString formatFieldValue(const FieldDescriptor& field, const void* base);
+
+// 显示名称，带单位时为“名称(单位)”
+QString fieldDisplayLabel(const FieldDescriptor& field);
+
+#endif // FIELD_DESCRIPTOR_H
@@ -0,0 +1,310 @@
+#include "frame_pipeline.h"
+#include "../common/log.h"
+#include "../common/trace_recorder.h"
+#include <QDateTime>
+#include <cstring>
+
+FramePipeline::FramePipeline()
+    : m_scanOffset(1)
+    , m_resyncBytes(0)
+{
+    // 预留一帧最大长度的两倍，重组时一般不再扩容
+    m_buffer.reserve(2 * (static_cast<int>(sizeof(pc_comm_protocol__head_t)) + MaxPayloadLength + 2));
+}
+
+QVector<DeviceMessage> FramePipeline::feed(const char* data, int size)
+{
+    H7_SPAN("protocol", "reassembly");
+    QVector<DeviceMessage> messages;
+    if (data && size > 0) {
+        m_buffer.append(data, size);
+    }
+
+    const uint8_t* buffer = reinterpret_cast<const uint8_t*>(m_buffer.constData());
+    const int bufferSize = m_buffer.size();
+    int pos = 0;
+
+    while (pos < bufferSize) {
+        // 帧头同步：丢弃帧头之前的字节
+        if (buffer[pos] != pc_protocol_head) {
+            const void* head = memchr(buffer + pos, pc_protocol_head, bufferSize - pos);
+            int next = head ? static_cast<int>(static_cast<const uint8_t*>(head) - buffer) : bufferSize;
+            discard(next - pos, "帧头前有无效数据");
+            pos = next;
+            m_scanOffset = 1;
+            continue;
+        }
+
+        int frameSize = 0;
+        const Candidate candidate = checkCandidate(buffer + pos, bufferSize - pos, &frameSize);
+
+        if (candidate == Incomplete) {
+            // 帧头声明的长度还无法确认；其后已有完整的有效帧时，当前帧头是误判
+            const int next = findConfirmedFrame(buffer, pos, bufferSize);
+            if (next < 0) {
+                break;
+            }
+            discard(next - pos, "帧头声明的长度与后续数据不符");
+            pos = next;
+            m_scanOffset = 1;
+            continue;
+        }
+
+        if (candidate == Rejected) {
+            // 地址、功能码或长度不合理的帧头直接跳过；帧头合理而CRC不符时计入CRC错误
+            if (frameSize > 0) {
+                m_stats.crcErrors++;
+                discard(1, "CRC校验失败");
+            } else {
+                discard(1, "帧头无效");
+            }
+            pos++;
+            m_scanOffset = 1;
+            continue;
+        }
+
+        // 校验通过，先报告之前的失步，再按功能码解码
+        flushResync(&messages);
+        QByteArray frameData = QByteArray::fromRawData(reinterpret_cast<const char*>(buffer + pos), frameSize);
+        messages.append(decodeFrame(frameData));
+        m_stats.framesDecoded++;
+        pos += frameSize;
+        m_scanOffset = 1;
+    }
+
+    // 缓冲中已没有待确认的数据时结束本次失步
+    if (pos == bufferSize) {
+        flushResync(&messages);
+    }
+
+    m_buffer.remove(0, pos);
+    return messages;
+}
+
+bool FramePipeline::isPlausibleHeader(const pc_comm_protocol__head_t& header)
+{
+    // 设备应答为 mcu -> pc，模拟设备收到的请求为 pc -> mcu
+    const bool fromMcu = header.source_addr == mcu_addr && header.target_addr == pc_addr;
+    const bool fromPc = header.source_addr == pc_addr && header.target_addr == mcu_addr;
+    if (!fromMcu && !fromPc) {
+        return false;
+    }
+    if (header.data_length > MaxPayloadLength) {
+        return false;
+    }
+
+    switch (header.function_code) {
+    case PC_VCU_INFO_GET:
+    case PC_MAC_ADDR_SET:
+    case PC_IP_ADDR_SET:
+    case PC_MASK_ADDR_SET:
+    case PC_GATEWAY_ADDR_SET:
+    case PC_HARDFAULT_INFO_GET:
+    case PC_MAC_ADDR_QUERY:
+    case PC_IP_ADDR_QUERY:
+    case PC_MASK_ADDR_QUERY:
+    case PC_GATEWAY_ADDR_QUERY:
+    case PC_VCU_PARAM_SET:
+        return true;
+    default:
+        return false;
+    }
+}
+
+FramePipeline::Candidate FramePipeline::checkCandidate(const uint8_t* data, int available, int* frameSize)
+{
+    const int headerSize = static_cast<int>(sizeof(pc_comm_protocol__head_t));
+    *frameSize = 0;
+
+    // 协议头未收全
+    if (available < headerSize) {
+        return Incomplete;
+    }
+
+    pc_comm_protocol__head_t header;
+    memcpy(&header, data, headerSize);
+    if (!isPlausibleHeader(header)) {
+        return Rejected;
+    }
+
+    // 整帧未收全
+    *frameSize = headerSize + header.data_length + 2;
+    if (available < *frameSize) {
+        return Incomplete;
+    }
+
+    // CRC校验
+    uint16_t receivedCRC;
+    memcpy(&receivedCRC, data + headerSize + header.data_length, 2);
+    uint16_t calculatedCRC;
+    {
+        H7_SPAN("protocol", "crc");
+        calculatedCRC = static_cast<uint16_t>(
+            CRC16(const_cast<uint8_t*>(data), static_cast<unsigned int>(headerSize + header.data_length)));
+    }
+    if (receivedCRC != calculatedCRC) {
+        qCDebug(lcProtocol) << "CRC校验失败, 功能码" << Qt::hex << header.function_code
+                            << "接收" << receivedCRC << "计算" << calculatedCRC;
+        return Rejected;
+    }
+    return Accepted;
+}
+
+int FramePipeline::findConfirmedFrame(const uint8_t* buffer, int pos, int bufferSize)
+{
+    // 已被否定的位置不再检查；未收全的候选帧留到下次从它开始
+    int scan = pos + m_scanOffset;
+    int resume = -1;
+    while (scan < bufferSize) {
+        const void* head = memchr(buffer + scan, pc_protocol_head, bufferSize - scan);
+        if (!head) {
+            break;
+        }
+        scan = static_cast<int>(static_cast<const uint8_t*>(head) - buffer);
+
+        int frameSize = 0;
+        const Candidate candidate = checkCandidate(buffer + scan, bufferSize - scan, &frameSize);
+        if (candidate == Accepted) {
+            return scan;
+        }
+        if (candidate == Incomplete && resume < 0) {
+            resume = scan;
+        }
+        scan++;
+    }
+
+    m_scanOffset = (resume >= 0 ? resume : bufferSize) - pos;
+    return -1;
+}
+
+void FramePipeline::discard(int count, const QString& reason)
+{
+    m_stats.discardedBytes += count;
+    if (m_resyncBytes == 0) {
+        m_resyncReason = reason;
+    }
+    m_resyncBytes += count;
+}
+
+void FramePipeline::flushResync(QVector<DeviceMessage>* messages)
+{
+    if (m_resyncBytes == 0) {
+        return;
+    }
+
+    DeviceMessage message;
+    message.type = DeviceMessage::InvalidFrame;
+    message.skippedBytes = m_resyncBytes;
+    message.errorMessage = QString("%1，重新同步丢弃 %2 字节").arg(m_resyncReason).arg(m_resyncBytes);
+    qCDebug(lcProtocol) << message.errorMessage;
+    messages->append(message);
+
+    m_resyncBytes = 0;
+    m_resyncReason.clear();
+}
+
+void FramePipeline::reset()
+{
+    m_buffer.clear();
+    m_scanOffset = 1;
+    m_resyncBytes = 0;
+    m_resyncReason.clear();
+}
+
+FramePipeline::Stats FramePipeline::stats() const
+{
+    return m_stats;
+}
+
+DeviceMessage FramePipeline::decodeFrame(const QByteArray& frameData)
+{
+    H7_SPAN("protocol", "decode");
+    DeviceMessage message;
+    const int headerSize = static_cast<int>(sizeof(pc_comm_protocol__head_t));
+
+    if (frameData.size() < headerSize + 2) {
+        message.errorMessage = "帧长度不足";
+        return message;
+    }
+
+    pc_comm_protocol__head_t header;
+    memcpy(&header, frameData.constData(), headerSize);
+
+    message.functionCode = header.function_code;
+    message.dataLength = header.data_length;
+
+    if (frameData.size() < headerSize + header.data_length + 2) {
+        message.errorMessage = "数据长度不匹配";
+        return message;
+    }
+
+    const char* payload = frameData.constData() + headerSize;
+    const int dataLength = header.data_length;
+    const qint64 receivedAtMs = QDateTime::currentMSecsSinceEpoch();
+
+    switch (header.function_code) {
+    case PC_HARDFAULT_INFO_GET:
+        if (dataLength == static_cast<int>(sizeof(hardfault_info_t))) {
+            QSharedPointer<HardFaultSnapshot> snapshot(new HardFaultSnapshot);
+            snapshot->receivedAtMs = receivedAtMs;
+            memcpy(&snapshot->info, payload, sizeof(hardfault_info_t));
+            message.type = DeviceMessage::HardFaultInfo;
+            message.hardFaultInfo = snapshot;
+        } else {
+            message.type = DeviceMessage::PayloadError;
+            message.errorMessage = QString("HardFault数据长度错误: 期望 %1, 实际 %2")
+                                   .arg(sizeof(hardfault_info_t)).arg(dataLength);
+        }
+        break;
+
+    case PC_VCU_INFO_GET:
+        if (dataLength == static_cast<int>(sizeof(state_def_t))) {
+            QSharedPointer<VcuSnapshot> snapshot(new VcuSnapshot);
+            snapshot->receivedAtMs = receivedAtMs;
+            memcpy(&snapshot->state, payload, sizeof(state_def_t));
+            message.type = DeviceMessage::VcuInfo;
+            message.vcuInfo = snapshot;
+        } else {
+            message.type = DeviceMessage::PayloadError;
+            message.errorMessage = QString("VCU数据长度错误: 期望 %1, 实际 %2")
+                                   .arg(sizeof(state_def_t)).arg(dataLength);
+        }
+        break;
+
+    case PC_MAC_ADDR_QUERY:
+        if (dataLength == 6) {
+            message.type = DeviceMessage::MacAddress;
+            message.payload = QByteArray(payload, dataLength);
+        } else {
+            message.type = DeviceMessage::PayloadError;
+            message.errorMessage = QString("MAC地址数据长度错误: 期望 6, 实际 %1").arg(dataLength);
+        }
+        break;
+
+    case PC_IP_ADDR_QUERY:
+    case PC_MASK_ADDR_QUERY:
+    case PC_GATEWAY_ADDR_QUERY: {
+        const QString name = header.function_code == PC_IP_ADDR_QUERY ? QStringLiteral("IP地址")
+                           : header.function_code == PC_MASK_ADDR_QUERY ? QStringLiteral("子网掩码")
+                           : QStringLiteral("网关地址");
+        if (dataLength == 4) {
+            message.type = header.function_code == PC_IP_ADDR_QUERY ? DeviceMessage::IpAddress
+                         : header.function_code == PC_MASK_ADDR_QUERY ? DeviceMessage::MaskAddress
+                         : DeviceMessage::GatewayAddress;
+            message.payload = QByteArray(payload, dataLength);
+        } else {
+            message.type = DeviceMessage::PayloadError;
+            message.errorMessage = QString("%1数据长度错误: 期望 4, 实际 %2").arg(name).arg(dataLength);
+        }
+        break;
+    }
+
+    default:
+        // 其他功能码保留原始数据
+        message.type = DeviceMessage::OtherFrame;
+        message.payload = QByteArray(payload, dataLength);
+        break;
+    }
+
+    return message;
+}
@@ -0,0 +1,75 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include <QByteArray>
+#include <QVector>
+#include "device_message.h"
+
+// 接收帧处理流水线
+// 在工作线程中完成：字节流重组 -> 帧头同步 -> CRC校验 -> 按功能码解码
+// 不依赖界面，串口、Socket以及无界面程序均可复用
+//
+// 帧头同步：
+// 1. 0xFF 之后的源/目标地址须为上位机与设备之间的方向、功能码须为协议定义的功能码，否则不当作帧头
+// 2. 帧头声明的长度尚未收全时，若后面已收到的数据中有一帧完整且校验通过的帧，判定当前帧头为误判并跳到该帧，
+//    不会因为一个误判的长帧头挡住其后的有效帧
+// 3. 一次失步（从第一个丢弃的字节到下一帧有效帧）只输出一条 InvalidFrame，附带丢弃的字节数
+class FramePipeline
+{
+public:
+    // 单帧数据部分允许的最大长度，超过视为错误帧头并重新同步
+    static constexpr int MaxPayloadLength = 1024;
+
+    // 流水线统计信息
+    struct Stats {
+        qint64 framesDecoded;     // 成功解码的帧数
+        qint64 crcErrors;         // CRC校验失败次数
+        qint64 discardedBytes;    // 重新同步时丢弃的字节数
+
+        Stats() {
+            framesDecoded = 0;
+            crcErrors = 0;
+            discardedBytes = 0;
+        }
+    };
+
+    FramePipeline();
+
+    // 输入一段接收数据，返回本次完整解出的全部消息；不完整的帧留待下次输入
+    QVector<DeviceMessage> feed(const char* data, int size);
+
+    // 清空重组缓冲（连接断开或重新打开时调用）
+    void reset();
+
+    // 获取统计信息
+    Stats stats() const;
+
+    // 解码一帧已校验过的完整帧
+    static DeviceMessage decodeFrame(const QByteArray& frameData);
+
+private:
+    enum Candidate {
+        Incomplete,     // 数据未收全，无法判断
+        Rejected,       // 不是有效帧
+        Accepted        // 完整且校验通过
+    };
+
+    // 检查 data 处的候选帧；frameSize 返回帧头声明的整帧长度
+    static Candidate checkCandidate(const uint8_t* data, int available, int* frameSize);
+    static bool isPlausibleHeader(const pc_comm_protocol__head_t& header);
+
+    // 当前帧未收全时，在其后已收到的数据中查找完整且校验通过的帧，返回其位置，没有时返回 -1
+    int findConfirmedFrame(const uint8_t* buffer, int pos, int bufferSize);
+
+    void discard(int count, const QString& reason);
+    void flushResync(QVector<DeviceMessage>* messages);
+
+    QByteArray m_buffer;
+    Stats m_stats;
+
+    int m_scanOffset;           // findConfirmedFrame 下次开始检查的位置（相对当前帧头）
+    int m_resyncBytes;          // 本次失步已丢弃的字节数
+    QString m_resyncReason;     // 本次失步的起因
+};
+
+#endif // FRAME_PIPELINE_H
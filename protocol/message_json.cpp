@@ -0,0 +1,136 @@
+#include "message_json.h"
+#include "field_descriptor.h"
+#include <QJsonValue>
+#include <cmath>
+
+namespace {
+
+QJsonObject fieldsToJson(const FieldDescriptor* fields, int count, const void* base)
+{
+    QJsonObject object;
+    for (int i = 0; i < count; ++i) {
+        const FieldDescriptor& field = fields[i];
+        if (!isNumericField(field)) {
+            object.insert(QString::fromLatin1(field.name), formatFieldValue(field, base));
+            continue;
+        }
+
+        double value = readFieldValue(field, base);
+        if (field.format == FieldFormat::Fixed) {
+            const double scale = std::pow(10.0, field.precision);
+            value = std::round(value * scale) / scale;
+        }
+        object.insert(QString::fromLatin1(field.name), value);
+    }
+    return object;
+}
+
+} // namespace
+
+namespace MessageJson {
+
+QString typeName(DeviceMessage::Type type)
+{
+    switch (type) {
+    case DeviceMessage::InvalidFrame:
+        return QStringLiteral("invalid");
+    case DeviceMessage::PayloadError:
+        return QStringLiteral("payload_error");
+    case DeviceMessage::VcuInfo:
+        return QStringLiteral("vcu");
+    case DeviceMessage::HardFaultInfo:
+        return QStringLiteral("hardfault");
+    case DeviceMessage::MacAddress:
+        return QStringLiteral("mac");
+    case DeviceMessage::IpAddress:
+        return QStringLiteral("ip");
+    case DeviceMessage::MaskAddress:
+        return QStringLiteral("mask");
+    case DeviceMessage::GatewayAddress:
+        return QStringLiteral("gateway");
+    case DeviceMessage::OtherFrame:
+        break;
+    }
+    return QStringLiteral("other");
+}
+
+QJsonObject toJson(const DeviceMessage& message)
+{
+    QJsonObject object;
+    object.insert("type", typeName(message.type));
+    object.insert("functionCode", QString("0x%1").arg(message.functionCode, 4, 16, QChar('0')));
+
+    switch (message.type) {
+    case DeviceMessage::InvalidFrame:
+        object.insert("error", message.errorMessage);
+        object.insert("skippedBytes", message.skippedBytes);
+        break;
+
+    case DeviceMessage::PayloadError:
+        object.insert("error", message.errorMessage);
+        break;
+
+    case DeviceMessage::VcuInfo:
+        object.insert("receivedAtMs", static_cast<double>(message.vcuInfo->receivedAtMs));
+        object.insert("value", vcuStateToJson(message.vcuInfo->state));
+        break;
+
+    case DeviceMessage::HardFaultInfo:
+        object.insert("receivedAtMs", static_cast<double>(message.hardFaultInfo->receivedAtMs));
+        object.insert("value", hardFaultToJson(message.hardFaultInfo->info));
+        break;
+
+    case DeviceMessage::MacAddress:
+        object.insert("value", macToString(message.payload));
+        break;
+
+    case DeviceMessage::IpAddress:
+    case DeviceMessage::MaskAddress:
+    case DeviceMessage::GatewayAddress:
+        object.insert("value", ipv4ToString(message.payload));
+        break;
+
+    case DeviceMessage::OtherFrame:
+        object.insert("value", QString::fromLatin1(message.payload.toHex()));
+        break;
+    }
+    return object;
+}
+
+QJsonObject vcuStateToJson(const state_def_t& state)
+{
+    return fieldsToJson(kVcuFields, kVcuFieldCount, &state);
+}
+
+QJsonObject hardFaultToJson(const hardfault_info_t& info)
+{
+    return fieldsToJson(kHardFaultFields, kHardFaultFieldCount, &info);
+}
+
+QString macToString(const QByteArray& mac)
+{
+    if (mac.size() != 6) {
+        return QString();
+    }
+    return QString("%1:%2:%3:%4:%5:%6")
+           .arg(static_cast<uint8_t>(mac[5]), 2, 16, QChar('0'))
+           .arg(static_cast<uint8_t>(mac[4]), 2, 16, QChar('0'))
+           .arg(static_cast<uint8_t>(mac[3]), 2, 16, QChar('0'))
+           .arg(static_cast<uint8_t>(mac[2]), 2, 16, QChar('0'))
+           .arg(static_cast<uint8_t>(mac[1]), 2, 16, QChar('0'))
+           .arg(static_cast<uint8_t>(mac[0]), 2, 16, QChar('0')).toUpper();
+}
+
+QString ipv4ToString(const QByteArray& address)
+{
+    if (address.size() != 4) {
+        return QString();
+    }
+    return QString("%1.%2.%3.%4")
+           .arg(static_cast<uint8_t>(address[3]))
+           .arg(static_cast<uint8_t>(address[2]))
+           .arg(static_cast<uint8_t>(address[1]))
+           .arg(static_cast<uint8_t>(address[0]));
+}
+
+}
@@ -0,0 +1,28 @@
+#ifndef MESSAGE_JSON_H
+#define MESSAGE_JSON_H
+
+#include <QJsonObject>
+#include <QString>
+#include "device_message.h"
+
+// 设备消息转 JSON，供无界面命令行和设备共享服务输出
+// 数值字段输出数字（定点字段按小数位数取整），十六进制、版本和地址字段输出字符串
+namespace MessageJson {
+
+// 消息类型名称：vcu、hardfault、mac、ip、mask、gateway、other、invalid、payload_error
+QString typeName(DeviceMessage::Type type);
+
+// 完整消息：{"type", "functionCode", "receivedAtMs", "value" / "error"}
+QJsonObject toJson(const DeviceMessage& message);
+
+// 按描述表输出结构体的全部字段
+QJsonObject vcuStateToJson(const state_def_t& state);
+QJsonObject hardFaultToJson(const hardfault_info_t& info);
+
+// 网络配置数据（设备按低字节在前传输）
+QString macToString(const QByteArray& mac);
+QString ipv4ToString(const QByteArray& address);
+
+}
+
+#endif // MESSAGE_JSON_H
@@ -1,7 +1,8 @@
 #include "protocol_frame.h"
 #include <QStringList>
 #include <QRegularExpression>
-#include <QDebug>
+#include <cstring>
+#include "../common/log.h"
 
 ProtocolFrame::ProtocolFrame()
 {
@@ -32,7 +33,7 @@ QByteArray ProtocolFrame::buildIpSetFrame(const QString& ipAddress)
 {
     QByteArray ipData = ipStringToBytes(ipAddress);
     if (ipData.isEmpty()) {
-        qWarning() << "Invalid IP address format:" << ipAddress;
+        qCWarning(lcProtocol) << "Invalid IP address format:" << ipAddress;
         return QByteArray();
     }
     
@@ -43,7 +44,7 @@ QByteArray ProtocolFrame::buildMaskSetFrame(const QString& maskAddress)
 {
     QByteArray maskData = ipStringToBytes(maskAddress);
     if (maskData.isEmpty()) {
-        qWarning() << "Invalid mask address format:" << maskAddress;
+        qCWarning(lcProtocol) << "Invalid mask address format:" << maskAddress;
         return QByteArray();
     }
 
@@ -54,7 +55,7 @@ QByteArray ProtocolFrame::buildGatewaySetFrame(const QString& gatewayAddress)
 {
     QByteArray gatewayData = ipStringToBytes(gatewayAddress);
     if (gatewayData.isEmpty()) {
-        qWarning() << "Invalid gateway address format:" << gatewayAddress;
+        qCWarning(lcProtocol) << "Invalid gateway address format:" << gatewayAddress;
         return QByteArray();
     }
 
@@ -73,7 +74,7 @@ QByteArray ProtocolFrame::buildVcuParamSetFrame(const QString& frontDecObstacleD
     vcuParamData.append(reinterpret_cast<const char*>(&rearObstacleDistanceFloat), sizeof(float));
     vcuParamData.append(reinterpret_cast<const char*>(&speedCorrectionFactorFloat), sizeof(float));
     if (vcuParamData.isEmpty()) {
-        qWarning() << "Invalid vcu param format:" << frontDecObstacleDistance << "or" << frontStopObstacleDistance << "or" << rearObstacleDistance << "or" << speedCorrectionFactor;    
+        qCWarning(lcProtocol) << "Invalid vcu param format:" << frontDecObstacleDistance << "or" << frontStopObstacleDistance << "or" << rearObstacleDistance << "or" << speedCorrectionFactor;    
         return QByteArray();
     }
 
@@ -122,6 +123,50 @@ QByteArray ProtocolFrame::buildGatewayQueryFrame()
     return buildFrame(PC_GATEWAY_ADDR_QUERY, emptyData);
 }
 
+QByteArray ProtocolFrame::joinFrames(const QList<QByteArray>& frames)
+{
+    int total = 0;
+    for (const QByteArray& frame : frames) {
+        total += frame.size();
+    }
+    
+    QByteArray data;
+    data.reserve(total);
+    for (const QByteArray& frame : frames) {
+        data.append(frame);
+    }
+    return data;
+}
+
+QList<QByteArray> ProtocolFrame::splitFrames(const QByteArray& data)
+{
+    QList<QByteArray> frames;
+    int offset = 0;
+    while (data.size() - offset >= static_cast<int>(sizeof(pc_comm_protocol__head_t))) {
+        pc_comm_protocol__head_t header;
+        memcpy(&header, data.constData() + offset, sizeof(header));
+        
+        const int frameSize = static_cast<int>(sizeof(header)) + header.data_length + 2;
+        if (data.size() - offset < frameSize) {
+            break;
+        }
+        frames.append(offset == 0 && frameSize == data.size() ? data : data.mid(offset, frameSize));
+        offset += frameSize;
+    }
+    return frames;
+}
+
+uint16_t ProtocolFrame::functionCodeOf(const QByteArray& frameData)
+{
+    if (frameData.size() < static_cast<int>(sizeof(pc_comm_protocol__head_t))) {
+        return 0;
+    }
+    
+    pc_comm_protocol__head_t header;
+    memcpy(&header, frameData.constData(), sizeof(header));
+    return header.function_code;
+}
+
 ProtocolFrame::ParsedData ProtocolFrame::parseFrame(const QByteArray& frameData)
 {
     ParsedData result;
@@ -2,6 +2,7 @@
 #define PROTOCOL_FRAME_H
 
 #include <QByteArray>
+#include <QList>
 #include <QString>
 #include <QHostAddress>
 #include <cstdint>
@@ -42,6 +43,13 @@ public:
     static QByteArray buildMaskQueryFrame();
     static QByteArray buildGatewayQueryFrame();
     
+    // 多帧首尾相接，由工作线程一次写出
+    static QByteArray joinFrames(const QList<QByteArray>& frames);
+    // 按帧头中的数据长度拆分首尾相接的多帧，不足一帧的尾部丢弃
+    static QList<QByteArray> splitFrames(const QByteArray& data);
+    // 帧的功能码，长度不足帧头时返回 0
+    static uint16_t functionCodeOf(const QByteArray& frameData);
+    
     // 解析接收到的帧数据
     struct ParsedData {
         uint8_t sourceAddr;
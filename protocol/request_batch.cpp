@@ -0,0 +1,141 @@
+#include "request_batch.h"
+#include "protocol_frame.h"
+
+RequestBatch::RequestBatch()
+    : m_pending(0)
+    , m_timeoutMs(0)
+{
+}
+
+void RequestBatch::add(const QString& name, const QByteArray& frame, quint16 replyCode)
+{
+    Item item;
+    item.name = name;
+    item.replyCode = replyCode != 0 ? replyCode : ProtocolFrame::functionCodeOf(frame);
+    item.frame = frame;
+    item.state = Pending;
+    m_items.append(item);
+    ++m_pending;
+}
+
+bool RequestBatch::isEmpty() const
+{
+    return m_items.isEmpty();
+}
+
+int RequestBatch::size() const
+{
+    return m_items.size();
+}
+
+const QList<RequestBatch::Item>& RequestBatch::items() const
+{
+    return m_items;
+}
+
+const RequestBatch::Item* RequestBatch::item(const QString& name) const
+{
+    for (const Item& item : m_items) {
+        if (item.name == name) {
+            return &item;
+        }
+    }
+    return nullptr;
+}
+
+QList<QByteArray> RequestBatch::frames() const
+{
+    QList<QByteArray> frames;
+    for (const Item& item : m_items) {
+        frames.append(item.frame);
+    }
+    return frames;
+}
+
+void RequestBatch::start(int timeoutMs)
+{
+    m_timeoutMs = timeoutMs;
+    m_timer.start();
+}
+
+bool RequestBatch::isStarted() const
+{
+    return m_timer.isValid();
+}
+
+qint64 RequestBatch::elapsedMs() const
+{
+    return m_timer.isValid() ? m_timer.elapsed() : 0;
+}
+
+int RequestBatch::remainingMs() const
+{
+    if (!m_timer.isValid()) {
+        return m_timeoutMs;
+    }
+    return static_cast<int>(qMax<qint64>(0, m_timeoutMs - m_timer.elapsed()));
+}
+
+bool RequestBatch::isExpired() const
+{
+    return m_timer.isValid() && m_timer.elapsed() >= m_timeoutMs;
+}
+
+bool RequestBatch::accept(const DeviceMessage& message)
+{
+    if (message.type == DeviceMessage::InvalidFrame) {
+        return false;
+    }
+
+    for (Item& item : m_items) {
+        if (item.state == Pending && item.replyCode == message.functionCode) {
+            item.state = message.isValid() ? Answered : Failed;
+            item.reply = message;
+            --m_pending;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RequestBatch::isComplete() const
+{
+    return m_pending == 0;
+}
+
+int RequestBatch::pendingCount() const
+{
+    return m_pending;
+}
+
+QStringList RequestBatch::pendingNames() const
+{
+    QStringList names;
+    for (const Item& item : m_items) {
+        if (item.state == Pending) {
+            names.append(item.name);
+        }
+    }
+    return names;
+}
+
+QStringList RequestBatch::failedNames() const
+{
+    QStringList names;
+    for (const Item& item : m_items) {
+        if (item.state == Failed) {
+            names.append(item.name);
+        }
+    }
+    return names;
+}
+
+RequestBatch RequestBatch::networkConfigQuery()
+{
+    RequestBatch batch;
+    batch.add("mac", ProtocolFrame::buildMacQueryFrame());
+    batch.add("ip", ProtocolFrame::buildIpQueryFrame());
+    batch.add("mask", ProtocolFrame::buildMaskQueryFrame());
+    batch.add("gateway", ProtocolFrame::buildGatewayQueryFrame());
+    return batch;
+}
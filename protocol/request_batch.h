@@ -0,0 +1,73 @@
+#ifndef REQUEST_BATCH_H
+#define REQUEST_BATCH_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include "device_message.h"
+
+// 流水线请求批次
+// 1. 多个请求帧首尾相接一次写出（payload），不逐个等待应答
+// 2. 应答按功能码匹配到最早未应答的同功能码请求，到达顺序不限，
+//    一次读到的多帧由 FramePipeline 逐帧解出后逐个 accept 即可
+// 3. 全部应答或超过截止时间即结束；截止时间由调用方的定时器检查
+// 不依赖界面和传输方式，界面、命令行均可复用；非线程安全
+class RequestBatch
+{
+public:
+    enum ItemState {
+        Pending,        // 等待应答
+        Answered,       // 收到有效应答
+        Failed          // 应答无效（载荷解码失败）
+    };
+
+    struct Item {
+        QString name;           // 请求名称，例如 "mac"、"ip"
+        quint16 replyCode;      // 期望的应答功能码
+        QByteArray frame;
+        ItemState state;
+        DeviceMessage reply;
+    };
+
+    RequestBatch();
+
+    // 添加请求；replyCode 为 0 时取请求帧自身的功能码（查询类应答与请求同功能码）
+    void add(const QString& name, const QByteArray& frame, quint16 replyCode = 0);
+
+    bool isEmpty() const;
+    int size() const;
+    const QList<Item>& items() const;
+    const Item* item(const QString& name) const;
+
+    // 全部请求帧，按添加顺序
+    QList<QByteArray> frames() const;
+
+    // 开始计时，timeoutMs 后视为超时
+    void start(int timeoutMs);
+    bool isStarted() const;
+    qint64 elapsedMs() const;
+    // 距截止时间的剩余毫秒数，已超时返回 0
+    int remainingMs() const;
+    bool isExpired() const;
+
+    // 匹配一条应答，属于本批次时返回 true
+    bool accept(const DeviceMessage& message);
+
+    bool isComplete() const;
+    int pendingCount() const;
+    QStringList pendingNames() const;
+    QStringList failedNames() const;
+
+    // 网络配置读取批次：mac、ip、mask、gateway 四项查询
+    static RequestBatch networkConfigQuery();
+
+private:
+    QList<Item> m_items;
+    int m_pending;
+    int m_timeoutMs;
+    QElapsedTimer m_timer;
+};
+
+#endif // REQUEST_BATCH_H
@@ -0,0 +1,124 @@
+#include "vcu_decoder.h"
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+// 按小端从任意地址读取一个字段
+template <typename T>
+inline T loadField(const uchar* p)
+{
+    T value;
+    memcpy(&value, p, sizeof(T));
+    return qFromLittleEndian(value);
+}
+
+template <>
+inline uint8_t loadField<uint8_t>(const uchar* p)
+{
+    return *p;
+}
+
+template <>
+inline int8_t loadField<int8_t>(const uchar* p)
+{
+    return static_cast<int8_t>(*p);
+}
+
+template <>
+inline float loadField<float>(const uchar* p)
+{
+    uint32_t bits = loadField<uint32_t>(p);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template <>
+inline FieldHostType_Text16 loadField<FieldHostType_Text16>(const uchar* p)
+{
+    FieldHostType_Text16 value;
+    memcpy(value.data(), p, value.size());
+    return value;
+}
+
+template <>
+inline FieldHostType_Ipv4 loadField<FieldHostType_Ipv4>(const uchar* p)
+{
+    FieldHostType_Ipv4 value;
+    memcpy(value.data(), p, value.size());
+    return value;
+}
+
+// 批量解码时每块的记录数，一块原始数据（约 16KB）可留在一级缓存中逐列处理
+const int kBatchBlockSize = 64;
+
+} // namespace
+
+void VcuColumns::clear()
+{
+    timestamps.clear();
+#define H7_VCU_COLUMN_CLEAR(name, ...) name.clear();
+    H7_VCU_FIELDS(H7_VCU_COLUMN_CLEAR)
+#undef H7_VCU_COLUMN_CLEAR
+}
+
+void VcuColumns::reserve(int count)
+{
+    timestamps.reserve(count);
+#define H7_VCU_COLUMN_RESERVE(name, ...) name.reserve(count);
+    H7_VCU_FIELDS(H7_VCU_COLUMN_RESERVE)
+#undef H7_VCU_COLUMN_RESERVE
+}
+
+VcuState decodeVcuState(const void* payload)
+{
+    const uchar* p = static_cast<const uchar*>(payload);
+    VcuState state;
+#define H7_VCU_DECODE_FIELD(name, member, offset, type, ...) \
+    state.name = loadField<FieldHostType_##type>(p + offset);
+    H7_VCU_FIELDS(H7_VCU_DECODE_FIELD)
+#undef H7_VCU_DECODE_FIELD
+    return state;
+}
+
+void decodeVcuBatch(const void* records, int stride, int count,
+                    int timestampOffset, int stateOffset, VcuColumns* columns)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    const uchar* base = static_cast<const uchar*>(records);
+    const int first = columns->size();
+
+    columns->timestamps.resize(first + count);
+#define H7_VCU_COLUMN_RESIZE(name, ...) columns->name.resize(first + count);
+    H7_VCU_FIELDS(H7_VCU_COLUMN_RESIZE)
+#undef H7_VCU_COLUMN_RESIZE
+
+    // 分块处理，块内逐列解码：每列是一个固定步长的紧凑循环
+    for (int blockBegin = 0; blockBegin < count; blockBegin += kBatchBlockSize) {
+        const int blockEnd = qMin(count, blockBegin + kBatchBlockSize);
+
+        // 时间戳为本机记录的数据，按本机字节序读取
+        qint64* timestamps = columns->timestamps.data() + first;
+        for (int i = blockBegin; i < blockEnd; ++i) {
+            timestamps[i] = 0;
+            if (timestampOffset >= 0) {
+                memcpy(&timestamps[i], base + static_cast<qint64>(i) * stride + timestampOffset, sizeof(qint64));
+            }
+        }
+
+#define H7_VCU_DECODE_COLUMN(name, member, offset, type, ...)                                       \
+        {                                                                                            \
+            FieldHostType_##type* column = columns->name.data() + first;                            \
+            const uchar* p = base + static_cast<qint64>(blockBegin) * stride + stateOffset + offset; \
+            for (int i = blockBegin; i < blockEnd; ++i, p += stride) {                               \
+                column[i] = loadField<FieldHostType_##type>(p);                                      \
+            }                                                                                        \
+        }
+        H7_VCU_FIELDS(H7_VCU_DECODE_COLUMN)
+#undef H7_VCU_DECODE_COLUMN
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef VCU_DECODER_H
+#define VCU_DECODER_H
+
+#include <QVector>
+#include <array>
+#include <cstdint>
+#include "field_descriptor.h"
+
+/*
+    VCU综合信息解码：
+    1. 协议中的 state_def_t 为 #pragma pack(1) 小端结构，浮点数不对齐，
+       直接通过指针或引用访问其成员在部分平台上是未定义行为且较慢
+    2. VcuState 由字段描述表生成，成员自然对齐，解码时逐字段 memcpy 读取并按小端转换
+    3. VcuColumns 为结构数组形式（每个字段一列），用于批量解码历史数据做分析
+ */
+
+// 字段类型对应的主机类型
+using FieldHostType_UInt8 = uint8_t;
+using FieldHostType_Int8 = int8_t;
+using FieldHostType_UInt16 = uint16_t;
+using FieldHostType_UInt32 = uint32_t;
+using FieldHostType_Float32 = float;
+using FieldHostType_Text16 = std::array<char, 16>;
+using FieldHostType_Ipv4 = std::array<uint8_t, 4>;
+
+// 自然对齐的VCU状态（成员名与字段描述表一致）
+struct VcuState {
+#define H7_VCU_HOST_MEMBER(name, member, offset, type, ...) FieldHostType_##type name;
+    H7_VCU_FIELDS(H7_VCU_HOST_MEMBER)
+#undef H7_VCU_HOST_MEMBER
+};
+
+// 结构数组形式的VCU状态序列
+struct VcuColumns {
+    QVector<qint64> timestamps;
+#define H7_VCU_COLUMN_MEMBER(name, member, offset, type, ...) QVector<FieldHostType_##type> name;
+    H7_VCU_FIELDS(H7_VCU_COLUMN_MEMBER)
+#undef H7_VCU_COLUMN_MEMBER
+
+    int size() const { return timestamps.size(); }
+    void clear();
+    void reserve(int count);
+};
+
+// 解码单帧：payload 为 sizeof(state_def_t) 字节的帧数据部分，无对齐要求
+VcuState decodeVcuState(const void* payload);
+
+// 批量解码：records 指向 count 条定长记录，每条 stride 字节，
+// 记录内 timestampOffset 处为本机字节序的 qint64 时间戳（小于 0 表示无时间戳，填 0），
+// stateOffset 处为 state_def_t 原始数据；结果追加到 columns
+void decodeVcuBatch(const void* records, int stride, int count,
+                    int timestampOffset, int stateOffset, VcuColumns* columns);
+
+#endif // VCU_DECODER_H
@@ -0,0 +1,209 @@
+#include "alarm_engine.h"
+#include "telemetry_archive.h"
+#include "../protocol/field_descriptor.h"
+#include "../common/log.h"
+
+AlarmEngine::AlarmEngine()
+{
+}
+
+bool AlarmEngine::setRules(const QList<AlarmRule>& rules)
+{
+    QVector<CompiledRule> compiled;
+    QVector<int> watchedFields;
+    QVector<QVector<int>> rulesBySlot;
+    QHash<int, int> slotOfField;
+
+    compiled.reserve(rules.size());
+    for (int i = 0; i < rules.size(); ++i) {
+        const AlarmRule& rule = rules[i];
+
+        const QByteArray fieldName = rule.field.toLatin1();
+        const int field = findField(kVcuFields, kVcuFieldCount, fieldName.constData());
+        if (field < 0) {
+            m_lastError = QString("报警规则 %1: 未知字段 %2").arg(rule.id, rule.field);
+            qCWarning(lcTelemetry) << m_lastError;
+            return false;
+        }
+        if (kVcuFields[field].type == FieldType::Text16 || kVcuFields[field].type == FieldType::Ipv4) {
+            m_lastError = QString("报警规则 %1: 字段 %2 不是数值").arg(rule.id, rule.field);
+            qCWarning(lcTelemetry) << m_lastError;
+            return false;
+        }
+        if (rule.hysteresis < 0.0) {
+            m_lastError = QString("报警规则 %1: 回差不能为负").arg(rule.id);
+            qCWarning(lcTelemetry) << m_lastError;
+            return false;
+        }
+
+        int slot = slotOfField.value(field, -1);
+        if (slot < 0) {
+            slot = watchedFields.size();
+            slotOfField.insert(field, slot);
+            watchedFields.append(field);
+            rulesBySlot.append(QVector<int>());
+        }
+
+        CompiledRule entry;
+        entry.rule = i;
+        entry.slot = slot;
+        entry.rate = rule.kind == AlarmRule::Rate;
+        entry.above = rule.direction == AlarmRule::Above;
+        entry.raiseLevel = rule.limit;
+        entry.clearLevel = entry.above ? rule.limit - rule.hysteresis : rule.limit + rule.hysteresis;
+
+        rulesBySlot[slot].append(compiled.size());
+        compiled.append(entry);
+    }
+
+    m_rules = rules;
+    m_compiled = compiled;
+    m_watchedFields = watchedFields;
+    m_rulesBySlot = rulesBySlot;
+    m_devices.clear();
+    m_lastError.clear();
+
+    qCDebug(lcTelemetry) << "报警规则已编译:" << m_compiled.size() << "条规则," << m_watchedFields.size() << "个字段";
+    return true;
+}
+
+QList<AlarmRule> AlarmEngine::rules() const
+{
+    return m_rules;
+}
+
+QString AlarmEngine::lastError() const
+{
+    return m_lastError;
+}
+
+QList<AlarmRule> AlarmEngine::defaultRules()
+{
+    // 气体限值取常用职业接触限值，单位按传感器的 ppm / %VOL 输出，现场可按实际传感器调整
+    QList<AlarmRule> rules;
+    rules << AlarmRule("emergency_stop", "emergency_stop", AlarmRule::Threshold, AlarmRule::Above, 0, 0, AlarmRule::Critical, "急停触发")
+          << AlarmRule("fire_sensor", "fire_sensor", AlarmRule::Threshold, AlarmRule::Above, 0, 0, AlarmRule::Critical, "检测到火焰")
+          << AlarmRule("fall_sensor", "fall_sensor", AlarmRule::Threshold, AlarmRule::Above, 0, 0, AlarmRule::Critical, "跌落传感器触发")
+          << AlarmRule("crash_head", "crash_head", AlarmRule::Threshold, AlarmRule::Above, 0, 0, AlarmRule::Critical, "前碰撞")
+          << AlarmRule("crash_rear", "crash_rear", AlarmRule::Threshold, AlarmRule::Above, 0, 0, AlarmRule::Critical, "后碰撞")
+          << AlarmRule("air_o2_low", "air_o2", AlarmRule::Threshold, AlarmRule::Below, 19.5, 0.5, AlarmRule::Critical, "氧气浓度过低")
+          << AlarmRule("air_h2s_high", "air_h2s", AlarmRule::Threshold, AlarmRule::Above, 10, 1, AlarmRule::Critical, "硫化氢浓度超限")
+          << AlarmRule("air_co_high", "air_co", AlarmRule::Threshold, AlarmRule::Above, 24, 2, AlarmRule::Critical, "一氧化碳浓度超限")
+          << AlarmRule("air_co_rise", "air_co", AlarmRule::Rate, AlarmRule::Above, 5, 1, AlarmRule::Warning, "一氧化碳浓度快速上升")
+          << AlarmRule("ch4_high", "ch4", AlarmRule::Threshold, AlarmRule::Above, 1.0, 0.1, AlarmRule::Critical, "甲烷浓度超限")
+          << AlarmRule("bat_temperature_high", "bat_temperature", AlarmRule::Threshold, AlarmRule::Above, 60, 5, AlarmRule::Warning, "电池温度过高");
+    return rules;
+}
+
+QVector<AlarmEvent> AlarmEngine::evaluate(const VcuSnapshot& snapshot)
+{
+    QVector<AlarmEvent> events;
+    if (m_compiled.isEmpty()) {
+        return events;
+    }
+
+    // 查找时直接引用快照中的序列号，不分配内存；新设备插入时才复制
+    const QByteArray rawKey = QByteArray::fromRawData(reinterpret_cast<const char*>(snapshot.state.serial_number),
+                                                      sizeof(snapshot.state.serial_number));
+    QHash<QByteArray, DeviceState>::iterator it = m_devices.find(rawKey);
+    if (it == m_devices.end()) {
+        DeviceState state;
+        state.initialized = false;
+        state.lastTimestampMs = 0;
+        state.sampleCount = 0;
+        state.values.fill(0.0, m_watchedFields.size());
+        state.changedAt.fill(0, m_watchedFields.size());
+        state.active.fill(0, m_compiled.size());
+        it = m_devices.insert(QByteArray(rawKey.constData(), rawKey.size()), state);
+    }
+
+    DeviceState& device = it.value();
+    const bool hasPrevious = device.initialized;
+    const double elapsedSeconds = (snapshot.receivedAtMs - device.lastTimestampMs) / 1000.0;
+    const bool rateValid = hasPrevious && elapsedSeconds > 0.0;
+    ++device.sampleCount;
+
+    QString deviceId;
+    for (int slot = 0; slot < m_watchedFields.size(); ++slot) {
+        const double value = readFieldValue(kVcuFields[m_watchedFields[slot]], &snapshot.state);
+        const double previous = device.values[slot];
+        if (hasPrevious && value == previous) {
+            continue;
+        }
+
+        device.values[slot] = value;
+        device.changedAt[slot] = device.sampleCount;
+
+        const QVector<int>& slotRules = m_rulesBySlot[slot];
+        for (int i = 0; i < slotRules.size(); ++i) {
+            const CompiledRule& rule = m_compiled[slotRules[i]];
+            if (!rule.rate) {
+                updateRule(slotRules[i], value, snapshot, &device, &deviceId, &events);
+            } else if (rateValid) {
+                updateRule(slotRules[i], (value - previous) / elapsedSeconds, snapshot, &device, &deviceId, &events);
+            }
+        }
+    }
+
+    // 值未变化的字段变化率为 0，只需检查其上仍处于触发状态的变化率规则
+    if (rateValid) {
+        for (int i = device.activeRateRules.size() - 1; i >= 0; --i) {
+            const int compiledIndex = device.activeRateRules[i];
+            if (device.changedAt[m_compiled[compiledIndex].slot] != device.sampleCount) {
+                updateRule(compiledIndex, 0.0, snapshot, &device, &deviceId, &events);
+            }
+        }
+    }
+
+    device.initialized = true;
+    device.lastTimestampMs = snapshot.receivedAtMs;
+    return events;
+}
+
+void AlarmEngine::reset()
+{
+    m_devices.clear();
+}
+
+void AlarmEngine::updateRule(int compiledIndex, double measured, const VcuSnapshot& snapshot,
+                             DeviceState* device, QString* deviceId, QVector<AlarmEvent>* events) const
+{
+    const CompiledRule& rule = m_compiled[compiledIndex];
+    const bool wasActive = device->active[compiledIndex] != 0;
+
+    bool isActive;
+    if (!wasActive) {
+        isActive = rule.above ? measured > rule.raiseLevel : measured < rule.raiseLevel;
+    } else {
+        isActive = !(rule.above ? measured <= rule.clearLevel : measured >= rule.clearLevel);
+    }
+
+    if (isActive == wasActive) {
+        return;
+    }
+
+    device->active[compiledIndex] = isActive ? 1 : 0;
+    if (rule.rate) {
+        if (isActive) {
+            device->activeRateRules.append(compiledIndex);
+        } else {
+            device->activeRateRules.removeOne(compiledIndex);
+        }
+    }
+
+    if (deviceId->isEmpty()) {
+        *deviceId = TelemetryArchive::vehicleIdOf(snapshot.state);
+    }
+
+    const AlarmRule& source = m_rules[rule.rule];
+    AlarmEvent event;
+    event.deviceId = *deviceId;
+    event.ruleId = source.id;
+    event.field = source.field;
+    event.message = source.message;
+    event.severity = source.severity;
+    event.active = isActive;
+    event.value = measured;
+    event.timestampMs = snapshot.receivedAtMs;
+    events->append(event);
+}
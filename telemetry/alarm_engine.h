@@ -0,0 +1,139 @@
+#ifndef ALARM_ENGINE_H
+#define ALARM_ENGINE_H
+
+#include <QString>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+#include <QMetaType>
+#include "../protocol/device_message.h"
+
+// 报警规则
+// 1. Threshold：字段值越过 limit 触发，回到 limit ∓ hysteresis 以内解除
+// 2. Rate：字段变化率（单位/秒）越过 limit 触发，回差规则同上
+struct AlarmRule {
+    enum Kind {
+        Threshold = 0,
+        Rate = 1
+    };
+
+    enum Direction {
+        Above = 0,      // 大于 limit 触发
+        Below = 1       // 小于 limit 触发
+    };
+
+    enum Severity {
+        Warning = 0,
+        Critical = 1
+    };
+
+    QString id;             // 规则标识
+    QString field;          // VCU字段名（与字段描述表一致）
+    Kind kind;
+    Direction direction;
+    double limit;
+    double hysteresis;      // 回差，>= 0
+    Severity severity;
+    QString message;        // 报警描述
+
+    AlarmRule() {
+        kind = Threshold;
+        direction = Above;
+        limit = 0.0;
+        hysteresis = 0.0;
+        severity = Warning;
+    }
+
+    AlarmRule(const QString& ruleId, const QString& fieldName, Kind ruleKind, Direction ruleDirection,
+              double ruleLimit, double ruleHysteresis, Severity ruleSeverity, const QString& text) {
+        id = ruleId;
+        field = fieldName;
+        kind = ruleKind;
+        direction = ruleDirection;
+        limit = ruleLimit;
+        hysteresis = ruleHysteresis;
+        severity = ruleSeverity;
+        message = text;
+    }
+};
+
+// 报警状态变化（触发或解除）
+struct AlarmEvent {
+    QString deviceId;           // 车辆序列号（24 位十六进制）
+    QString ruleId;
+    QString field;
+    QString message;
+    AlarmRule::Severity severity;
+    bool active;                // true 触发，false 解除
+    double value;               // 触发/解除时的字段值或变化率
+    qint64 timestampMs;         // 采样接收时间
+
+    AlarmEvent() {
+        severity = AlarmRule::Warning;
+        active = false;
+        value = 0.0;
+        timestampMs = 0;
+    }
+};
+
+Q_DECLARE_METATYPE(AlarmRule)
+Q_DECLARE_METATYPE(AlarmEvent)
+
+// 报警规则引擎（在通信工作线程中对每个VCU采样增量评估，非线程安全）
+// 规则在 setRules 时编译一次：按字段建立索引，只读取被规则引用的字段；
+// 每个采样只评估值发生变化的字段上的规则，以及仍处于触发状态的变化率规则，
+// 各设备（按序列号区分）的上次值和报警状态分别保存
+class AlarmEngine
+{
+public:
+    AlarmEngine();
+
+    // 编译并替换规则，清空各设备状态；规则有误时返回 false，原规则保持不变
+    bool setRules(const QList<AlarmRule>& rules);
+    QList<AlarmRule> rules() const;
+    QString lastError() const;
+
+    // 内置规则：安全传感器标志和常见气体限值
+    static QList<AlarmRule> defaultRules();
+
+    // 评估一个采样，返回本次状态发生变化的报警
+    QVector<AlarmEvent> evaluate(const VcuSnapshot& snapshot);
+
+    // 清空各设备状态，之后的采样按首次采样重新评估
+    void reset();
+
+private:
+    // 编译后的规则
+    struct CompiledRule {
+        int rule;               // m_rules 下标
+        int slot;               // 被引用字段下标（m_watchedFields）
+        bool rate;
+        bool above;
+        double raiseLevel;
+        double clearLevel;
+    };
+
+    // 单个设备的评估状态
+    struct DeviceState {
+        bool initialized;
+        qint64 lastTimestampMs;
+        quint64 sampleCount;
+        QVector<double> values;         // 每个被引用字段的上次值
+        QVector<quint64> changedAt;     // 每个被引用字段最后变化的采样序号
+        QVector<quint8> active;         // 每条编译规则是否处于触发状态
+        QVector<int> activeRateRules;   // 处于触发状态的变化率规则
+    };
+
+    void updateRule(int compiledIndex, double measured, const VcuSnapshot& snapshot,
+                    DeviceState* device, QString* deviceId, QVector<AlarmEvent>* events) const;
+
+    QList<AlarmRule> m_rules;
+    QVector<CompiledRule> m_compiled;
+    QVector<int> m_watchedFields;           // 被规则引用的字段（kVcuFields 下标）
+    QVector<QVector<int>> m_rulesBySlot;    // 每个被引用字段上的编译规则
+    QHash<QByteArray, DeviceState> m_devices;   // 键为 12 字节序列号
+    QString m_lastError;
+};
+
+#endif // ALARM_ENGINE_H
@@ -0,0 +1,304 @@
+#include "hardfault_history.h"
+#include "../common/log.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char kHistoryMagic[4] = { 'H', '7', 'H', 'F' };
+const quint16 kHistoryVersion = 1;
+// 固件保存 HardFault 现场时写入的魔数
+const quint32 kFaultMagic = 0xDEADBEEF;
+
+} // namespace
+
+HardFaultHistory::HardFaultHistory(const QString& filePath)
+    : m_filePath(filePath)
+    , m_writable(false)
+{
+}
+
+HardFaultHistory::~HardFaultHistory()
+{
+    m_file.close();
+}
+
+QString HardFaultHistory::filePath() const
+{
+    return m_filePath;
+}
+
+QString HardFaultHistory::lastError() const
+{
+    return m_lastError;
+}
+
+bool HardFaultHistory::load()
+{
+    m_file.close();
+    m_records.clear();
+    m_recordsByDevice.clear();
+    m_signaturesByDevice.clear();
+    m_locations.clear();
+    m_writable = false;
+
+    QFile file(m_filePath);
+    if (!file.exists()) {
+        m_writable = true;
+        return true;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_lastError = QString("打开故障历史失败: %1").arg(file.errorString());
+        qCWarning(lcTelemetry) << m_lastError;
+        return false;
+    }
+
+    const QByteArray data = file.readAll();
+    file.close();
+
+    FileHeader header;
+    if (data.size() < static_cast<int>(sizeof(header))) {
+        return rotateIncompatible("故障历史文件损坏");
+    }
+    memcpy(&header, data.constData(), sizeof(header));
+    if (memcmp(header.magic, kHistoryMagic, sizeof(header.magic)) != 0
+        || header.version != kHistoryVersion
+        || header.recordSize != sizeof(StoredRecord)) {
+        return rotateIncompatible("故障历史文件格式不兼容");
+    }
+
+    const int count = (data.size() - static_cast<int>(sizeof(header))) / static_cast<int>(sizeof(StoredRecord));
+    m_records.reserve(count);
+    const char* p = data.constData() + sizeof(header);
+    for (int i = 0; i < count; ++i, p += sizeof(StoredRecord)) {
+        StoredRecord stored;
+        memcpy(&stored, p, sizeof(stored));
+        // 早期版本会把“无故障”的全零应答也写入，加载时跳过
+        if (!isFaultRecord(stored.info)) {
+            continue;
+        }
+
+        Record record;
+        record.deviceId = QString::fromLatin1(stored.deviceId, static_cast<int>(strnlen(stored.deviceId, sizeof(stored.deviceId))));
+        record.receivedAtMs = stored.receivedAtMs;
+        record.info = stored.info;
+        m_records.append(record);
+        indexRecord(m_records.size() - 1);
+    }
+
+    // 写入中断留下的不完整记录截掉，保证后续追加对齐
+    const qint64 validSize = static_cast<qint64>(sizeof(header)) + static_cast<qint64>(count) * sizeof(StoredRecord);
+    if (data.size() > validSize) {
+        qCWarning(lcTelemetry) << "故障历史文件末尾记录不完整，已截断" << m_filePath;
+        QFile::resize(m_filePath, validSize);
+    }
+
+    qCDebug(lcTelemetry) << "已加载故障历史" << m_records.size() << "条," << m_recordsByDevice.size() << "辆车";
+    m_writable = true;
+    return true;
+}
+
+HardFaultHistory::AddResult HardFaultHistory::add(const QString& deviceId, qint64 receivedAtMs, const hardfault_info_t& info)
+{
+    // 去重按车辆进行，不允许用空标识或占位标识把不同车辆的故障合并
+    if (deviceId.isEmpty()) {
+        m_lastError = "车辆标识为空，故障未记录";
+        qCWarning(lcTelemetry) << m_lastError;
+        return Failed;
+    }
+    if (!isFaultRecord(info)) {
+        return NoFault;
+    }
+
+    const Signature signature = signatureOf(info);
+    if (m_signaturesByDevice.value(deviceId).contains(signature)) {
+        return Duplicate;
+    }
+
+    if (!openForAppend()) {
+        return Failed;
+    }
+
+    StoredRecord stored;
+    memset(&stored, 0, sizeof(stored));
+    stored.receivedAtMs = receivedAtMs;
+    const QByteArray id = deviceId.toLatin1();
+    memcpy(stored.deviceId, id.constData(), qMin(id.size(), static_cast<int>(sizeof(stored.deviceId))));
+    stored.info = info;
+
+    if (m_file.write(reinterpret_cast<const char*>(&stored), sizeof(stored)) != sizeof(stored) || !m_file.flush()) {
+        m_lastError = QString("写入故障历史失败: %1").arg(m_file.errorString());
+        qCWarning(lcTelemetry) << m_lastError;
+        return Failed;
+    }
+
+    Record record;
+    record.deviceId = deviceId;
+    record.receivedAtMs = receivedAtMs;
+    record.info = info;
+    m_records.append(record);
+    indexRecord(m_records.size() - 1);
+    return Added;
+}
+
+bool HardFaultHistory::isFaultRecord(const hardfault_info_t& info)
+{
+    // 打包结构体的字段先复制出来再比较
+    const quint32 magic = info.magic_number;
+    const quint32 faultCount = info.fault_count;
+    return magic == kFaultMagic && faultCount != 0;
+}
+
+int HardFaultHistory::size() const
+{
+    return m_records.size();
+}
+
+QStringList HardFaultHistory::devices() const
+{
+    QStringList result = m_recordsByDevice.keys();
+    result.sort();
+    return result;
+}
+
+QVector<HardFaultHistory::Record> HardFaultHistory::recordsOf(const QString& deviceId) const
+{
+    QVector<Record> result;
+    const QVector<int> indexes = m_recordsByDevice.value(deviceId);
+    result.reserve(indexes.size());
+    for (int index : indexes) {
+        result.append(m_records[index]);
+    }
+    return result;
+}
+
+QVector<HardFaultHistory::Record> HardFaultHistory::recordsAtPc(quint32 pc) const
+{
+    QVector<Record> result;
+    QHash<quint32, LocationEntry>::const_iterator it = m_locations.constFind(pc);
+    if (it == m_locations.constEnd()) {
+        return result;
+    }
+    result.reserve(it->records.size());
+    for (int index : it->records) {
+        result.append(m_records[index]);
+    }
+    return result;
+}
+
+QVector<HardFaultHistory::Location> HardFaultHistory::topLocations(int count) const
+{
+    // 索引中已按 PC 汇总，这里只对不同位置排序（数量远小于记录数）
+    QVector<Location> locations;
+    locations.reserve(m_locations.size());
+    for (QHash<quint32, LocationEntry>::const_iterator it = m_locations.constBegin(); it != m_locations.constEnd(); ++it) {
+        Location location;
+        location.pc = it.key();
+        location.faultCount = it->records.size();
+        location.deviceCount = it->devices.size();
+        location.lastSeenMs = it->lastSeenMs;
+        locations.append(location);
+    }
+
+    const int resultSize = qMin(qMax(count, 0), locations.size());
+    std::partial_sort(locations.begin(), locations.begin() + resultSize, locations.end(),
+                      [](const Location& a, const Location& b) {
+                          if (a.faultCount != b.faultCount) {
+                              return a.faultCount > b.faultCount;
+                          }
+                          return a.lastSeenMs > b.lastSeenMs;
+                      });
+    locations.resize(resultSize);
+    return locations;
+}
+
+HardFaultHistory::Signature HardFaultHistory::signatureOf(const hardfault_info_t& info)
+{
+    // hardfault_info_t 为打包结构，先复制到局部变量再使用
+    const quint32 pc = info.pc_value;
+    const quint32 lr = info.lr_value;
+    const quint32 faultCount = info.fault_count;
+    return Signature((static_cast<quint64>(pc) << 32) | lr, faultCount);
+}
+
+void HardFaultHistory::indexRecord(int recordIndex)
+{
+    const Record& record = m_records[recordIndex];
+    m_recordsByDevice[record.deviceId].append(recordIndex);
+    m_signaturesByDevice[record.deviceId].insert(signatureOf(record.info));
+
+    const quint32 pc = record.info.pc_value;
+    QHash<quint32, LocationEntry>::iterator it = m_locations.find(pc);
+    if (it == m_locations.end()) {
+        LocationEntry entry;
+        entry.lastSeenMs = record.receivedAtMs;
+        it = m_locations.insert(pc, entry);
+    }
+    it->records.append(recordIndex);
+    it->devices.insert(record.deviceId);
+    it->lastSeenMs = qMax(it->lastSeenMs, record.receivedAtMs);
+}
+
+bool HardFaultHistory::openForAppend()
+{
+    if (m_file.isOpen()) {
+        return true;
+    }
+    if (!m_writable) {
+        if (m_lastError.isEmpty()) {
+            m_lastError = "故障历史未加载，不能追加记录";
+        }
+        return false;
+    }
+
+    if (!QDir().mkpath(QFileInfo(m_filePath).absolutePath())) {
+        m_lastError = QString("创建故障历史目录失败: %1").arg(QFileInfo(m_filePath).absolutePath());
+        qCWarning(lcTelemetry) << m_lastError;
+        return false;
+    }
+
+    m_file.setFileName(m_filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        m_lastError = QString("打开故障历史失败: %1").arg(m_file.errorString());
+        qCWarning(lcTelemetry) << m_lastError;
+        return false;
+    }
+
+    // 新文件写入文件头
+    if (m_file.size() == 0) {
+        FileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, kHistoryMagic, sizeof(header.magic));
+        header.version = kHistoryVersion;
+        header.recordSize = sizeof(StoredRecord);
+        if (m_file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)) {
+            m_lastError = QString("写入故障历史失败: %1").arg(m_file.errorString());
+            qCWarning(lcTelemetry) << m_lastError;
+            m_file.close();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HardFaultHistory::rotateIncompatible(const QString& reason)
+{
+    // 移走无法识别的文件，保留原数据，之后的记录写入新文件
+    QString backupPath = m_filePath + ".bak";
+    if (QFile::exists(backupPath)) {
+        backupPath = QString("%1.%2.bak").arg(m_filePath, QDateTime::currentDateTime().toString("yyyyMMddhhmmss"));
+    }
+    if (!QFile::rename(m_filePath, backupPath)) {
+        m_lastError = QString("%1，且无法移走（不再记录新故障）: %2").arg(reason, m_filePath);
+        qCWarning(lcTelemetry) << m_lastError;
+        return false;
+    }
+
+    m_writable = true;
+    m_lastError = QString("%1，已改名为 %2，从空历史开始记录").arg(reason, backupPath);
+    qCWarning(lcTelemetry) << m_lastError;
+    return false;
+}
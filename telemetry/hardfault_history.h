@@ -0,0 +1,109 @@
+#ifndef HARDFAULT_HISTORY_H
+#define HARDFAULT_HISTORY_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QPair>
+#include <QFile>
+#include "../protocol/device_message.h"
+
+// HardFault 故障历史（按车辆序列号保存，去重，持久化到单个文件）
+// 1. 文件：16 字节文件头 + 定长记录 {qint64 接收时间, char[24] 车辆标识, hardfault_info_t}，只追加
+// 2. 同一车辆 (pc_value, lr_value, fault_count) 相同的记录视为同一次故障的重复读取，只保存一次
+// 3. 按 PC 建立哈希索引，全车队“哪些固件位置故障最多”直接由索引统计得到
+// 数据按本机字节序保存；非线程安全，在界面线程使用
+class HardFaultHistory
+{
+public:
+    enum AddResult {
+        Added = 0,
+        Duplicate,
+        NoFault,        // 设备无故障时应答全零结构，不记录
+        Failed
+    };
+
+    struct Record {
+        QString deviceId;
+        qint64 receivedAtMs;
+        hardfault_info_t info;
+    };
+
+    // 一个故障位置（PC）的统计
+    struct Location {
+        quint32 pc;
+        int faultCount;         // 去重后的故障次数
+        int deviceCount;        // 涉及的车辆数
+        qint64 lastSeenMs;      // 最近一次发生的接收时间
+    };
+
+    explicit HardFaultHistory(const QString& filePath);
+    ~HardFaultHistory();
+
+    QString filePath() const;
+    QString lastError() const;
+
+    // 读取历史文件并建立索引（文件不存在视为空历史）
+    // 文件损坏或格式不兼容时改名为 .bak 后从空历史开始，返回 false，lastError() 说明原因；
+    // 改名失败时不再追加写入，避免在旧格式文件后面写新记录
+    bool load();
+
+    // 添加一条记录，重复记录不写入；deviceId 必须是真实的车辆标识；需先调用 load()
+    AddResult add(const QString& deviceId, qint64 receivedAtMs, const hardfault_info_t& info);
+
+    // 魔数为 0xDEADBEEF 且故障计数非零才是一次真实故障
+    static bool isFaultRecord(const hardfault_info_t& info);
+
+    int size() const;
+    QStringList devices() const;
+    QVector<Record> recordsOf(const QString& deviceId) const;
+    QVector<Record> recordsAtPc(quint32 pc) const;
+
+    // 故障次数最多的 count 个位置（次数相同时按最近发生时间排序）
+    QVector<Location> topLocations(int count) const;
+
+private:
+    // 文件头
+    struct FileHeader {
+        char magic[4];
+        quint16 version;
+        quint16 recordSize;
+        quint8 reserved[8];
+    };
+
+    // 文件中的记录
+    struct StoredRecord {
+        qint64 receivedAtMs;
+        char deviceId[24];
+        hardfault_info_t info;
+    };
+
+    // 去重键：{(pc << 32) | lr, fault_count}
+    typedef QPair<quint64, quint32> Signature;
+
+    // 按 PC 的索引项
+    struct LocationEntry {
+        QVector<int> records;
+        QSet<QString> devices;
+        qint64 lastSeenMs;
+    };
+
+    static Signature signatureOf(const hardfault_info_t& info);
+    void indexRecord(int recordIndex);
+    bool openForAppend();
+    bool rotateIncompatible(const QString& reason);
+
+    QString m_filePath;
+    QString m_lastError;
+    QFile m_file;
+    bool m_writable;            // load() 成功或不兼容文件已移走后才允许追加
+
+    QVector<Record> m_records;
+    QHash<QString, QVector<int>> m_recordsByDevice;
+    QHash<QString, QSet<Signature>> m_signaturesByDevice;
+    QHash<quint32, LocationEntry> m_locations;
+};
+
+#endif // HARDFAULT_HISTORY_H
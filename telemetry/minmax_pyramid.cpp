@@ -0,0 +1,173 @@
+#include "minmax_pyramid.h"
+#include <limits>
+
+MinMaxPyramid::MinMaxPyramid(const TelemetryStore* store, int field)
+    : m_store(store)
+    , m_field(field)
+    , m_syncedSequence(store->firstSequence())
+{
+    // 逐层建立，直到一个桶覆盖整个存储容量
+    for (qint64 bucketSize = BucketFactor; bucketSize <= store->capacity(); bucketSize *= BucketFactor) {
+        Level level;
+        level.bucketSize = bucketSize;
+        level.currentBucket = -1;
+        // 桶数组在样本到达时再分配
+        level.maxBuckets = static_cast<int>(store->capacity() / bucketSize) + 2;
+        m_levels.append(level);
+    }
+}
+
+int MinMaxPyramid::field() const
+{
+    return m_field;
+}
+
+void MinMaxPyramid::sync()
+{
+    qint64 begin = m_syncedSequence;
+    const qint64 end = m_store->nextSequence();
+
+    // 存储已覆盖或清空了未处理的样本，从现存最早的样本重新开始累积
+    if (begin < m_store->firstSequence()) {
+        begin = m_store->firstSequence();
+        for (Level& level : m_levels) {
+            level.currentBucket = -1;
+        }
+    }
+
+    // 分块复制列数据，避免逐点访问环形缓冲
+    const int ChunkSize = 4096;
+    float values[ChunkSize];
+    qint64 sequence = begin;
+    while (sequence < end) {
+        const int count = m_store->copyColumn(m_field, sequence, qMin(end, sequence + ChunkSize), values);
+        if (count <= 0) {
+            break;
+        }
+
+        for (Level& level : m_levels) {
+            reserveBuckets(level, (sequence + count - 1) / level.bucketSize);
+            const int buckets = level.minValues.size();
+            float* minValues = level.minValues.data();
+            float* maxValues = level.maxValues.data();
+            for (int i = 0; i < count; ++i) {
+                const qint64 bucket = (sequence + i) / level.bucketSize;
+                const int slot = static_cast<int>(bucket % buckets);
+                const float value = values[i];
+                if (bucket != level.currentBucket) {
+                    level.currentBucket = bucket;
+                    minValues[slot] = value;
+                    maxValues[slot] = value;
+                } else {
+                    if (value < minValues[slot]) {
+                        minValues[slot] = value;
+                    }
+                    if (value > maxValues[slot]) {
+                        maxValues[slot] = value;
+                    }
+                }
+            }
+        }
+        sequence += count;
+    }
+
+    m_syncedSequence = end;
+}
+
+void MinMaxPyramid::reserveBuckets(Level& level, qint64 lastBucket) const
+{
+    const int allocated = level.minValues.size();
+    if (allocated == level.maxBuckets) {
+        return;
+    }
+    const qint64 firstBucket = m_store->firstSequence() / level.bucketSize;
+    const int required = static_cast<int>(qMin<qint64>(lastBucket - firstBucket + 1, level.maxBuckets));
+    if (required <= allocated) {
+        return;
+    }
+
+    const int buckets = qMin(level.maxBuckets, qMax(required, allocated > 0 ? allocated * 2 : InitialBuckets));
+    QVector<float> minValues(buckets);
+    QVector<float> maxValues(buckets);
+
+    // 桶数变化后桶号对应的位置也变化，把仍在存储范围内的已有桶搬到新位置
+    if (level.currentBucket >= 0 && allocated > 0) {
+        for (qint64 bucket = qMax(firstBucket, level.currentBucket - allocated + 1); bucket <= level.currentBucket; ++bucket) {
+            const int from = static_cast<int>(bucket % allocated);
+            const int to = static_cast<int>(bucket % buckets);
+            minValues[to] = level.minValues[from];
+            maxValues[to] = level.maxValues[from];
+        }
+    }
+
+    level.minValues.swap(minValues);
+    level.maxValues.swap(maxValues);
+}
+
+void MinMaxPyramid::query(qint64 beginSequence, qint64 endSequence, int pixels,
+                          QVector<float>* minValues, QVector<float>* maxValues) const
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    minValues->fill(nan, qMax(0, pixels));
+    maxValues->fill(nan, qMax(0, pixels));
+
+    const qint64 begin = qMax(beginSequence, m_store->firstSequence());
+    const qint64 end = qMin(endSequence, m_syncedSequence);
+    const qint64 count = end - begin;
+    if (count <= 0 || pixels <= 0) {
+        return;
+    }
+
+    // 选择桶宽不超过每像素样本数的最高层，-1 表示直接读取原始样本
+    int levelIndex = -1;
+    for (int i = 0; i < m_levels.size(); ++i) {
+        if (m_levels[i].bucketSize * pixels <= count) {
+            levelIndex = i;
+        }
+    }
+
+    float* outMin = minValues->data();
+    float* outMax = maxValues->data();
+
+    for (int pixel = 0; pixel < pixels; ++pixel) {
+        const qint64 first = begin + count * pixel / pixels;
+        const qint64 last = begin + count * (pixel + 1) / pixels;
+        if (last <= first) {
+            continue;
+        }
+
+        if (levelIndex < 0) {
+            float low = m_store->valueAt(m_field, first);
+            float high = low;
+            for (qint64 sequence = first + 1; sequence < last; ++sequence) {
+                const float value = m_store->valueAt(m_field, sequence);
+                low = qMin(low, value);
+                high = qMax(high, value);
+            }
+            outMin[pixel] = low;
+            outMax[pixel] = high;
+        } else {
+            // 像素边界对齐到桶边界，误差不超过一个桶（小于一个像素）
+            const Level& level = m_levels[levelIndex];
+            const qint64 firstBucket = first / level.bucketSize;
+            const qint64 lastBucket = qMax(firstBucket + 1, last / level.bucketSize);
+            aggregate(level, firstBucket, lastBucket, &outMin[pixel], &outMax[pixel]);
+        }
+    }
+}
+
+void MinMaxPyramid::aggregate(const Level& level, qint64 beginBucket, qint64 endBucket,
+                              float* minValue, float* maxValue) const
+{
+    const int buckets = level.minValues.size();
+    int slot = static_cast<int>(beginBucket % buckets);
+    float low = level.minValues[slot];
+    float high = level.maxValues[slot];
+    for (qint64 bucket = beginBucket + 1; bucket < endBucket; ++bucket) {
+        slot = static_cast<int>(bucket % buckets);
+        low = qMin(low, level.minValues[slot]);
+        high = qMax(high, level.maxValues[slot]);
+    }
+    *minValue = low;
+    *maxValue = high;
+}
@@ -0,0 +1,53 @@
+#ifndef MINMAX_PYRAMID_H
+#define MINMAX_PYRAMID_H
+
+#include <QVector>
+#include "telemetry_store.h"
+
+// 单个字段的最小/最大值金字塔（用于曲线抽稀绘制）
+// 1. 第 k 层每个桶覆盖 BucketFactor^k 个连续样本，保存桶内最小值和最大值
+// 2. 桶按样本序号对齐，各层均为环形数组，随样本增加按需扩大，最多与 TelemetryStore 的容量对应
+// 3. 查询时按“每像素样本数”选择桶宽不超过它的最高层，每像素只合并少量桶，
+//    绘制代价只与像素宽度有关，与样本总数无关
+// 跟随 TelemetryStore 增量更新，非线程安全
+class MinMaxPyramid
+{
+public:
+    // 相邻两层桶宽的倍数
+    static constexpr int BucketFactor = 8;
+
+    MinMaxPyramid(const TelemetryStore* store, int field);
+
+    int field() const;
+
+    // 处理存储中新增的样本
+    void sync();
+
+    // 把序号区间 [beginSequence, endSequence) 按 pixels 个像素列聚合，
+    // 输出每列的最小值和最大值；没有样本的列为 NaN
+    void query(qint64 beginSequence, qint64 endSequence, int pixels,
+               QVector<float>* minValues, QVector<float>* maxValues) const;
+
+private:
+    // 每层首次分配的桶数，之后按两倍扩大
+    static constexpr int InitialBuckets = 64;
+
+    struct Level {
+        qint64 bucketSize;
+        qint64 currentBucket;       // 当前正在累积的桶号
+        int maxBuckets;             // 覆盖存储全部容量所需的桶数
+        QVector<float> minValues;   // 按 bucket % 已分配桶数 存放
+        QVector<float> maxValues;
+    };
+
+    // 保证 level 能容纳从存储最早样本所在桶到 lastBucket 的全部桶
+    void reserveBuckets(Level& level, qint64 lastBucket) const;
+    void aggregate(const Level& level, qint64 beginBucket, qint64 endBucket, float* minValue, float* maxValue) const;
+
+    const TelemetryStore* m_store;
+    int m_field;
+    qint64 m_syncedSequence;
+    QVector<Level> m_levels;
+};
+
+#endif // MINMAX_PYRAMID_H
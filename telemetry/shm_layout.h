@@ -0,0 +1,174 @@
+#ifndef SHM_LAYOUT_H
+#define SHM_LAYOUT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+#include "../pc_protocol.h"
+}
+
+/*
+    VCU综合信息共享内存布局（POSIX shm，本机其他进程只读映射）
+    不依赖 Qt，外部程序只需包含本文件和 pc_protocol.h
+
+    [ShmHeader][ShmField × fieldCount][ShmSlot × slotCount]
+
+    1. 写入方每收到一帧VCU综合信息写入一个槽位，槽位按 publishCount % slotCount 循环使用
+    2. 每个槽位是一把顺序锁：写入前 seq 置为奇数，写完置为下一个偶数；
+       读取方在读数据前后各读一次 seq，两次相同且为偶数则数据完整，否则重试
+    3. 读取方只读不写，写入方从不等待读取方；慢读取方最多读到被覆盖的槽位并重试
+    4. 最新样本的读取只有几次原子加载，不涉及系统调用；
+       ShmReadGuard 可直接访问映射中的数据，不需要拷贝
+    5. 写入方重新创建共享内存时会把旧内存的 writerActive 清零，读取方发现后应重新打开
+ */
+namespace H7Shm {
+
+constexpr char DefaultName[] = "/h7_ipset_vcu";
+constexpr uint32_t Magic = 0x4D533748;     // "H7SM"
+constexpr uint16_t LayoutVersion = 1;
+constexpr uint32_t DefaultSlotCount = 64;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "共享内存中的原子变量必须无锁");
+
+// 字段描述（与 FieldDescriptor 对应，字符串为 UTF-8，以 '\0' 结尾）
+struct ShmField {
+    char name[32];
+    char unit[16];
+    char label[64];
+    char group[32];
+    uint16_t offset;        // 在 state_def_t 中的偏移
+    uint8_t type;           // FieldType
+    uint8_t format;         // FieldFormat
+    uint8_t precision;
+    uint8_t size;           // 字节数
+    uint8_t reserved[2];
+};
+static_assert(sizeof(ShmField) == 152, "ShmField 布局变化需要提升 LayoutVersion");
+
+struct alignas(64) ShmSlot {
+    std::atomic<uint64_t> seq;  // 奇数表示正在写入
+    int64_t receivedAtMs;       // 接收时间(ms, Unix时间)
+    uint64_t sampleIndex;       // 样本序号，从 0 开始
+    state_def_t state;          // 原始VCU综合信息（打包结构）
+};
+
+struct alignas(64) ShmHeader {
+    uint32_t magic;
+    uint16_t layoutVersion;
+    uint16_t headerSize;
+    uint32_t sampleSize;        // sizeof(state_def_t)
+    uint32_t slotSize;          // sizeof(ShmSlot)
+    uint32_t slotCount;
+    uint32_t fieldCount;
+    uint32_t fieldsOffset;      // 字段表相对映射起点的偏移
+    uint32_t slotsOffset;       // 槽位数组相对映射起点的偏移
+    uint64_t totalSize;         // 映射总长度
+    int64_t writerPid;
+    int64_t createdAtMs;
+
+    // 写入方独占的缓存行
+    alignas(64) std::atomic<uint64_t> publishCount;     // 已发布的样本数
+    std::atomic<uint32_t> writerActive;                 // 写入方关闭或被替换后为 0
+};
+
+inline const ShmField* fields(const ShmHeader* header)
+{
+    return reinterpret_cast<const ShmField*>(reinterpret_cast<const char*>(header) + header->fieldsOffset);
+}
+
+inline const ShmSlot* slots(const ShmHeader* header)
+{
+    return reinterpret_cast<const ShmSlot*>(reinterpret_cast<const char*>(header) + header->slotsOffset);
+}
+
+// 映射后先校验头部，避免按错误的布局读取
+inline bool isCompatible(const ShmHeader* header, size_t mappedSize)
+{
+    return mappedSize >= sizeof(ShmHeader)
+        && header->magic == Magic
+        && header->layoutVersion == LayoutVersion
+        && header->sampleSize == sizeof(state_def_t)
+        && header->slotSize == sizeof(ShmSlot)
+        && header->slotCount > 0
+        && header->totalSize <= mappedSize;
+}
+
+/*
+    原地读取最新样本：
+        H7Shm::ShmReadGuard guard(header);
+        if (guard.slot()) {
+            float voltage = guard.slot()->state.voltage;   // 直接读映射中的数据
+            if (guard.valid()) { ... 使用 voltage ... }    // 读完后校验，失败则丢弃重读
+        }
+    读到的值只有在 valid() 返回 true 后才能使用
+ */
+class ShmReadGuard
+{
+public:
+    explicit ShmReadGuard(const ShmHeader* header)
+        : m_slot(nullptr)
+        , m_seq(0)
+    {
+        const uint64_t count = header->publishCount.load(std::memory_order_acquire);
+        if (count == 0) {
+            return;
+        }
+        const ShmSlot* slot = slots(header) + (count - 1) % header->slotCount;
+        m_seq = slot->seq.load(std::memory_order_acquire);
+        if ((m_seq & 1) == 0) {
+            m_slot = slot;
+        }
+    }
+
+    const ShmSlot* slot() const { return m_slot; }
+
+    bool valid() const
+    {
+        if (!m_slot) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return m_slot->seq.load(std::memory_order_relaxed) == m_seq;
+    }
+
+private:
+    const ShmSlot* m_slot;
+    uint64_t m_seq;
+};
+
+// 拷贝最新样本，最多重试 retries 次；没有样本或一直被覆盖时返回 false
+inline bool readLatest(const ShmHeader* header, state_def_t* state, int64_t* receivedAtMs = nullptr,
+                       uint64_t* sampleIndex = nullptr, int retries = 8)
+{
+    for (int i = 0; i < retries; ++i) {
+        ShmReadGuard guard(header);
+        if (!guard.slot()) {
+            if (header->publishCount.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
+            continue;
+        }
+        state_def_t copy;
+        memcpy(&copy, &guard.slot()->state, sizeof(copy));
+        const int64_t timestamp = guard.slot()->receivedAtMs;
+        const uint64_t index = guard.slot()->sampleIndex;
+        if (guard.valid()) {
+            *state = copy;
+            if (receivedAtMs) {
+                *receivedAtMs = timestamp;
+            }
+            if (sampleIndex) {
+                *sampleIndex = index;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace H7Shm
+
+#endif // SHM_LAYOUT_H
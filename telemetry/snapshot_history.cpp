@@ -0,0 +1,152 @@
+#include "snapshot_history.h"
+#include "../protocol/field_descriptor.h"
+#include <cstring>
+
+SnapshotHistory::SnapshotHistory(int capacity)
+    : m_head(0)
+    , m_size(0)
+{
+    m_entries.resize(qBound(2, capacity, MaxCapacity));
+}
+
+void SnapshotHistory::setCapacity(int capacity)
+{
+    capacity = qBound(2, capacity, MaxCapacity);
+    if (capacity == m_entries.size()) {
+        return;
+    }
+
+    // 按时间顺序保留最近的快照
+    QVector<Entry> entries(capacity);
+    const int keep = qMin(m_size, capacity);
+    for (int i = 0; i < keep; ++i) {
+        entries[i] = entryAt(m_size - keep + i);
+    }
+    m_entries = entries;
+    m_head = 0;
+    m_size = keep;
+}
+
+int SnapshotHistory::capacity() const
+{
+    return m_entries.size();
+}
+
+int SnapshotHistory::size() const
+{
+    return m_size;
+}
+
+void SnapshotHistory::clear()
+{
+    m_head = 0;
+    m_size = 0;
+}
+
+void SnapshotHistory::append(qint64 timestampMs, const state_def_t& state)
+{
+    int slot;
+    if (m_size < m_entries.size()) {
+        slot = (m_head + m_size) % m_entries.size();
+        ++m_size;
+    } else {
+        slot = m_head;
+        m_head = (m_head + 1) % m_entries.size();
+    }
+
+    Entry& entry = m_entries[slot];
+    entry.timestampMs = timestampMs;
+    memset(&entry.block, 0, sizeof(entry.block));
+    memcpy(&entry.block, &state, sizeof(state));
+}
+
+qint64 SnapshotHistory::timestampAt(int i) const
+{
+    return entryAt(i).timestampMs;
+}
+
+const state_def_t* SnapshotHistory::stateAt(int i) const
+{
+    return reinterpret_cast<const state_def_t*>(&entryAt(i).block);
+}
+
+QVector<SnapshotHistory::FieldDiff> SnapshotHistory::diff() const
+{
+    QVector<FieldDiff> result;
+    if (m_size < 2) {
+        return result;
+    }
+
+    // 第一步：整块异或，得到窗口内任意相邻快照间变化过的字节
+    Block windowMask;
+    Block lastMask;
+    memset(&windowMask, 0, sizeof(windowMask));
+    for (int i = 1; i < m_size; ++i) {
+        const quint64* previous = entryAt(i - 1).block.words;
+        const quint64* current = entryAt(i).block.words;
+        for (int w = 0; w < BlockWords; ++w) {
+            windowMask.words[w] |= previous[w] ^ current[w];
+        }
+    }
+
+    const quint64* beforeLast = entryAt(m_size - 2).block.words;
+    const quint64* last = entryAt(m_size - 1).block.words;
+    for (int w = 0; w < BlockWords; ++w) {
+        lastMask.words[w] = beforeLast[w] ^ last[w];
+    }
+
+    auto touched = [](const Block& mask, int offset, int length) {
+        const uchar* bytes = reinterpret_cast<const uchar*>(mask.words) + offset;
+        for (int i = 0; i < length; ++i) {
+            if (bytes[i]) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // 第二步：只对掩码覆盖到的字段计算详细差异
+    for (int field = 0; field < kVcuFieldCount; ++field) {
+        const FieldDescriptor& descriptor = kVcuFields[field];
+        const int length = fieldTypeSize(descriptor.type);
+        if (!touched(windowMask, descriptor.offset, length)) {
+            continue;
+        }
+
+        FieldDiff item;
+        item.field = field;
+        item.changedLast = touched(lastMask, descriptor.offset, length);
+        item.changeCount = 0;
+        item.numeric = isNumericField(descriptor);
+        item.delta = 0.0;
+        item.minimum = 0.0;
+        item.maximum = 0.0;
+
+        for (int i = 1; i < m_size; ++i) {
+            const uchar* previous = reinterpret_cast<const uchar*>(&entryAt(i - 1).block) + descriptor.offset;
+            const uchar* current = reinterpret_cast<const uchar*>(&entryAt(i).block) + descriptor.offset;
+            if (memcmp(previous, current, length) != 0) {
+                ++item.changeCount;
+            }
+        }
+
+        if (item.numeric) {
+            item.minimum = readFieldValue(descriptor, stateAt(0));
+            item.maximum = item.minimum;
+            for (int i = 1; i < m_size; ++i) {
+                const double value = readFieldValue(descriptor, stateAt(i));
+                item.minimum = qMin(item.minimum, value);
+                item.maximum = qMax(item.maximum, value);
+            }
+            item.delta = readFieldValue(descriptor, stateAt(m_size - 1)) - readFieldValue(descriptor, stateAt(m_size - 2));
+        }
+
+        result.append(item);
+    }
+    return result;
+}
+
+const SnapshotHistory::Entry& SnapshotHistory::entryAt(int i) const
+{
+    return m_entries[(m_head + i) % m_entries.size()];
+}
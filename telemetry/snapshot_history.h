@@ -0,0 +1,67 @@
+#ifndef SNAPSHOT_HISTORY_H
+#define SNAPSHOT_HISTORY_H
+
+#include <QVector>
+#include "../protocol/device_message.h"
+
+// 最近 N 次VCU综合信息快照及字段级差异
+// 1. 快照按 8 字节对齐补齐到 256 字节保存，比较时先按 64 位字整块异或，
+//    把窗口内所有相邻快照的差异累积为一个字节掩码（循环可被编译器向量化）
+// 2. 只有掩码覆盖到的字段才按描述表逐个计算变化量、最小/最大值和变化次数
+class SnapshotHistory
+{
+public:
+    static constexpr int DefaultCapacity = 16;
+    static constexpr int MaxCapacity = 256;
+
+    // 单个字段的差异
+    struct FieldDiff {
+        int field;              // kVcuFields 下标
+        bool changedLast;       // 最近两次快照之间是否变化
+        int changeCount;        // 窗口内相邻快照间的变化次数
+        bool numeric;           // 数值字段才有以下统计
+        double delta;           // 最近一次 - 上一次
+        double minimum;         // 窗口内最小值
+        double maximum;         // 窗口内最大值
+    };
+
+    explicit SnapshotHistory(int capacity = DefaultCapacity);
+
+    // 窗口大小，缩小时丢弃最早的快照
+    void setCapacity(int capacity);
+    int capacity() const;
+    int size() const;
+    void clear();
+
+    void append(qint64 timestampMs, const state_def_t& state);
+
+    // i = 0 为最早，size() - 1 为最近
+    qint64 timestampAt(int i) const;
+    const state_def_t* stateAt(int i) const;
+
+    // 窗口内发生过变化的字段（按描述表顺序）
+    QVector<FieldDiff> diff() const;
+
+private:
+    static constexpr int BlockWords = 32;
+
+    // 对齐的快照数据，state_def_t 之后补 0
+    struct alignas(8) Block {
+        quint64 words[BlockWords];
+    };
+
+    struct Entry {
+        qint64 timestampMs;
+        Block block;
+    };
+
+    static_assert(sizeof(state_def_t) <= sizeof(Block), "state_def_t 超出快照块大小");
+
+    const Entry& entryAt(int i) const;
+
+    QVector<Entry> m_entries;   // 环形缓冲
+    int m_head;                 // 最早快照的位置
+    int m_size;
+};
+
+#endif // SNAPSHOT_HISTORY_H
@@ -0,0 +1,423 @@
+#include "telemetry_archive.h"
+#include "../common/log.h"
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+
+namespace {
+
+const char kSegmentMagic[4] = { 'H', '7', 'T', 'A' };
+const quint16 kSegmentVersion = 1;
+const char kSegmentSuffix[] = ".h7seg";
+const char kIndexSuffix[] = ".h7idx";
+
+} // namespace
+
+TelemetryArchive::TelemetryArchive(const QString& rootPath)
+    : m_rootPath(rootPath)
+    , m_segmentRecords(0)
+    , m_lastTimestamp(0)
+{
+}
+
+TelemetryArchive::~TelemetryArchive()
+{
+    close();
+}
+
+QString TelemetryArchive::rootPath() const
+{
+    return m_rootPath;
+}
+
+QString TelemetryArchive::lastError() const
+{
+    return m_lastError;
+}
+
+QString TelemetryArchive::vehicleIdOf(const state_def_t& state)
+{
+    uint32_t serial[3];
+    memcpy(serial, state.serial_number, sizeof(serial));
+    return QString("%1%2%3")
+           .arg(serial[0], 8, 16, QChar('0'))
+           .arg(serial[1], 8, 16, QChar('0'))
+           .arg(serial[2], 8, 16, QChar('0'))
+           .toUpper();
+}
+
+bool TelemetryArchive::append(const VcuSnapshot& snapshot)
+{
+    return append(vehicleIdOf(snapshot.state), snapshot.receivedAtMs, snapshot.state);
+}
+
+bool TelemetryArchive::append(const QString& vehicleId, qint64 timestampMs, const state_def_t& state)
+{
+    // 切换车辆时关闭当前段
+    if (m_segmentFile.isOpen() && vehicleId != m_vehicleId) {
+        close();
+    }
+
+    if (!m_segmentFile.isOpen()) {
+        // 接续该车辆已有归档的最后时间，保证跨段时间戳单调
+        m_lastTimestamp = lastTimestampOf(vehicleId);
+        const qint64 segmentStartMs = qMax(timestampMs, m_lastTimestamp + 1);
+        if (!openSegment(vehicleId, segmentStartMs)) {
+            return false;
+        }
+        // 查询和导出按段起始时间选段，段内第一条记录不能早于段名中的时间
+        timestampMs = segmentStartMs;
+    } else if (m_segmentRecords >= MaxRecordsPerSegment) {
+        close();
+        const qint64 segmentStartMs = qMax(timestampMs, m_lastTimestamp + 1);
+        if (!openSegment(vehicleId, segmentStartMs)) {
+            return false;
+        }
+        timestampMs = segmentStartMs;
+    }
+
+    // 保持时间戳单调不减
+    if (timestampMs < m_lastTimestamp) {
+        timestampMs = m_lastTimestamp;
+    }
+
+    if (m_segmentRecords % IndexInterval == 0) {
+        IndexEntry entry;
+        entry.timestampMs = timestampMs;
+        entry.recordIndex = static_cast<quint32>(m_segmentRecords);
+        entry.reserved = 0;
+        if (m_indexFile.write(reinterpret_cast<const char*>(&entry), sizeof(entry)) != sizeof(entry)) {
+            m_lastError = QString("写入索引失败: %1").arg(m_indexFile.errorString());
+            qCWarning(lcTelemetry) << m_lastError;
+            return false;
+        }
+    }
+
+    char record[sizeof(qint64) + sizeof(state_def_t)];
+    memcpy(record, &timestampMs, sizeof(qint64));
+    memcpy(record + sizeof(qint64), &state, sizeof(state_def_t));
+    if (m_segmentFile.write(record, sizeof(record)) != static_cast<qint64>(sizeof(record))) {
+        m_lastError = QString("写入归档失败: %1").arg(m_segmentFile.errorString());
+        qCWarning(lcTelemetry) << m_lastError;
+        return false;
+    }
+
+    m_segmentRecords++;
+    m_lastTimestamp = timestampMs;
+    return true;
+}
+
+void TelemetryArchive::flush()
+{
+    if (m_segmentFile.isOpen()) {
+        m_segmentFile.flush();
+        m_indexFile.flush();
+    }
+}
+
+void TelemetryArchive::close()
+{
+    if (m_segmentFile.isOpen()) {
+        m_segmentFile.close();
+        m_indexFile.close();
+    }
+    m_segmentRecords = 0;
+}
+
+QStringList TelemetryArchive::vehicles() const
+{
+    return QDir(m_rootPath).entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+}
+
+QPair<qint64, qint64> TelemetryArchive::timeSpan(const QString& vehicleId)
+{
+    if (vehicleId == m_vehicleId) {
+        flush();
+    }
+
+    QList<qint64> starts = segmentStarts(vehicleId);
+    qint64 first = -1;
+    for (qint64 start : starts) {
+        MappedSegment segment;
+        if (mapSegment(segmentPath(vehicleId, start), &segment) && segment.recordCount > 0) {
+            memcpy(&first, segment.records, sizeof(qint64));
+            break;
+        }
+    }
+
+    qint64 last = lastTimestampOf(vehicleId);
+    if (first < 0 || last <= 0) {
+        return qMakePair(qint64(-1), qint64(-1));
+    }
+    return qMakePair(first, last);
+}
+
+qint64 TelemetryArchive::query(const QString& vehicleId, qint64 fromMs, qint64 toMs, const RecordVisitor& visitor)
+{
+    if (fromMs > toMs) {
+        return 0;
+    }
+    if (vehicleId == m_vehicleId) {
+        flush();
+    }
+
+    // 段文件名即起始时间，只根据目录列表挑选相关段
+    QList<qint64> starts = segmentStarts(vehicleId);
+    qint64 visited = 0;
+    for (int i = 0; i < starts.size(); ++i) {
+        if (starts[i] > toMs) {
+            break;
+        }
+        if (i + 1 < starts.size() && starts[i + 1] <= fromMs) {
+            continue;
+        }
+        if (!querySegment(vehicleId, starts[i], fromMs, toMs, visitor, &visited)) {
+            break;
+        }
+    }
+    return visited;
+}
+
+qint64 TelemetryArchive::queryColumns(const QString& vehicleId, qint64 fromMs, qint64 toMs, VcuColumns* columns)
+{
+    if (fromMs > toMs) {
+        return 0;
+    }
+    if (vehicleId == m_vehicleId) {
+        flush();
+    }
+
+    QList<qint64> starts = segmentStarts(vehicleId);
+    qint64 decoded = 0;
+    for (int i = 0; i < starts.size(); ++i) {
+        if (starts[i] > toMs) {
+            break;
+        }
+        if (i + 1 < starts.size() && starts[i + 1] <= fromMs) {
+            continue;
+        }
+
+        MappedSegment segment;
+        if (!mapSegment(segmentPath(vehicleId, starts[i]), &segment) || segment.recordCount == 0) {
+            continue;
+        }
+
+        // 段内记录按时间有序，区间内的记录在映射内存中连续，一次批量解码
+        QList<IndexEntry> index = readIndex(indexPath(vehicleId, starts[i]));
+        const qint64 first = lowerBoundRecord(segment, index, fromMs);
+        const qint64 last = toMs == std::numeric_limits<qint64>::max()
+                          ? segment.recordCount
+                          : lowerBoundRecord(segment, index, toMs + 1);
+        if (last > first) {
+            decodeVcuBatch(segment.records + first * recordSize(), recordSize(), static_cast<int>(last - first),
+                           0, static_cast<int>(sizeof(qint64)), columns);
+            decoded += last - first;
+        }
+    }
+    return decoded;
+}
+
+int TelemetryArchive::recordSize()
+{
+    return static_cast<int>(sizeof(qint64) + sizeof(state_def_t));
+}
+
+QString TelemetryArchive::vehicleDir(const QString& vehicleId) const
+{
+    return m_rootPath + "/" + vehicleId;
+}
+
+QList<qint64> TelemetryArchive::segmentStarts(const QString& vehicleId) const
+{
+    QList<qint64> starts;
+    QStringList files = QDir(vehicleDir(vehicleId)).entryList(QStringList() << QString("*") + kSegmentSuffix, QDir::Files);
+    for (const QString& file : files) {
+        bool ok = false;
+        qint64 start = QFileInfo(file).completeBaseName().toLongLong(&ok);
+        if (ok) {
+            starts.append(start);
+        }
+    }
+    std::sort(starts.begin(), starts.end());
+    return starts;
+}
+
+QString TelemetryArchive::segmentPath(const QString& vehicleId, qint64 startMs) const
+{
+    return vehicleDir(vehicleId) + "/" + QString::number(startMs) + kSegmentSuffix;
+}
+
+QString TelemetryArchive::indexPath(const QString& vehicleId, qint64 startMs) const
+{
+    return vehicleDir(vehicleId) + "/" + QString::number(startMs) + kIndexSuffix;
+}
+
+bool TelemetryArchive::openSegment(const QString& vehicleId, qint64 startMs)
+{
+    if (!QDir().mkpath(vehicleDir(vehicleId))) {
+        m_lastError = QString("创建归档目录失败: %1").arg(vehicleDir(vehicleId));
+        qCWarning(lcTelemetry) << m_lastError;
+        return false;
+    }
+
+    m_segmentFile.setFileName(segmentPath(vehicleId, startMs));
+    if (!m_segmentFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_lastError = QString("打开归档段失败: %1").arg(m_segmentFile.errorString());
+        qCWarning(lcTelemetry) << m_lastError;
+        return false;
+    }
+
+    m_indexFile.setFileName(indexPath(vehicleId, startMs));
+    if (!m_indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_lastError = QString("打开归档索引失败: %1").arg(m_indexFile.errorString());
+        qCWarning(lcTelemetry) << m_lastError;
+        m_segmentFile.close();
+        return false;
+    }
+
+    SegmentHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kSegmentMagic, sizeof(header.magic));
+    header.version = kSegmentVersion;
+    header.headerSize = sizeof(SegmentHeader);
+    header.recordSize = static_cast<quint32>(recordSize());
+    header.stateSize = sizeof(state_def_t);
+    header.startMs = startMs;
+    m_segmentFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    m_vehicleId = vehicleId;
+    m_segmentRecords = 0;
+    qCDebug(lcTelemetry) << "新建归档段" << m_segmentFile.fileName();
+    return true;
+}
+
+bool TelemetryArchive::mapSegment(const QString& path, MappedSegment* segment) const
+{
+    segment->file.setFileName(path);
+    if (!segment->file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 fileSize = segment->file.size();
+    if (fileSize < static_cast<qint64>(sizeof(SegmentHeader))) {
+        return false;
+    }
+
+    const uchar* data = segment->file.map(0, fileSize);
+    if (!data) {
+        qCWarning(lcTelemetry) << "映射归档段失败" << path << segment->file.errorString();
+        return false;
+    }
+
+    SegmentHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, kSegmentMagic, sizeof(header.magic)) != 0
+        || header.version != kSegmentVersion
+        || header.recordSize != static_cast<quint32>(recordSize())
+        || header.stateSize != sizeof(state_def_t)) {
+        qCWarning(lcTelemetry) << "归档段格式不匹配" << path;
+        return false;
+    }
+
+    // 异常退出时可能留下不完整的最后一条记录，按整条记录计数
+    segment->records = data + header.headerSize;
+    segment->recordCount = (fileSize - header.headerSize) / header.recordSize;
+    return true;
+}
+
+QList<TelemetryArchive::IndexEntry> TelemetryArchive::readIndex(const QString& path) const
+{
+    QList<IndexEntry> entries;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return entries;
+    }
+
+    QByteArray data = file.readAll();
+    const int count = data.size() / static_cast<int>(sizeof(IndexEntry));
+    entries.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        IndexEntry entry;
+        memcpy(&entry, data.constData() + i * sizeof(IndexEntry), sizeof(IndexEntry));
+        entries.append(entry);
+    }
+    return entries;
+}
+
+qint64 TelemetryArchive::lastTimestampOf(const QString& vehicleId)
+{
+    QList<qint64> starts = segmentStarts(vehicleId);
+    for (int i = starts.size() - 1; i >= 0; --i) {
+        MappedSegment segment;
+        if (mapSegment(segmentPath(vehicleId, starts[i]), &segment) && segment.recordCount > 0) {
+            qint64 timestamp;
+            memcpy(&timestamp, segment.records + (segment.recordCount - 1) * recordSize(), sizeof(qint64));
+            return timestamp;
+        }
+    }
+    return 0;
+}
+
+qint64 TelemetryArchive::lowerBoundRecord(const MappedSegment& segment, const QList<IndexEntry>& index,
+                                          qint64 timestampMs) const
+{
+    const int size = recordSize();
+    auto timestampAt = [&segment, size](qint64 record) {
+        qint64 timestamp;
+        memcpy(&timestamp, segment.records + record * size, sizeof(qint64));
+        return timestamp;
+    };
+
+    // 稀疏索引：找到最后一个时间戳 < timestampMs 的索引项，只在该块内查找
+    qint64 low = 0;
+    qint64 high = segment.recordCount;
+    for (int i = 0; i < index.size(); ++i) {
+        if (index[i].timestampMs < timestampMs) {
+            low = qMin<qint64>(index[i].recordIndex, segment.recordCount);
+        } else {
+            high = qMin<qint64>(index[i].recordIndex, segment.recordCount);
+            break;
+        }
+    }
+
+    // 块内二分查找第一条时间戳 >= timestampMs 的记录
+    while (low < high) {
+        qint64 mid = low + (high - low) / 2;
+        if (timestampAt(mid) < timestampMs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool TelemetryArchive::querySegment(const QString& vehicleId, qint64 startMs, qint64 fromMs, qint64 toMs,
+                                    const RecordVisitor& visitor, qint64* visited)
+{
+    MappedSegment segment;
+    if (!mapSegment(segmentPath(vehicleId, startMs), &segment) || segment.recordCount == 0) {
+        return true;
+    }
+
+    const int size = recordSize();
+    const qint64 first = lowerBoundRecord(segment, readIndex(indexPath(vehicleId, startMs)), fromMs);
+
+    state_def_t state;
+    for (qint64 i = first; i < segment.recordCount; ++i) {
+        const uchar* record = segment.records + i * size;
+        qint64 timestamp;
+        memcpy(&timestamp, record, sizeof(qint64));
+        if (timestamp > toMs) {
+            return false;
+        }
+        memcpy(&state, record + sizeof(qint64), sizeof(state_def_t));
+        (*visited)++;
+        if (!visitor(timestamp, state)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,106 @@
+#ifndef TELEMETRY_ARCHIVE_H
+#define TELEMETRY_ARCHIVE_H
+
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QPair>
+#include <functional>
+#include "../protocol/device_message.h"
+#include "../protocol/vcu_decoder.h"
+
+// 遥测持久化归档（磁盘，按车辆分段追加写入）
+// 目录结构：<根目录>/<车辆序列号>/<起始时间ms>.h7seg 与同名 .h7idx
+// 1. 段文件：32 字节段头 + 定长记录 {qint64 时间戳, state_def_t 原始数据}，只追加
+// 2. 索引文件：每 IndexInterval 条记录写一项 {时间戳, 记录号}，按时间查询时只访问相关页
+// 3. 读取时通过 QFile::map 映射段文件，打开归档只列目录，不解析数据
+// 4. 每次启动写入新段，段内记录数达到 MaxRecordsPerSegment 后滚动到新段
+// 数据按本机字节序保存，只用于本机回放；非线程安全
+class TelemetryArchive
+{
+public:
+    // 每隔多少条记录写一条稀疏索引
+    static constexpr int IndexInterval = 256;
+    // 单段最大记录数
+    static constexpr int MaxRecordsPerSegment = 65536;
+
+    // 按时间顺序访问记录的回调，返回 false 停止遍历
+    typedef std::function<bool(qint64 timestampMs, const state_def_t& state)> RecordVisitor;
+
+    explicit TelemetryArchive(const QString& rootPath);
+    ~TelemetryArchive();
+
+    QString rootPath() const;
+    QString lastError() const;
+
+    // 由序列号生成车辆标识（24 位十六进制）
+    static QString vehicleIdOf(const state_def_t& state);
+
+    // 写入：车辆标识取自快照中的序列号
+    bool append(const VcuSnapshot& snapshot);
+    bool append(const QString& vehicleId, qint64 timestampMs, const state_def_t& state);
+    void flush();
+    void close();
+
+    // 读取
+    QStringList vehicles() const;
+    // 返回车辆归档的时间跨度 [最早, 最晚]，无数据时返回 (-1, -1)
+    QPair<qint64, qint64> timeSpan(const QString& vehicleId);
+    // 车辆各段的起始时间（升序），段 i 的记录时间在 [starts[i], starts[i+1]) 内
+    QList<qint64> segmentStarts(const QString& vehicleId) const;
+    // 按时间范围 [fromMs, toMs] 顺序遍历记录，返回访问的记录数
+    qint64 query(const QString& vehicleId, qint64 fromMs, qint64 toMs, const RecordVisitor& visitor);
+    // 按时间范围批量解码为结构数组形式（追加到 columns），返回解码的记录数
+    qint64 queryColumns(const QString& vehicleId, qint64 fromMs, qint64 toMs, VcuColumns* columns);
+
+private:
+    // 段头
+    struct SegmentHeader {
+        char magic[4];
+        quint16 version;
+        quint16 headerSize;
+        quint32 recordSize;
+        quint32 stateSize;
+        qint64 startMs;
+        quint8 reserved[8];
+    };
+
+    // 稀疏索引项
+    struct IndexEntry {
+        qint64 timestampMs;
+        quint32 recordIndex;
+        quint32 reserved;
+    };
+
+    // 已映射的段
+    struct MappedSegment {
+        QFile file;
+        const uchar* records;
+        qint64 recordCount;
+    };
+
+    static int recordSize();
+    QString vehicleDir(const QString& vehicleId) const;
+    QString segmentPath(const QString& vehicleId, qint64 startMs) const;
+    QString indexPath(const QString& vehicleId, qint64 startMs) const;
+
+    bool openSegment(const QString& vehicleId, qint64 startMs);
+    bool mapSegment(const QString& path, MappedSegment* segment) const;
+    QList<IndexEntry> readIndex(const QString& path) const;
+    qint64 lastTimestampOf(const QString& vehicleId);
+    qint64 lowerBoundRecord(const MappedSegment& segment, const QList<IndexEntry>& index, qint64 timestampMs) const;
+    bool querySegment(const QString& vehicleId, qint64 startMs, qint64 fromMs, qint64 toMs,
+                      const RecordVisitor& visitor, qint64* visited);
+
+    QString m_rootPath;
+    QString m_lastError;
+
+    // 当前写入段
+    QString m_vehicleId;
+    QFile m_segmentFile;
+    QFile m_indexFile;
+    qint64 m_segmentRecords;
+    qint64 m_lastTimestamp;
+};
+
+#endif // TELEMETRY_ARCHIVE_H
@@ -0,0 +1,414 @@
+#include "telemetry_exporter.h"
+#include "telemetry_archive.h"
+#include "../protocol/vcu_decoder.h"
+#include "../common/log.h"
+#include <QFile>
+#include <QtEndian>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace {
+
+// 列式格式
+const char kColumnarMagic[6] = { 'H', '7', 'C', 'O', 'L', '\0' };
+const quint16 kColumnarVersion = 1;
+const quint8 kTimestampColumnType = 0xFF;
+
+// CSV 输出缓冲
+const int kCsvBufferSize = 1024 * 1024;
+const int kCsvMaxRowSize = 4096;
+
+const uint64_t kPow10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL
+};
+
+// ---------- CSV 格式化 ----------
+
+inline char* appendUnsigned(char* p, uint64_t value)
+{
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (count > 0) {
+        *p++ = digits[--count];
+    }
+    return p;
+}
+
+inline char* appendSigned(char* p, int64_t value)
+{
+    if (value < 0) {
+        *p++ = '-';
+        return appendUnsigned(p, 0 - static_cast<uint64_t>(value));
+    }
+    return appendUnsigned(p, static_cast<uint64_t>(value));
+}
+
+inline char* appendHex(char* p, uint32_t value)
+{
+    static const char hexDigits[] = "0123456789ABCDEF";
+    *p++ = '0';
+    *p++ = 'x';
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        *p++ = hexDigits[(value >> shift) & 0xF];
+    }
+    return p;
+}
+
+// 定点格式化：按 precision 位小数四舍五入，超出整数范围时退回 snprintf
+char* appendFixed(char* p, float value, int precision)
+{
+    if (std::isnan(value)) {
+        memcpy(p, "nan", 3);
+        return p + 3;
+    }
+    if (std::isinf(value)) {
+        if (value < 0) {
+            *p++ = '-';
+        }
+        memcpy(p, "inf", 3);
+        return p + 3;
+    }
+
+    precision = qBound(0, precision, 8);
+    const double scaled = std::fabs(static_cast<double>(value)) * static_cast<double>(kPow10[precision]) + 0.5;
+    if (scaled >= 9.0e15) {
+        return p + snprintf(p, 64, "%.*f", precision, static_cast<double>(value));
+    }
+
+    const uint64_t fixed = static_cast<uint64_t>(scaled);
+    if (value < 0 && fixed != 0) {
+        *p++ = '-';
+    }
+    p = appendUnsigned(p, fixed / kPow10[precision]);
+    if (precision > 0) {
+        *p++ = '.';
+        uint64_t fraction = fixed % kPow10[precision];
+        for (int i = precision - 1; i >= 0; --i) {
+            p[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        p += precision;
+    }
+    return p;
+}
+
+inline char* appendCell(char* p, uint8_t value, FieldFormat format, int)
+{
+    return format == FieldFormat::Hex ? appendHex(p, value) : appendUnsigned(p, value);
+}
+
+inline char* appendCell(char* p, int8_t value, FieldFormat format, int)
+{
+    return format == FieldFormat::Hex ? appendHex(p, static_cast<uint8_t>(value)) : appendSigned(p, value);
+}
+
+inline char* appendCell(char* p, uint16_t value, FieldFormat format, int)
+{
+    return format == FieldFormat::Hex ? appendHex(p, value) : appendUnsigned(p, value);
+}
+
+inline char* appendCell(char* p, uint32_t value, FieldFormat format, int)
+{
+    return format == FieldFormat::Hex ? appendHex(p, value) : appendUnsigned(p, value);
+}
+
+inline char* appendCell(char* p, float value, FieldFormat, int precision)
+{
+    return appendFixed(p, value, precision);
+}
+
+// 文本字段：含逗号、引号或换行时按 CSV 规则加引号
+char* appendCell(char* p, const FieldHostType_Text16& value, FieldFormat, int)
+{
+    const char* text = value.data();
+    const int length = static_cast<int>(strnlen(text, value.size()));
+    bool needQuote = false;
+    for (int i = 0; i < length; ++i) {
+        if (text[i] == ',' || text[i] == '"' || text[i] == '\n' || text[i] == '\r') {
+            needQuote = true;
+            break;
+        }
+    }
+
+    if (!needQuote) {
+        memcpy(p, text, length);
+        return p + length;
+    }
+
+    *p++ = '"';
+    for (int i = 0; i < length; ++i) {
+        if (text[i] == '"') {
+            *p++ = '"';
+        }
+        *p++ = text[i];
+    }
+    *p++ = '"';
+    return p;
+}
+
+inline char* appendCell(char* p, const FieldHostType_Ipv4& value, FieldFormat, int)
+{
+    for (int i = 0; i < 4; ++i) {
+        if (i > 0) {
+            *p++ = '.';
+        }
+        p = appendUnsigned(p, value[i]);
+    }
+    return p;
+}
+
+// ---------- 列式编码 ----------
+
+template <typename T>
+QByteArray encodeDelta(const QVector<T>& values)
+{
+    // 无符号运算，溢出按模回绕，解码时同样回绕即可还原
+    typedef typename std::make_unsigned<T>::type U;
+    QByteArray raw(values.size() * static_cast<int>(sizeof(T)), Qt::Uninitialized);
+    uchar* out = reinterpret_cast<uchar*>(raw.data());
+    U previous = 0;
+    for (int i = 0; i < values.size(); ++i) {
+        const U current = static_cast<U>(values[i]);
+        qToLittleEndian<U>(static_cast<U>(current - previous), out + i * sizeof(T));
+        previous = current;
+    }
+    return raw;
+}
+
+QByteArray encodeColumn(const QVector<uint8_t>& values) { return encodeDelta(values); }
+QByteArray encodeColumn(const QVector<int8_t>& values) { return encodeDelta(values); }
+QByteArray encodeColumn(const QVector<uint16_t>& values) { return encodeDelta(values); }
+QByteArray encodeColumn(const QVector<uint32_t>& values) { return encodeDelta(values); }
+QByteArray encodeColumn(const QVector<qint64>& values) { return encodeDelta(values); }
+
+QByteArray encodeColumn(const QVector<float>& values)
+{
+    // 相邻采样值变化小，位模式异或后高位多为 0，压缩率高
+    QByteArray raw(values.size() * static_cast<int>(sizeof(float)), Qt::Uninitialized);
+    uchar* out = reinterpret_cast<uchar*>(raw.data());
+    uint32_t previous = 0;
+    for (int i = 0; i < values.size(); ++i) {
+        uint32_t bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+        qToLittleEndian<uint32_t>(bits ^ previous, out + i * sizeof(float));
+        previous = bits;
+    }
+    return raw;
+}
+
+template <typename T>
+QByteArray encodeRaw(const QVector<T>& values)
+{
+    return QByteArray(reinterpret_cast<const char*>(values.constData()), values.size() * static_cast<int>(sizeof(T)));
+}
+
+QByteArray encodeColumn(const QVector<FieldHostType_Text16>& values) { return encodeRaw(values); }
+QByteArray encodeColumn(const QVector<FieldHostType_Ipv4>& values) { return encodeRaw(values); }
+
+bool writeU16(QIODevice* device, quint16 value)
+{
+    uchar bytes[2];
+    qToLittleEndian(value, bytes);
+    return device->write(reinterpret_cast<const char*>(bytes), 2) == 2;
+}
+
+bool writeU32(QIODevice* device, quint32 value)
+{
+    uchar bytes[4];
+    qToLittleEndian(value, bytes);
+    return device->write(reinterpret_cast<const char*>(bytes), 4) == 4;
+}
+
+bool writeColumnDefinition(QIODevice* device, quint8 type, const char* name)
+{
+    const quint8 length = static_cast<quint8>(strlen(name));
+    return device->write(reinterpret_cast<const char*>(&type), 1) == 1
+        && device->write(reinterpret_cast<const char*>(&length), 1) == 1
+        && device->write(name, length) == length;
+}
+
+bool writeCompressedColumn(QIODevice* device, const QByteArray& raw)
+{
+    // 优先速度：导出一天的 20Hz 数据应在数秒内完成
+    const QByteArray compressed = qCompress(raw, 1);
+    return writeU32(device, static_cast<quint32>(compressed.size()))
+        && device->write(compressed) == compressed.size();
+}
+
+} // namespace
+
+TelemetryExporter::TelemetryExporter(QObject *parent)
+    : QObject(parent)
+    , m_cancelRequested(0)
+{
+}
+
+void TelemetryExporter::beginExport()
+{
+    m_cancelRequested.storeRelease(0);
+}
+
+void TelemetryExporter::cancel()
+{
+    m_cancelRequested.fetchAndStoreRelaxed(1);
+}
+
+void TelemetryExporter::exportArchive(const QString& archiveRoot, const QString& vehicleId,
+                                      qint64 fromMs, qint64 toMs, const QString& filePath, int format)
+{
+    // 取消标志由 beginExport() 在调用方清除，这里不再重置，否则排队期间的取消会丢失；
+    // 排队期间已取消时不创建（截断）目标文件
+    if (m_cancelRequested.loadAcquire()) {
+        emit exportFinished(false, "导出已取消");
+        return;
+    }
+
+    // 导出线程使用独立的只读归档实例
+    TelemetryArchive archive(archiveRoot);
+    const QList<qint64> allStarts = archive.segmentStarts(vehicleId);
+
+    // 与时间范围有重叠的段，以及每段对应的查询区间
+    QList<QPair<qint64, qint64>> ranges;
+    for (int i = 0; i < allStarts.size(); ++i) {
+        const qint64 segmentEnd = i + 1 < allStarts.size() ? allStarts[i + 1] - 1 : std::numeric_limits<qint64>::max();
+        if (allStarts[i] > toMs || segmentEnd < fromMs) {
+            continue;
+        }
+        ranges.append(qMakePair(qMax(fromMs, allStarts[i]), qMin(toMs, segmentEnd)));
+    }
+
+    if (ranges.isEmpty()) {
+        emit exportFinished(false, "没有可导出的数据");
+        return;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        emit exportFinished(false, QString("无法创建文件: %1").arg(file.errorString()));
+        return;
+    }
+
+    bool ok = format == Csv ? writeCsvHeader(&file) : writeColumnarHeader(&file);
+
+    VcuColumns columns;
+    qint64 rows = 0;
+    for (int i = 0; ok && i < ranges.size(); ++i) {
+        if (m_cancelRequested.loadAcquire()) {
+            file.close();
+            file.remove();
+            emit exportFinished(false, "导出已取消");
+            return;
+        }
+
+        // 逐段解码和写出，内存中只保留一个段的数据
+        columns.clear();
+        archive.queryColumns(vehicleId, ranges[i].first, ranges[i].second, &columns);
+        if (columns.size() > 0) {
+            ok = format == Csv ? writeCsvRows(&file, columns) : writeColumnarBlock(&file, columns);
+            rows += columns.size();
+        }
+
+        emit progressChanged((i + 1) * 100 / ranges.size());
+    }
+
+    if (ok && format == Columnar) {
+        ok = writeColumnarEnd(&file);
+    }
+
+    if (!ok) {
+        QString error = file.errorString();
+        file.close();
+        file.remove();
+        qCWarning(lcTelemetry) << "导出失败" << filePath << error;
+        emit exportFinished(false, QString("写入文件失败: %1").arg(error));
+        return;
+    }
+
+    file.close();
+    qCDebug(lcTelemetry) << "导出完成" << filePath << rows << "条记录";
+    emit exportFinished(true, QString("已导出 %1 条记录到 %2").arg(rows).arg(filePath));
+}
+
+bool TelemetryExporter::writeCsvHeader(QIODevice* device)
+{
+    QByteArray header("timestamp_ms");
+    for (int i = 0; i < kVcuFieldCount; ++i) {
+        header.append(',');
+        header.append(kVcuFields[i].name);
+    }
+    header.append('\n');
+    return device->write(header) == header.size();
+}
+
+bool TelemetryExporter::writeCsvRows(QIODevice* device, const VcuColumns& columns)
+{
+    QByteArray buffer(kCsvBufferSize, Qt::Uninitialized);
+    char* const begin = buffer.data();
+    char* const limit = begin + kCsvBufferSize - kCsvMaxRowSize;
+    char* p = begin;
+
+    for (int row = 0; row < columns.size(); ++row) {
+        p = appendSigned(p, columns.timestamps[row]);
+#define H7_CSV_CELL(name, member, offset, type, format, precision, ...) \
+        *p++ = ',';                                                   \
+        p = appendCell(p, columns.name[row], FieldFormat::format, precision);
+        H7_VCU_FIELDS(H7_CSV_CELL)
+#undef H7_CSV_CELL
+        *p++ = '\n';
+
+        if (p >= limit) {
+            if (device->write(begin, p - begin) != p - begin) {
+                return false;
+            }
+            p = begin;
+        }
+    }
+
+    return device->write(begin, p - begin) == p - begin;
+}
+
+bool TelemetryExporter::writeColumnarHeader(QIODevice* device)
+{
+    if (device->write(kColumnarMagic, sizeof(kColumnarMagic)) != sizeof(kColumnarMagic)
+        || !writeU16(device, kColumnarVersion)
+        || !writeU16(device, static_cast<quint16>(kVcuFieldCount + 1))
+        || !writeColumnDefinition(device, kTimestampColumnType, "timestamp_ms")) {
+        return false;
+    }
+
+    for (int i = 0; i < kVcuFieldCount; ++i) {
+        if (!writeColumnDefinition(device, static_cast<quint8>(kVcuFields[i].type), kVcuFields[i].name)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TelemetryExporter::writeColumnarBlock(QIODevice* device, const VcuColumns& columns)
+{
+    if (!writeU32(device, static_cast<quint32>(columns.size()))
+        || !writeCompressedColumn(device, encodeColumn(columns.timestamps))) {
+        return false;
+    }
+
+#define H7_COLUMNAR_COLUMN(name, ...)                                       \
+    if (!writeCompressedColumn(device, encodeColumn(columns.name))) {      \
+        return false;                                                       \
+    }
+    H7_VCU_FIELDS(H7_COLUMNAR_COLUMN)
+#undef H7_COLUMNAR_COLUMN
+
+    return true;
+}
+
+bool TelemetryExporter::writeColumnarEnd(QIODevice* device)
+{
+    return writeU32(device, 0);
+}
@@ -0,0 +1,61 @@
+#ifndef TELEMETRY_EXPORTER_H
+#define TELEMETRY_EXPORTER_H
+
+#include <QObject>
+#include <QString>
+#include <QAtomicInt>
+
+struct VcuColumns;
+class QIODevice;
+
+/*
+    遥测数据导出（在独立线程中运行）：
+    从 TelemetryArchive 按段读取并批量解码，逐段写出，内存占用与总时长无关。
+    1. CSV：首行为 timestamp_ms 和字段名，数值按字段描述表的格式和小数位数输出，
+       浮点数使用自带的定点格式化，不经过 QString
+    2. 列式二进制（.h7c，小端）：
+         文件头  "H7COL\0" | u16 版本 | u16 列数 | 每列 {u8 类型, u8 名称长度, 名称}
+         数据块  u32 行数 | 每列 {u32 压缩后长度, qCompress 数据} ...
+         结束    u32 0
+       压缩前按列变换：时间戳和整数列存与上一行的差值，浮点列存与上一行位模式的异或，
+       文本和地址列保持原样；变换在每个数据块内从 0 开始
+ */
+class TelemetryExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Format {
+        Csv = 0,
+        Columnar = 1
+    };
+
+    explicit TelemetryExporter(QObject *parent = nullptr);
+
+    // 排队调用 exportArchive 之前由调用方调用，清除上一次导出遗留的取消请求；
+    // 之后到达的 cancel() 即使早于 exportArchive 开始执行也会生效
+    void beginExport();
+
+    // 请求取消正在进行或已排队的导出（可在任意线程调用）
+    void cancel();
+
+public slots:
+    // 导出车辆在 [fromMs, toMs] 内的归档数据
+    void exportArchive(const QString& archiveRoot, const QString& vehicleId,
+                       qint64 fromMs, qint64 toMs, const QString& filePath, int format);
+
+signals:
+    void progressChanged(int percent);
+    void exportFinished(bool success, const QString& message);
+
+private:
+    bool writeCsvHeader(QIODevice* device);
+    bool writeCsvRows(QIODevice* device, const VcuColumns& columns);
+    bool writeColumnarHeader(QIODevice* device);
+    bool writeColumnarBlock(QIODevice* device, const VcuColumns& columns);
+    bool writeColumnarEnd(QIODevice* device);
+
+    QAtomicInt m_cancelRequested;
+};
+
+#endif // TELEMETRY_EXPORTER_H
@@ -0,0 +1,254 @@
+#include "telemetry_shm_publisher.h"
+#include "../common/log.h"
+#include "../protocol/field_descriptor.h"
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <new>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+template <size_t N>
+void copyText(char (&target)[N], const char* source)
+{
+    qstrncpy(target, source, N);
+}
+
+} // namespace
+
+TelemetryShmPublisher::TelemetryShmPublisher(const QString& name, quint32 slotCount)
+    : m_name(name)
+    , m_slotCount(qMax<quint32>(2, slotCount))
+    , m_header(nullptr)
+    , m_slots(nullptr)
+    , m_size(0)
+    , m_published(0)
+{
+}
+
+TelemetryShmPublisher::~TelemetryShmPublisher()
+{
+    close();
+}
+
+QString TelemetryShmPublisher::configuredName()
+{
+    const QString name = qEnvironmentVariable("H7_SHM_NAME");
+    if (name.isEmpty()) {
+        return QString::fromLatin1(H7Shm::DefaultName);
+    }
+    if (name == "off") {
+        return QString();
+    }
+    // POSIX 要求名称以 '/' 开头且不再含 '/'
+    return name.startsWith('/') ? name : "/" + name;
+}
+
+bool TelemetryShmPublisher::isOpen() const
+{
+    return m_header != nullptr;
+}
+
+QString TelemetryShmPublisher::name() const
+{
+    return m_name;
+}
+
+QString TelemetryShmPublisher::lastError() const
+{
+    return m_lastError;
+}
+
+#ifdef Q_OS_UNIX
+
+bool TelemetryShmPublisher::open()
+{
+    close();
+
+    const QByteArray name = m_name.toLocal8Bit();
+
+    // 同名内存已存在：写入方仍在运行时不能删除，否则它的读取方会一直读已失效的旧内存
+    int fd = shm_open(name.constData(), O_RDWR, 0);
+    if (fd >= 0) {
+        qint64 ownerPid = 0;
+        if (hasLiveWriter(fd, &ownerPid)) {
+            ::close(fd);
+            m_lastError = QString("共享内存 %1 正由进程 %2 发布，本进程不再发布（可用 H7_SHM_NAME 指定其他名称）")
+                          .arg(m_name).arg(ownerPid);
+            qCWarning(lcTelemetry) << m_lastError;
+            return false;
+        }
+
+        // 上次运行遗留的内存先标记失效，已映射的读取方据此重新打开
+        void* old = mmap(nullptr, sizeof(H7Shm::ShmHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (old != MAP_FAILED) {
+            H7Shm::ShmHeader* header = static_cast<H7Shm::ShmHeader*>(old);
+            if (header->magic == H7Shm::Magic) {
+                header->writerActive.store(0, std::memory_order_release);
+            }
+            munmap(old, sizeof(H7Shm::ShmHeader));
+        }
+        ::close(fd);
+        shm_unlink(name.constData());
+    }
+
+    const size_t fieldsOffset = sizeof(H7Shm::ShmHeader);
+    const size_t slotsOffset = (fieldsOffset + kVcuFieldCount * sizeof(H7Shm::ShmField) + alignof(H7Shm::ShmSlot) - 1)
+                             / alignof(H7Shm::ShmSlot) * alignof(H7Shm::ShmSlot);
+    const size_t size = slotsOffset + m_slotCount * sizeof(H7Shm::ShmSlot);
+
+    // O_EXCL：两个进程同时启动时只有一个能创建成功
+    fd = shm_open(name.constData(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        m_lastError = QString("创建共享内存 %1 失败: %2").arg(m_name, QString::fromLocal8Bit(strerror(errno)));
+        qCWarning(lcTelemetry) << m_lastError;
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        m_lastError = QString("设置共享内存 %1 大小失败: %2").arg(m_name, QString::fromLocal8Bit(strerror(errno)));
+        qCWarning(lcTelemetry) << m_lastError;
+        ::close(fd);
+        shm_unlink(name.constData());
+        return false;
+    }
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        m_lastError = QString("映射共享内存 %1 失败: %2").arg(m_name, QString::fromLocal8Bit(strerror(errno)));
+        qCWarning(lcTelemetry) << m_lastError;
+        shm_unlink(name.constData());
+        return false;
+    }
+
+    // ftruncate 后内容全为 0，原子变量的初值即为 0
+    H7Shm::ShmHeader* header = new (memory) H7Shm::ShmHeader;
+    header->magic = H7Shm::Magic;
+    header->layoutVersion = H7Shm::LayoutVersion;
+    header->headerSize = sizeof(H7Shm::ShmHeader);
+    header->sampleSize = sizeof(state_def_t);
+    header->slotSize = sizeof(H7Shm::ShmSlot);
+    header->slotCount = m_slotCount;
+    header->fieldCount = kVcuFieldCount;
+    header->fieldsOffset = static_cast<uint32_t>(fieldsOffset);
+    header->slotsOffset = static_cast<uint32_t>(slotsOffset);
+    header->totalSize = size;
+    header->writerPid = QCoreApplication::applicationPid();
+    header->createdAtMs = QDateTime::currentMSecsSinceEpoch();
+
+    H7Shm::ShmField* fields = reinterpret_cast<H7Shm::ShmField*>(static_cast<char*>(memory) + fieldsOffset);
+    for (int i = 0; i < kVcuFieldCount; ++i) {
+        const FieldDescriptor& field = kVcuFields[i];
+        H7Shm::ShmField& target = fields[i];
+        copyText(target.name, field.name);
+        copyText(target.unit, field.unit);
+        copyText(target.label, field.label);
+        copyText(target.group, field.group);
+        target.offset = field.offset;
+        target.type = static_cast<uint8_t>(field.type);
+        target.format = static_cast<uint8_t>(field.format);
+        target.precision = field.precision;
+        target.size = static_cast<uint8_t>(fieldTypeSize(field.type));
+    }
+
+    m_slots = reinterpret_cast<H7Shm::ShmSlot*>(static_cast<char*>(memory) + slotsOffset);
+    for (quint32 i = 0; i < m_slotCount; ++i) {
+        new (&m_slots[i]) H7Shm::ShmSlot;
+    }
+
+    m_header = header;
+    m_size = size;
+    m_published = 0;
+    m_header->publishCount.store(0, std::memory_order_relaxed);
+    m_header->writerActive.store(1, std::memory_order_release);
+
+    qCDebug(lcTelemetry) << "共享内存发布已启动:" << m_name << size << "字节," << m_slotCount << "个槽位";
+    return true;
+}
+
+bool TelemetryShmPublisher::hasLiveWriter(int fd, qint64* ownerPid) const
+{
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(H7Shm::ShmHeader)) {
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(H7Shm::ShmHeader), PROT_READ, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    const H7Shm::ShmHeader* header = static_cast<const H7Shm::ShmHeader*>(memory);
+    const qint64 pid = header->writerPid;
+    bool live = header->magic == H7Shm::Magic
+             && header->writerActive.load(std::memory_order_acquire) != 0
+             && pid > 0 && pid != QCoreApplication::applicationPid();
+    munmap(memory, sizeof(H7Shm::ShmHeader));
+
+    // 异常退出的写入方来不及清除 writerActive，再确认进程是否还在（EPERM 表示存在但属于其他用户）
+    if (live && kill(static_cast<pid_t>(pid), 0) != 0 && errno != EPERM) {
+        live = false;
+    }
+    *ownerPid = pid;
+    return live;
+}
+
+void TelemetryShmPublisher::close()
+{
+    if (!m_header) {
+        return;
+    }
+
+    // 标记失效后删除名称，已映射的读取方仍可访问到解除映射为止
+    m_header->writerActive.store(0, std::memory_order_release);
+    munmap(m_header, m_size);
+    shm_unlink(m_name.toLocal8Bit().constData());
+
+    m_header = nullptr;
+    m_slots = nullptr;
+    m_size = 0;
+}
+
+#else
+
+bool TelemetryShmPublisher::open()
+{
+    m_lastError = "当前平台不支持 POSIX 共享内存";
+    qCWarning(lcTelemetry) << m_lastError;
+    return false;
+}
+
+void TelemetryShmPublisher::close()
+{
+}
+
+#endif
+
+void TelemetryShmPublisher::publish(const VcuSnapshot& snapshot)
+{
+    if (!m_header) {
+        return;
+    }
+
+    const quint64 index = m_published++;
+    H7Shm::ShmSlot& slot = m_slots[index % m_slotCount];
+
+    // 顺序锁：seq 为奇数期间读取方会丢弃读到的数据
+    const uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.receivedAtMs = snapshot.receivedAtMs;
+    slot.sampleIndex = index;
+    memcpy(&slot.state, &snapshot.state, sizeof(state_def_t));
+
+    slot.seq.store(seq + 2, std::memory_order_release);
+    m_header->publishCount.store(index + 1, std::memory_order_release);
+}
@@ -0,0 +1,48 @@
+#ifndef TELEMETRY_SHM_PUBLISHER_H
+#define TELEMETRY_SHM_PUBLISHER_H
+
+#include <QString>
+#include "../protocol/device_message.h"
+#include "shm_layout.h"
+
+// VCU综合信息共享内存发布（布局见 shm_layout.h）
+// 1. open() 独占创建共享内存并写入头部和字段描述表；同名内存的写入方仍在运行时返回 false，
+//    写入方已退出（writerActive 为 0 或进程不存在）的遗留内存先标记失效、删除后再创建
+// 2. publish() 只做内存拷贝和几次原子写，不加锁、不做系统调用，也不等待读取方
+// 3. 只支持单个写入线程；Windows 等非 POSIX 平台上 open() 返回 false
+class TelemetryShmPublisher
+{
+public:
+    explicit TelemetryShmPublisher(const QString& name = QString::fromLatin1(H7Shm::DefaultName),
+                                   quint32 slotCount = H7Shm::DefaultSlotCount);
+    ~TelemetryShmPublisher();
+
+    bool open();
+    void close();
+
+    bool isOpen() const;
+    QString name() const;
+    QString lastError() const;
+
+    void publish(const VcuSnapshot& snapshot);
+
+    // 读取环境变量 H7_SHM_NAME 后的共享内存名称，设为 "off" 时返回空串（不发布）
+    static QString configuredName();
+
+private:
+    TelemetryShmPublisher(const TelemetryShmPublisher&) = delete;
+    TelemetryShmPublisher& operator=(const TelemetryShmPublisher&) = delete;
+
+    // 同名内存是否属于仍在运行的写入方，是时通过 ownerPid 返回其进程号
+    bool hasLiveWriter(int fd, qint64* ownerPid) const;
+
+    QString m_name;
+    quint32 m_slotCount;
+    H7Shm::ShmHeader* m_header;
+    H7Shm::ShmSlot* m_slots;
+    size_t m_size;
+    quint64 m_published;
+    QString m_lastError;
+};
+
+#endif // TELEMETRY_SHM_PUBLISHER_H
@@ -0,0 +1,306 @@
+#include "telemetry_store.h"
+#include <cstddef>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+struct ColumnEntry {
+    uint16_t offset;
+    int column;
+};
+
+// 存储列布局：取字段描述表中的数值字段，追加时按类型分组，每种类型一个紧凑循环
+struct ColumnPlan {
+    QVector<int> fields;                // 列号 -> kVcuFields 下标
+    QVector<ColumnEntry> uint8Columns;
+    QVector<ColumnEntry> int8Columns;
+    QVector<ColumnEntry> uint16Columns;
+    QVector<ColumnEntry> uint32Columns;
+    QVector<ColumnEntry> float32Columns;
+
+    ColumnPlan() {
+        for (int i = 0; i < kVcuFieldCount; ++i) {
+            const FieldDescriptor& field = kVcuFields[i];
+            if (!isNumericField(field)) {
+                continue;
+            }
+
+            ColumnEntry entry = { field.offset, fields.size() };
+            fields.append(i);
+            switch (field.type) {
+            case FieldType::UInt8:
+                uint8Columns.append(entry);
+                break;
+            case FieldType::Int8:
+                int8Columns.append(entry);
+                break;
+            case FieldType::UInt16:
+                uint16Columns.append(entry);
+                break;
+            case FieldType::UInt32:
+                uint32Columns.append(entry);
+                break;
+            case FieldType::Float32:
+                float32Columns.append(entry);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+};
+
+const ColumnPlan& columnPlan()
+{
+    static const ColumnPlan plan;
+    return plan;
+}
+
+template <typename T>
+inline void decodeColumns(const QVector<ColumnEntry>& entries, const char* base, float* columns, int capacity, int slot)
+{
+    for (const ColumnEntry& entry : entries) {
+        T value;
+        memcpy(&value, base + entry.offset, sizeof(T));
+        columns[entry.column * capacity + slot] = static_cast<float>(value);
+    }
+}
+
+} // namespace
+
+TelemetryStore::TelemetryStore(qint64 memoryBudgetBytes)
+    : m_capacity(0)
+    , m_allocated(0)
+    , m_firstSequence(0)
+    , m_nextSequence(0)
+{
+    // 每个样本占用：时间戳 + 每列一个 float
+    const qint64 bytesPerSample = static_cast<qint64>(sizeof(qint64)) + fieldCount() * static_cast<qint64>(sizeof(float));
+    m_capacity = static_cast<int>(qBound<qint64>(16, memoryBudgetBytes / bytesPerSample, INT_MAX / fieldCount()));
+}
+
+int TelemetryStore::fieldCount()
+{
+    return columnPlan().fields.size();
+}
+
+const FieldDescriptor& TelemetryStore::fieldDescriptor(int field)
+{
+    return kVcuFields[columnPlan().fields[field]];
+}
+
+QString TelemetryStore::fieldName(int field)
+{
+    if (field < 0 || field >= fieldCount()) {
+        return QString();
+    }
+    return QString::fromLatin1(kVcuFields[columnPlan().fields[field]].name);
+}
+
+int TelemetryStore::fieldIndex(const QString& name)
+{
+    for (int i = 0; i < fieldCount(); ++i) {
+        if (name == QLatin1String(kVcuFields[columnPlan().fields[i]].name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void TelemetryStore::append(const VcuSnapshot& snapshot)
+{
+    append(snapshot.receivedAtMs, snapshot.state);
+}
+
+void TelemetryStore::append(qint64 timestampMs, const state_def_t& state)
+{
+    // 保持时间戳单调不减（系统时间回拨时沿用上一个时间戳）
+    if (m_nextSequence > m_firstSequence) {
+        qint64 lastTimestamp = m_timestamps[slotOf(m_nextSequence - 1)];
+        if (timestampMs < lastTimestamp) {
+            timestampMs = lastTimestamp;
+        }
+    }
+
+    if (size() == m_allocated && m_allocated < m_capacity) {
+        grow(size() + 1);
+    }
+
+    const int slot = slotOf(m_nextSequence);
+    const char* base = reinterpret_cast<const char*>(&state);
+
+    const ColumnPlan& plan = columnPlan();
+    float* columns = m_columns.data();
+    m_timestamps[slot] = timestampMs;
+    decodeColumns<float>(plan.float32Columns, base, columns, m_allocated, slot);
+    decodeColumns<uint8_t>(plan.uint8Columns, base, columns, m_allocated, slot);
+    decodeColumns<int8_t>(plan.int8Columns, base, columns, m_allocated, slot);
+    decodeColumns<uint16_t>(plan.uint16Columns, base, columns, m_allocated, slot);
+    decodeColumns<uint32_t>(plan.uint32Columns, base, columns, m_allocated, slot);
+
+    m_nextSequence++;
+    if (m_nextSequence - m_firstSequence > m_capacity) {
+        m_firstSequence = m_nextSequence - m_capacity;
+    }
+}
+
+void TelemetryStore::clear()
+{
+    m_firstSequence = m_nextSequence;
+}
+
+int TelemetryStore::capacity() const
+{
+    return m_capacity;
+}
+
+int TelemetryStore::size() const
+{
+    return static_cast<int>(m_nextSequence - m_firstSequence);
+}
+
+bool TelemetryStore::isEmpty() const
+{
+    return m_nextSequence == m_firstSequence;
+}
+
+qint64 TelemetryStore::firstSequence() const
+{
+    return m_firstSequence;
+}
+
+qint64 TelemetryStore::nextSequence() const
+{
+    return m_nextSequence;
+}
+
+qint64 TelemetryStore::memoryUsage() const
+{
+    return static_cast<qint64>(m_timestamps.size()) * sizeof(qint64)
+         + static_cast<qint64>(m_columns.size()) * sizeof(float);
+}
+
+qint64 TelemetryStore::timestampAt(qint64 sequence) const
+{
+    return m_timestamps[slotOf(sequence)];
+}
+
+float TelemetryStore::valueAt(int field, qint64 sequence) const
+{
+    return m_columns[field * m_allocated + slotOf(sequence)];
+}
+
+QPair<qint64, qint64> TelemetryStore::sequenceRange(qint64 fromMs, qint64 toMs) const
+{
+    if (isEmpty() || fromMs > toMs) {
+        return qMakePair(m_nextSequence, m_nextSequence);
+    }
+    return qMakePair(lowerBound(fromMs), upperBound(toMs));
+}
+
+int TelemetryStore::copyTimestamps(qint64 beginSequence, qint64 endSequence, qint64* out) const
+{
+    QPair<qint64, qint64> range = clampRange(beginSequence, endSequence);
+    int count = static_cast<int>(range.second - range.first);
+    if (count <= 0) {
+        return 0;
+    }
+
+    int slot = slotOf(range.first);
+    int firstPart = qMin(count, m_allocated - slot);
+    memcpy(out, m_timestamps.constData() + slot, firstPart * sizeof(qint64));
+    if (count > firstPart) {
+        memcpy(out + firstPart, m_timestamps.constData(), (count - firstPart) * sizeof(qint64));
+    }
+    return count;
+}
+
+int TelemetryStore::copyColumn(int field, qint64 beginSequence, qint64 endSequence, float* out) const
+{
+    if (field < 0 || field >= fieldCount()) {
+        return 0;
+    }
+
+    QPair<qint64, qint64> range = clampRange(beginSequence, endSequence);
+    int count = static_cast<int>(range.second - range.first);
+    if (count <= 0) {
+        return 0;
+    }
+
+    const float* column = m_columns.constData() + field * m_allocated;
+    int slot = slotOf(range.first);
+    int firstPart = qMin(count, m_allocated - slot);
+    memcpy(out, column + slot, firstPart * sizeof(float));
+    if (count > firstPart) {
+        memcpy(out + firstPart, column, (count - firstPart) * sizeof(float));
+    }
+    return count;
+}
+
+int TelemetryStore::slotOf(qint64 sequence) const
+{
+    return static_cast<int>(sequence % m_allocated);
+}
+
+void TelemetryStore::grow(int required)
+{
+    const int allocated = qMin(m_capacity, qMax(required, m_allocated > 0 ? m_allocated * 2 : InitialSlots));
+    const int fields = fieldCount();
+
+    // 槽位数变化后序号对应的槽位也变化，逐个样本搬到新位置
+    QVector<qint64> timestamps(allocated);
+    QVector<float> columns(allocated * fields);
+    for (qint64 sequence = m_firstSequence; sequence < m_nextSequence; ++sequence) {
+        const int from = slotOf(sequence);
+        const int to = static_cast<int>(sequence % allocated);
+        timestamps[to] = m_timestamps[from];
+        for (int field = 0; field < fields; ++field) {
+            columns[field * allocated + to] = m_columns[field * m_allocated + from];
+        }
+    }
+
+    m_timestamps.swap(timestamps);
+    m_columns.swap(columns);
+    m_allocated = allocated;
+}
+
+qint64 TelemetryStore::lowerBound(qint64 timestampMs) const
+{
+    qint64 low = m_firstSequence;
+    qint64 high = m_nextSequence;
+    while (low < high) {
+        qint64 mid = low + (high - low) / 2;
+        if (m_timestamps[slotOf(mid)] < timestampMs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+qint64 TelemetryStore::upperBound(qint64 timestampMs) const
+{
+    qint64 low = m_firstSequence;
+    qint64 high = m_nextSequence;
+    while (low < high) {
+        qint64 mid = low + (high - low) / 2;
+        if (m_timestamps[slotOf(mid)] <= timestampMs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+QPair<qint64, qint64> TelemetryStore::clampRange(qint64 beginSequence, qint64 endSequence) const
+{
+    qint64 begin = qMax(beginSequence, m_firstSequence);
+    qint64 end = qMin(endSequence, m_nextSequence);
+    if (end < begin) {
+        end = begin;
+    }
+    return qMakePair(begin, end);
+}
@@ -0,0 +1,75 @@
+#ifndef TELEMETRY_STORE_H
+#define TELEMETRY_STORE_H
+
+#include <QVector>
+#include <QString>
+#include <QPair>
+#include "../protocol/device_message.h"
+#include "../protocol/field_descriptor.h"
+
+// 遥测时间序列存储（内存，列式环形缓冲）
+// 1. 字段描述表中 state_def_t 的每个数值字段单独一列连续存放（float），所有列共用一个时间戳列
+// 2. 容量由内存预算决定，写满后覆盖最早的样本，追加为均摊 O(1)
+//    缓冲区随数据增长按倍数扩大，达到容量后不再分配；不连接设备时不占用内存
+// 3. 样本使用全局递增的序号定位，序号 s 存放在第 s % 已分配槽位数 个槽位
+// 4. 时间戳保持单调不减，按时间范围查询为二分查找 O(log n)
+// 非线程安全，只在界面线程使用
+class TelemetryStore
+{
+public:
+    // 默认内存预算 64MB
+    static constexpr qint64 DefaultMemoryBudget = 64LL * 1024 * 1024;
+
+    explicit TelemetryStore(qint64 memoryBudgetBytes = DefaultMemoryBudget);
+
+    // 字段信息（列号与字段描述表下标不同，通过 fieldDescriptor 取描述）
+    static int fieldCount();
+    static const FieldDescriptor& fieldDescriptor(int field);
+    static QString fieldName(int field);
+    static int fieldIndex(const QString& name);   // 未找到返回 -1
+
+    // 追加样本
+    void append(const VcuSnapshot& snapshot);
+    void append(qint64 timestampMs, const state_def_t& state);
+    void clear();
+
+    // 容量与当前样本范围 [firstSequence, nextSequence)
+    int capacity() const;
+    int size() const;
+    bool isEmpty() const;
+    qint64 firstSequence() const;
+    qint64 nextSequence() const;
+    qint64 memoryUsage() const;
+
+    // 单点访问（序号必须在当前范围内）
+    qint64 timestampAt(qint64 sequence) const;
+    float valueAt(int field, qint64 sequence) const;
+
+    // 时间范围查询：返回时间戳落在 [fromMs, toMs] 内的样本序号区间 [first, second)
+    QPair<qint64, qint64> sequenceRange(qint64 fromMs, qint64 toMs) const;
+
+    // 按序号区间批量复制列数据，环形回绕时最多两次 memcpy，返回复制的样本数
+    int copyTimestamps(qint64 beginSequence, qint64 endSequence, qint64* out) const;
+    int copyColumn(int field, qint64 beginSequence, qint64 endSequence, float* out) const;
+
+private:
+    int slotOf(qint64 sequence) const;
+    qint64 lowerBound(qint64 timestampMs) const;   // 第一个时间戳 >= timestampMs 的序号
+    qint64 upperBound(qint64 timestampMs) const;   // 第一个时间戳 > timestampMs 的序号
+    QPair<qint64, qint64> clampRange(qint64 beginSequence, qint64 endSequence) const;
+
+    // 已满时把缓冲区扩大到至少 required 个槽位（不超过容量）
+    void grow(int required);
+
+    // 第一次追加时分配的槽位数
+    static constexpr int InitialSlots = 1024;
+
+    int m_capacity;             // 最大样本数（由内存预算决定）
+    int m_allocated;            // 当前已分配的槽位数
+    qint64 m_firstSequence;
+    qint64 m_nextSequence;
+    QVector<qint64> m_timestamps;
+    QVector<float> m_columns;      // 列优先：字段 f 占 [f * allocated, (f + 1) * allocated)
+};
+
+#endif // TELEMETRY_STORE_H
@@ -0,0 +1,13 @@
+# DeviceSession 单元测试：用内存中的假传输对象代替串口/网络线程，不需要设备
+QT       = core testlib serialport network
+
+# 协程设备接口（DeviceSession）需要 C++20；c++2a 兼容 Qt5 的 qmake
+CONFIG += c++2a console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_device_session
+
+include(../../h7_core.pri)
+
+SOURCES += \
+    tst_device_session.cpp
@@ -0,0 +1,240 @@
+#include <QtTest>
+#include "communication/device_session.h"
+#include "protocol/protocol_frame.h"
+
+// 假传输对象：接口与 SerialThread / SocketThread / DeviceLink 相同，记录写出的批次
+class FakeTransport : public QObject
+{
+    Q_OBJECT
+
+public:
+    bool isConnected() const { return connected; }
+
+    void sendBatch(const QList<QByteArray>& frames, SendQueue::Priority priority)
+    {
+        batches.append(frames);
+        priorities.append(priority);
+    }
+
+    // 模拟设备应答
+    void reply(quint16 functionCode, DeviceMessage::Type type = DeviceMessage::IpAddress)
+    {
+        DeviceMessage message;
+        message.type = type;
+        message.functionCode = functionCode;
+        if (type == DeviceMessage::PayloadError) {
+            message.errorMessage = "数据长度不符";
+        }
+        emit messageReceived(message);
+    }
+
+    bool connected = true;
+    QList<QList<QByteArray>> batches;
+    QList<SendQueue::Priority> priorities;
+
+signals:
+    void connectionStateChanged(bool connected);
+    void messageReceived(const DeviceMessage& message);
+    void dataSent(const QByteArray& data);
+};
+
+// 协程参数按值传入，挂起期间不引用调用方的临时对象
+static DeviceTask<DeviceResult> awaitOne(DeviceRequest request)
+{
+    co_return co_await request;
+}
+
+static DeviceTask<QList<DeviceResult>> awaitAll(DeviceSession* session, QList<DeviceRequest> requests)
+{
+    co_return co_await session->whenAll(requests);
+}
+
+class DeviceSessionTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void queryCompletesOnReply();
+    void whenAllSendsOneBatchInRequestOrder();
+    void setCompletesWhenWritten();
+    void invalidReply();
+    void timeout();
+    void cancelToken();
+    void completedRequestsReleaseTokenCallbacks();
+    void disconnectFailsPending();
+    void notConnectedCompletesImmediately();
+    void destroyingSessionCancelsPending();
+};
+
+void DeviceSessionTest::queryCompletesOnReply()
+{
+    FakeTransport transport;
+    DeviceSession session(&transport);
+
+    DeviceTask<DeviceResult> task = awaitOne(session.query(PC_IP_ADDR_QUERY));
+    QVERIFY(!task.isDone());
+    QCOMPARE(transport.batches.size(), 1);
+    QCOMPARE(transport.batches.first(), QList<QByteArray>{ProtocolFrame::buildIpQueryFrame()});
+    QCOMPARE(transport.priorities.first(), SendQueue::OneShotQuery);
+
+    // 其他功能码的应答不匹配
+    transport.reply(PC_MASK_ADDR_QUERY, DeviceMessage::MaskAddress);
+    QVERIFY(!task.isDone());
+
+    transport.reply(PC_IP_ADDR_QUERY);
+    QVERIFY(task.isDone());
+    QCOMPARE(task.result().status, DeviceResult::Ok);
+    QCOMPARE(task.result().message.functionCode, quint16(PC_IP_ADDR_QUERY));
+    QCOMPARE(session.pendingCount(), 0);
+}
+
+void DeviceSessionTest::whenAllSendsOneBatchInRequestOrder()
+{
+    FakeTransport transport;
+    DeviceSession session(&transport);
+
+    DeviceTask<QList<DeviceResult>> task = awaitAll(&session, {session.query(PC_IP_ADDR_QUERY),
+                                                               session.query(PC_MASK_ADDR_QUERY),
+                                                               session.set(ProtocolFrame::buildGatewaySetFrame("192.168.1.1"))});
+    QCOMPARE(transport.batches.size(), 1);
+    QCOMPARE(transport.batches.first().size(), 3);
+    // 组内有设置帧时按 ConfigWrite 写出
+    QCOMPARE(transport.priorities.first(), SendQueue::ConfigWrite);
+
+    // 到达顺序与请求顺序不同
+    transport.reply(PC_MASK_ADDR_QUERY, DeviceMessage::MaskAddress);
+    emit transport.dataSent(transport.batches.first().at(2));
+    QVERIFY(!task.isDone());
+    transport.reply(PC_IP_ADDR_QUERY);
+
+    QVERIFY(task.isDone());
+    const QList<DeviceResult> results = task.result();
+    QCOMPARE(results.size(), 3);
+    QCOMPARE(results[0].message.functionCode, quint16(PC_IP_ADDR_QUERY));
+    QCOMPARE(results[1].message.functionCode, quint16(PC_MASK_ADDR_QUERY));
+    QCOMPARE(results[2].status, DeviceResult::Ok);
+}
+
+void DeviceSessionTest::setCompletesWhenWritten()
+{
+    FakeTransport transport;
+    DeviceSession session(&transport);
+    const QByteArray frame = ProtocolFrame::buildIpSetFrame("192.168.1.20");
+
+    DeviceTask<DeviceResult> task = awaitOne(session.set(frame));
+    QCOMPARE(transport.priorities.first(), SendQueue::ConfigWrite);
+    QVERIFY(!task.isDone());
+
+    emit transport.dataSent(frame);
+    QVERIFY(task.isDone());
+    QCOMPARE(task.result().status, DeviceResult::Ok);
+}
+
+void DeviceSessionTest::invalidReply()
+{
+    FakeTransport transport;
+    DeviceSession session(&transport);
+
+    DeviceTask<DeviceResult> task = awaitOne(session.query(PC_IP_ADDR_QUERY));
+    transport.reply(PC_IP_ADDR_QUERY, DeviceMessage::PayloadError);
+    QVERIFY(task.isDone());
+    QCOMPARE(task.result().status, DeviceResult::InvalidReply);
+    QVERIFY(!task.result().error.isEmpty());
+}
+
+void DeviceSessionTest::timeout()
+{
+    FakeTransport transport;
+    DeviceSession session(&transport);
+
+    DeviceTask<DeviceResult> task = awaitOne(session.query(PC_IP_ADDR_QUERY).withTimeout(100));
+    QVERIFY(!task.isDone());
+    QTRY_VERIFY_WITH_TIMEOUT(task.isDone(), 2000);
+    QCOMPARE(task.result().status, DeviceResult::Timeout);
+
+    // 超时后迟到的应答被忽略
+    transport.reply(PC_IP_ADDR_QUERY);
+    QCOMPARE(session.pendingCount(), 0);
+}
+
+void DeviceSessionTest::cancelToken()
+{
+    FakeTransport transport;
+    DeviceSession session(&transport);
+    DeviceCancelToken token;
+
+    DeviceTask<DeviceResult> answered = awaitOne(session.query(PC_IP_ADDR_QUERY).withCancel(token));
+    DeviceTask<DeviceResult> cancelled = awaitOne(session.query(PC_MASK_ADDR_QUERY).withCancel(token));
+    QCOMPARE(token.pendingCount(), 2);
+
+    transport.reply(PC_IP_ADDR_QUERY);
+    QVERIFY(answered.isDone());
+    QCOMPARE(token.pendingCount(), 1);
+
+    token.cancel();
+    QVERIFY(cancelled.isDone());
+    QCOMPARE(cancelled.result().status, DeviceResult::Cancelled);
+    QCOMPARE(answered.result().status, DeviceResult::Ok);
+    QCOMPARE(token.pendingCount(), 0);
+    QCOMPARE(session.pendingCount(), 0);
+
+    // 已取消的令牌不再写出请求
+    DeviceTask<DeviceResult> late = awaitOne(session.query(PC_IP_ADDR_QUERY).withCancel(token));
+    QVERIFY(late.isDone());
+    QCOMPARE(late.result().status, DeviceResult::Cancelled);
+    QCOMPARE(transport.batches.size(), 2);
+}
+
+void DeviceSessionTest::completedRequestsReleaseTokenCallbacks()
+{
+    FakeTransport transport;
+    DeviceSession session(&transport);
+    DeviceCancelToken token;
+
+    // 长期复用的令牌不随请求数积累回调
+    for (int i = 0; i < 100; ++i) {
+        DeviceTask<DeviceResult> task = awaitOne(session.query(PC_IP_ADDR_QUERY).withCancel(token));
+        transport.reply(PC_IP_ADDR_QUERY);
+        QVERIFY(task.isDone());
+    }
+    QCOMPARE(token.pendingCount(), 0);
+}
+
+void DeviceSessionTest::disconnectFailsPending()
+{
+    FakeTransport transport;
+    DeviceSession session(&transport);
+
+    DeviceTask<DeviceResult> task = awaitOne(session.query(PC_IP_ADDR_QUERY));
+    transport.connected = false;
+    emit transport.connectionStateChanged(false);
+    QVERIFY(task.isDone());
+    QCOMPARE(task.result().status, DeviceResult::Disconnected);
+}
+
+void DeviceSessionTest::notConnectedCompletesImmediately()
+{
+    FakeTransport transport;
+    transport.connected = false;
+    DeviceSession session(&transport);
+
+    DeviceTask<DeviceResult> task = awaitOne(session.query(PC_IP_ADDR_QUERY));
+    QVERIFY(task.isDone());
+    QCOMPARE(task.result().status, DeviceResult::Disconnected);
+    QVERIFY(transport.batches.isEmpty());
+}
+
+void DeviceSessionTest::destroyingSessionCancelsPending()
+{
+    FakeTransport transport;
+    QScopedPointer<DeviceSession> session(new DeviceSession(&transport));
+
+    DeviceTask<DeviceResult> task = awaitOne(session->query(PC_IP_ADDR_QUERY));
+    session.reset();
+    QVERIFY(task.isDone());
+    QCOMPARE(task.result().status, DeviceResult::Cancelled);
+}
+
+QTEST_GUILESS_MAIN(DeviceSessionTest)
+
+#include "tst_device_session.moc"
@@ -1,8 +1,11 @@
 #include "debug_widget.h"
+#include "../communication/io_thread_pool.h"
+#include "../communication/rx_buffer_pool.h"
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QTextStream>
 #include <QScrollBar>
+#include <QStringList>
 #include <QDebug>
 
 DebugWidget::DebugWidget(QWidget *parent)
@@ -241,6 +244,22 @@ void DebugWidget::setDisplayFormat(DisplayFormat format)
     m_formatCombo->setCurrentIndex(static_cast<int>(format));
 }
 
+void DebugWidget::setSendQueueStats(const SendQueue::Stats& stats)
+{
+    QStringList lines;
+    lines << QString("发送队列深度: %1%2").arg(stats.totalDepth).arg(stats.congested ? " (拥塞)" : "");
+    for (int i = 0; i < SendQueue::PriorityCount; ++i) {
+        lines << QString("%1: 排队 %2/%3, 累计 %4, 丢弃 %5, 拒绝 %6")
+                 .arg(SendQueue::priorityName(static_cast<SendQueue::Priority>(i)))
+                 .arg(stats.depth[i])
+                 .arg(stats.capacity[i])
+                 .arg(stats.enqueued[i])
+                 .arg(stats.dropped[i])
+                 .arg(stats.rejected[i]);
+    }
+    m_sentStatsLabel->setToolTip(lines.join('\n'));
+}
+
 void DebugWidget::clearSentData()
 {
     m_sentTextEdit->clear();
@@ -399,6 +418,20 @@ void DebugWidget::updateReceivedStatistics()
 {
     QString stats = QString("接收: %1 包, %2").arg(m_receivedPacketsCount).arg(formatBytes(m_receivedBytesCount));
     m_receivedStatsLabel->setText(stats);
+    
+    // 接收缓冲池统计
+    RxBufferPool::Stats poolStats = RxBufferPool::instance()->stats();
+    IoThreadPool::Stats ioStats = IoThreadPool::instance()->stats();
+    m_receivedStatsLabel->setToolTip(QString("接收缓冲池: 共 %1 块, 使用中 %2 块, 峰值 %3 块\n申请 %4 次, 新分配内存 %5 次")
+                                     .arg(poolStats.totalChunks)
+                                     .arg(poolStats.inUseChunks)
+                                     .arg(poolStats.peakInUseChunks)
+                                     .arg(poolStats.acquireCount)
+                                     .arg(poolStats.allocationCount)
+                                     + QString("\nI/O线程: 已启动 %1 / %2, 会话 %3")
+                                     .arg(ioStats.startedThreads)
+                                     .arg(ioStats.maxThreads)
+                                     .arg(ioStats.sessions));
 }
 
 QString DebugWidget::formatBytes(int bytes) const
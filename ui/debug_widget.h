@@ -13,6 +13,7 @@
 #include <QComboBox>
 #include <QDateTime>
 #include <QTimer>
+#include "../communication/send_queue.h"
 
 class DebugWidget : public QWidget
 {
@@ -49,6 +50,9 @@ public:
     
     // 设置数据显示格式
     void setDisplayFormat(DisplayFormat format);
+    
+    // 更新发送队列统计显示
+    void setSendQueueStats(const SendQueue::Stats& stats);
 
 public slots:
     // 清除发送数据
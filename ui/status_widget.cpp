@@ -1,6 +1,13 @@
 #include "status_widget.h"
+#include "../common/log.h"
+#include <QElapsedTimer>
 #include <QMessageBox>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QColor>
 #include <QDebug>
+#include <cstring>
 
 StatusWidget::StatusWidget(QWidget *parent)
     : QWidget(parent)
@@ -13,91 +20,45 @@ StatusWidget::StatusWidget(QWidget *parent)
     , m_displayTabWidget(nullptr)
     , m_hardFaultTab(nullptr)
     , m_hardFaultScrollArea(nullptr)
-    , m_magicNumberEdit(nullptr)
-    , m_timestampEdit(nullptr)
-    , m_spValueEdit(nullptr)
-    , m_r0ValueEdit(nullptr)
-    , m_r1ValueEdit(nullptr)
-    , m_r2ValueEdit(nullptr)
-    , m_r3ValueEdit(nullptr)
-    , m_r12ValueEdit(nullptr)
-    , m_lrValueEdit(nullptr)
-    , m_pcValueEdit(nullptr)
-    , m_xpsrValueEdit(nullptr)
-    , m_faultCountEdit(nullptr)
     , m_hardFaultLastUpdateLabel(nullptr)
+    , m_hardFaultLocationTable(nullptr)
+    , m_firmwareLoadBtn(nullptr)
+    , m_firmwareLabel(nullptr)
+    , m_pcLocationEdit(nullptr)
+    , m_lrLocationEdit(nullptr)
+    , m_hasHardFault(false)
     , m_vcuTab(nullptr)
     , m_vcuScrollArea(nullptr)
-    , m_softwareVersionEdit(nullptr)
-    , m_hardwareVersionEdit(nullptr)
-    , m_bootVersionEdit(nullptr)
-    , m_electricEdit(nullptr)
-    , m_voltageEdit(nullptr)
-    , m_currentEdit(nullptr)
-    , m_wirelessVoltageEdit(nullptr)
-    , m_wirelessCurrentEdit(nullptr)
-    , m_temperatureEdit(nullptr)
-    , m_humidityEdit(nullptr)
-    , m_ipAddressEdit(nullptr)
-    , m_portEdit(nullptr)
-    , m_crashHeadEdit(nullptr)
-    , m_crashRearEdit(nullptr)
-    , m_proximityEdit(nullptr)
-    , m_emergencyStopEdit(nullptr)
-    , m_ctrlModeEdit(nullptr)
-    , m_clearModeEdit(nullptr)
-    , m_joyVcEdit(nullptr)
-    , m_joyVwEdit(nullptr)
-    , m_twistVcEdit(nullptr)
-    , m_twistVwEdit(nullptr)
-    , m_batTemperatureEdit(nullptr)
-    , m_cmdVcEdit(nullptr)
-    , m_cmdVwEdit(nullptr)
-    , m_devLockStaEdit(nullptr)
-    , m_fireSensorEdit(nullptr)
-    , m_fallSensorEdit(nullptr)
-    , m_ultrasonicFEdit(nullptr)
-    , m_ultrasonicREdit(nullptr)
-    , m_ultrasonicTlEdit(nullptr)
-    , m_ultrasonicTrEdit(nullptr)
-    , m_lifterHEdit(nullptr)
-    , m_airH2sEdit(nullptr)
-    , m_airCoEdit(nullptr)
-    , m_airO2Edit(nullptr)
-    , m_airExEdit(nullptr)
-    , m_airEdcEdit(nullptr)
-    , m_airC2h4Edit(nullptr)
-    , m_airHclEdit(nullptr)
-    , m_airCl2Edit(nullptr)
-    , m_airC3h6Edit(nullptr)
-    , m_airH2Edit(nullptr)
-    , m_airTempEdit(nullptr)
-    , m_airHumEdit(nullptr)
-    , m_airSf6Edit(nullptr)
-    , m_cocl2Edit(nullptr)
-    , m_c2h6oEdit(nullptr)
-    , m_ch4Edit(nullptr)
-    , m_drv0CurrentCh0Edit(nullptr)
-    , m_drv0CurrentCh1Edit(nullptr)
-    , m_drv1CurrentCh0Edit(nullptr)
-    , m_drv1CurrentCh1Edit(nullptr)
-    , m_joyCh0Edit(nullptr)
-    , m_joyCh1Edit(nullptr)
-    , m_joyCh2Edit(nullptr)
-    , m_joyCh3Edit(nullptr)
-    , m_serialNumber0Edit(nullptr)
-    , m_serialNumber1Edit(nullptr)
-    , m_serialNumber2Edit(nullptr)
-    , m_stsBmsEdit(nullptr)
-    , m_flagAirInvailEdit(nullptr)
-    , m_lfMotorCurrentEdit(nullptr)
-    , m_rfMotorCurrentEdit(nullptr)
-    , m_rrMotorCurrentEdit(nullptr)
-    , m_lrMotorCurrentEdit(nullptr)
     , m_vcuLastUpdateLabel(nullptr)
+    , m_hasVcu(false)
+    , m_networkConfigTab(nullptr)
+    , m_networkConfigScrollArea(nullptr)
+    , m_macQueryBtn(nullptr)
+    , m_ipQueryBtn(nullptr)
+    , m_maskQueryBtn(nullptr)
+    , m_gatewayQueryBtn(nullptr)
+    , m_networkReadAllBtn(nullptr)
+    , m_queryMacAddressEdit(nullptr)
+    , m_queryIpAddressEdit(nullptr)
+    , m_queryMaskAddressEdit(nullptr)
+    , m_queryGatewayAddressEdit(nullptr)
+    , m_networkConfigLastUpdateLabel(nullptr)
+    , m_trendTab(nullptr)
+    , m_trendFieldList(nullptr)
+    , m_trendWindowCombo(nullptr)
+    , m_trendChart(nullptr)
+    , m_telemetryStore(nullptr)
+    , m_snapshotTab(nullptr)
+    , m_snapshotCountSpin(nullptr)
+    , m_snapshotClearBtn(nullptr)
+    , m_snapshotInfoLabel(nullptr)
+    , m_snapshotTable(nullptr)
     , m_isReading(false)
     , m_statusTimer(nullptr)
 {
+    for (int i = 0; i < DisplayTabCount; ++i) {
+        m_tabBuilt[i] = false;
+    }
     initializeUI();
     setupConnections();
 }
@@ -164,18 +125,63 @@ void StatusWidget::initializeDisplayTabs()
 {
     m_displayTabWidget = new QTabWidget(this);
     
-    initializeHardFaultTab();
-    initializeVcuTab();
-    initializeNetworkConfigTab();
+    // 先放空白页，内容在第一次显示时由 ensureTabBuilt 构建（VCU页有近百个输入框，启动时不创建）
+    m_hardFaultTab = new QWidget();
+    m_vcuTab = new QWidget();
+    m_networkConfigTab = new QWidget();
+    m_trendTab = new QWidget();
+    m_snapshotTab = new QWidget();
     
     m_displayTabWidget->addTab(m_hardFaultTab, "HardFault故障信息");
     m_displayTabWidget->addTab(m_vcuTab, "VCU综合信息");
     m_displayTabWidget->addTab(m_networkConfigTab, "网络配置");
+    m_displayTabWidget->addTab(m_trendTab, "趋势图");
+    m_displayTabWidget->addTab(m_snapshotTab, "快照对比");
+}
+
+void StatusWidget::ensureTabBuilt(int index)
+{
+    if (index < 0 || index >= DisplayTabCount || m_tabBuilt[index]) {
+        return;
+    }
+    m_tabBuilt[index] = true;
+    
+    QElapsedTimer timer;
+    timer.start();
+    switch (index) {
+    case HardFaultTab:
+        initializeHardFaultTab();
+        updateHardFaultFields();
+        updateHardFaultLocationTable();
+        break;
+    case VcuTab:
+        initializeVcuTab();
+        updateVcuFields();
+        break;
+    case NetworkConfigTab:
+        initializeNetworkConfigTab();
+        updateNetworkConfigDisplay();
+        break;
+    case TrendTab:
+        initializeTrendTab();
+        break;
+    case SnapshotTab:
+        initializeSnapshotTab();
+        break;
+    default:
+        break;
+    }
+    qCDebug(lcUi) << "构建标签页" << m_displayTabWidget->tabText(index) << "耗时" << timer.elapsed() << "ms";
+}
+
+void StatusWidget::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    ensureTabBuilt(m_displayTabWidget->currentIndex());
 }
 
 void StatusWidget::initializeHardFaultTab()
 {
-    m_hardFaultTab = new QWidget();
     m_hardFaultScrollArea = new QScrollArea(m_hardFaultTab);
     m_hardFaultScrollArea->setWidgetResizable(true);
     
@@ -183,79 +189,21 @@ void StatusWidget::initializeHardFaultTab()
     QWidget* contentWidget = new QWidget();
     QGridLayout* gridLayout = new QGridLayout(contentWidget);
     
-    int row = 0;
+    // 按字段描述表生成显示项
+    int row = addFieldRows(gridLayout, contentWidget, kHardFaultFields, kHardFaultFieldCount, &m_hardFaultFieldEdits);
     
-    // 魔数标识
-    gridLayout->addWidget(new QLabel("魔数标识:", contentWidget), row, 0);
-    m_magicNumberEdit = new QLineEdit(contentWidget);
-    m_magicNumberEdit->setReadOnly(true);
-    gridLayout->addWidget(m_magicNumberEdit, row++, 1);
-    
-    // 时间戳
-    gridLayout->addWidget(new QLabel("时间戳(运行时间):", contentWidget), row, 0);
-    m_timestampEdit = new QLineEdit(contentWidget);
-    m_timestampEdit->setReadOnly(true);
-    gridLayout->addWidget(m_timestampEdit, row++, 1);
-    
-    // 堆栈指针值
-    gridLayout->addWidget(new QLabel("堆栈指针值(SP):", contentWidget), row, 0);
-    m_spValueEdit = new QLineEdit(contentWidget);
-    m_spValueEdit->setReadOnly(true);
-    gridLayout->addWidget(m_spValueEdit, row++, 1);
-    
-    // r0寄存器值
-    gridLayout->addWidget(new QLabel("r0寄存器值:", contentWidget), row, 0);
-    m_r0ValueEdit = new QLineEdit(contentWidget);
-    m_r0ValueEdit->setReadOnly(true);
-    gridLayout->addWidget(m_r0ValueEdit, row++, 1);
-    
-    // r1寄存器值
-    gridLayout->addWidget(new QLabel("r1寄存器值:", contentWidget), row, 0);
-    m_r1ValueEdit = new QLineEdit(contentWidget);
-    m_r1ValueEdit->setReadOnly(true);
-    gridLayout->addWidget(m_r1ValueEdit, row++, 1);
-    
-    // r2寄存器值
-    gridLayout->addWidget(new QLabel("r2寄存器值:", contentWidget), row, 0);
-    m_r2ValueEdit = new QLineEdit(contentWidget);
-    m_r2ValueEdit->setReadOnly(true);
-    gridLayout->addWidget(m_r2ValueEdit, row++, 1);
-    
-    // r3寄存器值
-    gridLayout->addWidget(new QLabel("r3寄存器值:", contentWidget), row, 0);
-    m_r3ValueEdit = new QLineEdit(contentWidget);
-    m_r3ValueEdit->setReadOnly(true);
-    gridLayout->addWidget(m_r3ValueEdit, row++, 1);
-    
-    // r12寄存器值
-    gridLayout->addWidget(new QLabel("r12寄存器值:", contentWidget), row, 0);
-    m_r12ValueEdit = new QLineEdit(contentWidget);
-    m_r12ValueEdit->setReadOnly(true);
-    gridLayout->addWidget(m_r12ValueEdit, row++, 1);
-    
-    // 链接寄存器值
-    gridLayout->addWidget(new QLabel("链接寄存器值(LR):", contentWidget), row, 0);
-    m_lrValueEdit = new QLineEdit(contentWidget);
-    m_lrValueEdit->setReadOnly(true);
-    gridLayout->addWidget(m_lrValueEdit, row++, 1);
-    
-    // 程序计数器值
-    gridLayout->addWidget(new QLabel("程序计数器值(PC):", contentWidget), row, 0);
-    m_pcValueEdit = new QLineEdit(contentWidget);
-    m_pcValueEdit->setReadOnly(true);
-    gridLayout->addWidget(m_pcValueEdit, row++, 1);
-    
-    // xpsr寄存器值
-    gridLayout->addWidget(new QLabel("xpsr寄存器值:", contentWidget), row, 0);
-    m_xpsrValueEdit = new QLineEdit(contentWidget);
-    m_xpsrValueEdit->setReadOnly(true);
-    gridLayout->addWidget(m_xpsrValueEdit, row++, 1);
-    
-    // 故障计数器
-    gridLayout->addWidget(new QLabel("故障计数器:", contentWidget), row, 0);
-    m_faultCountEdit = new QLineEdit(contentWidget);
-    m_faultCountEdit->setReadOnly(true);
-    gridLayout->addWidget(m_faultCountEdit, row++, 1);
+    // PC/LR 对应的函数和源码位置（需加载固件ELF）
+    m_pcLocationEdit = new QLineEdit(contentWidget);
+    m_pcLocationEdit->setReadOnly(true);
+    m_pcLocationEdit->setPlaceholderText("加载固件ELF后显示");
+    gridLayout->addWidget(new QLabel("PC位置:", contentWidget), row, 0);
+    gridLayout->addWidget(m_pcLocationEdit, row++, 1);
+    
+    m_lrLocationEdit = new QLineEdit(contentWidget);
+    m_lrLocationEdit->setReadOnly(true);
+    m_lrLocationEdit->setPlaceholderText("加载固件ELF后显示");
+    gridLayout->addWidget(new QLabel("LR位置:", contentWidget), row, 0);
+    gridLayout->addWidget(m_lrLocationEdit, row++, 1);
     
     // 最后更新时间
     m_hardFaultLastUpdateLabel = new QLabel("暂无数据", contentWidget);
@@ -268,14 +216,36 @@ void StatusWidget::initializeHardFaultTab()
     
     m_hardFaultScrollArea->setWidget(contentWidget);
     
+    // 故障位置统计
+    QGroupBox* locationGroup = new QGroupBox("故障位置统计（全部车辆）", m_hardFaultTab);
+    QVBoxLayout* locationLayout = new QVBoxLayout(locationGroup);
+    m_hardFaultLocationTable = new QTableWidget(0, 5, locationGroup);
+    m_hardFaultLocationTable->setHorizontalHeaderLabels(QStringList() << "PC地址" << "故障次数" << "车辆数" << "最近发生" << "函数/源码位置");
+    m_hardFaultLocationTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_hardFaultLocationTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_hardFaultLocationTable->verticalHeader()->setVisible(false);
+    m_hardFaultLocationTable->horizontalHeader()->setStretchLastSection(true);
+    locationLayout->addWidget(m_hardFaultLocationTable);
+    
+    // 固件ELF
+    QHBoxLayout* firmwareLayout = new QHBoxLayout();
+    m_firmwareLoadBtn = new QPushButton("加载固件ELF...", m_hardFaultTab);
+    m_firmwareLabel = new QLabel("未加载固件", m_hardFaultTab);
+    m_firmwareLabel->setStyleSheet("color: gray;");
+    firmwareLayout->addWidget(m_firmwareLoadBtn);
+    firmwareLayout->addWidget(m_firmwareLabel, 1);
+    
     // 设置tab布局
     QVBoxLayout* tabLayout = new QVBoxLayout(m_hardFaultTab);
-    tabLayout->addWidget(m_hardFaultScrollArea);
+    tabLayout->addLayout(firmwareLayout);
+    tabLayout->addWidget(m_hardFaultScrollArea, 3);
+    tabLayout->addWidget(locationGroup, 2);
+    
+    connect(m_firmwareLoadBtn, &QPushButton::clicked, this, &StatusWidget::onLoadFirmwareClicked);
 }
 
 void StatusWidget::initializeVcuTab()
 {
-    m_vcuTab = new QWidget();
     m_vcuScrollArea = new QScrollArea(m_vcuTab);
     m_vcuScrollArea->setWidgetResizable(true);
     
@@ -283,407 +253,8 @@ void StatusWidget::initializeVcuTab()
     QWidget* contentWidget = new QWidget();
     QGridLayout* gridLayout = new QGridLayout(contentWidget);
     
-    int row = 0;
-    
-    // 版本信息组
-    QLabel* versionGroupLabel = new QLabel("版本信息", contentWidget);
-    versionGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(versionGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("软件版本:", contentWidget), row, 0);
-    m_softwareVersionEdit = new QLineEdit(contentWidget);
-    m_softwareVersionEdit->setReadOnly(true);
-    gridLayout->addWidget(m_softwareVersionEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("硬件版本:", contentWidget), row, 0);
-    m_hardwareVersionEdit = new QLineEdit(contentWidget);
-    m_hardwareVersionEdit->setReadOnly(true);
-    gridLayout->addWidget(m_hardwareVersionEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("Boot版本:", contentWidget), row, 0);
-    m_bootVersionEdit = new QLineEdit(contentWidget);
-    m_bootVersionEdit->setReadOnly(true);
-    gridLayout->addWidget(m_bootVersionEdit, row++, 1);
-    
-    // 电源信息组
-    QLabel* powerGroupLabel = new QLabel("电源信息", contentWidget);
-    powerGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(powerGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("电量(%):", contentWidget), row, 0);
-    m_electricEdit = new QLineEdit(contentWidget);
-    m_electricEdit->setReadOnly(true);
-    gridLayout->addWidget(m_electricEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("电压(V):", contentWidget), row, 0);
-    m_voltageEdit = new QLineEdit(contentWidget);
-    m_voltageEdit->setReadOnly(true);
-    gridLayout->addWidget(m_voltageEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("电流(A):", contentWidget), row, 0);
-    m_currentEdit = new QLineEdit(contentWidget);
-    m_currentEdit->setReadOnly(true);
-    gridLayout->addWidget(m_currentEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("无线充电电压(V):", contentWidget), row, 0);
-    m_wirelessVoltageEdit = new QLineEdit(contentWidget);
-    m_wirelessVoltageEdit->setReadOnly(true);
-    gridLayout->addWidget(m_wirelessVoltageEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("无线充电电流(A):", contentWidget), row, 0);
-    m_wirelessCurrentEdit = new QLineEdit(contentWidget);
-    m_wirelessCurrentEdit->setReadOnly(true);
-    gridLayout->addWidget(m_wirelessCurrentEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("电池温度(℃):", contentWidget), row, 0);
-    m_batTemperatureEdit = new QLineEdit(contentWidget);
-    m_batTemperatureEdit->setReadOnly(true);
-    gridLayout->addWidget(m_batTemperatureEdit, row++, 1);
-    
-    // 环境信息组
-    QLabel* envGroupLabel = new QLabel("环境信息", contentWidget);
-    envGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(envGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("温度(℃):", contentWidget), row, 0);
-    m_temperatureEdit = new QLineEdit(contentWidget);
-    m_temperatureEdit->setReadOnly(true);
-    gridLayout->addWidget(m_temperatureEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("湿度(%):", contentWidget), row, 0);
-    m_humidityEdit = new QLineEdit(contentWidget);
-    m_humidityEdit->setReadOnly(true);
-    gridLayout->addWidget(m_humidityEdit, row++, 1);
-    
-    // 网络信息组
-    QLabel* netGroupLabel = new QLabel("网络信息", contentWidget);
-    netGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(netGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("IP地址:", contentWidget), row, 0);
-    m_ipAddressEdit = new QLineEdit(contentWidget);
-    m_ipAddressEdit->setReadOnly(true);
-    gridLayout->addWidget(m_ipAddressEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("端口:", contentWidget), row, 0);
-    m_portEdit = new QLineEdit(contentWidget);
-    m_portEdit->setReadOnly(true);
-    gridLayout->addWidget(m_portEdit, row++, 1);
-    
-    // 传感器状态组
-    QLabel* sensorGroupLabel = new QLabel("传感器状态", contentWidget);
-    sensorGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(sensorGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("前碰撞:", contentWidget), row, 0);
-    m_crashHeadEdit = new QLineEdit(contentWidget);
-    m_crashHeadEdit->setReadOnly(true);
-    gridLayout->addWidget(m_crashHeadEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("后碰撞:", contentWidget), row, 0);
-    m_crashRearEdit = new QLineEdit(contentWidget);
-    m_crashRearEdit->setReadOnly(true);
-    gridLayout->addWidget(m_crashRearEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("接近开关:", contentWidget), row, 0);
-    m_proximityEdit = new QLineEdit(contentWidget);
-    m_proximityEdit->setReadOnly(true);
-    gridLayout->addWidget(m_proximityEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("急停:", contentWidget), row, 0);
-    m_emergencyStopEdit = new QLineEdit(contentWidget);
-    m_emergencyStopEdit->setReadOnly(true);
-    gridLayout->addWidget(m_emergencyStopEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("火焰传感:", contentWidget), row, 0);
-    m_fireSensorEdit = new QLineEdit(contentWidget);
-    m_fireSensorEdit->setReadOnly(true);
-    gridLayout->addWidget(m_fireSensorEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("跌落传感:", contentWidget), row, 0);
-    m_fallSensorEdit = new QLineEdit(contentWidget);
-    m_fallSensorEdit->setReadOnly(true);
-    gridLayout->addWidget(m_fallSensorEdit, row++, 1);
-    
-    // 超声波传感器组
-    QLabel* ultrasonicGroupLabel = new QLabel("超声波传感器", contentWidget);
-    ultrasonicGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(ultrasonicGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("前超声波避障:", contentWidget), row, 0);
-    m_ultrasonicFEdit = new QLineEdit(contentWidget);
-    m_ultrasonicFEdit->setReadOnly(true);
-    gridLayout->addWidget(m_ultrasonicFEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("后超声波避障:", contentWidget), row, 0);
-    m_ultrasonicREdit = new QLineEdit(contentWidget);
-    m_ultrasonicREdit->setReadOnly(true);
-    gridLayout->addWidget(m_ultrasonicREdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("左转超声波避障:", contentWidget), row, 0);
-    m_ultrasonicTlEdit = new QLineEdit(contentWidget);
-    m_ultrasonicTlEdit->setReadOnly(true);
-    gridLayout->addWidget(m_ultrasonicTlEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("右转超声波避障:", contentWidget), row, 0);
-    m_ultrasonicTrEdit = new QLineEdit(contentWidget);
-    m_ultrasonicTrEdit->setReadOnly(true);
-    gridLayout->addWidget(m_ultrasonicTrEdit, row++, 1);
-    
-    // 气体传感器组
-    QLabel* gasGroupLabel = new QLabel("气体传感器", contentWidget);
-    gasGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(gasGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("air_h2s:", contentWidget), row, 0);
-    m_airH2sEdit = new QLineEdit(contentWidget);
-    m_airH2sEdit->setReadOnly(true);
-    gridLayout->addWidget(m_airH2sEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_co:", contentWidget), row, 0);
-    m_airCoEdit = new QLineEdit(contentWidget);
-    m_airCoEdit->setReadOnly(true);
-    gridLayout->addWidget(m_airCoEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_o2:", contentWidget), row, 0);
-    m_airO2Edit = new QLineEdit(contentWidget);
-    m_airO2Edit->setReadOnly(true);
-    gridLayout->addWidget(m_airO2Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_ex:", contentWidget), row, 0);
-    m_airExEdit = new QLineEdit(contentWidget);
-    m_airExEdit->setReadOnly(true);
-    gridLayout->addWidget(m_airExEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_edc:", contentWidget), row, 0);
-    m_airEdcEdit = new QLineEdit(contentWidget);
-    m_airEdcEdit->setReadOnly(true);
-    gridLayout->addWidget(m_airEdcEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_c2h4:", contentWidget), row, 0);
-    m_airC2h4Edit = new QLineEdit(contentWidget);
-    m_airC2h4Edit->setReadOnly(true);
-    gridLayout->addWidget(m_airC2h4Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_hcl:", contentWidget), row, 0);
-    m_airHclEdit = new QLineEdit(contentWidget);
-    m_airHclEdit->setReadOnly(true);
-    gridLayout->addWidget(m_airHclEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_cl2:", contentWidget), row, 0);
-    m_airCl2Edit = new QLineEdit(contentWidget);
-    m_airCl2Edit->setReadOnly(true);
-    gridLayout->addWidget(m_airCl2Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_c3h6:", contentWidget), row, 0);
-    m_airC3h6Edit = new QLineEdit(contentWidget);
-    m_airC3h6Edit->setReadOnly(true);
-    gridLayout->addWidget(m_airC3h6Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_h2:", contentWidget), row, 0);
-    m_airH2Edit = new QLineEdit(contentWidget);
-    m_airH2Edit->setReadOnly(true);
-    gridLayout->addWidget(m_airH2Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_temp:", contentWidget), row, 0);
-    m_airTempEdit = new QLineEdit(contentWidget);
-    m_airTempEdit->setReadOnly(true);
-    gridLayout->addWidget(m_airTempEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_hum:", contentWidget), row, 0);
-    m_airHumEdit = new QLineEdit(contentWidget);
-    m_airHumEdit->setReadOnly(true);
-    gridLayout->addWidget(m_airHumEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("air_sf6:", contentWidget), row, 0);
-    m_airSf6Edit = new QLineEdit(contentWidget);
-    m_airSf6Edit->setReadOnly(true);
-    gridLayout->addWidget(m_airSf6Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("cocl2:", contentWidget), row, 0);
-    m_cocl2Edit = new QLineEdit(contentWidget);
-    m_cocl2Edit->setReadOnly(true);
-    gridLayout->addWidget(m_cocl2Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("c2h6o:", contentWidget), row, 0);
-    m_c2h6oEdit = new QLineEdit(contentWidget);
-    m_c2h6oEdit->setReadOnly(true);
-    gridLayout->addWidget(m_c2h6oEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("ch4:", contentWidget), row, 0);
-    m_ch4Edit = new QLineEdit(contentWidget);
-    m_ch4Edit->setReadOnly(true);
-    gridLayout->addWidget(m_ch4Edit, row++, 1);
-    
-    // 驱动器电流组
-    QLabel* driverGroupLabel = new QLabel("驱动器电流", contentWidget);
-    driverGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(driverGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("drv0_current_ch0:", contentWidget), row, 0);
-    m_drv0CurrentCh0Edit = new QLineEdit(contentWidget);
-    m_drv0CurrentCh0Edit->setReadOnly(true);
-    gridLayout->addWidget(m_drv0CurrentCh0Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("drv0_current_ch1:", contentWidget), row, 0);
-    m_drv0CurrentCh1Edit = new QLineEdit(contentWidget);
-    m_drv0CurrentCh1Edit->setReadOnly(true);
-    gridLayout->addWidget(m_drv0CurrentCh1Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("drv1_current_ch0:", contentWidget), row, 0);
-    m_drv1CurrentCh0Edit = new QLineEdit(contentWidget);
-    m_drv1CurrentCh0Edit->setReadOnly(true);
-    gridLayout->addWidget(m_drv1CurrentCh0Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("drv1_current_ch1:", contentWidget), row, 0);
-    m_drv1CurrentCh1Edit = new QLineEdit(contentWidget);
-    m_drv1CurrentCh1Edit->setReadOnly(true);
-    gridLayout->addWidget(m_drv1CurrentCh1Edit, row++, 1);
-    
-    // 遥控器通道组
-    QLabel* joyChannelGroupLabel = new QLabel("遥控器通道", contentWidget);
-    joyChannelGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(joyChannelGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("joy_ch0:", contentWidget), row, 0);
-    m_joyCh0Edit = new QLineEdit(contentWidget);
-    m_joyCh0Edit->setReadOnly(true);
-    gridLayout->addWidget(m_joyCh0Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("joy_ch1:", contentWidget), row, 0);
-    m_joyCh1Edit = new QLineEdit(contentWidget);
-    m_joyCh1Edit->setReadOnly(true);
-    gridLayout->addWidget(m_joyCh1Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("joy_ch2:", contentWidget), row, 0);
-    m_joyCh2Edit = new QLineEdit(contentWidget);
-    m_joyCh2Edit->setReadOnly(true);
-    gridLayout->addWidget(m_joyCh2Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("joy_ch3:", contentWidget), row, 0);
-    m_joyCh3Edit = new QLineEdit(contentWidget);
-    m_joyCh3Edit->setReadOnly(true);
-    gridLayout->addWidget(m_joyCh3Edit, row++, 1);
-    
-    // 序列号组
-    QLabel* serialGroupLabel = new QLabel("序列号", contentWidget);
-    serialGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(serialGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("serial_number[0]:", contentWidget), row, 0);
-    m_serialNumber0Edit = new QLineEdit(contentWidget);
-    m_serialNumber0Edit->setReadOnly(true);
-    gridLayout->addWidget(m_serialNumber0Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("serial_number[1]:", contentWidget), row, 0);
-    m_serialNumber1Edit = new QLineEdit(contentWidget);
-    m_serialNumber1Edit->setReadOnly(true);
-    gridLayout->addWidget(m_serialNumber1Edit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("serial_number[2]:", contentWidget), row, 0);
-    m_serialNumber2Edit = new QLineEdit(contentWidget);
-    m_serialNumber2Edit->setReadOnly(true);
-    gridLayout->addWidget(m_serialNumber2Edit, row++, 1);
-    
-    // BMS和标志位组
-    QLabel* bmsGroupLabel = new QLabel("BMS和标志位", contentWidget);
-    bmsGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(bmsGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("sts_bms:", contentWidget), row, 0);
-    m_stsBmsEdit = new QLineEdit(contentWidget);
-    m_stsBmsEdit->setReadOnly(true);
-    gridLayout->addWidget(m_stsBmsEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("flag_air_invail:", contentWidget), row, 0);
-    m_flagAirInvailEdit = new QLineEdit(contentWidget);
-    m_flagAirInvailEdit->setReadOnly(true);
-    gridLayout->addWidget(m_flagAirInvailEdit, row++, 1);
-    
-    // 电机电流组
-    QLabel* motorCurrentGroupLabel = new QLabel("电机电流", contentWidget);
-    motorCurrentGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(motorCurrentGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("lf_motor_current:", contentWidget), row, 0);
-    m_lfMotorCurrentEdit = new QLineEdit(contentWidget);
-    m_lfMotorCurrentEdit->setReadOnly(true);
-    gridLayout->addWidget(m_lfMotorCurrentEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("rf_motor_current:", contentWidget), row, 0);
-    m_rfMotorCurrentEdit = new QLineEdit(contentWidget);
-    m_rfMotorCurrentEdit->setReadOnly(true);
-    gridLayout->addWidget(m_rfMotorCurrentEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("rr_motor_current:", contentWidget), row, 0);
-    m_rrMotorCurrentEdit = new QLineEdit(contentWidget);
-    m_rrMotorCurrentEdit->setReadOnly(true);
-    gridLayout->addWidget(m_rrMotorCurrentEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("lr_motor_current:", contentWidget), row, 0);
-    m_lrMotorCurrentEdit = new QLineEdit(contentWidget);
-    m_lrMotorCurrentEdit->setReadOnly(true);
-    gridLayout->addWidget(m_lrMotorCurrentEdit, row++, 1);
-    
-    // 控制信息组
-    QLabel* controlGroupLabel = new QLabel("控制信息", contentWidget);
-    controlGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(controlGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("控制模式:", contentWidget), row, 0);
-    m_ctrlModeEdit = new QLineEdit(contentWidget);
-    m_ctrlModeEdit->setReadOnly(true);
-    gridLayout->addWidget(m_ctrlModeEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("清除模式:", contentWidget), row, 0);
-    m_clearModeEdit = new QLineEdit(contentWidget);
-    m_clearModeEdit->setReadOnly(true);
-    gridLayout->addWidget(m_clearModeEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("遥控线速度:", contentWidget), row, 0);
-    m_joyVcEdit = new QLineEdit(contentWidget);
-    m_joyVcEdit->setReadOnly(true);
-    gridLayout->addWidget(m_joyVcEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("遥控角速度:", contentWidget), row, 0);
-    m_joyVwEdit = new QLineEdit(contentWidget);
-    m_joyVwEdit->setReadOnly(true);
-    gridLayout->addWidget(m_joyVwEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("反馈线速度:", contentWidget), row, 0);
-    m_twistVcEdit = new QLineEdit(contentWidget);
-    m_twistVcEdit->setReadOnly(true);
-    gridLayout->addWidget(m_twistVcEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("反馈角速度:", contentWidget), row, 0);
-    m_twistVwEdit = new QLineEdit(contentWidget);
-    m_twistVwEdit->setReadOnly(true);
-    gridLayout->addWidget(m_twistVwEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("指令线速度:", contentWidget), row, 0);
-    m_cmdVcEdit = new QLineEdit(contentWidget);
-    m_cmdVcEdit->setReadOnly(true);
-    gridLayout->addWidget(m_cmdVcEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("指令角速度:", contentWidget), row, 0);
-    m_cmdVwEdit = new QLineEdit(contentWidget);
-    m_cmdVwEdit->setReadOnly(true);
-    gridLayout->addWidget(m_cmdVwEdit, row++, 1);
-    
-    // 设备状态组
-    QLabel* deviceGroupLabel = new QLabel("设备状态", contentWidget);
-    deviceGroupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
-    gridLayout->addWidget(deviceGroupLabel, row++, 0, 1, 2);
-    
-    gridLayout->addWidget(new QLabel("设备锁状态:", contentWidget), row, 0);
-    m_devLockStaEdit = new QLineEdit(contentWidget);
-    m_devLockStaEdit->setReadOnly(true);
-    gridLayout->addWidget(m_devLockStaEdit, row++, 1);
-    
-    gridLayout->addWidget(new QLabel("升降机高度:", contentWidget), row, 0);
-    m_lifterHEdit = new QLineEdit(contentWidget);
-    m_lifterHEdit->setReadOnly(true);
-    gridLayout->addWidget(m_lifterHEdit, row++, 1);
+    // 按字段描述表生成显示项
+    int row = addFieldRows(gridLayout, contentWidget, kVcuFields, kVcuFieldCount, &m_vcuFieldEdits);
     
     // 最后更新时间
     m_vcuLastUpdateLabel = new QLabel("暂无数据", contentWidget);
@@ -701,9 +272,37 @@ void StatusWidget::initializeVcuTab()
     tabLayout->addWidget(m_vcuScrollArea);
 }
 
+int StatusWidget::addFieldRows(QGridLayout* gridLayout, QWidget* contentWidget,
+                               const FieldDescriptor* fields, int count, QVector<QLineEdit*>* edits)
+{
+    int row = 0;
+    const char* currentGroup = "";
+    
+    edits->clear();
+    edits->reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const FieldDescriptor& field = fields[i];
+        
+        // 分组标题
+        if (field.group[0] != '\0' && strcmp(field.group, currentGroup) != 0) {
+            currentGroup = field.group;
+            QLabel* groupLabel = new QLabel(QString::fromUtf8(field.group), contentWidget);
+            groupLabel->setStyleSheet("font-weight: bold; color: blue; margin-top: 10px;");
+            gridLayout->addWidget(groupLabel, row++, 0, 1, 2);
+        }
+        
+        gridLayout->addWidget(new QLabel(fieldDisplayLabel(field) + ":", contentWidget), row, 0);
+        QLineEdit* edit = new QLineEdit(contentWidget);
+        edit->setReadOnly(true);
+        gridLayout->addWidget(edit, row++, 1);
+        edits->append(edit);
+    }
+    
+    return row;
+}
+
 void StatusWidget::initializeNetworkConfigTab()
 {
-    m_networkConfigTab = new QWidget();
     m_networkConfigScrollArea = new QScrollArea(m_networkConfigTab);
     m_networkConfigScrollArea->setWidgetResizable(true);
     
@@ -719,11 +318,14 @@ void StatusWidget::initializeNetworkConfigTab()
     m_ipQueryBtn = new QPushButton("IP地址查询", queryGroupBox);
     m_maskQueryBtn = new QPushButton("子网掩码查询", queryGroupBox);
     m_gatewayQueryBtn = new QPushButton("网关地址查询", queryGroupBox);
+    m_networkReadAllBtn = new QPushButton("读取全部网络配置", queryGroupBox);
+    m_networkReadAllBtn->setToolTip("四项查询一次发出，按应答到达顺序填入");
     
     queryLayout->addWidget(m_macQueryBtn, 0, 0);
     queryLayout->addWidget(m_ipQueryBtn, 0, 1);
     queryLayout->addWidget(m_maskQueryBtn, 1, 0);
     queryLayout->addWidget(m_gatewayQueryBtn, 1, 1);
+    queryLayout->addWidget(m_networkReadAllBtn, 2, 0, 1, 2);
     
     mainLayout->addWidget(queryGroupBox);
     
@@ -771,6 +373,152 @@ void StatusWidget::initializeNetworkConfigTab()
     // 创建标签页布局
     QVBoxLayout* tabLayout = new QVBoxLayout(m_networkConfigTab);
     tabLayout->addWidget(m_networkConfigScrollArea);
+    
+    connect(m_macQueryBtn, &QPushButton::clicked, this, &StatusWidget::onMacQueryClicked);
+    connect(m_ipQueryBtn, &QPushButton::clicked, this, &StatusWidget::onIpQueryClicked);
+    connect(m_maskQueryBtn, &QPushButton::clicked, this, &StatusWidget::onMaskQueryClicked);
+    connect(m_gatewayQueryBtn, &QPushButton::clicked, this, &StatusWidget::onGatewayQueryClicked);
+    connect(m_networkReadAllBtn, &QPushButton::clicked, this, &StatusWidget::onNetworkReadAllClicked);
+}
+
+void StatusWidget::initializeTrendTab()
+{
+    QHBoxLayout* tabLayout = new QHBoxLayout(m_trendTab);
+    
+    // 左侧：时间窗口和字段选择
+    QVBoxLayout* selectLayout = new QVBoxLayout();
+    
+    m_trendWindowCombo = new QComboBox(m_trendTab);
+    m_trendWindowCombo->addItem("最近10秒", 10 * 1000);
+    m_trendWindowCombo->addItem("最近1分钟", 60 * 1000);
+    m_trendWindowCombo->addItem("最近10分钟", 10 * 60 * 1000);
+    m_trendWindowCombo->addItem("最近1小时", 60 * 60 * 1000);
+    m_trendWindowCombo->addItem("全部", 0);
+    m_trendWindowCombo->setCurrentIndex(1);
+    selectLayout->addWidget(m_trendWindowCombo);
+    
+    m_trendFieldList = new QListWidget(m_trendTab);
+    m_trendFieldList->setMaximumWidth(200);
+    for (int i = 0; i < TelemetryStore::fieldCount(); ++i) {
+        QListWidgetItem* item = new QListWidgetItem(TelemetryStore::fieldName(i), m_trendFieldList);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(Qt::Unchecked);
+        item->setData(Qt::UserRole, i);
+    }
+    selectLayout->addWidget(m_trendFieldList);
+    
+    // 右侧：曲线
+    m_trendChart = new TelemetryChartWidget(m_trendTab);
+    m_trendChart->setTimeWindow(m_trendWindowCombo->currentData().toLongLong());
+    if (m_telemetryStore) {
+        m_trendChart->setTelemetryStore(m_telemetryStore);
+    }
+    
+    tabLayout->addLayout(selectLayout);
+    tabLayout->addWidget(m_trendChart, 1);
+    
+    // 默认显示电压和电流
+    const QStringList defaultFields = QStringList() << "voltage" << "current";
+    for (const QString& name : defaultFields) {
+        int field = TelemetryStore::fieldIndex(name);
+        if (field >= 0) {
+            m_trendFieldList->item(field)->setCheckState(Qt::Checked);
+        }
+    }
+    onTrendFieldChanged(nullptr);
+    
+    connect(m_trendFieldList, &QListWidget::itemChanged, this, &StatusWidget::onTrendFieldChanged);
+    connect(m_trendWindowCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &StatusWidget::onTrendWindowChanged);
+}
+
+void StatusWidget::initializeSnapshotTab()
+{
+    QVBoxLayout* tabLayout = new QVBoxLayout(m_snapshotTab);
+    
+    // 窗口大小和清空
+    QHBoxLayout* controlLayout = new QHBoxLayout();
+    m_snapshotCountSpin = new QSpinBox(m_snapshotTab);
+    m_snapshotCountSpin->setRange(2, SnapshotHistory::MaxCapacity);
+    m_snapshotCountSpin->setValue(SnapshotHistory::DefaultCapacity);
+    m_snapshotClearBtn = new QPushButton("清空快照", m_snapshotTab);
+    m_snapshotInfoLabel = new QLabel(m_snapshotTab);
+    m_snapshotInfoLabel->setStyleSheet("color: gray;");
+    controlLayout->addWidget(new QLabel("保留最近", m_snapshotTab));
+    controlLayout->addWidget(m_snapshotCountSpin);
+    controlLayout->addWidget(new QLabel("次读取", m_snapshotTab));
+    controlLayout->addWidget(m_snapshotClearBtn);
+    controlLayout->addWidget(m_snapshotInfoLabel, 1);
+    tabLayout->addLayout(controlLayout);
+    
+    // 只列出窗口内变化过的字段，最近一次读取中变化的字段高亮
+    m_snapshotTable = new QTableWidget(0, 7, m_snapshotTab);
+    m_snapshotTable->setHorizontalHeaderLabels(QStringList() << "字段" << "上次值" << "当前值" << "变化量"
+                                               << "窗口最小值" << "窗口最大值" << "变化次数");
+    m_snapshotTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_snapshotTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_snapshotTable->verticalHeader()->setVisible(false);
+    m_snapshotTable->horizontalHeader()->setStretchLastSection(true);
+    tabLayout->addWidget(m_snapshotTable, 1);
+    
+    updateSnapshotTable();
+    
+    connect(m_snapshotCountSpin, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &StatusWidget::onSnapshotCountChanged);
+    connect(m_snapshotClearBtn, &QPushButton::clicked, this, &StatusWidget::onSnapshotClearClicked);
+}
+
+void StatusWidget::updateSnapshotTable()
+{
+    if (!m_tabBuilt[SnapshotTab]) {
+        return;
+    }
+    
+    const int count = m_snapshotHistory.size();
+    if (count == 0) {
+        m_snapshotInfoLabel->setText("暂无快照，读取VCU综合信息后自动保存");
+    } else {
+        m_snapshotInfoLabel->setText(QString("已保存 %1 个快照，%2 至 %3")
+            .arg(count)
+            .arg(QDateTime::fromMSecsSinceEpoch(m_snapshotHistory.timestampAt(0)).toString("hh:mm:ss.zzz"))
+            .arg(QDateTime::fromMSecsSinceEpoch(m_snapshotHistory.timestampAt(count - 1)).toString("hh:mm:ss.zzz")));
+    }
+    
+    const QVector<SnapshotHistory::FieldDiff> diffs = m_snapshotHistory.diff();
+    m_snapshotTable->setRowCount(diffs.size());
+    if (diffs.isEmpty()) {
+        return;
+    }
+    
+    const state_def_t* previous = m_snapshotHistory.stateAt(count - 2);
+    const state_def_t* current = m_snapshotHistory.stateAt(count - 1);
+    const QColor highlight(255, 240, 200);
+    
+    for (int row = 0; row < diffs.size(); ++row) {
+        const SnapshotHistory::FieldDiff& diff = diffs[row];
+        const FieldDescriptor& field = kVcuFields[diff.field];
+        
+        QStringList cells;
+        cells << fieldDisplayLabel(field)
+              << formatFieldValue(field, previous)
+              << formatFieldValue(field, current);
+        if (diff.numeric) {
+            cells << QString::number(diff.delta, 'f', field.precision)
+                  << QString::number(diff.minimum, 'f', field.precision)
+                  << QString::number(diff.maximum, 'f', field.precision);
+        } else {
+            cells << "-" << "-" << "-";
+        }
+        cells << QString::number(diff.changeCount);
+        
+        for (int column = 0; column < cells.size(); ++column) {
+            QTableWidgetItem* item = new QTableWidgetItem(cells[column]);
+            if (diff.changedLast) {
+                item->setBackground(highlight);
+            }
+            m_snapshotTable->setItem(row, column, item);
+        }
+    }
 }
 
 void StatusWidget::setupConnections()
@@ -779,11 +527,8 @@ void StatusWidget::setupConnections()
     connect(m_hardFaultReadBtn, &QPushButton::clicked, this, &StatusWidget::onHardFaultReadClicked);
     connect(m_vcuReadBtn, &QPushButton::clicked, this, &StatusWidget::onVcuReadClicked);
     
-    // 网络配置查询按钮信号连接
-    connect(m_macQueryBtn, &QPushButton::clicked, this, &StatusWidget::onMacQueryClicked);
-    connect(m_ipQueryBtn, &QPushButton::clicked, this, &StatusWidget::onIpQueryClicked);
-    connect(m_maskQueryBtn, &QPushButton::clicked, this, &StatusWidget::onMaskQueryClicked);
-    connect(m_gatewayQueryBtn, &QPushButton::clicked, this, &StatusWidget::onGatewayQueryClicked);
+    // 各标签页内控件的信号在构建该页时连接
+    connect(m_displayTabWidget, &QTabWidget::currentChanged, this, &StatusWidget::onDisplayTabChanged);
     
     // 状态更新定时器
     m_statusTimer = new QTimer(this);
@@ -791,6 +536,69 @@ void StatusWidget::setupConnections()
     m_statusTimer->start(1000); // 每秒更新一次
 }
 
+void StatusWidget::setTelemetryStore(const TelemetryStore* store)
+{
+    m_telemetryStore = store;
+    if (m_trendChart) {
+        m_trendChart->setTelemetryStore(store);
+    }
+}
+
+void StatusWidget::notifyTelemetryAppended()
+{
+    // 趋势图未构建时不需要通知，构建时直接读取全部数据
+    if (m_trendChart) {
+        m_trendChart->notifyDataAppended();
+    }
+}
+
+void StatusWidget::onTrendFieldChanged(QListWidgetItem* item)
+{
+    Q_UNUSED(item);
+    
+    QList<int> fields;
+    for (int i = 0; i < m_trendFieldList->count(); ++i) {
+        QListWidgetItem* fieldItem = m_trendFieldList->item(i);
+        if (fieldItem->checkState() == Qt::Checked) {
+            fields.append(fieldItem->data(Qt::UserRole).toInt());
+        }
+    }
+    m_trendChart->setTraces(fields);
+}
+
+void StatusWidget::onSnapshotCountChanged(int count)
+{
+    m_snapshotHistory.setCapacity(count);
+    updateSnapshotTable();
+}
+
+void StatusWidget::onSnapshotClearClicked()
+{
+    m_snapshotHistory.clear();
+    updateSnapshotTable();
+}
+
+void StatusWidget::onDisplayTabChanged(int index)
+{
+    if (index < 0) {
+        return;
+    }
+    if (!m_tabBuilt[index]) {
+        ensureTabBuilt(index);
+        return;
+    }
+    
+    // 快照表只在可见时刷新，切换过来时补一次
+    if (m_displayTabWidget->widget(index) == m_snapshotTab) {
+        updateSnapshotTable();
+    }
+}
+
+void StatusWidget::onTrendWindowChanged(int index)
+{
+    m_trendChart->setTimeWindow(m_trendWindowCombo->itemData(index).toLongLong());
+}
+
 void StatusWidget::onHardFaultReadClicked()
 {
     emit hardFaultInfoReadRequested();
@@ -801,6 +609,59 @@ void StatusWidget::onVcuReadClicked()
     emit vcuInfoReadRequested();
 }
 
+void StatusWidget::onLoadFirmwareClicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(this,
+        "加载固件ELF",
+        "",
+        "ELF文件 (*.elf *.axf *.out);;所有文件 (*.*)");
+    
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    QString error;
+    QSharedPointer<ElfSymbolizer> symbolizer = ElfSymbolizer::open(fileName, &error);
+    if (!symbolizer) {
+        showErrorMessage(error);
+        return;
+    }
+    
+    m_symbolizer = symbolizer;
+    QString buildId = m_symbolizer->buildId().isEmpty() ? QString("无") : QString::fromLatin1(m_symbolizer->buildId().toHex());
+    m_firmwareLabel->setText(QString("%1  build-id: %2  函数: %3%4")
+                             .arg(QFileInfo(fileName).fileName(), buildId)
+                             .arg(m_symbolizer->functionCount())
+                             .arg(m_symbolizer->hasLineInfo() ? "" : "（无行号信息）"));
+    m_firmwareLabel->setStyleSheet("");
+    updateFaultLocations();
+}
+
+QString StatusWidget::describeAddress(quint32 address)
+{
+    // LR 为 EXC_RETURN 时表示故障发生在异常返回过程中
+    if (address >= 0xFFFFFFE0u) {
+        return "EXC_RETURN（异常返回）";
+    }
+    return m_symbolizer->resolve(address).toString();
+}
+
+void StatusWidget::updateFaultLocations()
+{
+    if (!m_symbolizer || !m_tabBuilt[HardFaultTab]) {
+        return;
+    }
+    
+    if (m_hasHardFault) {
+        m_pcLocationEdit->setText(describeAddress(m_lastHardFault.pc_value));
+        m_lrLocationEdit->setText(describeAddress(m_lastHardFault.lr_value));
+    }
+    
+    for (int row = 0; row < m_hardFaultLocations.size() && row < m_hardFaultLocationTable->rowCount(); ++row) {
+        m_hardFaultLocationTable->setItem(row, 4, new QTableWidgetItem(describeAddress(m_hardFaultLocations[row].pc)));
+    }
+}
+
 void StatusWidget::onMacQueryClicked()
 {
     emit macAddressQueryRequested();
@@ -821,132 +682,111 @@ void StatusWidget::onGatewayQueryClicked()
     emit gatewayAddressQueryRequested();
 }
 
+void StatusWidget::onNetworkReadAllClicked()
+{
+    emit networkConfigReadRequested();
+}
+
 void StatusWidget::displayHardFaultInfo(const hardfault_info_t& hardFaultData)
 {
-    // 更新HardFault信息显示
-    m_magicNumberEdit->setText(formatHexValue(hardFaultData.magic_number));
-    m_timestampEdit->setText(formatTimestamp(hardFaultData.timestamp));
-    m_spValueEdit->setText(formatHexValue(hardFaultData.sp_value));
-    m_r0ValueEdit->setText(formatHexValue(hardFaultData.r0_value));
-    m_r1ValueEdit->setText(formatHexValue(hardFaultData.r1_value));
-    m_r2ValueEdit->setText(formatHexValue(hardFaultData.r2_value));
-    m_r3ValueEdit->setText(formatHexValue(hardFaultData.r3_value));
-    m_r12ValueEdit->setText(formatHexValue(hardFaultData.r12_value));
-    m_lrValueEdit->setText(formatHexValue(hardFaultData.lr_value));
-    m_pcValueEdit->setText(formatHexValue(hardFaultData.pc_value));
-    m_xpsrValueEdit->setText(formatHexValue(hardFaultData.xpsr_value));
-    m_faultCountEdit->setText(QString::number(hardFaultData.fault_count));
-    
-    // 更新时间戳
+    m_lastHardFault = hardFaultData;
+    m_hasHardFault = true;
+    m_lastHardFaultUpdate = QDateTime::currentDateTime();
+    
+    // 切换到HardFault页面（未构建时在此构建并显示上面保存的数据）
+    m_displayTabWidget->setCurrentIndex(HardFaultTab);
+    updateHardFaultFields();
+}
+
+void StatusWidget::displayNoHardFault()
+{
+    m_hasHardFault = false;
     m_lastHardFaultUpdate = QDateTime::currentDateTime();
+    
+    m_displayTabWidget->setCurrentIndex(HardFaultTab);
+    updateHardFaultFields();
+}
+
+void StatusWidget::updateHardFaultFields()
+{
+    if (!m_tabBuilt[HardFaultTab] || !m_lastHardFaultUpdate.isValid()) {
+        return;
+    }
+    
+    if (!m_hasHardFault) {
+        for (int i = 0; i < kHardFaultFieldCount; ++i) {
+            m_hardFaultFieldEdits[i]->clear();
+        }
+        m_hardFaultLastUpdateLabel->setText(QString("无故障记录（%1）")
+                                            .arg(m_lastHardFaultUpdate.toString("yyyy-MM-dd hh:mm:ss")));
+        m_pcLocationEdit->clear();
+        m_lrLocationEdit->clear();
+        return;
+    }
+    
+    for (int i = 0; i < kHardFaultFieldCount; ++i) {
+        m_hardFaultFieldEdits[i]->setText(formatFieldValue(kHardFaultFields[i], &m_lastHardFault));
+    }
     m_hardFaultLastUpdateLabel->setText(m_lastHardFaultUpdate.toString("yyyy-MM-dd hh:mm:ss"));
+    updateFaultLocations();
+}
+
+void StatusWidget::displayHardFaultLocations(const QVector<HardFaultHistory::Location>& locations)
+{
+    m_hardFaultLocations = locations;
+    updateHardFaultLocationTable();
+}
+
+void StatusWidget::updateHardFaultLocationTable()
+{
+    if (!m_tabBuilt[HardFaultTab]) {
+        return;
+    }
     
-    // 切换到HardFault页面
-    m_displayTabWidget->setCurrentIndex(0);
+    const QVector<HardFaultHistory::Location>& locations = m_hardFaultLocations;
+    m_hardFaultLocationTable->setRowCount(locations.size());
+    for (int row = 0; row < locations.size(); ++row) {
+        const HardFaultHistory::Location& location = locations[row];
+        m_hardFaultLocationTable->setItem(row, 0, new QTableWidgetItem(
+            "0x" + QString("%1").arg(location.pc, 8, 16, QChar('0')).toUpper()));
+        m_hardFaultLocationTable->setItem(row, 1, new QTableWidgetItem(QString::number(location.faultCount)));
+        m_hardFaultLocationTable->setItem(row, 2, new QTableWidgetItem(QString::number(location.deviceCount)));
+        m_hardFaultLocationTable->setItem(row, 3, new QTableWidgetItem(
+            QDateTime::fromMSecsSinceEpoch(location.lastSeenMs).toString("yyyy-MM-dd hh:mm:ss")));
+    }
+    
+    updateFaultLocations();
 }
 
 void StatusWidget::displayVcuInfo(const state_def_t& vcuData)
 {
-    // 版本信息
-    m_softwareVersionEdit->setText(formatVersion(vcuData.software_version, 16));
-    m_hardwareVersionEdit->setText(formatVersion(vcuData.hardware_version, 16));
-    m_bootVersionEdit->setText(formatVersion(vcuData.boot_version, 16));
-    
-    // 电源信息
-    m_electricEdit->setText(QString::number(vcuData.electric));
-    m_voltageEdit->setText(formatFloatValue(vcuData.voltage, 2));
-    m_currentEdit->setText(formatFloatValue(vcuData.current, 2));
-    m_wirelessVoltageEdit->setText(formatFloatValue(vcuData.wireless_voltage, 2));
-    m_wirelessCurrentEdit->setText(formatFloatValue(vcuData.wireless_current, 2));
-    m_batTemperatureEdit->setText(formatFloatValue(vcuData.bat_temperature, 2));
-    
-    // 环境信息
-    m_temperatureEdit->setText(formatFloatValue(vcuData.temperature, 2));
-    m_humidityEdit->setText(formatFloatValue(vcuData.humidity, 2));
-    
-    // 网络信息
-    m_ipAddressEdit->setText(formatIpAddress(vcuData.ip));
-    m_portEdit->setText(QString::number(vcuData.port));
-    
-    // 传感器状态
-    m_crashHeadEdit->setText(QString::number(vcuData.crash_head));
-    m_crashRearEdit->setText(QString::number(vcuData.crash_rear));
-    m_proximityEdit->setText(QString::number(vcuData.proximity));
-    m_emergencyStopEdit->setText(QString::number(vcuData.emergency_stop));
-    m_fireSensorEdit->setText(QString::number(vcuData.fire_sensor));
-    m_fallSensorEdit->setText(QString::number(vcuData.fall_sensor));
-    
-    // 超声波传感器
-    m_ultrasonicFEdit->setText(QString::number(vcuData.ultrasonic_f));
-    m_ultrasonicREdit->setText(QString::number(vcuData.ultrasonic_r));
-    m_ultrasonicTlEdit->setText(QString::number(vcuData.ultrasonic_tl));
-    m_ultrasonicTrEdit->setText(QString::number(vcuData.ultrasonic_tr));
-    
-    // 气体传感器数据
-    m_airH2sEdit->setText(formatFloatValue(vcuData.air_h2s, 2));
-    m_airCoEdit->setText(formatFloatValue(vcuData.air_co, 2));
-    m_airO2Edit->setText(formatFloatValue(vcuData.air_o2, 2));
-    m_airExEdit->setText(formatFloatValue(vcuData.air_ex, 2));
-    m_airEdcEdit->setText(formatFloatValue(vcuData.air_edc, 2));
-    m_airC2h4Edit->setText(formatFloatValue(vcuData.air_c2h4, 2));
-    m_airHclEdit->setText(formatFloatValue(vcuData.air_hcl, 2));
-    m_airCl2Edit->setText(formatFloatValue(vcuData.air_cl2, 2));
-    m_airC3h6Edit->setText(formatFloatValue(vcuData.air_c3h6, 2));
-    m_airH2Edit->setText(formatFloatValue(vcuData.air_h2, 2));
-    m_airTempEdit->setText(formatFloatValue(vcuData.air_temp, 2));
-    m_airHumEdit->setText(formatFloatValue(vcuData.air_hum, 2));
-    m_airSf6Edit->setText(formatFloatValue(vcuData.air_sf6, 2));
-    m_cocl2Edit->setText(formatFloatValue(vcuData.cocl2, 2));
-    m_c2h6oEdit->setText(formatFloatValue(vcuData.c2h6o, 2));
-    m_ch4Edit->setText(formatFloatValue(vcuData.ch4, 2));
-    
-    // 驱动器电流数据
-    m_drv0CurrentCh0Edit->setText(formatFloatValue(vcuData.drv0_current_ch0, 2));
-    m_drv0CurrentCh1Edit->setText(formatFloatValue(vcuData.drv0_current_ch1, 2));
-    m_drv1CurrentCh0Edit->setText(formatFloatValue(vcuData.drv1_current_ch0, 2));
-    m_drv1CurrentCh1Edit->setText(formatFloatValue(vcuData.drv1_current_ch1, 2));
-    
-    // 遥控器通道数据
-    m_joyCh0Edit->setText(formatFloatValue(vcuData.joy_ch0, 2));
-    m_joyCh1Edit->setText(formatFloatValue(vcuData.joy_ch1, 2));
-    m_joyCh2Edit->setText(formatFloatValue(vcuData.joy_ch2, 2));
-    m_joyCh3Edit->setText(formatFloatValue(vcuData.joy_ch3, 2));
-    
-    // 序列号数据
-    m_serialNumber0Edit->setText(formatHexValue(vcuData.serial_number[0]));
-    m_serialNumber1Edit->setText(formatHexValue(vcuData.serial_number[1]));
-    m_serialNumber2Edit->setText(formatHexValue(vcuData.serial_number[2]));
-    
-    // BMS和标志位
-    m_stsBmsEdit->setText(formatHexValue(vcuData.sts_bms));
-    m_flagAirInvailEdit->setText(QString::number(vcuData.flag_air_invail));
-    
-    // 电机电流数据
-    m_lfMotorCurrentEdit->setText(formatFloatValue(vcuData.lf_motor_current, 2));
-    m_rfMotorCurrentEdit->setText(formatFloatValue(vcuData.rf_motor_current, 2));
-    m_rrMotorCurrentEdit->setText(formatFloatValue(vcuData.rr_motor_current, 2));
-    m_lrMotorCurrentEdit->setText(formatFloatValue(vcuData.lr_motor_current, 2));
-    
-    // 控制信息
-    m_ctrlModeEdit->setText(QString::number(vcuData.ctrl_mode));
-    m_clearModeEdit->setText(QString::number(vcuData.clear_mode));
-    m_joyVcEdit->setText(formatFloatValue(vcuData.joy_vc, 3));
-    m_joyVwEdit->setText(formatFloatValue(vcuData.joy_vw, 3));
-    m_twistVcEdit->setText(formatFloatValue(vcuData.twist_vc, 3));
-    m_twistVwEdit->setText(formatFloatValue(vcuData.twist_vw, 3));
-    m_cmdVcEdit->setText(formatFloatValue(vcuData.cmd_vc, 3));
-    m_cmdVwEdit->setText(formatFloatValue(vcuData.cmd_vw, 3));
-    
-    // 设备状态
-    m_devLockStaEdit->setText(QString::number(vcuData.dev_lock_sta));
-    m_lifterHEdit->setText(QString::number(vcuData.lifter_h));
-    
-    // 更新时间戳
+    m_lastVcu = vcuData;
+    m_hasVcu = true;
     m_lastVcuUpdate = QDateTime::currentDateTime();
-    m_vcuLastUpdateLabel->setText(m_lastVcuUpdate.toString("yyyy-MM-dd hh:mm:ss"));
+    updateVcuFields();
+    
+    // 保存快照
+    m_snapshotHistory.append(m_lastVcuUpdate.toMSecsSinceEpoch(), vcuData);
+    
+    // 正在查看趋势图或快照对比时停留在当前页，否则切换到VCU页面
+    QWidget* currentTab = m_displayTabWidget->currentWidget();
+    if (currentTab == m_snapshotTab) {
+        updateSnapshotTable();
+    } else if (currentTab != m_trendTab) {
+        m_displayTabWidget->setCurrentIndex(VcuTab);
+    }
+}
+
+void StatusWidget::updateVcuFields()
+{
+    if (!m_tabBuilt[VcuTab] || !m_hasVcu) {
+        return;
+    }
     
-    // 切换到VCU页面
-    m_displayTabWidget->setCurrentIndex(1);
+    for (int i = 0; i < kVcuFieldCount; ++i) {
+        m_vcuFieldEdits[i]->setText(formatFieldValue(kVcuFields[i], &m_lastVcu));
+    }
+    m_vcuLastUpdateLabel->setText(m_lastVcuUpdate.toString("yyyy-MM-dd hh:mm:ss"));
 }
 
 void StatusWidget::setReadingStatus(bool isReading, const QString& message)
@@ -974,57 +814,6 @@ void StatusWidget::updateStatusDisplay()
 {
 }
 
-// 数据格式化工具函数实现
-QString StatusWidget::formatTimestamp(uint32_t timestamp)
-{
-    uint32_t seconds = timestamp / 1000;
-    uint32_t ms = timestamp % 1000;
-    uint32_t hours = seconds / 3600;
-    uint32_t minutes = (seconds % 3600) / 60;
-    uint32_t secs = seconds % 60;
-    
-    return QString("%1:%2:%3.%4")
-           .arg(hours, 2, 10, QChar('0'))
-           .arg(minutes, 2, 10, QChar('0'))
-           .arg(secs, 2, 10, QChar('0'))
-           .arg(ms, 3, 10, QChar('0'));
-}
-
-QString StatusWidget::formatHexValue(uint32_t value)
-{
-    return QString("0x%1").arg(value, 8, 16, QChar('0')).toUpper();
-}
-
-QString StatusWidget::formatFloatValue(float value, int precision)
-{
-    return QString::number(value, 'f', precision);
-}
-
-QString StatusWidget::formatBoolValue(uint8_t value)
-{
-    return value ? "是" : "否";
-}
-
-QString StatusWidget::formatIpAddress(const uint8_t ip[4])
-{
-    return QString("%1.%2.%3.%4")
-           .arg(ip[0])
-           .arg(ip[1])
-           .arg(ip[2])
-           .arg(ip[3]);
-}
-
-QString StatusWidget::formatVersion(const char* version, int maxLength)
-{
-    QByteArray versionArray(version, maxLength);
-    // 查找第一个'\0'或到达最大长度
-    int nullIndex = versionArray.indexOf('\0');
-    if (nullIndex >= 0) {
-        versionArray.truncate(nullIndex);
-    }
-    return QString::fromUtf8(versionArray);
-}
-
 void StatusWidget::displayMacAddress(const QByteArray& macData)
 {
     if (macData.size() == 6) {
@@ -1036,11 +825,12 @@ void StatusWidget::displayMacAddress(const QByteArray& macData)
                            .arg((uint8_t)macData[1], 2, 16, QChar('0'))
                            .arg((uint8_t)macData[0], 2, 16, QChar('0')).toUpper();
         
-        m_queryMacAddressEdit->setText(macString);
-        m_networkConfigLastUpdateLabel->setText(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"));
+        m_macText = macString;
+        m_lastNetworkConfigUpdate = QDateTime::currentDateTime();
     } else {
-        m_queryMacAddressEdit->setText("数据格式错误");
+        m_macText = "数据格式错误";
     }
+    updateNetworkConfigDisplay();
 }
 
 void StatusWidget::displayIpAddress(const QByteArray& ipData)
@@ -1052,11 +842,12 @@ void StatusWidget::displayIpAddress(const QByteArray& ipData)
                           .arg((uint8_t)ipData[1])
                           .arg((uint8_t)ipData[0]);
         
-        m_queryIpAddressEdit->setText(ipString);
-        m_networkConfigLastUpdateLabel->setText(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"));
+        m_ipText = ipString;
+        m_lastNetworkConfigUpdate = QDateTime::currentDateTime();
     } else {
-        m_queryIpAddressEdit->setText("数据格式错误");
+        m_ipText = "数据格式错误";
     }
+    updateNetworkConfigDisplay();
 }
 
 void StatusWidget::displayMaskAddress(const QByteArray& maskData)
@@ -1068,11 +859,12 @@ void StatusWidget::displayMaskAddress(const QByteArray& maskData)
                             .arg((uint8_t)maskData[1])
                             .arg((uint8_t)maskData[0]);
         
-        m_queryMaskAddressEdit->setText(maskString);
-        m_networkConfigLastUpdateLabel->setText(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"));
+        m_maskText = maskString;
+        m_lastNetworkConfigUpdate = QDateTime::currentDateTime();
     } else {
-        m_queryMaskAddressEdit->setText("数据格式错误");
+        m_maskText = "数据格式错误";
     }
+    updateNetworkConfigDisplay();
 }
 
 void StatusWidget::displayGatewayAddress(const QByteArray& gatewayData)
@@ -1084,9 +876,25 @@ void StatusWidget::displayGatewayAddress(const QByteArray& gatewayData)
                                .arg((uint8_t)gatewayData[1])
                                .arg((uint8_t)gatewayData[0]);
         
-        m_queryGatewayAddressEdit->setText(gatewayString);
-        m_networkConfigLastUpdateLabel->setText(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"));
+        m_gatewayText = gatewayString;
+        m_lastNetworkConfigUpdate = QDateTime::currentDateTime();
     } else {
-        m_queryGatewayAddressEdit->setText("数据格式错误");
+        m_gatewayText = "数据格式错误";
     }
-} 
\ No newline at end of file
+    updateNetworkConfigDisplay();
+}
+
+void StatusWidget::updateNetworkConfigDisplay()
+{
+    if (!m_tabBuilt[NetworkConfigTab]) {
+        return;
+    }
+    
+    m_queryMacAddressEdit->setText(m_macText);
+    m_queryIpAddressEdit->setText(m_ipText);
+    m_queryMaskAddressEdit->setText(m_maskText);
+    m_queryGatewayAddressEdit->setText(m_gatewayText);
+    if (m_lastNetworkConfigUpdate.isValid()) {
+        m_networkConfigLastUpdateLabel->setText(m_lastNetworkConfigUpdate.toString("yyyy-MM-dd hh:mm:ss"));
+    }
+}
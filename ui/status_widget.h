@@ -14,10 +14,17 @@
 #include <QProgressBar>
 #include <QTimer>
 #include <QDateTime>
+#include <QVector>
+#include <QListWidget>
+#include <QComboBox>
+#include <QTableWidget>
+#include <QSpinBox>
+#include "telemetry_chart_widget.h"
 
-extern "C" {
-#include "../pc_protocol.h"
-}
+#include "../protocol/field_descriptor.h"
+#include "../telemetry/hardfault_history.h"
+#include "../firmware/elf_symbolizer.h"
+#include "../telemetry/snapshot_history.h"
 
 class StatusWidget : public QWidget
 {
@@ -29,8 +36,13 @@ public:
 
     // 数据显示方法
     void displayHardFaultInfo(const hardfault_info_t& hardFaultData);
+    // 设备应答无故障记录（全零结构）
+    void displayNoHardFault();
     void displayVcuInfo(const state_def_t& vcuData);
     
+    // 全车队故障位置统计（按故障次数降序）
+    void displayHardFaultLocations(const QVector<HardFaultHistory::Location>& locations);
+    
     // 网络配置显示方法
     void displayMacAddress(const QByteArray& macData);
     void displayIpAddress(const QByteArray& ipData);
@@ -40,6 +52,14 @@ public:
     // 状态管理
     void setReadingStatus(bool isReading, const QString& message = QString());
     void showErrorMessage(const QString& error);
+    
+    // 趋势图数据源
+    void setTelemetryStore(const TelemetryStore* store);
+    void notifyTelemetryAppended();
+
+protected:
+    // 第一次显示时才构建当前标签页
+    void showEvent(QShowEvent* event) override;
 
 signals:
     // 请求信号
@@ -51,22 +71,45 @@ signals:
     void ipAddressQueryRequested();
     void maskAddressQueryRequested();
     void gatewayAddressQueryRequested();
+    // 四项网络配置一次读取
+    void networkConfigReadRequested();
 
 private slots:
     // 按键槽函数
     void onHardFaultReadClicked();
     void onVcuReadClicked();
+    void onLoadFirmwareClicked();
     
     // 网络配置查询按键槽函数
     void onMacQueryClicked();
     void onIpQueryClicked();
     void onMaskQueryClicked();
     void onGatewayQueryClicked();
+    void onNetworkReadAllClicked();
+    
+    // 趋势图
+    void onTrendFieldChanged(QListWidgetItem* item);
+    void onTrendWindowChanged(int index);
+    
+    // 快照对比
+    void onSnapshotCountChanged(int count);
+    void onSnapshotClearClicked();
+    void onDisplayTabChanged(int index);
     
     // 状态更新
     void updateStatusDisplay();
 
 private:
+    // 显示区域标签页（与 addTab 顺序一致）
+    enum DisplayTab {
+        HardFaultTab = 0,
+        VcuTab,
+        NetworkConfigTab,
+        TrendTab,
+        SnapshotTab,
+        DisplayTabCount
+    };
+    
     // UI初始化
     void initializeUI();
     void initializeControlGroup();
@@ -74,15 +117,24 @@ private:
     void initializeHardFaultTab();
     void initializeVcuTab();
     void initializeNetworkConfigTab();
+    void initializeTrendTab();
+    void initializeSnapshotTab();
+    // 标签页内容在第一次切换到该页时构建，之前收到的数据构建后补显示
+    void ensureTabBuilt(int index);
+    void updateHardFaultFields();
+    void updateHardFaultLocationTable();
+    void updateVcuFields();
+    void updateNetworkConfigDisplay();
+    void updateSnapshotTable();
     void setupConnections();
     
-    // 数据格式化工具
-    QString formatTimestamp(uint32_t timestamp);
-    QString formatHexValue(uint32_t value);
-    QString formatFloatValue(float value, int precision = 2);
-    QString formatBoolValue(uint8_t value);
-    QString formatIpAddress(const uint8_t ip[4]);
-    QString formatVersion(const char* version, int maxLength);
+    // 用已加载的固件解析 PC/LR 和故障位置统计
+    void updateFaultLocations();
+    QString describeAddress(quint32 address);
+    
+    // 按字段描述表生成一组“名称: 值”显示行，返回下一个空行号
+    int addFieldRows(QGridLayout* gridLayout, QWidget* contentWidget,
+                     const FieldDescriptor* fields, int count, QVector<QLineEdit*>* edits);
     
     // UI组件
     QVBoxLayout* m_mainLayout;
@@ -96,107 +148,33 @@ private:
     
     // 显示区域
     QTabWidget* m_displayTabWidget;
+    bool m_tabBuilt[DisplayTabCount];
     
     // HardFault信息显示
     QWidget* m_hardFaultTab;
     QScrollArea* m_hardFaultScrollArea;
-    QLineEdit* m_magicNumberEdit;
-    QLineEdit* m_timestampEdit;
-    QLineEdit* m_spValueEdit;
-    QLineEdit* m_r0ValueEdit;
-    QLineEdit* m_r1ValueEdit;
-    QLineEdit* m_r2ValueEdit;
-    QLineEdit* m_r3ValueEdit;
-    QLineEdit* m_r12ValueEdit;
-    QLineEdit* m_lrValueEdit;
-    QLineEdit* m_pcValueEdit;
-    QLineEdit* m_xpsrValueEdit;
-    QLineEdit* m_faultCountEdit;
+    QVector<QLineEdit*> m_hardFaultFieldEdits;     // 与 kHardFaultFields 一一对应
     QLabel* m_hardFaultLastUpdateLabel;
+    QTableWidget* m_hardFaultLocationTable;
+    QPushButton* m_firmwareLoadBtn;
+    QLabel* m_firmwareLabel;
+    QLineEdit* m_pcLocationEdit;
+    QLineEdit* m_lrLocationEdit;
+    
+    // 固件符号解析
+    QSharedPointer<ElfSymbolizer> m_symbolizer;
+    hardfault_info_t m_lastHardFault;
+    bool m_hasHardFault;
+    QVector<HardFaultHistory::Location> m_hardFaultLocations;
     
     // VCU信息显示
     QWidget* m_vcuTab;
     QScrollArea* m_vcuScrollArea;
-    QLineEdit* m_softwareVersionEdit;
-    QLineEdit* m_hardwareVersionEdit;
-    QLineEdit* m_bootVersionEdit;
-    QLineEdit* m_electricEdit;
-    QLineEdit* m_voltageEdit;
-    QLineEdit* m_currentEdit;
-    QLineEdit* m_wirelessVoltageEdit;
-    QLineEdit* m_wirelessCurrentEdit;
-    QLineEdit* m_temperatureEdit;
-    QLineEdit* m_humidityEdit;
-    QLineEdit* m_ipAddressEdit;
-    QLineEdit* m_portEdit;
-    QLineEdit* m_crashHeadEdit;
-    QLineEdit* m_crashRearEdit;
-    QLineEdit* m_proximityEdit;
-    QLineEdit* m_emergencyStopEdit;
-    QLineEdit* m_ctrlModeEdit;
-    QLineEdit* m_clearModeEdit;
-    QLineEdit* m_joyVcEdit;
-    QLineEdit* m_joyVwEdit;
-    QLineEdit* m_twistVcEdit;
-    QLineEdit* m_twistVwEdit;
-    QLineEdit* m_batTemperatureEdit;
-    QLineEdit* m_cmdVcEdit;
-    QLineEdit* m_cmdVwEdit;
-    QLineEdit* m_devLockStaEdit;
-    QLineEdit* m_fireSensorEdit;
-    QLineEdit* m_fallSensorEdit;
-    QLineEdit* m_ultrasonicFEdit;
-    QLineEdit* m_ultrasonicREdit;
-    QLineEdit* m_ultrasonicTlEdit;
-    QLineEdit* m_ultrasonicTrEdit;
-    QLineEdit* m_lifterHEdit;
-    
-    // 气体传感器数据
-    QLineEdit* m_airH2sEdit;
-    QLineEdit* m_airCoEdit;
-    QLineEdit* m_airO2Edit;
-    QLineEdit* m_airExEdit;
-    QLineEdit* m_airEdcEdit;
-    QLineEdit* m_airC2h4Edit;
-    QLineEdit* m_airHclEdit;
-    QLineEdit* m_airCl2Edit;
-    QLineEdit* m_airC3h6Edit;
-    QLineEdit* m_airH2Edit;
-    QLineEdit* m_airTempEdit;
-    QLineEdit* m_airHumEdit;
-    QLineEdit* m_airSf6Edit;
-    QLineEdit* m_cocl2Edit;
-    QLineEdit* m_c2h6oEdit;
-    QLineEdit* m_ch4Edit;
-    
-    // 驱动器电流数据
-    QLineEdit* m_drv0CurrentCh0Edit;
-    QLineEdit* m_drv0CurrentCh1Edit;
-    QLineEdit* m_drv1CurrentCh0Edit;
-    QLineEdit* m_drv1CurrentCh1Edit;
-    
-    // 遥控器通道数据
-    QLineEdit* m_joyCh0Edit;
-    QLineEdit* m_joyCh1Edit;
-    QLineEdit* m_joyCh2Edit;
-    QLineEdit* m_joyCh3Edit;
-    
-    // 序列号数据
-    QLineEdit* m_serialNumber0Edit;
-    QLineEdit* m_serialNumber1Edit;
-    QLineEdit* m_serialNumber2Edit;
-    
-    // BMS和标志位
-    QLineEdit* m_stsBmsEdit;
-    QLineEdit* m_flagAirInvailEdit;
-    
-    // 电机电流数据
-    QLineEdit* m_lfMotorCurrentEdit;
-    QLineEdit* m_rfMotorCurrentEdit;
-    QLineEdit* m_rrMotorCurrentEdit;
-    QLineEdit* m_lrMotorCurrentEdit;
+    QVector<QLineEdit*> m_vcuFieldEdits;           // 与 kVcuFields 一一对应
     
     QLabel* m_vcuLastUpdateLabel;
+    state_def_t m_lastVcu;
+    bool m_hasVcu;
     
     // 网络配置标签页
     QWidget* m_networkConfigTab;
@@ -205,12 +183,35 @@ private:
     QPushButton* m_ipQueryBtn;
     QPushButton* m_maskQueryBtn;
     QPushButton* m_gatewayQueryBtn;
+    QPushButton* m_networkReadAllBtn;
     QLineEdit* m_queryMacAddressEdit;
     QLineEdit* m_queryIpAddressEdit;
     QLineEdit* m_queryMaskAddressEdit;
     QLineEdit* m_queryGatewayAddressEdit;
     QLabel* m_networkConfigLastUpdateLabel;
     
+    // 网络配置显示文本（标签页未构建时先保存）
+    QString m_macText;
+    QString m_ipText;
+    QString m_maskText;
+    QString m_gatewayText;
+    QDateTime m_lastNetworkConfigUpdate;
+    
+    // 趋势图标签页
+    QWidget* m_trendTab;
+    QListWidget* m_trendFieldList;
+    QComboBox* m_trendWindowCombo;
+    TelemetryChartWidget* m_trendChart;
+    const TelemetryStore* m_telemetryStore;
+    
+    // 快照对比标签页
+    QWidget* m_snapshotTab;
+    QSpinBox* m_snapshotCountSpin;
+    QPushButton* m_snapshotClearBtn;
+    QLabel* m_snapshotInfoLabel;
+    QTableWidget* m_snapshotTable;
+    SnapshotHistory m_snapshotHistory;
+    
     // 状态管理
     bool m_isReading;
     QTimer* m_statusTimer;
@@ -0,0 +1,246 @@
+#include "telemetry_chart_widget.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QDateTime>
+#include <cmath>
+
+namespace {
+
+// 左侧标签区宽度和底部时间轴高度
+const int kLabelWidth = 160;
+const int kAxisHeight = 20;
+
+// 曲线配色
+const QColor kTraceColors[] = {
+    QColor(31, 119, 180), QColor(255, 127, 14), QColor(44, 160, 44), QColor(214, 39, 40),
+    QColor(148, 103, 189), QColor(140, 86, 75), QColor(227, 119, 194), QColor(127, 127, 127),
+    QColor(188, 189, 34), QColor(23, 190, 207), QColor(0, 0, 128), QColor(128, 128, 0)
+};
+const int kTraceColorCount = static_cast<int>(sizeof(kTraceColors) / sizeof(kTraceColors[0]));
+
+} // namespace
+
+TelemetryChartWidget::TelemetryChartWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_store(nullptr)
+    , m_timeWindowMs(60 * 1000)
+    , m_dirty(true)
+    , m_refreshTimer(nullptr)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumHeight(200);
+
+    // 最高 60 帧刷新，没有新数据时不重绘
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(16);
+    connect(m_refreshTimer, &QTimer::timeout, this, &TelemetryChartWidget::onRefreshTimeout);
+}
+
+TelemetryChartWidget::~TelemetryChartWidget()
+{
+    clearPyramids();
+}
+
+void TelemetryChartWidget::setTelemetryStore(const TelemetryStore* store)
+{
+    QList<int> fields = traces();
+    m_store = store;
+    setTraces(fields);
+}
+
+void TelemetryChartWidget::setTraces(const QList<int>& fields)
+{
+    clearPyramids();
+    if (m_store) {
+        for (int field : fields) {
+            if (field >= 0 && field < TelemetryStore::fieldCount()) {
+                m_pyramids.append(new MinMaxPyramid(m_store, field));
+            }
+        }
+    }
+    m_dirty = true;
+    update();
+}
+
+QList<int> TelemetryChartWidget::traces() const
+{
+    QList<int> fields;
+    for (MinMaxPyramid* pyramid : m_pyramids) {
+        fields.append(pyramid->field());
+    }
+    return fields;
+}
+
+void TelemetryChartWidget::setTimeWindow(qint64 windowMs)
+{
+    m_timeWindowMs = qMax<qint64>(0, windowMs);
+    m_dirty = true;
+    update();
+}
+
+void TelemetryChartWidget::notifyDataAppended()
+{
+    m_dirty = true;
+}
+
+void TelemetryChartWidget::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().color(QPalette::Base));
+
+    if (!m_store || m_pyramids.isEmpty()) {
+        painter.setPen(palette().color(QPalette::Text));
+        painter.drawText(rect(), Qt::AlignCenter, "请在左侧勾选要显示的字段");
+        return;
+    }
+
+    // 增量更新金字塔
+    for (MinMaxPyramid* pyramid : m_pyramids) {
+        pyramid->sync();
+    }
+
+    QPair<qint64, qint64> range = visibleRange();
+    const QRect plotArea(kLabelWidth, 0, qMax(1, width() - kLabelWidth), qMax(1, height() - kAxisHeight));
+    const int laneCount = m_pyramids.size();
+
+    for (int i = 0; i < laneCount; ++i) {
+        const int top = plotArea.top() + plotArea.height() * i / laneCount;
+        const int bottom = plotArea.top() + plotArea.height() * (i + 1) / laneCount;
+        const QRect lane(plotArea.left(), top, plotArea.width(), bottom - top);
+
+        painter.setPen(palette().color(QPalette::Mid));
+        painter.drawLine(0, bottom - 1, width(), bottom - 1);
+
+        drawTrace(painter, m_pyramids[i], lane, range.first, range.second, kTraceColors[i % kTraceColorCount]);
+    }
+
+    // 时间轴：可见范围的起止时间
+    painter.setPen(palette().color(QPalette::Text));
+    const QRect axisArea(plotArea.left(), plotArea.bottom() + 1, plotArea.width(), kAxisHeight);
+    if (range.second > range.first) {
+        QString beginText = QDateTime::fromMSecsSinceEpoch(m_store->timestampAt(range.first)).toString("hh:mm:ss");
+        QString endText = QDateTime::fromMSecsSinceEpoch(m_store->timestampAt(range.second - 1)).toString("hh:mm:ss");
+        painter.drawText(axisArea, Qt::AlignLeft | Qt::AlignVCenter, beginText);
+        painter.drawText(axisArea, Qt::AlignRight | Qt::AlignVCenter, endText);
+    }
+    painter.drawText(axisArea, Qt::AlignCenter, QString("%1 个样本").arg(range.second - range.first));
+}
+
+void TelemetryChartWidget::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+    m_dirty = true;
+}
+
+void TelemetryChartWidget::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    m_refreshTimer->start();
+}
+
+void TelemetryChartWidget::hideEvent(QHideEvent* event)
+{
+    QWidget::hideEvent(event);
+    m_refreshTimer->stop();
+}
+
+void TelemetryChartWidget::onRefreshTimeout()
+{
+    if (m_dirty) {
+        m_dirty = false;
+        update();
+    }
+}
+
+void TelemetryChartWidget::clearPyramids()
+{
+    qDeleteAll(m_pyramids);
+    m_pyramids.clear();
+}
+
+QPair<qint64, qint64> TelemetryChartWidget::visibleRange() const
+{
+    if (m_store->isEmpty()) {
+        return qMakePair(m_store->nextSequence(), m_store->nextSequence());
+    }
+    if (m_timeWindowMs == 0) {
+        return qMakePair(m_store->firstSequence(), m_store->nextSequence());
+    }
+    const qint64 lastTimestamp = m_store->timestampAt(m_store->nextSequence() - 1);
+    return m_store->sequenceRange(lastTimestamp - m_timeWindowMs, lastTimestamp);
+}
+
+void TelemetryChartWidget::drawTrace(QPainter& painter, MinMaxPyramid* pyramid, const QRect& lane,
+                                     qint64 beginSequence, qint64 endSequence, const QColor& color)
+{
+    const int pixels = lane.width();
+    pyramid->query(beginSequence, endSequence, pixels, &m_minBuffer, &m_maxBuffer);
+
+    // 纵轴范围
+    float low = 0.0f;
+    float high = 0.0f;
+    bool hasValue = false;
+    for (int x = 0; x < pixels; ++x) {
+        if (std::isnan(m_minBuffer[x])) {
+            continue;
+        }
+        if (!hasValue) {
+            low = m_minBuffer[x];
+            high = m_maxBuffer[x];
+            hasValue = true;
+        } else {
+            low = qMin(low, m_minBuffer[x]);
+            high = qMax(high, m_maxBuffer[x]);
+        }
+    }
+
+    // 标签：字段名和纵轴范围
+    const QRect labelArea(4, lane.top(), kLabelWidth - 8, lane.height());
+    painter.setPen(color);
+    QString label = TelemetryStore::fieldName(pyramid->field());
+    if (hasValue) {
+        label += QString("\n[%1, %2]").arg(low, 0, 'g', 6).arg(high, 0, 'g', 6);
+    }
+    painter.drawText(labelArea, Qt::AlignLeft | Qt::AlignVCenter, label);
+
+    if (!hasValue) {
+        return;
+    }
+
+    // 常量曲线画在带中间
+    const double span = high > low ? static_cast<double>(high) - low : 1.0;
+    const double top = lane.top() + 2;
+    const double scale = (lane.height() - 4) / span;
+    const double offset = high > low ? 0.0 : (lane.height() - 4) / 2.0;
+    auto mapY = [&](float value) {
+        return top + offset + (high - value) * scale;
+    };
+
+    // 每个像素列一条 min-max 竖线，相邻列首尾相连
+    m_lineBuffer.clear();
+    m_lineBuffer.reserve(pixels * 2);
+    double previousX = 0.0;
+    double previousY = 0.0;
+    bool hasPrevious = false;
+    for (int x = 0; x < pixels; ++x) {
+        if (std::isnan(m_minBuffer[x])) {
+            continue;
+        }
+        const double px = lane.left() + x + 0.5;
+        const double yMin = mapY(m_minBuffer[x]);
+        const double yMax = mapY(m_maxBuffer[x]);
+        if (hasPrevious) {
+            const double joinY = previousY < yMax ? yMax : (previousY > yMin ? yMin : previousY);
+            m_lineBuffer.append(QLineF(previousX, previousY, px, joinY));
+        }
+        m_lineBuffer.append(QLineF(px, yMax, px, yMin));
+        previousX = px;
+        previousY = (yMin + yMax) / 2.0;
+        hasPrevious = true;
+    }
+
+    painter.setPen(QPen(color, 1));
+    painter.drawLines(m_lineBuffer);
+}
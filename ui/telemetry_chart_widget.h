@@ -0,0 +1,63 @@
+#ifndef TELEMETRY_CHART_WIDGET_H
+#define TELEMETRY_CHART_WIDGET_H
+
+#include <QWidget>
+#include <QTimer>
+#include <QList>
+#include <QVector>
+#include "../telemetry/telemetry_store.h"
+#include "../telemetry/minmax_pyramid.h"
+
+// 遥测趋势图（QPainter 绘制的多通道带状图）
+// 每条曲线占一条水平带，纵轴按可见范围内的最小/最大值自动缩放；
+// 数据来自 TelemetryStore，经 MinMaxPyramid 按像素抽稀，
+// 新数据到达只置脏标记，由 16ms 定时器合并重绘
+class TelemetryChartWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TelemetryChartWidget(QWidget *parent = nullptr);
+    ~TelemetryChartWidget();
+
+    void setTelemetryStore(const TelemetryStore* store);
+
+    // 设置显示的字段（TelemetryStore 字段索引）
+    void setTraces(const QList<int>& fields);
+    QList<int> traces() const;
+
+    // 显示最近 windowMs 毫秒的数据，0 表示显示全部
+    void setTimeWindow(qint64 windowMs);
+
+public slots:
+    // 存储中有新样本
+    void notifyDataAppended();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private slots:
+    void onRefreshTimeout();
+
+private:
+    void clearPyramids();
+    QPair<qint64, qint64> visibleRange() const;
+    void drawTrace(QPainter& painter, MinMaxPyramid* pyramid, const QRect& lane,
+                   qint64 beginSequence, qint64 endSequence, const QColor& color);
+
+    const TelemetryStore* m_store;
+    QList<MinMaxPyramid*> m_pyramids;
+    qint64 m_timeWindowMs;
+    bool m_dirty;
+    QTimer* m_refreshTimer;
+
+    // 绘制缓冲，避免每帧分配
+    QVector<float> m_minBuffer;
+    QVector<float> m_maxBuffer;
+    QVector<QLineF> m_lineBuffer;
+};
+
+#endif // TELEMETRY_CHART_WIDGET_H